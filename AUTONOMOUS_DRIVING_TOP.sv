@@ -1,47 +1,95 @@
 `timescale 1ns/1ps
-module AUTONOMOUS_DRIVING_TOP(
+// CNN → PID 단독 통합 탑 (AXI 없이 고정 설정, PID 기본값은 AXI 레지스터 리셋값과 같음)
+module AUTONOMOUS_DRIVING_TOP #(
+    parameter [4:0]  ERR_SHIFT = 5'd11,          // CNN_OUTPUT_SCALE (2048)
+    parameter signed [15:0] KP = 16'sh0100,      // Q8.8, 1.0
+    parameter signed [15:0] KI = 16'sh0000,
+    parameter signed [15:0] KD = 16'sh0000,
+    parameter [23:0] INT_LIMIT = 24'd8192,
+    parameter [7:0]  OUT_LIMIT = 8'd80           // 조향 최대
+)(
     input logic clk,
-    input logic rst,
+    input logic rst,          // Active Low
     input logic start_signal, // 전체 시스템 시작 신호
-    
+
     // 카메라 이미지 입력
     input logic pixel_valid,
     input logic [7:0] pixel_in,
-    
+
     // 최종 제어 출력
     output logic final_control_valid,
-    output logic signed [47:0] final_control_output // 예: 조향각
+    output logic signed [15:0] final_control_output // 조향 명령 (±OUT_LIMIT)
 );
 
     // CNN과 PID 간의 연결 신호
     logic cnn_result_valid;
     logic signed [47:0] cnn_lane_error;
 
-    // 1. CNN 모듈 인스턴스화
-    CNN_TOP u_cnn_top(
+    // 1. CNN 모듈 인스턴스화 (32x32 고정 파이프라인, 합성 시 초기 가중치)
+    CNN_TOP_Improved u_cnn_top(
         .clk(clk),
         .rst(rst),
         .start_signal(start_signal),
         .pixel_valid(pixel_valid),
         .pixel_in(pixel_in),
-        
+
         // CNN의 최종 출력을 PID로 연결
         .final_result_valid(cnn_result_valid),
-        .final_lane_result(cnn_lane_error)
+        .final_lane_result(cnn_lane_error),
+        .final_class_idx(),
+        .final_class_score(),
+        .final_class_margin(),
+        .final_frame_tag(),
+        .frame_ready(),
+        .cnn_busy(),
+        .perf_stage_busy(),
+        .perf_stage_stall(),
+        .final_latency(),
+        .final_fc_cycles(),
+        .final_fc_nonzero(),
+        .final_t_feature(),
+        .final_t_flatten(),
+        .final_t_fc_start(),
+        .final_seq_path(),
+        .timeout_error(),
+        .i_wt_wr_en(1'b0),
+        .i_wt_wr_addr(17'd0),
+        .i_wt_wr_data(32'd0),
+        .i_wt_swap_req(1'b0),
+        .o_wt_active_bank(),
+        .o_wt_swap_busy(),
+        .i_quant_cfg(32'h0000_0001),
+        .i_geometry(32'h0000_2020),
+        .i_seq_ctrl(32'd0),
+        .i_seq_wr_en(1'b0),
+        .i_seq_wr_addr(17'd0),
+        .i_seq_wr_data(32'd0),
+        .o_seq_busy(),
+        .o_seq_error(),
+        .o_seq_layer()
     );
 
     // 2. PID 제어기 인스턴스화
     PID_Controller u_pid_controller(
         .clk(clk),
         .rst(rst),
-        
+
+        // 고정 설정
+        .i_clear(1'b0),
+        .i_err_shift(ERR_SHIFT),
+        .i_kp(KP),
+        .i_ki(KI),
+        .i_kd(KD),
+        .i_int_limit(INT_LIMIT),
+        .i_out_limit(OUT_LIMIT),
+
         // CNN의 출력을 PID의 입력으로 사용
         .i_cnn_valid(cnn_result_valid),
         .i_cnn_error(cnn_lane_error),
-        
+
         // PID의 최종 출력을 시스템의 최종 출력으로 연결
         .o_pid_valid(final_control_valid),
         .o_pid_output(final_control_output)
     );
 
-endmodule
\ No newline at end of file
+endmodule
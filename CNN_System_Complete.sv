@@ -2,10 +2,10 @@ module IP_CNN_System_WithTest(
     input logic clk,
     input logic rst_n,
     
-    // SPI SLAVE - 라즈베리파이로부터 이미지 수신
+    // SPI SLAVE - 라즈베리파이로부터 이미지 수신 (spi_frame_receiver 프레임, 1비트 모드만: io1~3 핀 없음)
     input logic spi_slave_sclk,   
     input logic spi_slave_mosi,   
-    output logic spi_slave_miso,  
+    output logic spi_slave_miso,  // 명령 바이트 동안 상태 바이트
     input logic spi_slave_ss,     
     
     // SPI MASTER - 모터보드로 명령 전송  
@@ -17,7 +17,7 @@ module IP_CNN_System_WithTest(
     // 상태 LED
     output logic [3:0] status_led,
     
-    // 테스트 전용 인터페이스
+    // 테스트 전용 인터페이스 (헤더/CRC 없이 32x32 픽셀 1024개를 직접 주입)
     input logic test_mode,        
     input logic test_pixel_valid, 
     input logic [7:0] test_pixel_data
@@ -28,26 +28,21 @@ module IP_CNN_System_WithTest(
     logic cnn_pixel_valid;
     logic [7:0] cnn_pixel_data;
     logic cnn_busy;
+    logic cnn_frame_ready;
     logic cnn_result_valid;
     logic signed [47:0] cnn_result;
     
-    // ===== SPI Slave 신호들 =====
-    logic [7:0] spi_rx_data;
-    logic spi_rx_valid;
+    // ===== SPI 프레임 수신기 신호들 =====
+    logic rx_frame_start, rx_frame_done, rx_frame_ok;
+    logic rx_pixel_valid;
+    logic [7:0] rx_pixel_data;
+    logic spi_miso_out, spi_miso_oe;
     
-    // ===== 테스트 모드 신호 선택 =====
-    logic [7:0] rx_data;
-    logic rx_valid;
-    
-    always_comb begin
-        if (test_mode) begin
-            rx_data = test_pixel_data;
-            rx_valid = test_pixel_valid;
-        end else begin
-            rx_data = spi_rx_data;
-            rx_valid = spi_rx_valid;
-        end
-    end
+    // ===== 테스트 모드 픽셀 경로 =====
+    logic test_accept, test_start, test_active;
+    logic test_valid_d;
+    logic [7:0] test_data_d;
+    logic test_done;
     
     // ===== SPI Master 신호들 =====
     logic [7:0] spi_tx_data;
@@ -57,6 +52,8 @@ module IP_CNN_System_WithTest(
     // ===== 제어 신호들 =====
     logic [15:0] pixel_count;
     logic [2:0] motor_command;
+    logic frame_ok;        // 수신 프레임 CRC 일치 (테스트 모드는 항상 1)
+    logic result_seen;     // 프레임 종료 확인 전에 CNN 결과가 먼저 나온 경우
     
     // ===== 상태 머신 =====
     enum logic [2:0] {
@@ -67,61 +64,31 @@ module IP_CNN_System_WithTest(
         DONE       = 3'b100
     } current_state, next_state;
 
-    // ===== 간단한 SPI SLAVE 구현 =====
-    logic [2:0] spi_bit_count;
-    logic [7:0] spi_shift_reg;
-    logic spi_sclk_d1, spi_sclk_d2;
-    logic spi_ss_d1, spi_ss_d2;
-    logic spi_sclk_posedge, spi_sclk_negedge;
-    logic spi_ss_negedge, spi_ss_posedge;
+    // ===== SPI 프레임 수신기 (SCLK 도메인 캡처 + 비동기 FIFO + 헤더/CRC) =====
+    spi_frame_receiver #(
+        .FIFO_DEPTH(64)
+    ) spi_slave_inst (
+        .clk(clk),
+        .rst(rst_n),
+        .i_sclk(spi_slave_sclk),
+        .i_ss_n(spi_slave_ss),
+        .i_io({3'b000, spi_slave_mosi}),
+        .o_miso(spi_miso_out),
+        .o_miso_oe(spi_miso_oe),
+        .i_expected_len(16'd1024),   // 32x32 고정 (i_geometry 기본값)
+        .i_frame_ready(cnn_frame_ready && current_state == IDLE && !test_mode),   // 이전 결과 전송까지 FIFO에서 대기
+        .o_frame_start(rx_frame_start),
+        .o_pixel_valid(rx_pixel_valid),
+        .o_pixel_data(rx_pixel_data),
+        .o_frame_done(rx_frame_done),
+        .o_frame_ok(rx_frame_ok),
+        .o_seq(),
+        .o_frame_count(),
+        .o_error_count(),
+        .o_busy()
+    );
 
-    
-    // 클럭 도메인 동기화
-    always_ff @(posedge clk or negedge rst_n) begin
-        if (!rst_n) begin
-            spi_sclk_d1 <= 0; spi_sclk_d2 <= 0;
-            spi_ss_d1 <= 1; spi_ss_d2 <= 1;
-        end else begin
-            spi_sclk_d1 <= spi_slave_sclk; spi_sclk_d2 <= spi_sclk_d1;
-            spi_ss_d1 <= spi_slave_ss; spi_ss_d2 <= spi_ss_d1;
-        end
-    end
-    
-    assign spi_sclk_posedge = spi_sclk_d1 & ~spi_sclk_d2;
-    assign spi_sclk_negedge = ~spi_sclk_d1 & spi_sclk_d2;
-    assign spi_ss_negedge = ~spi_ss_d1 & spi_ss_d2;
-    assign spi_ss_posedge = spi_ss_d1 & ~spi_ss_d2;
-    
-    // SPI Slave 로직
-    always_ff @(posedge clk or negedge rst_n) begin
-        if (!rst_n) begin
-            spi_bit_count <= 0;
-            spi_shift_reg <= 0;
-            spi_rx_data <= 0;
-            spi_rx_valid <= 0;
-        end else begin
-            spi_rx_valid <= 0; // 기본값
-            
-            if (spi_ss_negedge) begin
-                // SPI 전송 시작
-                spi_bit_count <= 0;
-                spi_shift_reg <= 0;
-            end else if (!spi_slave_ss && spi_sclk_posedge) begin
-                // 데이터 수신 (SCLK 상승 엣지에서)
-                spi_shift_reg <= {spi_shift_reg[6:0], spi_slave_mosi};
-                spi_bit_count <= spi_bit_count + 1;
-                
-                if (spi_bit_count == 7) begin
-                    // 8비트 완성
-                    spi_rx_data <= {spi_shift_reg[6:0], spi_slave_mosi};
-                    spi_rx_valid <= 1;
-                    spi_bit_count <= 0;
-                end
-            end
-        end
-    end
-    
-    assign spi_slave_miso = 1'b0; // 간단히 0으로 고정
+    assign spi_slave_miso = spi_miso_oe ? spi_miso_out : 1'b0;
 
     // ===== 간단한 SPI MASTER 구현 =====
     logic [3:0] master_bit_count;
@@ -180,8 +147,8 @@ module IP_CNN_System_WithTest(
         end
     end
 
-    // ===== CNN 엔진 (간단한 버전 사용) =====
-   CNN_TOP_Simple cnn_engine (
+    // ===== CNN 엔진 =====
+    CNN_TOP_Improved cnn_engine (
         .clk(clk),
         .rst(rst_n),
         .start_signal(cnn_start),
@@ -189,26 +156,40 @@ module IP_CNN_System_WithTest(
         .pixel_in(cnn_pixel_data),
         .final_result_valid(cnn_result_valid),
         .final_lane_result(cnn_result),
-        .cnn_busy(cnn_busy)
-    ); 
+        .frame_ready(cnn_frame_ready),
+        .cnn_busy(cnn_busy),
+        // 가중치는 합성 시 초기값 사용 (런타임 로드 없음)
+        .i_wt_wr_en(1'b0),
+        .i_wt_wr_addr(17'd0),
+        .i_wt_wr_data(32'd0),
+        .i_wt_swap_req(1'b0),
+        .i_quant_cfg(32'h0000_0001),
+        .i_geometry(32'h0000_2020),
+        // 레이어 시퀀서 미사용 (고정 파이프라인)
+        .i_seq_ctrl(32'd0),
+        .i_seq_wr_en(1'b0),
+        .i_seq_wr_addr(17'd0),
+        .i_seq_wr_data(32'd0),
+        .o_seq_busy(),
+        .o_seq_error(),
+        .o_seq_layer()
+    );
 
     // ===== 제어 로직 =====
     
-    // 상태 전환 (통합 신호 사용)
+    // 상태 전환 (SPI 프레임 또는 테스트 픽셀)
     always_comb begin
         next_state = current_state;
         case (current_state)
             IDLE: begin
-                if (rx_valid) next_state = RECEIVING;
+                if (test_mode ? test_start : rx_frame_start) next_state = RECEIVING;
             end
             RECEIVING: begin
-                if (pixel_count >= 1023) next_state = PROCESSING;
+                if (test_mode ? test_done : rx_frame_done) next_state = PROCESSING;
+            end
+            PROCESSING: begin
+                if (cnn_result_valid || result_seen) next_state = frame_ok ? SENDING : DONE;
             end
-           PROCESSING: begin
-    if (cnn_result_valid) begin
-        next_state = SENDING;
-    end
-end
             SENDING: begin
                 if (!spi_tx_busy) next_state = DONE;
             end
@@ -226,107 +207,97 @@ end
         end
     end
     
-    // ===== 픽셀 데이터 처리 (디버그 추가) =====
+    // ===== 테스트 모드 픽셀: 첫 픽셀 클럭에 시작 펄스, 픽셀은 한 클럭 뒤에 CNN으로 =====
+    // (CNN이 다음 프레임을 받을 수 있을 때만 새 프레임 시작, 1024개 후 종료)
+    assign test_accept = test_mode && test_pixel_valid && (test_active || (current_state == IDLE && cnn_frame_ready));
+    assign test_start = test_accept && !test_active;
+
     always_ff @(posedge clk or negedge rst_n) begin
         if (!rst_n) begin
             pixel_count <= 0;
-            cnn_start <= 0;
-            cnn_pixel_valid <= 0;
-            cnn_pixel_data <= 0;
+            test_active <= 0;
+            test_valid_d <= 0;
+            test_data_d <= 0;
+            test_done <= 0;
         end else begin
-            case (current_state)
-               IDLE: begin
-    pixel_count <= 0;
-    cnn_start <= 0;
-    // 상태 진입시에만 출력
-    if (current_state != IDLE) begin
-        $display("DEBUG: IDLE 상태 진입");
+            test_done <= 0;
+            test_valid_d <= test_accept;
+            test_data_d <= test_pixel_data;
+            if (test_accept) begin
+                test_active <= 1;
+                pixel_count <= pixel_count + 1;
+                if (pixel_count == 1023) begin
+                    test_active <= 0;
+                    test_done <= 1;
+                    pixel_count <= 0;
+                    $display("DEBUG: 1024 픽셀 수신 완료");
+                end
+            end
+        end
     end
-end
-                
+    
+    assign cnn_start = test_mode ? test_start : rx_frame_start;
+    assign cnn_pixel_valid = test_mode ? test_valid_d : rx_pixel_valid;
+    assign cnn_pixel_data = test_mode ? test_data_d : rx_pixel_data;
+
+    always_ff @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            frame_ok <= 0;
+            result_seen <= 0;
+        end else begin
+            case (current_state)
+                IDLE: begin
+                    result_seen <= 0;
+                end
                 RECEIVING: begin
-                    if (rx_valid) begin
-                        // 수신된 픽셀 데이터 처리
-                        cnn_pixel_data <= rx_data;
-                        cnn_pixel_valid <= 1;
-                        
-                        pixel_count <= pixel_count + 1;
-                        
-                        // 디버그 출력 - 매번 출력
-                        $display("DEBUG: 픽셀 수신 - count=%d, data=0x%02X", pixel_count, rx_data);
-                        
-                        // CNN 시작 신호 (첫 번째 픽셀에서만)
-                        if (pixel_count == 0) begin
-                            cnn_start <= 1;
-                            $display("DEBUG: CNN 시작 신호 활성화");
-                        end else begin
-                            cnn_start <= 0;
-                        end
-                        
-                        // 100개마다 출력
-                        if (pixel_count % 100 == 0) begin
-                            $display("DEBUG: %d/1024 픽셀 수신됨", pixel_count);
-                        end
-                        
-                        if (pixel_count >= 1023) begin
-                            $display("DEBUG: !!! 1024 픽셀 수신 완료 - 다음 상태로 전환해야 함 !!!");
-                        end
-                    end else begin
-                        cnn_pixel_valid <= 0;
-                        cnn_start <= 0;
-                    end
+                    if (cnn_result_valid) result_seen <= 1;
+                    if (test_mode ? test_done : rx_frame_done) frame_ok <= test_mode | rx_frame_ok;
                 end
-                
                 PROCESSING: begin
-    cnn_pixel_valid <= 0;
-    cnn_start <= 0;
-    if (cnn_result_valid) begin
-        $display("DEBUG: ✅ CNN 처리 완료! 결과: 0x%012X", cnn_result);
-    end
-end
-                
-                default: begin
-                    cnn_pixel_valid <= 0;
-                    cnn_start <= 0;
+                    if (cnn_result_valid) begin
+                        $display("DEBUG: ✅ CNN 처리 완료! 결과: 0x%012X", cnn_result);
+                    end
                 end
+                default: ;
             endcase
         end
     end
     
     // ===== 모터 명령 생성 및 전송 (간소화) =====
-   always_ff @(posedge clk or negedge rst_n) begin
-    if (!rst_n) begin
-        motor_command <= 3'b000;
-        spi_tx_data <= 8'h00;
-        spi_tx_start <= 0;
-    end else begin
-        spi_tx_start <= 0;
-        
-        case (current_state)
-            PROCESSING: begin
-                if (cnn_result_valid) begin
-                    // CNN 결과에 따른 모터 명령
-                    if (cnn_result[47] == 1'b1) begin
-                        motor_command <= 3'b001;  // 좌회전
-                    end else if (cnn_result[46:0] > 47'h1000000000000) begin
-                        motor_command <= 3'b010;  // 우회전  
-                    end else begin
-                        motor_command <= 3'b100;  // 직진
+    always_ff @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            motor_command <= 3'b000;
+            spi_tx_data <= 8'h00;
+            spi_tx_start <= 0;
+        end else begin
+            spi_tx_start <= 0;
+            
+            case (current_state)
+                RECEIVING, PROCESSING: begin
+                    if (cnn_result_valid) begin
+                        // CNN 결과에 따른 모터 명령
+                        if (cnn_result[47] == 1'b1) begin
+                            motor_command <= 3'b001;  // 좌회전
+                        end else if (cnn_result[46:0] > 47'h1000000000000) begin
+                            motor_command <= 3'b010;  // 우회전  
+                        end else begin
+                            motor_command <= 3'b100;  // 직진
+                        end
                     end
-                    $display("DEBUG: CNN 결과: 0x%012X, 모터: %b", cnn_result, motor_command);
                 end
-            end
-            
-            SENDING: begin
-                if (current_state != next_state) begin
-                    spi_tx_data <= {5'b10101, motor_command};
-                    spi_tx_start <= 1;
-                    $display("DEBUG: SPI 전송: 0x%02X", {5'b10101, motor_command});
+                
+                SENDING: begin
+                    if (current_state != next_state) begin
+                        spi_tx_data <= {5'b10101, motor_command};
+                        spi_tx_start <= 1;
+                        $display("DEBUG: SPI 전송: 0x%02X", {5'b10101, motor_command});
+                    end
                 end
-            end
-        endcase
+                
+                default: ;
+            endcase
+        end
     end
-end
     
     // ===== 상태 표시 =====
     always_ff @(posedge clk or negedge rst_n) begin
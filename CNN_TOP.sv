@@ -1,5 +1,13 @@
 `timescale 1ns/1ps
-module CNN_TOP_Improved(
+module CNN_TOP_Improved #(
+    parameter QUANT_MODE = 0,   // 0: 22비트 (기존), 1: INT16, 2: INT8 (FC DSP 패킹)
+    parameter MAX_IMG_WIDTH = 32,    // 런타임 프레임 크기의 합성 시 최대값 (라인 버퍼 / flatten 뱅크)
+    parameter MAX_IMG_HEIGHT = 32,
+    parameter CORE_RETIME = 0,       // 1: conv MAC 입력 / FC 레인 선택 / MAC 곱 파이프라인 추가 (cnn_core_cdc 고속 코어 클럭)
+    parameter FC_ZERO_SKIP = 0,      // 1: FC가 0이 아닌 입력만 계산 (가중치 RAM 레인 수배, Fully_Connected_Layer 참고)
+    parameter FC_WEIGHT_FILE = "",   // 학습된 FC 전체 뉴런 가중치 ($readmemh), 없으면 클래스 뉴런은 런타임 로드
+    parameter CLASS_FALLBACK_SHIFT = 11  // 클래스 가중치 미로드 시 임계값 분류의 조향 스케일 (CNN_OUTPUT_SCALE 2048)
+)(
     input logic clk,
     input logic rst,  
     input logic start_signal,
@@ -7,196 +15,644 @@ module CNN_TOP_Improved(
     input logic [7:0] pixel_in,
     output logic final_result_valid,
     output logic signed [47:0] final_lane_result,
-    output logic cnn_busy
+    output logic [1:0] final_class_idx,            // FC argmax 패턴 클래스
+    output logic signed [47:0] final_class_score,  // 최대 클래스 점수
+    output logic [47:0] final_class_margin,        // 1등 - 2등 점수 차 (신뢰도)
+    output logic [7:0] final_frame_tag,            // 결과가 속한 프레임 번호
+    output logic frame_ready,                      // 새 프레임 시작 가능 (쓰기 뱅크 비어 있음)
+    output logic cnn_busy,
+    // ===== 성능 카운터용 단계 상태 (bit0 conv, bit1 pool, bit2 flatten, bit3 FC) =====
+    output logic [3:0] perf_stage_busy,            // 단계가 입력을 처리한 사이클
+    output logic [3:0] perf_stage_stall,           // 프레임 진행 중이지만 진행하지 못한 사이클
+    output logic [31:0] final_latency,             // 마지막 결과의 프레임 시작→결과 사이클 수
+    output logic [31:0] final_fc_cycles,           // 마지막 결과의 FC 패스 사이클 수 (zero skip 효과)
+    output logic [15:0] final_fc_nonzero,          // 마지막 결과에서 FC가 MAC에 발행한 입력 수 (FC_ZERO_SKIP = 0이면 전체)
+    // ===== 마지막 결과의 단계 시각 (프레임 시작 기준 사이클, 결과 시각 = final_latency) =====
+    output logic [31:0] final_t_feature,           // conv/pool 마지막 출력
+    output logic [31:0] final_t_flatten,           // flatten 뱅크 완료 (재양자화 지연 포함)
+    output logic [31:0] final_t_fc_start,          // FC가 뱅크를 가져감 (이전 프레임 FC 대기 포함)
+    output logic final_seq_path,                   // 마지막 결과가 시퀀서 프레임 (1이면 FC 통계 / 단계 시각 = 0)
+    output logic timeout_error,                    // 워치독 타임아웃 (단계별 OR)
+    // ===== 가중치 로드 (쓰기는 항상 섀도 뱅크로) =====
+    input logic i_wt_wr_en,
+    input logic [16:0] i_wt_wr_addr,               // [11:0] 인덱스, [15:12] 뉴런, [16] 1 = conv 커널
+    input logic [31:0] i_wt_wr_data,
+    input logic i_wt_swap_req,                     // 다음 프레임 경계에서 뱅크 교체
+    output logic o_wt_active_bank,                 // 새 프레임이 사용할 뱅크
+    output logic o_wt_swap_busy,                   // 교체 대기 중이거나 이전 뱅크를 쓰는 프레임이 남아 있음
+    // ===== Feature → FC 재양자화 설정 ([15:0] scale, [21:16] shift, [31:24] zero point) =====
+    input logic [31:0] i_quant_cfg,                // QUANT_MODE = 0이면 무시
+    // ===== 프레임 크기 ([7:0] 폭, [15:8] 높이, [17:16] log2(stride), [18] 1 = same 패딩) =====
+    input logic [31:0] i_geometry,                 // 프레임 시작 시 래치, 폭/높이는 4 ~ 최대값으로 제한
+    // ===== 레이어 시퀀서 ([0] 1 = 프레임을 디스크립터 네트워크로 실행, [11:8] 레이어 수) =====
+    // 시퀀서 프레임은 위의 conv / pool / FC 엔진을 레이어마다 빌려 씀 (고정 파이프라인과 번갈아 실행)
+    input logic [31:0] i_seq_ctrl,
+    input logic i_seq_wr_en,                       // 디스크립터 / conv 커널 쓰기 (시퀀서 idle일 때만)
+    input logic [16:0] i_seq_wr_addr,              // [16] 1 = 커널 메모리 ([15:0] 워드), 0 = 디스크립터 ([4:0] 레이어 * 4 + 워드)
+    input logic [31:0] i_seq_wr_data,
+    output logic o_seq_busy,
+    output logic o_seq_error,                      // 디스크립터 오류 / 시퀀서 FC 타임아웃
+    output logic [3:0] o_seq_layer
 );
 
+    localparam ACT_WIDTH = (QUANT_MODE == 2) ? 8 : (QUANT_MODE == 1) ? 16 : 22;
+    // same 패딩 + stride 1일 때 pooling 출력이 가장 큼
+    localparam MAX_FC_INPUTS = (MAX_IMG_WIDTH / 2) * (MAX_IMG_HEIGHT / 2);
+    localparam GEO_DEFAULT = {13'd0, 1'b0, 2'd0, 8'(MAX_IMG_HEIGHT), 8'(MAX_IMG_WIDTH)};
+    localparam SEQ_WMEM_WORDS = 2048;
+
     // ===== 내부 신호들 =====
     logic signed [21:0] feature_result;
     logic feature_valid;
     logic feature_done;
+    logic pool_input_valid;
+    
+    // 재양자화 후 flatten으로 들어가는 값 (QUANT_MODE = 0이면 feature 출력 그대로)
+    logic signed [ACT_WIDTH-1:0] flatten_in_data;
+    logic flatten_in_valid;
+    logic flatten_in_done;
+    logic [31:0] frame_quant_cfg;   // 프레임 시작 시 래치 (프레임 중 변경 방지)
+    logic [31:0] frame_geometry;    // 프레임 시작 시 래치 (범위 제한 후)
+    logic [31:0] geometry_clamped;
     
     logic flattened_buffer_full;
-    logic signed [21:0] flatten_data [0:224];
+    logic signed [ACT_WIDTH-1:0] flatten_data [0:MAX_FC_INPUTS-1];
+    logic [$clog2(MAX_FC_INPUTS+1)-1:0] flatten_length;   // 읽기 뱅크 프레임의 FC 입력 수
+    logic [$clog2(MAX_FC_INPUTS)-1:0] flatten_nz_index [0:MAX_FC_INPUTS-1];
+    logic [$clog2(MAX_FC_INPUTS+1)-1:0] flatten_nz_count; // 읽기 뱅크의 0이 아닌 입력 수
+    logic [31:0] fc_cycles;
+    logic [$clog2(MAX_FC_INPUTS+1)-1:0] fc_active_inputs;
     
     logic fc_start_pulse;
     logic fc_result_valid;
     logic signed [47:0] fc_result_data;
+    logic signed [47:0] fc_neuron_data [0:4];
+    logic [1:0] fc_class_idx;
+    logic signed [47:0] fc_class_score;
+    logic [47:0] fc_class_margin;
     
-    // ===== 개선된 상태 머신 (실제 완료 신호 기반) =====
-    enum logic [2:0] {
-        ST_IDLE          = 3'b000,
-        ST_FEATURE_CONV  = 3'b001,
-        ST_FLATTEN_WAIT  = 3'b010,
-        ST_FC_COMPUTE    = 3'b011,
-        ST_RESULT_READY  = 3'b100,
-        ST_DONE          = 3'b101
-    } current_state, next_state;
+    // ===== 파이프라인 상태 머신 (프레임 N+1 수신과 프레임 N FC 계산을 겹침) =====
+    // Feature 측: 카메라 픽셀 → conv/ReLU/pool → flatten 쓰기 뱅크
+    enum logic [1:0] {
+        FE_IDLE          = 2'b00,
+        FE_CONV          = 2'b01
+    } fe_state, fe_next_state;
     
-    // 타이머는 비상용으로만 사용 (워치독)
-    logic [19:0] watchdog_timer;  // 더 긴 타이머
-    logic timeout_error;
+    // FC 측: flatten 읽기 뱅크 → FC → 결과
+    enum logic [1:0] {
+        FC_IDLE          = 2'b00,
+        FC_COMPUTE       = 2'b01,
+        FC_DONE          = 2'b10
+    } fc_state, fc_next_state;
+    
+    // 타이머는 비상용으로만 사용 (워치독, 단계별)
+    logic [19:0] fe_watchdog_timer;  // 더 긴 타이머
+    logic [19:0] fc_watchdog_timer;
+    logic fe_timeout, fc_timeout;
     
     logic signed [47:0] final_result_reg;
     logic final_result_valid_reg;
+    logic [1:0] final_class_idx_reg;
+    logic signed [47:0] final_class_score_reg;
+    logic [47:0] final_class_margin_reg;
+    logic [7:0] final_frame_tag_reg;
     logic feature_start;
+    
+    // ===== 프레임 태그 (뱅크별로 저장되어 결과와 함께 출력) =====
+    logic start_pending;
+    logic [7:0] frame_tag_cnt;
+    logic [7:0] bank_tag [0:1];
+    logic [7:0] fc_frame_tag;
+    logic flatten_bank_free;
+    logic flatten_wr_bank, flatten_rd_bank;
+    logic flatten_release;
+    
+    // ===== 지연 측정 (프레임 시작 시각을 태그처럼 뱅크별로 저장) =====
+    logic [31:0] cycle_cnt;
+    logic [31:0] bank_ts [0:1];
+    logic [31:0] fc_frame_ts;
+    logic [31:0] final_latency_reg;
+    logic [31:0] final_fc_cycles_reg;
+    logic [15:0] final_fc_nonzero_reg;
+    logic [31:0] bank_t_feature [0:1];
+    logic [31:0] bank_t_flatten [0:1];
+    logic [31:0] fc_t_feature, fc_t_flatten, fc_t_start;
+    logic [31:0] final_t_feature_reg, final_t_flatten_reg, final_t_fc_start_reg;
+    logic final_seq_path_reg;
+    
+    // ===== 가중치 뱅크 (태그처럼 flatten 뱅크별로 기록 → conv와 FC가 같은 가중치 세트 사용) =====
+    logic wt_active;          // 새 프레임의 conv가 사용할 뱅크
+    logic wt_swap_pending;
+    logic bank_wsel [0:1];    // flatten 뱅크별 프레임의 가중치 뱅크
+    logic fc_wt_bank;         // FC가 계산 중인 프레임의 가중치 뱅크
+    logic [1:0] wt_class_loaded;  // 뱅크별 클래스 뉴런 (1~4) 가중치가 써졌는지 (0이면 임계값 분류로 대체)
+    logic pipeline_idle;
+    
+    // ===== 레이어 시퀀서 (seq_busy 동안 엔진 입력은 시퀀서 쪽) =====
+    logic seq_start, seq_busy, seq_frame_ready, seq_can_start;
+    logic seq_result_valid;
+    logic signed [47:0] seq_lane_result;
+    logic [1:0] seq_class_idx;
+    logic signed [47:0] seq_class_score;
+    logic [47:0] seq_class_margin;
+    logic [31:0] seq_latency;
+    logic [7:0] seq_frame_tag;
+    logic [$clog2(MAX_IMG_WIDTH):0] seq_img_width;
+    logic [$clog2(MAX_IMG_HEIGHT):0] seq_img_height;
+    logic signed [7:0] seq_kernel [0:8];
+    logic seq_conv_start, seq_conv_valid;
+    logic [7:0] seq_conv_pixel;
+    logic signed [21:0] conv_result_raw;
+    logic conv_valid_raw;
+    logic seq_pool_start, seq_pool_valid;
+    logic signed [21:0] seq_pool_pixel;
+    logic seq_fc_valid, seq_fc_done;
+    logic signed [ACT_WIDTH-1:0] seq_fc_data;
+    logic signed [ACT_WIDTH-1:0] fe_flatten_data;
+    logic fe_flatten_valid, fe_flatten_done;
 
+    // ===== 프레임 크기 범위 제한 (conv 출력이 최소 2x2 → pooling 출력 1개 이상) =====
+    function automatic logic [7:0] clamp_dim(input logic [7:0] v, input int max_v);
+        if (v < 8'd4)              return 8'd4;
+        else if (v > 8'(max_v))    return 8'(max_v);
+        else                       return v;
+    endfunction
+    
+    always_comb begin
+        geometry_clamped = {13'd0, i_geometry[18:16],
+                            clamp_dim(i_geometry[15:8], MAX_IMG_HEIGHT),
+                            clamp_dim(i_geometry[7:0], MAX_IMG_WIDTH)};
+        // stride 8 (log2 = 3)은 지원하지 않음 → 4로 제한
+        if (i_geometry[17:16] == 2'd3) geometry_clamped[17:16] = 2'd2;
+    end
+    
     // ===== Feature Extractor (수정된 버전 사용) =====
-    Feature_Extractor_Fixed u_feature_extractor(
+    Feature_Extractor_Fixed #(
+        .IMG_WIDTH(MAX_IMG_WIDTH),
+        .IMG_HEIGHT(MAX_IMG_HEIGHT),
+        .RETIME(CORE_RETIME)
+    ) u_feature_extractor(
         .clk(clk), 
         .rst(rst),
-        .start_signal(feature_start),
-        .pixel_valid_in(pixel_valid),
-        .pixel_in(pixel_in), 
+        .start_signal(seq_busy ? seq_conv_start : feature_start),
+        .pixel_valid_in(seq_busy ? seq_conv_valid : pixel_valid),
+        .pixel_in(seq_busy ? seq_conv_pixel : pixel_in), 
         .final_result_out(feature_result),
         .final_result_valid(feature_valid), 
-        .final_done_signal(feature_done)
+        .final_done_signal(feature_done),
+        .pool_input_valid(pool_input_valid),
+        .i_kernel_bank(wt_active),
+        .i_kernel_wr_en(i_wt_wr_en && i_wt_wr_addr[16]),
+        .i_kernel_wr_bank(~wt_active),
+        .i_kernel_wr_idx(i_wt_wr_addr[3:0]),
+        .i_kernel_wr_data(i_wt_wr_data[7:0]),
+        .i_img_width(seq_busy ? seq_img_width : frame_geometry[$clog2(MAX_IMG_WIDTH):0]),
+        .i_img_height(seq_busy ? seq_img_height : frame_geometry[8 +: $clog2(MAX_IMG_HEIGHT)+1]),
+        .i_stride_log2(seq_busy ? 2'd0 : frame_geometry[17:16]),
+        .i_pad_same(seq_busy ? 1'b0 : frame_geometry[18]),
+        .i_seq_mode(seq_busy),
+        .i_kernel_ovr_data(seq_kernel),
+        .i_pool_start(seq_pool_start),
+        .i_pool_valid(seq_pool_valid),
+        .i_pool_pixel(seq_pool_pixel),
+        .o_conv_result(conv_result_raw),
+        .o_conv_valid(conv_valid_raw)
     );
     
+    // ===== 레이어 시퀀서: 디스크립터 표 + 레이어 사이 특징 맵 + 제어 FSM (엔진은 위의 것을 공유) =====
+    cnn_layer_sequencer #(
+        .MAX_LAYERS(8),
+        .MAX_WIDTH(MAX_IMG_WIDTH),
+        .MAX_HEIGHT(MAX_IMG_HEIGHT),
+        .MAP_WORDS(4096),
+        .WMEM_WORDS(SEQ_WMEM_WORDS),
+        .FC_INPUTS(MAX_FC_INPUTS),
+        .FC_NEURONS(5),
+        .FC_WIDTH(ACT_WIDTH)
+    ) u_layer_seq (
+        .clk(clk),
+        .rst(rst),
+        .i_num_layers(i_seq_ctrl[11:8]),
+        .i_desc_wr_en(i_seq_wr_en && !i_seq_wr_addr[16]),
+        .i_desc_wr_addr(i_seq_wr_addr[4:0]),
+        .i_desc_wr_data(i_seq_wr_data),
+        .i_wmem_wr_en(i_seq_wr_en && i_seq_wr_addr[16] && (i_seq_wr_addr[15:0] < SEQ_WMEM_WORDS)),
+        .i_wmem_wr_addr(i_seq_wr_addr[$clog2(SEQ_WMEM_WORDS)-1:0]),
+        .i_wmem_wr_data(i_seq_wr_data[21:0]),
+        .i_frame_start(seq_start),
+        .i_pixel_valid(pixel_valid),
+        .i_pixel_in(pixel_in),
+        .o_frame_ready(seq_frame_ready),
+        .o_result_valid(seq_result_valid),
+        .o_lane_result(seq_lane_result),
+        .o_class_idx(seq_class_idx),
+        .o_class_score(seq_class_score),
+        .o_class_margin(seq_class_margin),
+        .o_latency(seq_latency),
+        .o_busy(seq_busy),
+        .o_error(o_seq_error),
+        .o_layer(o_seq_layer),
+        .o_img_width(seq_img_width),
+        .o_img_height(seq_img_height),
+        .o_kernel(seq_kernel),
+        .o_conv_start(seq_conv_start),
+        .o_conv_valid(seq_conv_valid),
+        .o_conv_pixel(seq_conv_pixel),
+        .i_conv_result(conv_result_raw),
+        .i_conv_valid(conv_valid_raw),
+        .o_pool_start(seq_pool_start),
+        .o_pool_valid(seq_pool_valid),
+        .o_pool_pixel(seq_pool_pixel),
+        .i_pool_result(feature_result),
+        .i_pool_valid(feature_valid),
+        .o_fc_wr_valid(seq_fc_valid),
+        .o_fc_wr_data(seq_fc_data),
+        .o_fc_wr_done(seq_fc_done),
+        .i_fc_result_valid(fc_result_valid && fc_state == FC_COMPUTE),
+        .i_fc_timeout(fc_timeout),
+        .i_fc_neuron(fc_neuron_data)
+    );
+    
+    // 시퀀서 프레임은 FE와 FC가 모두 비어 있을 때만 시작 (엔진 공유)
+    assign seq_can_start = seq_frame_ready && (fe_state == FE_IDLE) && (fc_state == FC_IDLE) && !flattened_buffer_full;
+    assign seq_start = (start_signal || start_pending) && i_seq_ctrl[0] && seq_can_start;
+    
+    // ===== 레이어 경계 재양자화 (반올림 + 포화) =====
+    generate
+        if (QUANT_MODE == 0) begin : gen_no_quant
+            assign fe_flatten_data = feature_result;
+            assign fe_flatten_valid = feature_valid;
+            assign fe_flatten_done = feature_done;
+        end else begin : gen_quant
+            logic [1:0] done_pipe;   // requantizer 지연(2)만큼 done 지연 → 뱅크 전환 후 FE 종료
+            
+            requantizer #(
+                .IN_WIDTH(22),
+                .OUT_WIDTH(ACT_WIDTH)
+            ) u_requantizer (
+                .clk(clk),
+                .rst(rst),
+                .i_scale(frame_quant_cfg[15:0]),
+                .i_shift(frame_quant_cfg[21:16]),
+                .i_zero_point(frame_quant_cfg[31:24]),
+                .i_valid(feature_valid && !seq_busy),
+                .i_data(feature_result),
+                .o_valid(fe_flatten_valid),
+                .o_data(fe_flatten_data)
+            );
+            
+            always_ff @(posedge clk or negedge rst) begin
+                if (!rst) done_pipe <= 2'b00;
+                else      done_pipe <= {done_pipe[0], feature_done && !seq_busy};
+            end
+            assign fe_flatten_done = done_pipe[1];
+        end
+    endgenerate
+    
+    // 시퀀서 FC 레이어: 입력 벡터를 재양자화 없이 (시퀀서 입력 시프트로 이미 ACT_WIDTH) 쓰기 뱅크로
+    assign flatten_in_data  = seq_busy ? seq_fc_data : fe_flatten_data;
+    assign flatten_in_valid = seq_busy ? seq_fc_valid : fe_flatten_valid;
+    assign flatten_in_done  = seq_busy ? seq_fc_done : fe_flatten_done;
+    
     // ===== Flatten Buffer =====
-    flatten_buffer u_flatten_buffer(
+    flatten_buffer #(
+        .DATA_WIDTH(ACT_WIDTH),
+        .BUFFER_SIZE(MAX_FC_INPUTS)
+    ) u_flatten_buffer(
         .clk(clk), 
         .rst(rst),
-        .i_data_valid(feature_valid),
-        .i_data_in(feature_result), 
+        .i_data_valid(flatten_in_valid),
+        .i_data_in(flatten_in_data), 
+        .i_frame_done(flatten_in_done),
+        .i_bank_release(flatten_release),
         .o_buffer_full(flattened_buffer_full),
-        .o_flattened_data(flatten_data)
+        .o_bank_free(flatten_bank_free),
+        .o_wr_bank(flatten_wr_bank),
+        .o_rd_bank(flatten_rd_bank),
+        .o_length(flatten_length),
+        .o_flattened_data(flatten_data),
+        .o_nz_index(flatten_nz_index),
+        .o_nz_count(flatten_nz_count)
     );
     
-    // ===== Fully Connected Layer (수정된 버전 사용) =====
-    Fully_Connected_Layer_Fixed u_fully_connected_layer(
+    // ===== Fully Connected Layer (8레인 병렬 MAC + argmax 헤드, FC_ZERO_SKIP이면 0인 입력은 건너뜀) =====
+    Fully_Connected_Layer_Fixed #(
+        .NUM_INPUTS(MAX_FC_INPUTS),
+        .NUM_LANES(8),
+        .NUM_CLASSES(4),
+        .DATA_WIDTH(ACT_WIDTH),
+        .WEIGHT_FILE(FC_WEIGHT_FILE),
+        .ZERO_SKIP(FC_ZERO_SKIP),
+        .RETIME(CORE_RETIME)
+    ) u_fully_connected_layer(
         .clk(clk), 
         .rst(rst),
         .i_start(fc_start_pulse),
         .i_flattened_data(flatten_data), 
+        .i_num_inputs(flatten_length),
+        .i_nz_index(flatten_nz_index),
+        .i_nz_count(flatten_nz_count),
         .o_result_valid(fc_result_valid), 
-        .o_result_data(fc_result_data)
+        .o_result_data(fc_result_data),
+        .o_neuron_data(fc_neuron_data),
+        .o_class_idx(fc_class_idx),
+        .o_class_score(fc_class_score),
+        .o_class_margin(fc_class_margin),
+        .o_cycles(fc_cycles),
+        .o_active_inputs(fc_active_inputs),
+        .i_weight_bank(fc_wt_bank),
+        .i_wt_wr_en(i_wt_wr_en && !i_wt_wr_addr[16]),
+        .i_wt_wr_bank(~wt_active),
+        .i_wt_wr_neuron(i_wt_wr_addr[15:12]),
+        .i_wt_wr_index(i_wt_wr_addr[11:0]),
+        .i_wt_wr_data(i_wt_wr_data[ACT_WIDTH-1:0])
     );
     
-    // ===== 개선된 상태 전환 로직 (실제 신호 기반) =====
+    // ===== Feature 측 상태 전환 =====
+    // 쓰기 뱅크가 비어 있으면 FC가 이전 프레임을 계산하는 중에도 다음 프레임을 받음
     always_comb begin
-        next_state = current_state;
-        case(current_state)
-            ST_IDLE: begin
-                if(start_signal) begin
-                    next_state = ST_FEATURE_CONV;
+        fe_next_state = fe_state;
+        case(fe_state)
+            FE_IDLE: begin
+                if((start_signal || start_pending) && flatten_bank_free && !i_seq_ctrl[0] && !seq_busy) begin
+                    fe_next_state = FE_CONV;
                 end
             end
             
-            ST_FEATURE_CONV: begin
-                // 실제 feature extraction 완료 신호 기반
-                if(feature_done) begin
-                    next_state = ST_FLATTEN_WAIT;
-                end else if(timeout_error) begin
-                    // 비상시에만 타임아웃 사용
-                    next_state = ST_DONE;  // 에러로 종료
+            FE_CONV: begin
+                // 마지막 pooling 결과와 같은 사이클에 flatten 뱅크가 채워짐
+                if(flatten_in_done) begin
+                    fe_next_state = FE_IDLE;
+                end else if(fe_timeout) begin
+                    fe_next_state = FE_IDLE;  // 에러로 종료
                 end
             end
             
-            ST_FLATTEN_WAIT: begin
-                // 실제 flatten buffer 완료 신호 기반
+            default: fe_next_state = FE_IDLE;
+        endcase
+    end
+    
+    // ===== FC 측 상태 전환 =====
+    always_comb begin
+        fc_next_state = fc_state;
+        case(fc_state)
+            FC_IDLE: begin
+                // 실제 flatten 읽기 뱅크 완료 신호 기반
                 if(flattened_buffer_full) begin
-                    next_state = ST_FC_COMPUTE;
-                end else if(timeout_error) begin
-                    next_state = ST_DONE;
+                    fc_next_state = FC_COMPUTE;
                 end
             end
             
-            ST_FC_COMPUTE: begin
-                // 실제 FC layer 완료 신호 기반
+            FC_COMPUTE: begin
                 if(fc_result_valid) begin
-                    next_state = ST_RESULT_READY;
-                end else if(timeout_error) begin
-                    next_state = ST_DONE;
+                    fc_next_state = FC_DONE;
+                end else if(fc_timeout) begin
+                    fc_next_state = FC_DONE;
                 end
             end
             
-            ST_RESULT_READY: begin
-                next_state = ST_DONE;
+            FC_DONE: begin
+                fc_next_state = FC_IDLE;
             end
             
-            ST_DONE: begin
-                next_state = ST_IDLE;
-            end
+            default: fc_next_state = FC_IDLE;
         endcase
     end
     
     // ===== 상태 레지스터 및 제어 로직 =====
     always_ff @(posedge clk or negedge rst) begin
         if (!rst) begin
-            current_state <= ST_IDLE;
-            watchdog_timer <= 20'h0;
-            timeout_error <= 1'b0;
+            fe_state <= FE_IDLE;
+            fc_state <= FC_IDLE;
+            fe_watchdog_timer <= 20'h0;
+            fc_watchdog_timer <= 20'h0;
+            fe_timeout <= 1'b0;
+            fc_timeout <= 1'b0;
+            start_pending <= 1'b0;
+            frame_tag_cnt <= 8'h0;
+            bank_tag <= '{default: '0};
+            fc_frame_tag <= 8'h0;
             final_result_reg <= 48'h0;
             final_result_valid_reg <= 1'b0;
+            final_class_idx_reg <= 2'b0;
+            final_class_score_reg <= 48'h0;
+            final_class_margin_reg <= 48'h0;
+            final_frame_tag_reg <= 8'h0;
+            cycle_cnt <= 32'h0;
+            bank_ts <= '{default: '0};
+            fc_frame_ts <= 32'h0;
+            final_latency_reg <= 32'h0;
+            final_fc_cycles_reg <= 32'h0;
+            final_fc_nonzero_reg <= 16'h0;
+            bank_t_feature <= '{default: '0};
+            bank_t_flatten <= '{default: '0};
+            fc_t_feature <= 32'h0;
+            fc_t_flatten <= 32'h0;
+            fc_t_start <= 32'h0;
+            final_t_feature_reg <= 32'h0;
+            final_t_flatten_reg <= 32'h0;
+            final_t_fc_start_reg <= 32'h0;
+            final_seq_path_reg <= 1'b0;
+            wt_active <= 1'b0;
+            wt_swap_pending <= 1'b0;
+            bank_wsel <= '{default: '0};
+            fc_wt_bank <= 1'b0;
+            wt_class_loaded <= (FC_WEIGHT_FILE != "") ? 2'b11 : 2'b00;
+            frame_quant_cfg <= 32'h0000_0001;
+            frame_geometry <= GEO_DEFAULT;
+            seq_frame_tag <= 8'h0;
         end else begin
-            current_state <= next_state;
-            
-            // 워치독 타이머 (비상용)
-            if (current_state != next_state) begin
-                watchdog_timer <= 20'h0;
-                timeout_error <= 1'b0;
-                
-                // 상태 전환 로그
-                case(next_state)
-                    ST_FEATURE_CONV: $display("CNN: Feature Extraction 시작");
-                    ST_FLATTEN_WAIT: $display("CNN: Flatten 대기");
-                    ST_FC_COMPUTE: $display("CNN: FC Layer 시작");
-                    ST_RESULT_READY: $display("CNN: 결과 준비됨");
-                    ST_DONE: $display("CNN: 완료");
-                endcase
+            cycle_cnt <= cycle_cnt + 1;
+            fe_state <= fe_next_state;
+            fc_state <= fc_next_state;
+            final_result_valid_reg <= 1'b0;
+            
+            // 뱅크가 꽉 차 있는 동안 (시퀀서 경로: 엔진이 비지 않은 동안) 들어온 시작 요청은 보류
+            if ((fe_state == FE_IDLE && fe_next_state == FE_CONV) || seq_start) begin
+                start_pending <= 1'b0;
+            end else if (start_signal) begin
+                start_pending <= 1'b1;
+            end
+            
+            // 워치독 타이머 (비상용, 단계별)
+            if (fe_state != fe_next_state || fe_state == FE_IDLE) begin
+                fe_watchdog_timer <= 20'h0;
+                fe_timeout <= 1'b0;
             end else begin
-                watchdog_timer <= watchdog_timer + 1;
+                fe_watchdog_timer <= fe_watchdog_timer + 1;
                 // 더 긴 타임아웃 (200,000 사이클 ≈ 2ms @100MHz)
-                if (watchdog_timer > 200000) begin
-                    timeout_error <= 1'b1;
-                    $display("CNN: 워치독 타임아웃! 상태: %s", current_state.name);
+                if (fe_watchdog_timer > 200000) begin
+                    fe_timeout <= 1'b1;
+                    $display("CNN: Feature 워치독 타임아웃! 상태: %s", fe_state.name);
                 end
             end
             
-            // 결과 래치 (실제 완료 신호 기반)
-            if (current_state == ST_IDLE && next_state == ST_FEATURE_CONV) begin
-                final_result_valid_reg <= 1'b0;
+            if (fc_state != fc_next_state || fc_state == FC_IDLE) begin
+                fc_watchdog_timer <= 20'h0;
+                fc_timeout <= 1'b0;
+            end else begin
+                fc_watchdog_timer <= fc_watchdog_timer + 1;
+                if (fc_watchdog_timer > 200000) begin
+                    fc_timeout <= 1'b1;
+                    $display("CNN: FC 워치독 타임아웃! 상태: %s", fc_state.name);
+                end
+            end
+            
+            // 프레임 시작: 태그 부여 (채울 뱅크에 기록)
+            if (fe_state == FE_IDLE && fe_next_state == FE_CONV) begin
+                bank_tag[flatten_wr_bank] <= frame_tag_cnt;
+                bank_ts[flatten_wr_bank] <= cycle_cnt;
+                bank_wsel[flatten_wr_bank] <= wt_active ^ wt_swap_pending;
+                frame_quant_cfg <= i_quant_cfg;
+                frame_geometry <= geometry_clamped;
+                frame_tag_cnt <= frame_tag_cnt + 1;
+                $display("CNN: Feature Extraction 시작 (frame tag %0d, bank %0d)", frame_tag_cnt, flatten_wr_bank);
+            end
+            
+            // 시퀀서 프레임 시작: 태그 부여, FC 레이어는 이 프레임의 가중치 뱅크로 계산 (두 flatten 뱅크 모두)
+            if (seq_start) begin
+                seq_frame_tag <= frame_tag_cnt;
+                bank_wsel <= '{default: wt_active ^ wt_swap_pending};
+                frame_tag_cnt <= frame_tag_cnt + 1;
+                $display("CNN: 레이어 시퀀서 시작 (frame tag %0d, %0d layers)", frame_tag_cnt, i_seq_ctrl[11:8]);
+            end
+            
+            // 단계 시각: 채우는 뱅크에 기록 (flatten 뱅크는 done 다음 사이클에 전환)
+            if (fe_state == FE_CONV && feature_done) begin
+                bank_t_feature[flatten_wr_bank] <= cycle_cnt - bank_ts[flatten_wr_bank];
+            end
+            if (fe_state == FE_CONV && flatten_in_done) begin
+                bank_t_flatten[flatten_wr_bank] <= cycle_cnt - bank_ts[flatten_wr_bank];
+            end
+            
+            if (fc_state == FC_IDLE && fc_next_state == FC_COMPUTE) begin
+                fc_frame_tag <= bank_tag[flatten_rd_bank];
+                fc_frame_ts <= bank_ts[flatten_rd_bank];
+                fc_wt_bank <= bank_wsel[flatten_rd_bank];
+                fc_t_feature <= bank_t_feature[flatten_rd_bank];
+                fc_t_flatten <= bank_t_flatten[flatten_rd_bank];
+                fc_t_start <= cycle_cnt - bank_ts[flatten_rd_bank];
+                $display("CNN: FC Layer 시작 (frame tag %0d, bank %0d)", bank_tag[flatten_rd_bank], flatten_rd_bank);
+            end
+            
+            // 가중치 뱅크 교체: 새 프레임 시작 시점 (파이프라인이 비어 있으면 즉시)
+            // 진행 중인 프레임은 시작할 때 기록한 뱅크로 끝까지 계산 → 추론 정지 없음
+            if (wt_swap_pending && (feature_start || seq_start || pipeline_idle)) begin
+                wt_active <= ~wt_active;
+                wt_swap_pending <= 1'b0;
+                $display("CNN: 가중치 뱅크 교체 → bank %0d", ~wt_active);
+            end
+            if (i_wt_swap_req) begin
+                wt_swap_pending <= 1'b1;
+            end
+            if (i_wt_wr_en && !i_wt_wr_addr[16] && i_wt_wr_addr[15:12] >= 4'd1 && i_wt_wr_addr[15:12] <= 4'd4) begin
+                wt_class_loaded[~wt_active] <= 1'b1;
             end
             
-            if (fc_result_valid && current_state == ST_FC_COMPUTE) begin
+            // 결과 래치 (실제 완료 신호 기반) - 1사이클 유효 펄스, 결과/태그는 유지
+            if (fc_result_valid && fc_state == FC_COMPUTE && !seq_busy) begin
                 final_result_reg <= fc_result_data;
                 final_result_valid_reg <= 1'b1;
-                $display("CNN: 최종 결과 = 0x%012X", fc_result_data);
+                if (wt_class_loaded[fc_wt_bank]) begin
+                    final_class_idx_reg <= fc_class_idx;
+                    final_class_score_reg <= fc_class_score;
+                    final_class_margin_reg <= fc_class_margin;
+                end else begin
+                    final_class_idx_reg <= lane_class(fc_result_data);
+                    final_class_score_reg <= 48'h0;
+                    final_class_margin_reg <= 48'h0;
+                end
+                final_frame_tag_reg <= fc_frame_tag;
+                final_latency_reg <= cycle_cnt - fc_frame_ts;
+                final_fc_cycles_reg <= fc_cycles;
+                final_fc_nonzero_reg <= 16'(fc_active_inputs);
+                final_t_feature_reg <= fc_t_feature;
+                final_t_flatten_reg <= fc_t_flatten;
+                final_t_fc_start_reg <= fc_t_start;
+                final_seq_path_reg <= 1'b0;
+                $display("CNN: 최종 결과 = 0x%012X, 클래스 = %0d, frame tag %0d", fc_result_data, fc_class_idx, fc_frame_tag);
             end
             
-            if (current_state == ST_DONE && next_state == ST_IDLE) begin
-                final_result_valid_reg <= 1'b0;
+            // 시퀀서 결과: 지연은 시퀀서가 센 프레임 사이클, FC 통계 / 단계 시각은 없음
+            if (seq_result_valid) begin
+                final_result_reg <= seq_lane_result;
+                final_result_valid_reg <= 1'b1;
+                final_class_idx_reg <= seq_class_idx;
+                final_class_score_reg <= seq_class_score;
+                final_class_margin_reg <= seq_class_margin;
+                final_frame_tag_reg <= seq_frame_tag;
+                final_latency_reg <= seq_latency;
+                final_fc_cycles_reg <= 32'h0;
+                final_fc_nonzero_reg <= 16'h0;
+                final_t_feature_reg <= 32'h0;
+                final_t_flatten_reg <= 32'h0;
+                final_t_fc_start_reg <= 32'h0;
+                final_seq_path_reg <= 1'b1;
+                $display("CNN: 시퀀서 결과 = 0x%012X, 클래스 = %0d, frame tag %0d", seq_lane_result, seq_class_idx, seq_frame_tag);
             end
         end
     end
     
-    // ===== FC 시작 펄스 생성 (개선) =====
-    logic fc_start_d1;
-    always_ff @(posedge clk or negedge rst) begin
-        if (!rst) begin
-            fc_start_d1 <= 1'b0;
-        end else begin
-            fc_start_d1 <= (current_state == ST_FLATTEN_WAIT) && flattened_buffer_full;
-        end
-    end
+    // ===== 클래스 폴백: 학습된 클래스 가중치가 없을 때 차선 회귀 값으로 분류 =====
+    // 조향각 = 결과 / 2^SHIFT (0 방향 절삭) 기준: |각| < 8 직진, > 25 좌, < -25 우, 그 외 시작/끝
+    // (이전 펌웨어 cnn_classify_pattern과 같은 경계, 점수 / margin은 0)
+    localparam signed [47:0] CLS_STRAIGHT = 48'sd8 <<< CLASS_FALLBACK_SHIFT;
+    localparam signed [47:0] CLS_CURVE    = 48'sd26 <<< CLASS_FALLBACK_SHIFT;
+
+    function automatic [1:0] lane_class(input logic signed [47:0] r);
+        if (r > -CLS_STRAIGHT && r < CLS_STRAIGHT) lane_class = 2'd0;   // STRAIGHT
+        else if (r >= CLS_CURVE)                   lane_class = 2'd1;   // LEFT_CURVE
+        else if (r <= -CLS_CURVE)                  lane_class = 2'd2;   // RIGHT_CURVE
+        else                                       lane_class = 2'd3;   // START_END
+    endfunction
+
+    // ===== FC 시작 펄스 / 뱅크 반환 =====
+    assign fc_start_pulse = (fc_state == FC_IDLE) && flattened_buffer_full;
+    assign flatten_release = (fc_state == FC_DONE);
     
-    assign fc_start_pulse = (current_state == ST_FLATTEN_WAIT) && flattened_buffer_full && !fc_start_d1;
+    // ===== 가중치 뱅크 상태 =====
+    assign pipeline_idle = (fe_state == FE_IDLE) && (fc_state == FC_IDLE) && !flattened_buffer_full &&
+                           !seq_busy && !start_signal && !start_pending;
+    assign o_wt_active_bank = wt_active;
+    assign o_wt_swap_busy = wt_swap_pending ||
+                            ((fc_state != FC_IDLE) && (fc_wt_bank != wt_active)) ||
+                            (flattened_buffer_full && (bank_wsel[flatten_rd_bank] != wt_active));
     
-    // ===== Feature Extractor 시작 신호 생성 (개선) =====
-    logic feature_start_d1;
-    always_ff @(posedge clk or negedge rst) begin
-        if (!rst) begin
-            feature_start_d1 <= 1'b0;
-        end else begin
-            feature_start_d1 <= (current_state == ST_FEATURE_CONV);
-        end
-    end
-    assign feature_start = (current_state == ST_FEATURE_CONV) && !feature_start_d1;
+    // ===== Feature Extractor 시작 신호 생성 =====
+    assign feature_start = (fe_state == FE_IDLE) && (fe_next_state == FE_CONV);
     
     // ===== 출력 신호 =====
-    assign cnn_busy = (current_state != ST_IDLE);
+    assign timeout_error = fe_timeout | fc_timeout;
+    assign cnn_busy = (fe_state != FE_IDLE) || (fc_state != FC_IDLE) || seq_busy;
+    assign frame_ready = i_seq_ctrl[0] ? seq_can_start : ((fe_state == FE_IDLE) && flatten_bank_free && !seq_busy);
+    assign o_seq_busy = seq_busy;
     assign final_result_valid = final_result_valid_reg;
     assign final_lane_result = final_result_reg;
+    assign final_class_idx = final_class_idx_reg;
+    assign final_class_score = final_class_score_reg;
+    assign final_class_margin = final_class_margin_reg;
+    assign final_frame_tag = final_frame_tag_reg;
+    assign final_latency = final_latency_reg;
+    assign final_fc_cycles = final_fc_cycles_reg;
+    assign final_fc_nonzero = final_fc_nonzero_reg;
+    assign final_t_feature = final_t_feature_reg;
+    assign final_t_flatten = final_t_flatten_reg;
+    assign final_t_fc_start = final_t_fc_start_reg;
+    assign final_seq_path = final_seq_path_reg;
+    
+    // ===== 단계별 busy/stall =====
+    // conv/pool: 프레임 중 입력 비트가 들어온 사이클 = busy, 없으면 stall (입력 대기)
+    // flatten: 쓰기 = busy, 두 뱅크가 모두 차서 다음 프레임 시작이 막힌 사이클 = stall
+    // FC: 계산 중 = busy, Feature 측이 프레임을 만드는 동안 FC가 쉬는 사이클 = stall
+    // 시퀀서 프레임: conv/pool 패스의 입력 사이클만 busy로 셈 (레이어 사이 제어 사이클은 제외)
+    assign perf_stage_busy[0]  = ((fe_state == FE_CONV) && pixel_valid) || seq_conv_valid;
+    assign perf_stage_stall[0] = (fe_state == FE_CONV) && !pixel_valid;
+    assign perf_stage_busy[1]  = ((fe_state == FE_CONV) && pool_input_valid) || seq_pool_valid;
+    assign perf_stage_stall[1] = (fe_state == FE_CONV) && !pool_input_valid;
+    assign perf_stage_busy[2]  = flatten_in_valid;
+    assign perf_stage_stall[2] = (start_signal || start_pending) && !flatten_bank_free;
+    assign perf_stage_busy[3]  = (fc_state == FC_COMPUTE);
+    assign perf_stage_stall[3] = (fc_state == FC_IDLE) && (fe_state == FE_CONV);
     
     // ===== 디버그 출력 =====
     always_ff @(posedge clk) begin
@@ -14,13 +14,27 @@ module CONV_RELU_TOP(
 	// 내부 연결 신호
 	logic signed [21:0] conv_result;
 	logic             conv_valid;
+	logic signed [7:0] no_ovr [0:8] = '{default: 8'sd0};
 	
 	// 1. Convolution Engine 인스턴스
 	conv_engine_2d U0_CONV (
 		.clk, .rst, .start_signal, .pixel_valid, .pixel_in,
 		.result_out(conv_result),
 		.result_valid(conv_valid),
-		.done_signal(done_signal) // done 신호는 conv 엔진에서 나옴
+		.done_signal(done_signal), // done 신호는 conv 엔진에서 나옴
+		// 커널 고정 (초기 Sobel 뱅크 사용)
+		.i_kernel_bank(1'b0),
+		.i_kernel_wr_en(1'b0),
+		.i_kernel_wr_bank(1'b0),
+		.i_kernel_wr_idx(4'd0),
+		.i_kernel_wr_data(8'sd0),
+		.i_kernel_ovr(1'b0),
+		.i_kernel_ovr_data(no_ovr),
+		// 32x32 고정
+		.i_img_width(6'd32),
+		.i_img_height(6'd32),
+		.i_stride_log2(2'd0),
+		.i_pad_same(1'b0)
 	);
 	
 	// 2. Activation Function 인스턴스
@@ -1,5 +1,9 @@
 `timescale 1ns/1ps
-module Feature_Extractor_Fixed(
+module Feature_Extractor_Fixed #(
+	parameter IMG_WIDTH = 32,    // 입력 프레임 최대 크기 (라인 버퍼)
+	parameter IMG_HEIGHT = 32,
+	parameter RETIME = 0         // 1: conv MAC 입력 레지스터 한 단 (conv_engine_2d RETIME)
+)(
 	input logic clk,
 	input logic rst,
 	input logic start_signal,
@@ -7,8 +11,39 @@ module Feature_Extractor_Fixed(
 	input logic [7:0] pixel_in,
 	output logic signed [21:0] final_result_out,
 	output logic final_result_valid,
-	output logic final_done_signal
+	output logic final_done_signal,
+	output logic pool_input_valid,  // Max Pooling 입력 비트 (성능 카운터용)
+	
+	// ===== conv 커널 뱅크 (conv_engine_2d로 그대로 전달) =====
+	input logic i_kernel_bank,
+	input logic i_kernel_wr_en,
+	input logic i_kernel_wr_bank,
+	input logic [3:0] i_kernel_wr_idx,
+	input logic signed [7:0] i_kernel_wr_data,
+	
+	// ===== 런타임 프레임 크기 (프레임 동안 고정) =====
+	input logic [$clog2(IMG_WIDTH):0] i_img_width,
+	input logic [$clog2(IMG_HEIGHT):0] i_img_height,
+	input logic [1:0] i_stride_log2,
+	input logic i_pad_same,
+	
+	// ===== 레이어 시퀀서 모드: conv와 pool을 따로 구동 (conv → ReLU → pool 연결 끊음) =====
+	// conv는 start_signal / pixel 입력 + 오버라이드 커널, pool은 아래 입력 (크기 = i_img_width/height)
+	input logic i_seq_mode,
+	input logic signed [7:0] i_kernel_ovr_data [0:8],
+	input logic i_pool_start,
+	input logic i_pool_valid,
+	input logic signed [21:0] i_pool_pixel,
+	output logic signed [21:0] o_conv_result,       // ReLU 전 conv 결과
+	output logic o_conv_valid
 );
+	// conv 출력 크기 = (same ? W : W-2) / stride (올림) → pooling 입력 크기
+	logic [$clog2(IMG_WIDTH):0] conv_out_width;
+	logic [$clog2(IMG_HEIGHT):0] conv_out_height;
+	
+	assign conv_out_width  = ((i_pad_same ? i_img_width  : i_img_width  - 2'd2) + ((1 << i_stride_log2) - 1)) >> i_stride_log2;
+	assign conv_out_height = ((i_pad_same ? i_img_height : i_img_height - 2'd2) + ((1 << i_stride_log2) - 1)) >> i_stride_log2;
+	
 	logic signed [21:0] conv_result;
 	logic conv_valid;
 	logic conv_done_signal;
@@ -16,25 +51,17 @@ module Feature_Extractor_Fixed(
 	logic Activation_valid;
 	logic signed [21:0] Activation_result;
 	
-	// ===== 22비트로 데이터 보존 (BRAM 사용) =====
-	(* ram_style = "block" *) logic signed [21:0] conv_buffer [0:899];  // 16→22비트로 수정
-	logic [9:0] buffer_addr;
-	logic buffer_write_en;
-	logic buffer_complete;
-	
-	// Max Pooling 입력 제어
-	logic max_pool_start;
-	logic conv_done_d1;
-	logic [9:0] read_addr;
-	logic reading_buffer;
-	logic read_valid;
-	logic signed [21:0] buffered_data;
-	
-	conv_engine_2d	U0(
+	conv_engine_2d #( .IMG_WIDTH(IMG_WIDTH), .IMG_HEIGHT(IMG_HEIGHT), .RETIME(RETIME))
+	U0(
 		.clk, .rst, .start_signal, 
 		.pixel_in, .pixel_valid(pixel_valid_in),
 		.result_out(conv_result), .result_valid(conv_valid),
-		.done_signal(conv_done_signal)
+		.done_signal(conv_done_signal),
+		.i_kernel_bank, .i_kernel_wr_en, .i_kernel_wr_bank,
+		.i_kernel_wr_idx, .i_kernel_wr_data,
+		.i_kernel_ovr(i_seq_mode), .i_kernel_ovr_data,
+		.i_img_width, .i_img_height,
+		.i_stride_log2, .i_pad_same
 	);
 	
 	Activation_Function U1(
@@ -43,75 +70,25 @@ module Feature_Extractor_Fixed(
 		.result_valid(Activation_valid), .result_out(Activation_result)
 	);
 	
-	// ===== 개선된 버퍼 관리 (데이터 손실 방지) =====
-	assign buffer_write_en = Activation_valid;
-	
-	always_ff @(posedge clk or negedge rst) begin
-		if (!rst) begin
-			buffer_addr <= 10'b0;
-			buffer_complete <= 1'b0;
-		end else if (buffer_write_en) begin
-			// ✅ 수정: 22비트 전체 저장 (데이터 손실 없음)
-			conv_buffer[buffer_addr] <= Activation_result;  // 전체 22비트 보존
-			
-			if (buffer_addr == 899) begin  // 30x30 = 900
-				buffer_addr <= 10'b0;
-				buffer_complete <= 1'b1;
-				$display("Feature Buffer 완료: 900개 픽셀 저장됨");
-			end else begin
-				buffer_addr <= buffer_addr + 1;
-			end
-		end else if (!conv_done_signal) begin
-			buffer_complete <= 1'b0;
-		end
-	end
-	
-	// Conv 완료 감지
-	always_ff @(posedge clk or negedge rst) begin
-		if (!rst) begin
-			conv_done_d1 <= 1'b0;
-		end else begin
-			conv_done_d1 <= conv_done_signal;
-		end
-	end
-	
-	assign max_pool_start = buffer_complete && !conv_done_d1;
-	
-	// ===== 개선된 버퍼 읽기 =====
-	always_ff @(posedge clk or negedge rst) begin
-		if (!rst) begin
-			read_addr <= 10'b0;
-			reading_buffer <= 1'b0;
-			read_valid <= 1'b0;
-		end else if (max_pool_start) begin
-			reading_buffer <= 1'b1;
-			read_addr <= 10'b0;
-			read_valid <= 1'b1;
-			$display("Max Pooling 시작: 900개 픽셀 처리");
-		end else if (reading_buffer) begin
-			if (read_addr == 899) begin
-				read_addr <= 10'b0;
-				reading_buffer <= 1'b0;
-				read_valid <= 1'b0;
-				$display("버퍼 읽기 완료");
-			end else begin
-				read_addr <= read_addr + 1;
-			end
-		end
-	end
-	
-	// ✅ 수정: 22비트 데이터 그대로 사용 (부호 확장 불필요)
-	assign buffered_data = conv_buffer[read_addr];
-	
-	Max_Pooling #( .IMG_WIDTH(30), .IMG_HEIGHT(30))
+	// ===== 스트리밍 연결: ReLU 출력을 바로 Max Pooling으로 전달 =====
+	// Conv 행이 들어오는 동안 Pooling 결과가 나오므로 900개 BRAM 버퍼와 재생 FSM이 필요 없음
+	// Max Pooling은 conv와 같은 start_signal로 시작하고 자체 라인 버퍼로 2x2 윈도우를 구성
+	// (same 패딩이면 conv 출력이 입력 크기 그대로 → 최대 크기도 입력과 같음)
+	Max_Pooling #( .IMG_WIDTH(IMG_WIDTH), .IMG_HEIGHT(IMG_HEIGHT))
 	U2 (
 		.clk, .rst, 
-		.start_signal(max_pool_start),
-		.pixel_in(buffered_data), 
-		.pixel_valid(read_valid),
+		.start_signal(i_seq_mode ? i_pool_start : start_signal),
+		.pixel_in(i_seq_mode ? i_pool_pixel : Activation_result), 
+		.pixel_valid(i_seq_mode ? i_pool_valid : Activation_valid),
 		.result_out(final_result_out), 
 		.result_valid(final_result_valid), 
-		.done_signal(final_done_signal)
+		.done_signal(final_done_signal),
+		.i_img_width(i_seq_mode ? i_img_width : conv_out_width),
+		.i_img_height(i_seq_mode ? i_img_height : conv_out_height)
 	);
 	
+	assign pool_input_valid = Activation_valid;
+	assign o_conv_result = conv_result;
+	assign o_conv_valid = conv_valid;
+	
 endmodule
\ No newline at end of file
@@ -1,44 +1,249 @@
 `timescale 1ns/1ps
-module Fully_Connected_Layer_Fixed(
+module Fully_Connected_Layer_Fixed #(
+	parameter NUM_INPUTS  = 225,  // 최대 입력 수 (실제 개수는 i_num_inputs)
+	parameter NUM_LANES   = 8,    // P: 병렬 MAC 레인 수 (사이클당 입력 P개 처리)
+	parameter NUM_CLASSES = 4,    // 패턴 클래스 수 (STRAIGHT / LEFT / RIGHT / START_END)
+	parameter NUM_NEURONS = 1 + NUM_CLASSES, // 뉴런 0 = 차선 회귀, 1~ = 클래스 점수
+	parameter WEIGHT_FILE = "",   // 전체 뉴런 가중치 파일 ($readmemh, 선택)
+	parameter DATA_WIDTH  = 22,   // 활성값/가중치 폭: 22 (기존), 16 (INT16), 8 (INT8, DSP당 곱 2개)
+	parameter ZERO_SKIP   = 0,    // 1: 0이 아닌 입력만 레인에 발행 (flatten 인덱스 목록, 가중치 RAM 레인마다 전체 복사), 0: 전체 순차
+	parameter RETIME      = 0     // 1: 가중치 RAM 출력 레지스터 + MAC 곱 한 단 추가 (고속 코어 클럭, 패스당 +2사이클)
+	// 파이프라인: 인덱스 단 (nz 인덱스 등록) → 가중치 RAM 등록 읽기 → (RETIME) → MAC → 덧셈 트리 → 누적
+)(
 	input logic clk,
 	input logic rst,
 	input logic i_start,
-	input logic signed [21:0] i_flattened_data [0:224],
+	input logic signed [DATA_WIDTH-1:0] i_flattened_data [0:NUM_INPUTS-1],
+	input logic [$clog2(NUM_INPUTS+1)-1:0] i_num_inputs,          // 런타임 입력 수 (시작 시 래치)
+	input logic [$clog2(NUM_INPUTS)-1:0] i_nz_index [0:NUM_INPUTS-1],  // 0이 아닌 입력의 인덱스 (앞에서부터)
+	input logic [$clog2(NUM_INPUTS+1)-1:0] i_nz_count,            // 0이 아닌 입력 수 (시작 시 래치)
 	output logic o_result_valid,
-	output logic signed [47:0] o_result_data
+	output logic signed [47:0] o_result_data,                       // 뉴런 0 (기존 출력 유지)
+	output logic signed [47:0] o_neuron_data [0:NUM_NEURONS-1],     // 전체 뉴런 누적값
+	output logic [$clog2(NUM_CLASSES)-1:0] o_class_idx,             // argmax 클래스
+	output logic signed [47:0] o_class_score,                       // 최대 클래스 점수
+	output logic [47:0] o_class_margin,                             // 1등 - 2등 점수 차 (신뢰도)
+	output logic [31:0] o_cycles,                                   // 마지막 패스의 시작→결과 사이클 수
+	output logic [$clog2(NUM_INPUTS+1)-1:0] o_active_inputs,        // 마지막 패스에서 MAC에 발행한 입력 수
+	
+	// ===== 가중치 뱅크 (런타임 로드, 프레임 경계에서 교체) =====
+	input logic i_weight_bank,                                      // 연산에 사용할 뱅크 (계산 중 고정)
+	input logic i_wt_wr_en,                                         // 섀도 뱅크 쓰기
+	input logic i_wt_wr_bank,
+	input logic [3:0] i_wt_wr_neuron,
+	input logic [11:0] i_wt_wr_index,
+	input logic signed [DATA_WIDTH-1:0] i_wt_wr_data
 );
-	// ===== 하드코딩된 가중치 ROM (파일 의존성 제거) =====
-	logic signed [21:0] weight_ROM [0 : 224];
+	localparam NUM_BEATS = (NUM_INPUTS + NUM_LANES - 1) / NUM_LANES;  // 최대 입력일 때 한 패스의 사이클 수
+	localparam CLASS_BASE = NUM_NEURONS - NUM_CLASSES;
+	localparam NUM_PAIRS = (NUM_NEURONS + 1) / 2;   // INT8 패킹: 뉴런 2개가 레인 활성값 공유
+	// 뱅크 하나의 레인별 깊이: 순차 모드에서 레인 l은 k ≡ l (mod P) 인덱스만 읽음 → 인터리브 (NUM_BEATS 워드)
+	// zero skip이면 어느 레인이든 임의 인덱스를 읽으므로 레인마다 전체 복사본 (저장량 P배 + 레인마다 입력 수:1 선택기)
+	// → 인덱스 mod P 뱅크 + 충돌 시 정지 구조가 들어오기 전까지 기본값은 0
+	localparam BANK_DEPTH = ZERO_SKIP ? NUM_INPUTS : NUM_BEATS;
+	localparam ADDR_W = $clog2(2 * BANK_DEPTH);
+	
+	// ===== 하드코딩된 가중치 ROM (뉴런별) - 두 뱅크의 초기값 =====
+	logic signed [21:0] weight_ROM [0:NUM_NEURONS-1][0:NUM_INPUTS-1];
+	
+	// ===== 이중 뱅크 가중치 RAM: 뉴런 x 레인마다 독립 메모리 (쓰기 1 + 등록 읽기 1 → BRAM 추론) =====
+	// 주소 = 뱅크 * BANK_DEPTH + 오프셋, 한 뱅크로 추론하는 동안 다른 뱅크에 로드
+	// 앞 두 차원은 generate 상수로만 인덱싱 → 뉴런 x 레인 개의 독립 RAM으로 분리
+	logic signed [DATA_WIDTH-1:0] weight_RAM [0:NUM_NEURONS-1][0:NUM_LANES-1][0:2*BANK_DEPTH-1];
 	
 	// ===== 상태 정의 =====
-	enum logic [1:0] {
+	enum logic [2:0] {
 		IDLE, 
 		COMPUTE, 
+		DRAIN,
+		ARGMAX,
 		DONE
 	} state;
 	
 	// ===== 내부 신호들 =====
-	logic [7:0] mac_cnt;
+	logic [$clog2(NUM_BEATS+1)-1:0] beat_cnt;     // 발행한 비트 번호
+	logic [$clog2(NUM_BEATS+1)-1:0] acc_cnt;      // 누적 완료한 비트 수
 	logic mac_valid;
-	logic signed [47:0] accumulator_reg;
-	logic signed [47:0] mac_sum_in;
-	logic signed [47:0] mac_sum_out;
-	logic mac_sum_out_valid;
-	
-	// ===== MAC Unit =====
-	MAC_unit MAC(
-		.clk(clk), 
-		.rst(rst), 
-		.i_valid(mac_valid),
-		.data_in_a(i_flattened_data[mac_cnt]),
-		.data_in_b(weight_ROM[mac_cnt]),
-		.sum_in(mac_sum_in),
-		.o_valid(mac_sum_out_valid),
-		.sum_out(mac_sum_out)
-	);
+	logic [$clog2(NUM_INPUTS+1)-1:0] num_inputs;   // 이번 패스의 입력 수
+	logic [$clog2(NUM_BEATS+1)-1:0] num_beats;    // ceil(발행할 입력 수 / P), 최소 1
+	logic [$clog2(NUM_INPUTS+1)-1:0] num_active;   // 발행할 입력 수 (zero skip이면 0이 아닌 입력 수)
+	logic [$clog2(NUM_INPUTS+1)-1:0] start_active;
+	logic [31:0] cycle_cnt;
+	
+	logic signed [DATA_WIDTH-1:0] lane_data   [0:NUM_LANES-1];
+	logic [ADDR_W-1:0] lane_addr [0:NUM_LANES-1];      // 레인별 가중치 RAM 읽기 주소
+	logic signed [47:0] lane_prod   [0:NUM_NEURONS-1][0:NUM_LANES-1];
+	logic lane_prod_valid [0:NUM_NEURONS-1][0:NUM_LANES-1];
+	
+	logic signed [47:0] tree_sum [0:NUM_NEURONS-1];
+	logic tree_valid [0:NUM_NEURONS-1];
+	
+	logic signed [47:0] accumulator_reg [0:NUM_NEURONS-1];
+	
+	// ===== 인덱스 단: 비트마다 레인별 입력 인덱스를 먼저 등록 =====
+	// zero skip: 비트 b의 레인 l은 k = b*P + l번째 0이 아닌 입력 → 활성값과 가중치를 같은 인덱스로 모음
+	// 0인 입력은 곱이 0이므로 건너뛰어도 누적값은 비트 단위로 같음
+	// 압축된 nz 인덱스 목록 읽기 (큰 mux)와 가중치 RAM 주소 사이에 레지스터 → RAM 읽기는 등록된 주소로만
+	logic [$clog2(NUM_INPUTS)-1:0] idx_q [0:NUM_LANES-1];
+	logic [$clog2(NUM_BEATS+1)-1:0] beat_q;
+	logic idx_ok [0:NUM_LANES-1];                      // 범위 안 레인 (범위 밖은 활성값 0)
+	logic idx_issue;
+	
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			idx_q <= '{default: '0};
+			idx_ok <= '{default: 1'b0};
+			beat_q <= '0;
+			idx_issue <= 1'b0;
+		end else begin
+			idx_issue <= mac_valid;
+			beat_q <= beat_cnt;
+			for(int l = 0; l < NUM_LANES; l++) begin
+				int k, idx;
+				k = beat_cnt * NUM_LANES + l;
+				idx = (ZERO_SKIP && k < NUM_INPUTS) ? int'(i_nz_index[k]) : k;
+				idx_ok[l] <= (k < NUM_INPUTS) && (k < num_active) && (idx < num_inputs);
+				idx_q[l] <= (k < NUM_INPUTS) ? idx : 0;
+			end
+		end
+	end
+	
+	// ===== 레인 입력 선택 (등록된 인덱스 → 활성값 / 가중치 RAM 주소, 범위 밖은 0) =====
+	// 범위 밖 레인은 활성값만 0 (가중치는 아무 값이어도 곱이 0)
+	always_comb begin
+		for(int l = 0; l < NUM_LANES; l++) begin
+			lane_addr[l] = ADDR_W'(i_weight_bank * BANK_DEPTH + (ZERO_SKIP ? int'(idx_q[l]) : int'(beat_q)));
+			lane_data[l] = idx_ok[l] ? i_flattened_data[idx_q[l]] : '0;
+		end
+	end
+	
+	// ===== 가중치 읽기 단: RAM 등록 읽기와 같은 사이클에 활성값 / 발행 신호도 한 단 지연 =====
+	logic signed [DATA_WIDTH-1:0] rd_data   [0:NUM_LANES-1];
+	logic signed [DATA_WIDTH-1:0] rd_weight [0:NUM_NEURONS-1][0:NUM_LANES-1];
+	logic rd_issue;
+	
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			rd_data <= '{default: '0};
+			rd_issue <= 1'b0;
+		end else begin
+			rd_data <= lane_data;
+			rd_issue <= idx_issue;
+		end
+	end
+	
+	// ===== 가중치 쓰기 포트 (리셋 없음: CNN 소프트 리셋 후에도 유지) =====
+	// 순차 모드는 인덱스를 담당 레인 하나에만, zero skip은 모든 레인 복사본에 씀
+	logic [ADDR_W-1:0] wr_addr;
+	logic wr_ok;
+	
+	assign wr_ok = i_wt_wr_en && i_wt_wr_neuron < NUM_NEURONS && i_wt_wr_index < NUM_INPUTS;
+	assign wr_addr = ADDR_W'(i_wt_wr_bank * BANK_DEPTH + (ZERO_SKIP ? i_wt_wr_index : i_wt_wr_index / NUM_LANES));
+	
+	genvar n, l, p;
+	generate
+		for(n = 0; n < NUM_NEURONS; n = n + 1) begin : gen_wt_neuron
+			for(l = 0; l < NUM_LANES; l = l + 1) begin : gen_wt_lane
+				always @(posedge clk) begin
+					if(wr_ok && i_wt_wr_neuron == n && (ZERO_SKIP || i_wt_wr_index % NUM_LANES == l))
+						weight_RAM[n][l][wr_addr] <= i_wt_wr_data;
+					rd_weight[n][l] <= weight_RAM[n][l][lane_addr[l]];
+				end
+			end
+		end
+	endgenerate
+	
+	// ===== RAM 출력 레지스터 (RETIME): 고속 코어 클럭에서 BRAM 출력 → DSP 입력 경로 분리 =====
+	logic signed [DATA_WIDTH-1:0] mac_data   [0:NUM_LANES-1];
+	logic signed [DATA_WIDTH-1:0] mac_weight [0:NUM_NEURONS-1][0:NUM_LANES-1];
+	logic mac_issue;
+	
+	generate
+		if(RETIME) begin : gen_lane_reg
+			always_ff @(posedge clk or negedge rst) begin
+				if(!rst) begin
+					mac_data <= '{default: '0};
+					mac_weight <= '{default: '{default: '0}};
+					mac_issue <= 1'b0;
+				end else begin
+					mac_data <= rd_data;
+					mac_weight <= rd_weight;
+					mac_issue <= rd_issue;
+				end
+			end
+		end else begin : gen_lane_comb
+			assign mac_data = rd_data;
+			assign mac_weight = rd_weight;
+			assign mac_issue = rd_issue;
+		end
+	endgenerate
+	
+	// ===== 뉴런 x 레인 MAC 배열 + 뉴런별 덧셈 트리 =====
+	// INT8: 같은 레인 활성값을 쓰는 뉴런 두 개를 DSP 하나로 (mac_int8x2, 지연 동일)
+	generate
+		if(DATA_WIDTH == 8) begin : gen_packed
+			for(p = 0; p < NUM_PAIRS; p = p + 1) begin : gen_pair
+				for(l = 0; l < NUM_LANES; l = l + 1) begin : gen_lane
+					logic signed [47:0] prod_hi;
+					logic prod_valid;
+					
+					mac_int8x2 MAC2(
+						.clk(clk),
+						.rst(rst),
+						.i_valid(mac_issue),
+						.data_in_a(mac_data[l]),
+						.weight_lo(mac_weight[2*p][l]),
+						.weight_hi((2*p + 1 < NUM_NEURONS) ? mac_weight[(2*p + 1) % NUM_NEURONS][l] : 8'sd0),
+						.o_valid(prod_valid),
+						.prod_lo(lane_prod[2*p][l]),
+						.prod_hi(prod_hi)
+					);
+					
+					assign lane_prod_valid[2*p][l] = prod_valid;
+					if(2*p + 1 < NUM_NEURONS) begin : gen_hi
+						assign lane_prod[2*p+1][l] = prod_hi;
+						assign lane_prod_valid[2*p+1][l] = prod_valid;
+					end
+				end
+			end
+		end else begin : gen_mac
+			for(n = 0; n < NUM_NEURONS; n = n + 1) begin : gen_neuron
+				for(l = 0; l < NUM_LANES; l = l + 1) begin : gen_lane
+					MAC_unit #(.A_WIDTH(DATA_WIDTH), .B_WIDTH(DATA_WIDTH), .MUL_STAGES(1 + RETIME)) MAC(
+						.clk(clk), 
+						.rst(rst), 
+						.i_valid(mac_issue),
+						.data_in_a(mac_data[l]),
+						.data_in_b(mac_weight[n][l]),
+						.sum_in(48'sd0),
+						.o_valid(lane_prod_valid[n][l]),
+						.sum_out(lane_prod[n][l])
+					);
+				end
+			end
+		end
+		
+		for(n = 0; n < NUM_NEURONS; n = n + 1) begin : gen_neuron_tree
+			fc_adder_tree #(.NUM_IN(NUM_LANES), .WIDTH(48)) TREE(
+				.clk(clk),
+				.rst(rst),
+				.i_valid(lane_prod_valid[n][0]),
+				.i_data(lane_prod[n]),
+				.o_valid(tree_valid[n]),
+				.o_sum(tree_sum[n])
+			);
+		end
+	endgenerate
+	
+	// ===== 이번 패스에서 발행할 입력 수 =====
+	always_comb begin
+		start_active = (i_num_inputs > NUM_INPUTS) ? NUM_INPUTS : i_num_inputs;
+		if(ZERO_SKIP && i_nz_count < start_active) start_active = i_nz_count;
+	end
 	
 	// ===== 시작 펄스 감지 =====
 	logic i_start_d1;
+	logic start_pulse;
 	always_ff @(posedge clk or negedge rst) begin 
 		if(!rst) 
 			i_start_d1 <= 1'b0; 
@@ -46,134 +251,211 @@ module Fully_Connected_Layer_Fixed(
 			i_start_d1 <= i_start;
 	end
 	
-	logic start_pulse = i_start & ~i_start_d1;
+	assign start_pulse = i_start & ~i_start_d1;
+	
+	// ===== Argmax (클래스 뉴런 중 최댓값과 2등) =====
+	logic [$clog2(NUM_CLASSES)-1:0] best_idx;
+	logic signed [47:0] best_score, second_score;
+	
+	always_comb begin
+		best_idx = '0;
+		best_score = accumulator_reg[CLASS_BASE];
+		second_score = {1'b1, 47'b0};  // 최솟값
+		for(int c = 1; c < NUM_CLASSES; c++) begin
+			if(accumulator_reg[CLASS_BASE + c] > best_score) begin
+				second_score = best_score;
+				best_score = accumulator_reg[CLASS_BASE + c];
+				best_idx = c;
+			end else if(accumulator_reg[CLASS_BASE + c] > second_score) begin
+				second_score = accumulator_reg[CLASS_BASE + c];
+			end
+		end
+	end
 	
 	// ===== 메인 상태 머신 =====
 	always_ff @(posedge clk or negedge rst) begin  
 		if(!rst) begin  
 			state <= IDLE;
-			mac_cnt <= 8'h0;
+			beat_cnt <= '0;
+			acc_cnt <= '0;
 			mac_valid <= 1'b0;
-			accumulator_reg <= 48'h0;
+			num_inputs <= NUM_INPUTS;
+			num_beats <= NUM_BEATS;
+			num_active <= NUM_INPUTS;
+			cycle_cnt <= '0;
+			o_cycles <= '0;
+			o_active_inputs <= '0;
+			accumulator_reg <= '{default: '0};
 			o_result_valid <= 1'b0;
+			o_class_idx <= '0;
+			o_class_score <= '0;
+			o_class_margin <= '0;
 		end else begin
+			if(state != IDLE) cycle_cnt <= cycle_cnt + 1;
+			
+			// 덧셈 트리 출력 누적 (모든 뉴런이 같은 타이밍)
+			if(tree_valid[0] && state != IDLE) begin
+				for(int k = 0; k < NUM_NEURONS; k++)
+					accumulator_reg[k] <= accumulator_reg[k] + tree_sum[k];
+				acc_cnt <= acc_cnt + 1'b1;
+			end
+			
 			case(state) 
 				IDLE: begin
 					mac_valid <= 1'b0;
 					o_result_valid <= 1'b0;
 					
 					if(start_pulse) begin
-						accumulator_reg <= 48'h0;
-						mac_cnt <= 8'h0;
+						accumulator_reg <= '{default: '0};
+						beat_cnt <= '0;
+						acc_cnt <= '0;
 						mac_valid <= 1'b1;
+						num_inputs <= (i_num_inputs > NUM_INPUTS) ? NUM_INPUTS : i_num_inputs;
+						num_active <= start_active;
+						num_beats <= (start_active == 0) ? 1 : (start_active + NUM_LANES - 1) / NUM_LANES;
+						cycle_cnt <= 32'd1;
 						state <= COMPUTE;
-						$display("FC Layer 시작: 225개 가중치 계산");
+						$display("FC Layer 시작: %0d개 입력 (0 아닌 입력 %0d), %0d 레인, %0d 뉴런",
+						         i_num_inputs, start_active, NUM_LANES, NUM_NEURONS);
 					end
 				end
 				
 				COMPUTE: begin
-					// MAC 결과 누적
-					if(mac_sum_out_valid) begin
-						accumulator_reg <= mac_sum_out;
-						
-						// 진행 상황 출력 (디버깅용)
-						if(mac_cnt % 50 == 0) begin
-							$display("FC 진행: %d/225, 누적값: %h", mac_cnt, mac_sum_out);
-						end
-					end
-					
-					// 모든 가중치 처리 완료?
-					if(mac_cnt == 224) begin
-						state <= DONE;
+					// 모든 비트 발행 완료?
+					if(beat_cnt == num_beats - 1) begin
 						mac_valid <= 1'b0;
-						o_result_valid <= 1'b1;
-						$display("FC Layer 완료: 최종 결과 = %h", accumulator_reg);
+						state <= DRAIN;
 					end else begin
-						mac_cnt <= mac_cnt + 1'b1;
+						beat_cnt <= beat_cnt + 1'b1;
 						mac_valid <= 1'b1;
 					end
 				end
 				
-				DONE: begin
-					o_result_valid <= 1'b1;
-					if(!i_start) begin
-						state <= IDLE;
-						o_result_valid <= 1'b0;
+				DRAIN: begin
+					// MAC + 덧셈 트리 파이프라인 비우기
+					if(acc_cnt == num_beats) begin
+						state <= ARGMAX;
 					end
 				end
+				
+				ARGMAX: begin
+					o_class_idx <= best_idx;
+					o_class_score <= best_score;
+					o_class_margin <= (NUM_CLASSES > 1) ? (best_score - second_score) : '0;
+					o_result_valid <= 1'b1;
+					o_cycles <= cycle_cnt + 1;
+					o_active_inputs <= num_active;
+					state <= DONE;
+					$display("FC Layer 완료: 최종 결과 = %h, 클래스 = %0d", accumulator_reg[0], best_idx);
+				end
+				
+				DONE: begin
+					o_result_valid <= 1'b0;
+					state <= IDLE;
+				end
+				
+				default: state <= IDLE;
 			endcase
 		end
 	end
 	
 	// ===== 출력 할당 =====
-	assign mac_sum_in = accumulator_reg;
-	assign o_result_data = accumulator_reg;
+	assign o_result_data = accumulator_reg[0];
+	assign o_neuron_data = accumulator_reg;
 	
 	// ===== 가중치 하드코딩 (파일 의존성 제거) =====
 	initial begin
-		// weight.mem 파일의 모든 225개 가중치를 하드코딩
-		weight_ROM[0] = 22'h3FFE46;   weight_ROM[1] = 22'h3FFB24;   weight_ROM[2] = 22'h3FFDB8;   weight_ROM[3] = 22'h3FFB7F;
-		weight_ROM[4] = 22'h000136;   weight_ROM[5] = 22'h000964;   weight_ROM[6] = 22'h3FFD6A;   weight_ROM[7] = 22'h0001CC;
-		weight_ROM[8] = 22'h3FFCE0;   weight_ROM[9] = 22'h000496;   weight_ROM[10] = 22'h3FFE85;  weight_ROM[11] = 22'h3FFD36;
-		weight_ROM[12] = 22'h0000D7;  weight_ROM[13] = 22'h000079;  weight_ROM[14] = 22'h3FFAEB;  weight_ROM[15] = 22'h00039F;
-		weight_ROM[16] = 22'h3FFA5D;  weight_ROM[17] = 22'h3FFAD6;  weight_ROM[18] = 22'h0005D2;  weight_ROM[19] = 22'h00072A;
-		weight_ROM[20] = 22'h3FFDA6;  weight_ROM[21] = 22'h3FFA89;  weight_ROM[22] = 22'h00039B;  weight_ROM[23] = 22'h3FFDCD;
-		weight_ROM[24] = 22'h3FF9A6;  weight_ROM[25] = 22'h00043A;  weight_ROM[26] = 22'h000190;  weight_ROM[27] = 22'h3FFF68;
-		weight_ROM[28] = 22'h000457;  weight_ROM[29] = 22'h000898;  weight_ROM[30] = 22'h3FFE43;  weight_ROM[31] = 22'h00016F;
-		weight_ROM[32] = 22'h000095;  weight_ROM[33] = 22'h3FFFB9;  weight_ROM[34] = 22'h3FFC68;  weight_ROM[35] = 22'h00068C;
-		weight_ROM[36] = 22'h000111;  weight_ROM[37] = 22'h0000C2;  weight_ROM[38] = 22'h00055E;  weight_ROM[39] = 22'h0007EF;
-		weight_ROM[40] = 22'h0003DC;  weight_ROM[41] = 22'h3FFC44;  weight_ROM[42] = 22'h00001C;  weight_ROM[43] = 22'h00003E;
-		weight_ROM[44] = 22'h3FFED7;  weight_ROM[45] = 22'h3FFC04;  weight_ROM[46] = 22'h0006B2;  weight_ROM[47] = 22'h0005DB;
-		weight_ROM[48] = 22'h0002E1;  weight_ROM[49] = 22'h3FFF1B;  weight_ROM[50] = 22'h000489;  weight_ROM[51] = 22'h0002F0;
-		weight_ROM[52] = 22'h3FFFC8;  weight_ROM[53] = 22'h00068C;  weight_ROM[54] = 22'h3FFBF1;  weight_ROM[55] = 22'h3FF94C;
-		weight_ROM[56] = 22'h000DE9;  weight_ROM[57] = 22'h3FFF5A;  weight_ROM[58] = 22'h3FFCF9;  weight_ROM[59] = 22'h3FF84B;
-		weight_ROM[60] = 22'h0003B8;  weight_ROM[61] = 22'h3FFB62;  weight_ROM[62] = 22'h3FFAF3;  weight_ROM[63] = 22'h3FFCA2;
-		weight_ROM[64] = 22'h3FF87A;  weight_ROM[65] = 22'h3FFE78;  weight_ROM[66] = 22'h00006B;  weight_ROM[67] = 22'h3FFE9B;
-		weight_ROM[68] = 22'h3FF915;  weight_ROM[69] = 22'h3FFBDF;  weight_ROM[70] = 22'h000230;  weight_ROM[71] = 22'h3FFD72;
-		weight_ROM[72] = 22'h0001FF;  weight_ROM[73] = 22'h000934;  weight_ROM[74] = 22'h3FFAF9;  weight_ROM[75] = 22'h0001EC;
-		weight_ROM[76] = 22'h000284;  weight_ROM[77] = 22'h3FFA2F;  weight_ROM[78] = 22'h00001B;  weight_ROM[79] = 22'h000281;
-		weight_ROM[80] = 22'h3FFB80;  weight_ROM[81] = 22'h3FFFAE;  weight_ROM[82] = 22'h3FFD29;  weight_ROM[83] = 22'h000308;
-		weight_ROM[84] = 22'h3FF861;  weight_ROM[85] = 22'h3FF8CF;  weight_ROM[86] = 22'h000982;  weight_ROM[87] = 22'h3FFA34;
-		weight_ROM[88] = 22'h00042E;  weight_ROM[89] = 22'h3FFB60;  weight_ROM[90] = 22'h3FF9C6;  weight_ROM[91] = 22'h3FFA7B;
-		weight_ROM[92] = 22'h3FFB31;  weight_ROM[93] = 22'h3FFCE4;  weight_ROM[94] = 22'h3FF8A5;  weight_ROM[95] = 22'h3FFC0D;
-		weight_ROM[96] = 22'h3FF1D1;  weight_ROM[97] = 22'h00014D;  weight_ROM[98] = 22'h000588;  weight_ROM[99] = 22'h3FF8BD;
-		weight_ROM[100] = 22'h000205; weight_ROM[101] = 22'h000040; weight_ROM[102] = 22'h3FFB96; weight_ROM[103] = 22'h00009B;
-		weight_ROM[104] = 22'h000000; weight_ROM[105] = 22'h0004EA; weight_ROM[106] = 22'h00030F; weight_ROM[107] = 22'h000B1D;
-		weight_ROM[108] = 22'h3FFBE6; weight_ROM[109] = 22'h00020D; weight_ROM[110] = 22'h0000D1; weight_ROM[111] = 22'h000388;
-		weight_ROM[112] = 22'h0000CB; weight_ROM[113] = 22'h3FFEA6; weight_ROM[114] = 22'h3FFB97; weight_ROM[115] = 22'h3FFD6D;
-		weight_ROM[116] = 22'h3FFBB8; weight_ROM[117] = 22'h00064E; weight_ROM[118] = 22'h3FFE82; weight_ROM[119] = 22'h0000BE;
-		weight_ROM[120] = 22'h3FFFCF; weight_ROM[121] = 22'h000204; weight_ROM[122] = 22'h3FFBF3; weight_ROM[123] = 22'h3FFDCD;
-		weight_ROM[124] = 22'h0009A6; weight_ROM[125] = 22'h3FFD80; weight_ROM[126] = 22'h000048; weight_ROM[127] = 22'h000434;
-		weight_ROM[128] = 22'h000628; weight_ROM[129] = 22'h3FFCF5; weight_ROM[130] = 22'h0003D1; weight_ROM[131] = 22'h00012F;
-		weight_ROM[132] = 22'h000130; weight_ROM[133] = 22'h3FFE75; weight_ROM[134] = 22'h3FFB1D; weight_ROM[135] = 22'h0000EF;
-		weight_ROM[136] = 22'h3FF7E0; weight_ROM[137] = 22'h000045; weight_ROM[138] = 22'h000223; weight_ROM[139] = 22'h3FFA54;
-		weight_ROM[140] = 22'h3FFA3D; weight_ROM[141] = 22'h000753; weight_ROM[142] = 22'h0000A6; weight_ROM[143] = 22'h000464;
-		weight_ROM[144] = 22'h000514; weight_ROM[145] = 22'h3FF8F5; weight_ROM[146] = 22'h0002E0; weight_ROM[147] = 22'h3FFCCC;
-		weight_ROM[148] = 22'h3FFF13; weight_ROM[149] = 22'h000433; weight_ROM[150] = 22'h00019A; weight_ROM[151] = 22'h3FFBF6;
-		weight_ROM[152] = 22'h0001D5; weight_ROM[153] = 22'h3FFDF0; weight_ROM[154] = 22'h3FFB17; weight_ROM[155] = 22'h000A3D;
-		weight_ROM[156] = 22'h3FFCE1; weight_ROM[157] = 22'h0008C8; weight_ROM[158] = 22'h000370; weight_ROM[159] = 22'h0005BD;
-		weight_ROM[160] = 22'h00005B; weight_ROM[161] = 22'h0003DE; weight_ROM[162] = 22'h0003BC; weight_ROM[163] = 22'h3FF69F;
-		weight_ROM[164] = 22'h00035A; weight_ROM[165] = 22'h0001D8; weight_ROM[166] = 22'h3FFE4C; weight_ROM[167] = 22'h3FFAEE;
-		weight_ROM[168] = 22'h3FFF41; weight_ROM[169] = 22'h0004F0; weight_ROM[170] = 22'h3FFF51; weight_ROM[171] = 22'h3FFC69;
-		weight_ROM[172] = 22'h3FF9FA; weight_ROM[173] = 22'h0005C4; weight_ROM[174] = 22'h000768; weight_ROM[175] = 22'h00002E;
-		weight_ROM[176] = 22'h3FF81C; weight_ROM[177] = 22'h3FFFBD; weight_ROM[178] = 22'h000069; weight_ROM[179] = 22'h0002DA;
-		weight_ROM[180] = 22'h0003D3; weight_ROM[181] = 22'h3FFE80; weight_ROM[182] = 22'h0006F8; weight_ROM[183] = 22'h000685;
-		weight_ROM[184] = 22'h3FFBF6; weight_ROM[185] = 22'h000385; weight_ROM[186] = 22'h0001D1; weight_ROM[187] = 22'h3FFE08;
-		weight_ROM[188] = 22'h0003E1; weight_ROM[189] = 22'h3FFF9E; weight_ROM[190] = 22'h3FFF00; weight_ROM[191] = 22'h000362;
-		weight_ROM[192] = 22'h000194; weight_ROM[193] = 22'h000618; weight_ROM[194] = 22'h3FF759; weight_ROM[195] = 22'h0004D9;
-		weight_ROM[196] = 22'h3FFA95; weight_ROM[197] = 22'h00022F; weight_ROM[198] = 22'h3FFB2A; weight_ROM[199] = 22'h3FFD58;
-		weight_ROM[200] = 22'h0003BD; weight_ROM[201] = 22'h3FFE98; weight_ROM[202] = 22'h0000E9; weight_ROM[203] = 22'h3FFACA;
-		weight_ROM[204] = 22'h3FFA14; weight_ROM[205] = 22'h3FF9A6; weight_ROM[206] = 22'h000147; weight_ROM[207] = 22'h00053F;
-		weight_ROM[208] = 22'h3FF91C; weight_ROM[209] = 22'h0005AA; weight_ROM[210] = 22'h3FFD5C; weight_ROM[211] = 22'h0005A7;
-		weight_ROM[212] = 22'h3FFBE2; weight_ROM[213] = 22'h3FFCAA; weight_ROM[214] = 22'h0002F0; weight_ROM[215] = 22'h000640;
-		weight_ROM[216] = 22'h3FFDA5; weight_ROM[217] = 22'h000159; weight_ROM[218] = 22'h000469; weight_ROM[219] = 22'h000640;
-		weight_ROM[220] = 22'h0004CA; weight_ROM[221] = 22'h000286; weight_ROM[222] = 22'h3FFDE7; weight_ROM[223] = 22'h3FFBC2;
-		weight_ROM[224] = 22'h000760;
+		// 클래스 뉴런은 0으로 초기화 (WEIGHT_FILE이 주어지면 아래에서 덮어씀)
+		for(int n = 0; n < NUM_NEURONS; n++)
+			for(int k = 0; k < NUM_INPUTS; k++)
+				weight_ROM[n][k] = '0;
+		
+		// 뉴런 0: weight.mem 파일의 모든 225개 차선 회귀 가중치를 하드코딩
+		weight_ROM[0][0] = 22'h3FFE46;   weight_ROM[0][1] = 22'h3FFB24;   weight_ROM[0][2] = 22'h3FFDB8;   weight_ROM[0][3] = 22'h3FFB7F;
+		weight_ROM[0][4] = 22'h000136;   weight_ROM[0][5] = 22'h000964;   weight_ROM[0][6] = 22'h3FFD6A;   weight_ROM[0][7] = 22'h0001CC;
+		weight_ROM[0][8] = 22'h3FFCE0;   weight_ROM[0][9] = 22'h000496;   weight_ROM[0][10] = 22'h3FFE85;  weight_ROM[0][11] = 22'h3FFD36;
+		weight_ROM[0][12] = 22'h0000D7;  weight_ROM[0][13] = 22'h000079;  weight_ROM[0][14] = 22'h3FFAEB;  weight_ROM[0][15] = 22'h00039F;
+		weight_ROM[0][16] = 22'h3FFA5D;  weight_ROM[0][17] = 22'h3FFAD6;  weight_ROM[0][18] = 22'h0005D2;  weight_ROM[0][19] = 22'h00072A;
+		weight_ROM[0][20] = 22'h3FFDA6;  weight_ROM[0][21] = 22'h3FFA89;  weight_ROM[0][22] = 22'h00039B;  weight_ROM[0][23] = 22'h3FFDCD;
+		weight_ROM[0][24] = 22'h3FF9A6;  weight_ROM[0][25] = 22'h00043A;  weight_ROM[0][26] = 22'h000190;  weight_ROM[0][27] = 22'h3FFF68;
+		weight_ROM[0][28] = 22'h000457;  weight_ROM[0][29] = 22'h000898;  weight_ROM[0][30] = 22'h3FFE43;  weight_ROM[0][31] = 22'h00016F;
+		weight_ROM[0][32] = 22'h000095;  weight_ROM[0][33] = 22'h3FFFB9;  weight_ROM[0][34] = 22'h3FFC68;  weight_ROM[0][35] = 22'h00068C;
+		weight_ROM[0][36] = 22'h000111;  weight_ROM[0][37] = 22'h0000C2;  weight_ROM[0][38] = 22'h00055E;  weight_ROM[0][39] = 22'h0007EF;
+		weight_ROM[0][40] = 22'h0003DC;  weight_ROM[0][41] = 22'h3FFC44;  weight_ROM[0][42] = 22'h00001C;  weight_ROM[0][43] = 22'h00003E;
+		weight_ROM[0][44] = 22'h3FFED7;  weight_ROM[0][45] = 22'h3FFC04;  weight_ROM[0][46] = 22'h0006B2;  weight_ROM[0][47] = 22'h0005DB;
+		weight_ROM[0][48] = 22'h0002E1;  weight_ROM[0][49] = 22'h3FFF1B;  weight_ROM[0][50] = 22'h000489;  weight_ROM[0][51] = 22'h0002F0;
+		weight_ROM[0][52] = 22'h3FFFC8;  weight_ROM[0][53] = 22'h00068C;  weight_ROM[0][54] = 22'h3FFBF1;  weight_ROM[0][55] = 22'h3FF94C;
+		weight_ROM[0][56] = 22'h000DE9;  weight_ROM[0][57] = 22'h3FFF5A;  weight_ROM[0][58] = 22'h3FFCF9;  weight_ROM[0][59] = 22'h3FF84B;
+		weight_ROM[0][60] = 22'h0003B8;  weight_ROM[0][61] = 22'h3FFB62;  weight_ROM[0][62] = 22'h3FFAF3;  weight_ROM[0][63] = 22'h3FFCA2;
+		weight_ROM[0][64] = 22'h3FF87A;  weight_ROM[0][65] = 22'h3FFE78;  weight_ROM[0][66] = 22'h00006B;  weight_ROM[0][67] = 22'h3FFE9B;
+		weight_ROM[0][68] = 22'h3FF915;  weight_ROM[0][69] = 22'h3FFBDF;  weight_ROM[0][70] = 22'h000230;  weight_ROM[0][71] = 22'h3FFD72;
+		weight_ROM[0][72] = 22'h0001FF;  weight_ROM[0][73] = 22'h000934;  weight_ROM[0][74] = 22'h3FFAF9;  weight_ROM[0][75] = 22'h0001EC;
+		weight_ROM[0][76] = 22'h000284;  weight_ROM[0][77] = 22'h3FFA2F;  weight_ROM[0][78] = 22'h00001B;  weight_ROM[0][79] = 22'h000281;
+		weight_ROM[0][80] = 22'h3FFB80;  weight_ROM[0][81] = 22'h3FFFAE;  weight_ROM[0][82] = 22'h3FFD29;  weight_ROM[0][83] = 22'h000308;
+		weight_ROM[0][84] = 22'h3FF861;  weight_ROM[0][85] = 22'h3FF8CF;  weight_ROM[0][86] = 22'h000982;  weight_ROM[0][87] = 22'h3FFA34;
+		weight_ROM[0][88] = 22'h00042E;  weight_ROM[0][89] = 22'h3FFB60;  weight_ROM[0][90] = 22'h3FF9C6;  weight_ROM[0][91] = 22'h3FFA7B;
+		weight_ROM[0][92] = 22'h3FFB31;  weight_ROM[0][93] = 22'h3FFCE4;  weight_ROM[0][94] = 22'h3FF8A5;  weight_ROM[0][95] = 22'h3FFC0D;
+		weight_ROM[0][96] = 22'h3FF1D1;  weight_ROM[0][97] = 22'h00014D;  weight_ROM[0][98] = 22'h000588;  weight_ROM[0][99] = 22'h3FF8BD;
+		weight_ROM[0][100] = 22'h000205; weight_ROM[0][101] = 22'h000040; weight_ROM[0][102] = 22'h3FFB96; weight_ROM[0][103] = 22'h00009B;
+		weight_ROM[0][104] = 22'h000000; weight_ROM[0][105] = 22'h0004EA; weight_ROM[0][106] = 22'h00030F; weight_ROM[0][107] = 22'h000B1D;
+		weight_ROM[0][108] = 22'h3FFBE6; weight_ROM[0][109] = 22'h00020D; weight_ROM[0][110] = 22'h0000D1; weight_ROM[0][111] = 22'h000388;
+		weight_ROM[0][112] = 22'h0000CB; weight_ROM[0][113] = 22'h3FFEA6; weight_ROM[0][114] = 22'h3FFB97; weight_ROM[0][115] = 22'h3FFD6D;
+		weight_ROM[0][116] = 22'h3FFBB8; weight_ROM[0][117] = 22'h00064E; weight_ROM[0][118] = 22'h3FFE82; weight_ROM[0][119] = 22'h0000BE;
+		weight_ROM[0][120] = 22'h3FFFCF; weight_ROM[0][121] = 22'h000204; weight_ROM[0][122] = 22'h3FFBF3; weight_ROM[0][123] = 22'h3FFDCD;
+		weight_ROM[0][124] = 22'h0009A6; weight_ROM[0][125] = 22'h3FFD80; weight_ROM[0][126] = 22'h000048; weight_ROM[0][127] = 22'h000434;
+		weight_ROM[0][128] = 22'h000628; weight_ROM[0][129] = 22'h3FFCF5; weight_ROM[0][130] = 22'h0003D1; weight_ROM[0][131] = 22'h00012F;
+		weight_ROM[0][132] = 22'h000130; weight_ROM[0][133] = 22'h3FFE75; weight_ROM[0][134] = 22'h3FFB1D; weight_ROM[0][135] = 22'h0000EF;
+		weight_ROM[0][136] = 22'h3FF7E0; weight_ROM[0][137] = 22'h000045; weight_ROM[0][138] = 22'h000223; weight_ROM[0][139] = 22'h3FFA54;
+		weight_ROM[0][140] = 22'h3FFA3D; weight_ROM[0][141] = 22'h000753; weight_ROM[0][142] = 22'h0000A6; weight_ROM[0][143] = 22'h000464;
+		weight_ROM[0][144] = 22'h000514; weight_ROM[0][145] = 22'h3FF8F5; weight_ROM[0][146] = 22'h0002E0; weight_ROM[0][147] = 22'h3FFCCC;
+		weight_ROM[0][148] = 22'h3FFF13; weight_ROM[0][149] = 22'h000433; weight_ROM[0][150] = 22'h00019A; weight_ROM[0][151] = 22'h3FFBF6;
+		weight_ROM[0][152] = 22'h0001D5; weight_ROM[0][153] = 22'h3FFDF0; weight_ROM[0][154] = 22'h3FFB17; weight_ROM[0][155] = 22'h000A3D;
+		weight_ROM[0][156] = 22'h3FFCE1; weight_ROM[0][157] = 22'h0008C8; weight_ROM[0][158] = 22'h000370; weight_ROM[0][159] = 22'h0005BD;
+		weight_ROM[0][160] = 22'h00005B; weight_ROM[0][161] = 22'h0003DE; weight_ROM[0][162] = 22'h0003BC; weight_ROM[0][163] = 22'h3FF69F;
+		weight_ROM[0][164] = 22'h00035A; weight_ROM[0][165] = 22'h0001D8; weight_ROM[0][166] = 22'h3FFE4C; weight_ROM[0][167] = 22'h3FFAEE;
+		weight_ROM[0][168] = 22'h3FFF41; weight_ROM[0][169] = 22'h0004F0; weight_ROM[0][170] = 22'h3FFF51; weight_ROM[0][171] = 22'h3FFC69;
+		weight_ROM[0][172] = 22'h3FF9FA; weight_ROM[0][173] = 22'h0005C4; weight_ROM[0][174] = 22'h000768; weight_ROM[0][175] = 22'h00002E;
+		weight_ROM[0][176] = 22'h3FF81C; weight_ROM[0][177] = 22'h3FFFBD; weight_ROM[0][178] = 22'h000069; weight_ROM[0][179] = 22'h0002DA;
+		weight_ROM[0][180] = 22'h0003D3; weight_ROM[0][181] = 22'h3FFE80; weight_ROM[0][182] = 22'h0006F8; weight_ROM[0][183] = 22'h000685;
+		weight_ROM[0][184] = 22'h3FFBF6; weight_ROM[0][185] = 22'h000385; weight_ROM[0][186] = 22'h0001D1; weight_ROM[0][187] = 22'h3FFE08;
+		weight_ROM[0][188] = 22'h0003E1; weight_ROM[0][189] = 22'h3FFF9E; weight_ROM[0][190] = 22'h3FFF00; weight_ROM[0][191] = 22'h000362;
+		weight_ROM[0][192] = 22'h000194; weight_ROM[0][193] = 22'h000618; weight_ROM[0][194] = 22'h3FF759; weight_ROM[0][195] = 22'h0004D9;
+		weight_ROM[0][196] = 22'h3FFA95; weight_ROM[0][197] = 22'h00022F; weight_ROM[0][198] = 22'h3FFB2A; weight_ROM[0][199] = 22'h3FFD58;
+		weight_ROM[0][200] = 22'h0003BD; weight_ROM[0][201] = 22'h3FFE98; weight_ROM[0][202] = 22'h0000E9; weight_ROM[0][203] = 22'h3FFACA;
+		weight_ROM[0][204] = 22'h3FFA14; weight_ROM[0][205] = 22'h3FF9A6; weight_ROM[0][206] = 22'h000147; weight_ROM[0][207] = 22'h00053F;
+		weight_ROM[0][208] = 22'h3FF91C; weight_ROM[0][209] = 22'h0005AA; weight_ROM[0][210] = 22'h3FFD5C; weight_ROM[0][211] = 22'h0005A7;
+		weight_ROM[0][212] = 22'h3FFBE2; weight_ROM[0][213] = 22'h3FFCAA; weight_ROM[0][214] = 22'h0002F0; weight_ROM[0][215] = 22'h000640;
+		weight_ROM[0][216] = 22'h3FFDA5; weight_ROM[0][217] = 22'h000159; weight_ROM[0][218] = 22'h000469; weight_ROM[0][219] = 22'h000640;
+		weight_ROM[0][220] = 22'h0004CA; weight_ROM[0][221] = 22'h000286; weight_ROM[0][222] = 22'h3FFDE7; weight_ROM[0][223] = 22'h3FFBC2;
+		weight_ROM[0][224] = 22'h000760;
+		
+		// 전체 뉴런 가중치 파일 (뉴런 순서대로 NUM_NEURONS x NUM_INPUTS 워드)
+		if(WEIGHT_FILE != "") begin
+			$readmemh(WEIGHT_FILE, weight_ROM);
+		end
+		
+		// 두 뱅크 모두 같은 초기 가중치로 시작 (레인 배치는 쓰기 포트와 같은 규칙)
+		// (기존 가중치는 16비트에 들어가므로 INT16은 그대로, INT8은 WEIGHT_FILE 또는 런타임 로드 필요)
+		for(int n = 0; n < NUM_NEURONS; n++)
+			for(int l = 0; l < NUM_LANES; l++)
+				for(int a = 0; a < 2 * BANK_DEPTH; a++)
+					weight_RAM[n][l][a] = '0;
+		for(int n = 0; n < NUM_NEURONS; n++)
+			for(int k = 0; k < NUM_INPUTS; k++)
+				for(int l = 0; l < NUM_LANES; l++) begin
+					if(ZERO_SKIP) begin
+						weight_RAM[n][l][k] = DATA_WIDTH'(weight_ROM[n][k]);
+						weight_RAM[n][l][BANK_DEPTH + k] = DATA_WIDTH'(weight_ROM[n][k]);
+					end else if(k % NUM_LANES == l) begin
+						weight_RAM[n][l][k / NUM_LANES] = DATA_WIDTH'(weight_ROM[n][k]);
+						weight_RAM[n][l][BANK_DEPTH + k / NUM_LANES] = DATA_WIDTH'(weight_ROM[n][k]);
+					end
+				end
 		
 		$display("✓ 하드코딩된 가중치 초기화 완료: 225개");
-		$display("  Weight[0] = 0x%06X", weight_ROM[0]);
-		$display("  Weight[1] = 0x%06X", weight_ROM[1]);
-		$display("  Weight[224] = 0x%06X", weight_ROM[224]);
+		$display("  Weight[0] = 0x%06X", weight_ROM[0][0]);
+		$display("  Weight[1] = 0x%06X", weight_ROM[0][1]);
+		$display("  Weight[224] = 0x%06X", weight_ROM[0][224]);
 	end
 	
 endmodule
\ No newline at end of file
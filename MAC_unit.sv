@@ -1,21 +1,36 @@
 `timescale 1ns/1ps
-module MAC_unit(
+module MAC_unit #(
+	parameter A_WIDTH = 22,   // INT16 모드: 16 (16x16 → DSP48 하나)
+	parameter B_WIDTH = 22,
+	parameter MUL_STAGES = 1  // 2: 곱 레지스터 한 단 추가 (22x22는 DSP48 두 개 캐스케이드 → 고속 클럭용), 지연 +1
+)(
 	input logic clk,
 	input logic rst,
 	input logic i_valid,
-	input logic signed [21:0] data_in_a,
-	input logic signed [21:0] data_in_b,
+	input logic signed [A_WIDTH-1:0] data_in_a,
+	input logic signed [B_WIDTH-1:0] data_in_b,
 	input logic signed [47:0] sum_in,
 	output logic o_valid,
 	output logic signed [47:0] sum_out
 );
-	logic signed [21:0] data_a_reg;
-	logic signed [21:0] data_b_reg;
-	logic signed [43:0] mul_result_reg;
+	logic signed [A_WIDTH-1:0] data_a_reg;
+	logic signed [B_WIDTH-1:0] data_b_reg;
+	logic signed [A_WIDTH+B_WIDTH-1:0] mul_result_reg;
 	logic i_valid_d1;
 	logic i_valid_d2;
 	logic signed [47:0] sum_in_d1;
 	logic signed [47:0] sum_in_d2;
+	logic signed [A_WIDTH+B_WIDTH-1:0] mul_result_d3;
+	logic i_valid_d3;
+	logic signed [47:0] sum_in_d3;
+	
+	// 마지막 덧셈 단 입력 (MUL_STAGES = 1이면 d3 레지스터는 쓰이지 않아 합성에서 제거)
+	logic signed [A_WIDTH+B_WIDTH-1:0] mul_tail;
+	logic valid_tail;
+	logic signed [47:0] sum_tail;
+	assign mul_tail   = (MUL_STAGES > 1) ? mul_result_d3 : mul_result_reg;
+	assign valid_tail = (MUL_STAGES > 1) ? i_valid_d3 : i_valid_d2;
+	assign sum_tail   = (MUL_STAGES > 1) ? sum_in_d3 : sum_in_d2;
 	
 	always_ff@(posedge clk or negedge rst) begin 
 		if(!rst) begin  
@@ -28,6 +43,9 @@ module MAC_unit(
 			o_valid <= '0;
 			sum_in_d1 <= '0;
 			sum_in_d2 <= '0;
+			mul_result_d3 <= '0;
+			i_valid_d3 <= '0;
+			sum_in_d3 <= '0;
 		end else begin
 			data_a_reg <= data_in_a;
 			data_b_reg <= data_in_b;
@@ -38,8 +56,12 @@ module MAC_unit(
 			i_valid_d2 <= i_valid_d1;
 			sum_in_d2 <= sum_in_d1;
 			
-			sum_out <= mul_result_reg + sum_in_d2;
-			o_valid <= i_valid_d2;
+			mul_result_d3 <= mul_result_reg;
+			i_valid_d3 <= i_valid_d2;
+			sum_in_d3 <= sum_in_d2;
+			
+			sum_out <= mul_tail + sum_tail;
+			o_valid <= valid_tail;
 		end
 	end
 	
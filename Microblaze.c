@@ -1,42 +1,231 @@
-#include <stdio.h>
-#include "platform.h"
-#include "xil_printf.h"
-#include "xparameters.h"
-#include "xil_io.h"
-#include "xuartlite_l.h"
-#include "sleep.h"
-#include "xil_types.h"
-
-/* ================= UART 설정 ================= */
-#ifndef UARTB
-  #if defined(XPAR_AXI_UARTLITE_1_BASEADDR)
-    #define UARTB XPAR_AXI_UARTLITE_1_BASEADDR
-  #elif defined(XPAR_UARTLITE_1_BASEADDR)
-    #define UARTB XPAR_UARTLITE_1_BASEADDR
-  #else
-    #define UARTB STDIN_BASEADDRESS
-  #endif
-#endif
+#include <stdlib.h>
+#include "hal.h"
+#include "sched.h"
+#include "telem.h"
 
-static inline void uart_putc(char c){ XUartLite_SendByte(UARTB, (u8)c); }
+/* ================= UART (HAL 콘솔) ================= */
+static inline void uart_putc(char c){ hal_uart_putc(c); }
 static void uart_puts(const char *s){ while(*s) uart_putc(*s++); }
-static void uart_flush_rx(void){ while(!XUartLite_IsReceiveEmpty(UARTB)) (void)XUartLite_RecvByte(UARTB); }
+static void uart_flush_rx(void){ hal_uart_flush_rx(); }
 
 /* ================= CNN AXI Lite 레지스터 맵 ================= */
 #define CNN_BASE_ADDR    XPAR_CNN_AXI_LITE_WRAPPER_0_BASEADDR  // Vivado에서 할당될 주소
 
-// AXI Lite 레지스터 오프셋 (CNN_AXI_Lite_Wrapper와 일치)
+// AXI Lite 레지스터 오프셋 (myip_CNN_v1_0_S00_AXI_CNN 레지스터 맵과 일치)
 #define REG_CONTROL      0x00    // 제어 레지스터
-#define REG_STATUS       0x04    // 상태 레지스터
-#define REG_RESULT_LOW   0x08    // CNN 결과 하위 32비트
-#define REG_RESULT_HIGH  0x0C    // CNN 결과 상위 16비트  
-#define REG_FRAME_COUNT  0x10    // 처리된 프레임 수
-#define REG_ERROR_CODE   0x14    // 오류 코드
+#define REG_PIXEL_DATA   0x04    // 픽셀 데이터 레지스터
+#define REG_STATUS       0x08    // 상태 레지스터
+#define REG_RESULT_LOW   0x0C    // CNN 결과 하위 32비트
+#define REG_RESULT_HIGH  0x10    // CNN 결과 상위 16비트  
+#define REG_FRAME_COUNT  0x14    // 처리된 프레임 수
+#define REG_ERROR_CODE   0x18    // [31] 픽셀 FIFO 오버플로, [30] 가중치 FIFO 오버플로, [29] 결과 FIFO 오버플로, [28:0] 타임아웃 수
+#define REG_CLASS        0x1C    // FC argmax 패턴 클래스 (CNN_PATTERN_*)
+#define REG_CLASS_SCORE  0x20    // 최대 클래스 점수
+#define REG_CLASS_MARGIN 0x24    // 1등 - 2등 클래스 점수 차 (신뢰도)
+#define REG_INGEST_STATUS 0x28   // AXI4-Stream 입력: [8:0] FIFO 비트 수, [31:16] 수신 프레임 수
+#define REG_IRQ_ENABLE   0x2C    // 인터럽트 인에이블 (IER)
+#define REG_IRQ_STATUS   0x30    // 인터럽트 상태 (ISR, 1 쓰기로 클리어)
+#define REG_PERF_CTRL    0x34    // 성능 카운터 제어: [0] 스냅샷, [1] 초기화, [12:8] 선택
+#define REG_PERF_DATA    0x38    // 선택된 카운터 스냅샷 값
+#define REG_WEIGHT_ADDR  0x3C    // 가중치 주소: [11:0] 인덱스, [15:12] 뉴런, [16] conv 커널 (쓰기마다 자동 증가)
+#define REG_WEIGHT_DATA  0x40    // 가중치 데이터 (섀도 뱅크에 기록)
+#define REG_WEIGHT_CTRL  0x44    // 쓰기: [0] 뱅크 교체 요청 / 읽기: [0] 교체 중, [1] 활성 뱅크
+#define REG_QUANT_CFG    0x48    // 재양자화: [15:0] scale, [21:16] shift, [31:24] zero point
+#define REG_SEQ_CTRL     0x4C    // 레이어 시퀀서: [0] 활성화, [11:8] 레이어 수
+#define REG_SEQ_ADDR     0x50    // 시퀀서 주소: [12:0] 인덱스, [16] 1 = 가중치 메모리 / 0 = 디스크립터 (자동 증가)
+#define REG_SEQ_DATA     0x54    // 시퀀서 디스크립터/가중치 데이터
+#define REG_SEQ_STATUS   0x58    // 시퀀서 상태: [0] busy, [1] 디스크립터 오류, [2] 프레임 수신 가능, [3] 활성, [7:4] 레이어
+#define REG_GEOMETRY     0x5C    // 프레임: [7:0] 폭, [15:8] 높이, [17:16] log2(stride), [18] same 패딩
+#define REG_PRE_CTRL     0x60    // 전처리: [0] 활성화, [2:1] 포맷, [6:4] dx-1, [10:8] dy-1, [27:16] 원본 폭
+#define REG_PRE_ROI_POS  0x64    // ROI 시작: [11:0] x0, [27:16] y0
+#define REG_PRE_ROI_SIZE 0x68    // ROI 크기: [11:0] 폭, [27:16] 높이
+#define REG_HW_CTRL      0x6C    // 하드웨어 조향 루프: [0] 활성화, [1] 초기화, [12:8] 오차 shift, [23:16] 기본 듀티, [31:24] 최대 조향
+#define REG_HW_KP_KI     0x70    // PID Kp [15:0], Ki [31:16] (signed Q8.8)
+#define REG_HW_KD        0x74    // PID Kd [15:0] (signed Q8.8), [23:16] 결과당 조향 변화 한계
+#define REG_HW_INT_LIMIT 0x78    // PID 적분 한계 [23:0]
+#define REG_HW_STATUS    0x7C    // [7:0] 조향, [14:8] 좌 듀티, [15] 출력 중, [22:16] 우 듀티, [23] 쓰기 중, [31:24] 쓰기 오류
+#define REG_HW_UPDATES   0x80    // 하드웨어가 쓴 PWM 듀티 갱신 수
+#define REG_RF_STATUS    0x84    // 결과 FIFO: [4:0] 대기 엔트리 수, [31:16] 가득 차 버린 결과 수
+#define REG_RF_RESULT_LO 0x88    // 헤드 엔트리 결과 하위 32비트
+#define REG_RF_RESULT_HI 0x8C    // 헤드 엔트리: [15:0] 결과 상위, [17:16] 클래스, [31] 앞에서 결과 버려짐
+#define REG_RF_SEQ       0x90    // 헤드 엔트리 시퀀스 번호 (결과마다 +1, 버린 결과 포함)
+#define REG_RF_TS_FIRST  0x94    // 헤드 엔트리 첫 픽셀 수신 사이클
+#define REG_RF_TS_RESULT 0x98    // 헤드 엔트리 결과 사이클
+#define REG_RF_POP       0x9C    // 쓰기: 헤드 엔트리 제거
+#define REG_CYCLE_NOW    0xA0    // 타임스탬프 사이클 카운터 (s00_axi_cnn_aclk)
+#define REG_FCD_CTRL     0xA4    // 프레임 변화 검출: [0] 활성, [15:8] 연속 생략 한도 (0 = 제한 없음)
+#define REG_FCD_THRESH   0xA8    // 마지막 추론 프레임과의 SAD가 이 값 이하면 추론 생략
+#define REG_FCD_SAD      0xAC    // 마지막 프레임 SAD
+#define REG_FCD_SKIPS    0xB0    // 이전 결과를 재출력한 프레임 수
+#define REG_US_CTRL      0xB4    // 초음파 샘플러: [0] 활성, [2:1] 필터, [15:8] 주기 ms, [25:16] 최대 cm
+#define REG_US_OBST      0xB8    // 장애물 조향: [7:0] 벽 cm, [15:8] 이득, [23:16] 2배 거리 cm
+#define REG_US_DIST      0xBC    // 스냅샷: [9:0] 전방, [19:10] 오른쪽, [29:20] 왼쪽 cm
+#define REG_US_INFO      0xC0    // 스냅샷: [15:0] 장애물 조향 항 (signed), [18:16] 유효, [31:24] 번호
+#define REG_US_TS        0xC4    // 스냅샷 샘플 사이클 (REG_CYCLE_NOW 단위)
+#define REG_US_REJECTS   0xC8    // 범위 밖 / BCD 오류로 버린 샘플 수
+#define REG_TR_CTRL      0xCC    // 지연 기록기: [0] 활성, [1] 지연 / [2] 워치독 / [3] overflow 트리거, [4] 재무장 (쓰기), [15:8] 트리거 후 결과 수
+#define REG_TR_THRESH    0xD0    // 첫 픽셀 → 결과 지연 트리거 임계 (버스 사이클, 0 = 끔)
+#define REG_TR_SEL       0xD4    // [3:0] 워드, [7:4] 엔트리, [8] 이벤트 기록
+#define REG_TR_DATA      0xD8    // 선택한 워드
+#define REG_TR_STATUS    0xDC    // [3:0] 다음 엔트리, [7:4] 트리거 엔트리, [10:8] 다음 이벤트, [12] 트리거, [13] 정지, [23:16] 이벤트 수
+
+// 제어 레지스터 비트 정의
+#define CTRL_CNN_START      (1 << 0)   // CNN 시작
+#define CTRL_CNN_RESET      (1 << 1)   // CNN 리셋
+#define CTRL_STREAM_ENABLE  (1 << 5)   // AXI4-Stream 픽셀 입력 사용 (DMA/CPU 버스트)
 
 // 상태 레지스터 비트 정의
 #define STATUS_CNN_BUSY     (1 << 0)   // CNN 처리 중
 #define STATUS_RESULT_VALID (1 << 1)   // 결과 유효
 #define STATUS_SPI_COMPLETE (1 << 2)   // SPI 프레임 완료
+#define STATUS_FRAME_READY  (1 << 5)   // 다음 프레임 수신 가능 (flatten 쓰기 뱅크 비어 있음)
+#define STATUS_FRAME_TAG(s) (((s) >> 8) & 0xFF)  // 마지막 결과의 프레임 번호
+#define STATUS_QUANT_MODE(s) (((s) >> 16) & 0x3)  // 0 = 22비트, 1 = INT16, 2 = INT8
+
+// 오류 코드 (REG_ERROR_CODE)
+#define ERR_PIX_FIFO_OVF    (1u << 31)  // 코어 픽셀 FIFO에 full 상태로 쓴 적 있음 (CNN 리셋까지 유지)
+#define ERR_WT_FIFO_OVF     (1u << 30)  // 코어 가중치 FIFO 오버플로 (가중치 / 디스크립터 쓰기 유실)
+#define ERR_RES_FIFO_OVF    (1u << 29)  // 코어 결과 FIFO 오버플로 (프레임 결과 유실)
+#define ERR_TIMEOUTS(e)     ((e) & 0x1FFFFFFFu)
+
+// 인터럽트 소스 비트 (IER/ISR 공통)
+#define IRQ_RESULT_DONE     (1 << 0)   // 새 CNN 결과 래치
+#define IRQ_FRAME_READY     (1 << 1)   // 다음 프레임 수신 가능 (상승 에지)
+
+// 성능 카운터 제어 / 인덱스 (cnn_perf_counters와 일치)
+#define PERF_CTRL_SNAPSHOT  (1 << 0)   // 모든 카운터를 한 번에 스냅샷
+#define PERF_CTRL_CLEAR     (1 << 1)   // 누적 카운터 초기화
+#define PERF_CTRL_SEL(i)    (((u32)(i) & 0x1F) << 8)
+#define PERF_STAGE_BUSY(s)  (2 * (s))      // s: 0 ingest, 1 conv, 2 pool, 3 flatten, 4 FC
+#define PERF_STAGE_STALL(s) (2 * (s) + 1)
+#define PERF_LAT_LAST       10
+#define PERF_LAT_MIN        11
+#define PERF_LAT_MAX        12
+#define PERF_FRAMES         13
+#define PERF_TIMEOUTS       14
+#define PERF_CYCLES         15
+#define PERF_FC_CYCLES      16     // 마지막 프레임 FC 사이클 (0인 입력 건너뜀)
+#define PERF_FC_NONZERO     17     // 마지막 프레임 FC가 발행한 입력 수 (zero skip 구성이면 0이 아닌 입력만)
+#define PERF_NUM_STAGES     5
+
+// 가중치 뱅크
+#define WT_ADDR_CONV        (1u << 16)
+#define WT_ADDR_FC(n, k)    ((((u32)(n) & 0xF) << 12) | ((u32)(k) & 0xFFF))
+#define WT_CTRL_SWAP        (1 << 0)
+#define WT_STATUS_BUSY      (1 << 0)
+#define WT_STATUS_BANK      (1 << 1)
+#define WT_SWAP_TIMEOUT_MS  200
+#define WT_FC_NEURONS       5       // Fully_Connected_Layer_Fixed NUM_NEURONS
+#define WT_FC_INPUTS        225     // Fully_Connected_Layer_Fixed NUM_INPUTS
+
+// 레이어 시퀀서 (디스크립터 = 32비트 워드 4개)
+#define SEQ_MAX_LAYERS      8
+#define SEQ_WMEM_WORDS      2048    // 커널 메모리 (cnn_layer_sequencer WMEM_WORDS)
+#define SEQ_CTRL_ENABLE     (1 << 0)
+#define SEQ_CTRL_LAYERS(n)  (((u32)(n) & 0xF) << 8)
+#define SEQ_ADDR_WMEM       (1u << 16)
+#define SEQ_STATUS_BUSY     (1 << 0)
+#define SEQ_STATUS_ERROR    (1 << 1)
+#define SEQ_STATUS_LAYER(s) (((s) >> 4) & 0xF)
+#define SEQ_OP_CONV3X3      0
+#define SEQ_OP_MAXPOOL2X2   1
+#define SEQ_OP_FC           2
+#define SEQ_IDLE_TIMEOUT_MS 200
+
+// 프레임 크기 (합성 최대값 = CNN_TOP_Improved MAX_IMG_WIDTH/HEIGHT, FC 입력 최대 = (최대/2)^2)
+#define GEO_MAX_DIM         32
+#define GEO_MIN_DIM         4
+#define GEO_PAD_SAME        (1u << 18)
+
+// 입력 전처리 (AXI4-Stream 경로 전용, 원본 바이트 → 그레이 → ROI → dx x dy 평균)
+#define PRE_FMT_GRAY8       0
+#define PRE_FMT_RGB888      1
+#define PRE_FMT_RGB565      2
+#define PRE_CTRL_ENABLE     (1u << 0)
+#define PRE_MAX_DECIM       8
+#define PRE_MAX_SRC_DIM     4095
+#define PRE_LINE_BUFFER     64      // image_preprocessor MAX_OUT_WIDTH
+
+// 하드웨어 조향 루프 (CNN 결과 → PID → 좌/우 듀티 → PWM IP, CPU는 감독만)
+#define HW_CTRL_ENABLE      (1u << 0)
+#define HW_CTRL_CLEAR       (1u << 1)
+#define HW_CTRL_ERR_SHIFT   11      // 오차 = 결과 >> 11 (CNN_OUTPUT_SCALE 2048)
+#define HW_STATUS_STEER(s)  ((int)(s8)((s) & 0xFF))
+#define HW_STATUS_DUTY_L(s) (((s) >> 8) & 0x7F)
+#define HW_STATUS_ARMED     (1u << 15)
+#define HW_STATUS_DUTY_R(s) (((s) >> 16) & 0x7F)
+#define HW_STATUS_BUSY      (1u << 23)
+#define HW_STATUS_ERRORS(s) (((s) >> 24) & 0xFF)
+#define HW_KP_Q8            0x0100  // Kp 1.0 (펌웨어 경로와 같은 조향 크기)
+#define HW_KI_Q8            0
+#define HW_KD_Q8            0x0040  // Kd 0.25
+#define HW_STEER_RATE       10      // 결과당 최대 조향 변화
+#define HW_INT_LIMIT        2000
+#define HW_RELEASE_US       200     // PWM 소유권 반환 대기 상한 (진행 중 쓰기 + 정지 쓰기)
+#define HW_WATCHDOG_MS      200     // 이 시간 동안 새 프레임이 없으면 초음파 자율주행으로 전환
+
+// 결과 FIFO / 타임스탬프
+#define RF_LEVEL(s)         ((s) & 0x1F)
+#define RF_DROPS(s)         ((s) >> 16)
+#define RF_HI_CLASS(h)      (((h) >> 16) & 0x3)
+#define RF_HI_REUSED        (1u << 30)
+#define RF_HI_OVERFLOW      (1u << 31)
+#define CNN_CLK_MHZ         100     // 타임스탬프 클럭 (s00_axi_cnn_aclk)
+#define CNN_CORE_MHZ        250     // CNN 코어 클럭 (cnn_core_clk): 지연 / FC 사이클 카운터 단위 (목표값, 구현 클럭과 맞출 것)
+#define CNN_STALE_MS        40      // 결과 생성 후 이보다 오래된 결과는 조향에 쓰지 않음
+
+// 프레임 변화 검출 (스트림 경로)
+#define FCD_CTRL_ENABLE     (1u << 0)
+#define FCD_MAX_SKIP        8       // 연속 생략 후 강제 추론 (조명 변화 등 누적 대비)
+#define FCD_SAD_PER_PIXEL   2       // 임계값 = 픽셀당 평균 차이 x 프레임 픽셀 수
+
+// 초음파 스냅샷 (하드웨어 샘플링 / 필터)
+#define US_CTRL_ENABLE      (1u << 0)
+#define US_FILTER_LATEST    0
+#define US_FILTER_AVG       1       // 유효 샘플 평균 (기존 ULTRA_TAPS 3 소프트웨어 필터와 같음)
+#define US_FILTER_MEDIAN    2
+#define US_CTRL(filter, period_ms, max_cm) \
+    (US_CTRL_ENABLE | (((u32)(filter) & 0x3) << 1) | (((u32)(period_ms) & 0xFF) << 8) | (((u32)(max_cm) & 0x3FF) << 16))
+#define US_DIST_CM(d, ch)   (((d) >> (10 * (ch))) & 0x3FF)
+#define US_INFO_OBST(i)     ((int)(s16)((i) & 0xFFFF))
+#define US_INFO_SEQ(i)      ((i) >> 24)
+#define US_PERIOD_MS        5       // 센서 태스크 주기
+#define US_MAX_CM           400
+#define US_STALE_MS         50      // 이 시간 동안 새 스냅샷이 없으면 센서 IP 직접 읽기로
+
+// 프레임별 지연 기록기 (최근 16프레임 + 이벤트 8개)
+#define TR_CTRL_ENABLE      (1u << 0)
+#define TR_CTRL_TRIG_LAT    (1u << 1)
+#define TR_CTRL_TRIG_WDT    (1u << 2)
+#define TR_CTRL_TRIG_OVF    (1u << 3)
+#define TR_CTRL_REARM       (1u << 4)
+#define TR_CTRL_POST(n)     (((u32)(n) & 0xFF) << 8)
+#define TR_SEL(entry, word) ((((u32)(entry) & 0xF) << 4) | ((u32)(word) & 0xF))
+#define TR_SEL_EV(idx, word) (0x100u | TR_SEL(idx, word))
+#define TR_STATUS_NEXT(s)   ((s) & 0xF)
+#define TR_STATUS_TRIG(s)   (((s) >> 4) & 0xF)
+#define TR_STATUS_EV_NEXT(s) (((s) >> 8) & 0x7)
+#define TR_STATUS_TRIGGERED (1u << 12)
+#define TR_STATUS_FROZEN    (1u << 13)
+#define TR_STATUS_EVENTS(s) (((s) >> 16) & 0xFF)
+#define TR_F_VALID          (1u << 7)
+#define TR_F_TRIGGER        (1u << 6)
+#define TR_F_RESULT         (1u << 5)
+#define TR_F_SEQ            (1u << 4)
+#define TR_F_READ           (1u << 3)
+#define TR_F_OVERFLOW       (1u << 2)
+#define TR_F_WATCHDOG       (1u << 1)
+#define TR_F_REUSED         (1u << 0)
+#define TR_ENTRIES          16
+#define TR_EVENTS           8
+#define TR_FREEZE_MS        20      // 첫 픽셀 → 결과가 제어 주기를 넘는 프레임에서 트리거
+#define TR_POST             4       // 트리거 후 기록할 결과 수 (앞뒤 문맥)
+#define TR_HIST_BINS        16      // log2 us 구간: [0,2) [2,4) ... [32768,)
+
+/* ================= 인터럽트 설정 (INTC는 HAL이 소유) ================= */
+#ifndef CNN_IRQ_ID
+  #define CNN_IRQ_ID XPAR_MICROBLAZE_0_AXI_INTC_MYIP_CNN_0_O_CNN_INTERRUPT_INTR
+#endif
 
 /* ================= PWM 및 초음파 설정 (기존 유지) ================= */
 #define PWM_BASE   XPAR_DCMOTOR_MYIP_V1_0_BASEADDR
@@ -52,6 +241,9 @@ static void uart_flush_rx(void){ while(!XUartLite_IsReceiveEmpty(UARTB)) (void)X
 #define CNN_TIMEOUT_MS      100     // CNN 결과 대기 최대 시간
 #define CNN_OUTPUT_SCALE    2048    // 추출된 가중치 기반 스케일링
 #define CNN_STEER_MAX       80      // 최대 조향각
+#define CNN_REQUANT_SCALE   1       // INT8/INT16 재양자화 배율 (scale / 2^shift)
+#define CNN_REQUANT_SHIFT_INT8  3   // Sobel+pool 출력 0~1020 → INT8 0~127
+#define CNN_REQUANT_SHIFT_INT16 0
 
 /* CNN 패턴 정의 */
 #define CNN_PATTERN_STRAIGHT    0
@@ -80,6 +272,7 @@ static void uart_flush_rx(void){ while(!XUartLite_IsReceiveEmpty(UARTB)) (void)X
 #define FRONT_SLOW2_PCT 30
 #define BACKUP_MS      800
 #define BACKUP_PCT      55
+#define SPIN_MS       1000      // 비상 후진 뒤 회전 시간
 
 /* ================= 채널/차륜 매핑 (기존 유지) ================= */
 #define CH_FR 0
@@ -99,43 +292,597 @@ static int  cnn_pattern = -1;
 static int  cnn_timeout_count = 0;
 static int prev_dutyL = -1, prev_dutyR = -1;
 
+/* 킥 (저속 출발 보조): 대기 대신 종료 시각을 기록하고 모터 태스크가 목표 듀티로 전환 */
+static int kick_active = 0;
+static u32 kick_end_us = 0;
+static u8  kick_dir = 0;
+static u8  kick_target[4];
+
+/* 비상 회피: 후진 → 회전 → 전진을 제어 태스크 주기마다 한 단계씩 (UART 처리 계속) */
+enum { AUTO_RUN, AUTO_BACKUP, AUTO_SPIN };
+static int auto_phase = AUTO_RUN;
+static u32 auto_phase_end_us = 0;
+static int auto_left_more = 0;
+
+/* 센서 태스크가 갱신하는 초음파 이동 평균 (cm, 0 = 유효 샘플 없음) */
+#define ULTRA_TAPS 3
+enum { US_F, US_R, US_L, US_NUM };
+static u32 ultra_hist[US_NUM][ULTRA_TAPS];
+static int ultra_pos = 0;
+static u32 ultra_cm[US_NUM];
+
+/* 하드웨어 스냅샷: 번호가 바뀌는 동안만 사용 (이전 비트스트림 / 샘플러 정지 → 소프트웨어 필터) */
+static int us_hw_ok = 0;                  // US_CTRL 쓰기 후 읽기 일치
+static int us_hw_fresh = 0;               // 이번 센서 주기에 스냅샷 사용
+static u32 us_last_seq = 0;
+static u32 us_seq_seen_us = 0;
+static int us_seq_seen = 0;
+static int ultra_obst = 0;                // 하드웨어가 계산한 장애물 조향 항 (us_hw_fresh일 때)
+
+/* CNN 태스크 → 제어 태스크: 마지막 제어 주기 이후 새 조향 결과 */
+static s32 cnn_new_steer = 0;
+static int cnn_new_valid = 0;
+static u32 cnn_new_ts = 0;                // 결과 사이클 (오래된 결과 판정)
+
+/* ================= CNN 결과 메일박스 (ISR → 제어 루프) =================
+ * 단일 생산자(ISR) / 단일 소비자(main) 링 버퍼. 락 없이 동작:
+ *   - ISR만 head를, main만 tail을 갱신
+ *   - 슬롯을 먼저 채우고 head를 나중에 올림 (volatile 순서 보장)
+ * ISR은 하드웨어 결과 FIFO를 한 번에 비워 넣음 (크기 = FIFO 깊이)
+ * 가득 차면 새 결과를 버리고 drops를 증가 (시퀀스 공백으로도 드러남) */
+#define CNN_MBOX_SIZE 16  // 2의 거듭제곱, cnn_result_fifo DEPTH
+#define CNN_MBOX_MASK (CNN_MBOX_SIZE - 1)
+
+typedef struct {
+    u32 result_low;
+    u32 result_high;  // [15:0]만 결과
+    u32 class_id;
+    u32 seq;          // 결과 시퀀스 번호
+    u32 ts_first;     // 첫 픽셀 수신 사이클
+    u32 ts_result;    // 결과 사이클
+    u32 overflow;     // 1 = 이 결과 앞에서 하드웨어 FIFO가 결과를 버림
+    u32 reused;       // 1 = 프레임 변화 없음, 이전 추론 결과 재출력
+} CnnResult;
+
+static volatile CnnResult cnn_mbox[CNN_MBOX_SIZE];
+static volatile u32 cnn_mbox_head = 0;    // ISR만 씀
+static volatile u32 cnn_mbox_tail = 0;    // main만 씀
+static volatile u32 cnn_mbox_drops = 0;
+static volatile u32 cnn_irq_count = 0;
+
+static int cnn_irq_ok = 0;                // 0이면 CNN 태스크에서 ISR 폴링
+
+/* 메일박스 소비 통계 (main만 씀) */
+static u32 cnn_seq_next = 0;
+static int cnn_seq_synced = 0;
+static u32 cnn_seq_lost = 0;              // 시퀀스 공백 (하드웨어 FIFO 또는 메일박스에서 버려진 결과)
+static u32 cnn_lat_last_cyc = 0;          // 첫 픽셀 → 결과
+static u32 cnn_lat_max_cyc = 0;
+static u32 cnn_burst_max = 0;             // 한 번에 비운 결과 수 최대
+static u32 cnn_stale_count = 0;           // 오래되어 조향에 쓰지 않은 결과
+static u32 cnn_reused_count = 0;          // 재출력 결과 (추론 생략 프레임)
+
+/* 하드웨어 조향 루프: 켜져 있는 동안 PWM IP는 하드웨어가 소유 (CPU 모터 쓰기 전에 반환) */
+static int hw_loop_on = 0;
+static u32 hw_loop_ctrl = 0;              // 마지막으로 쓴 HW_CTRL (같은 값 재쓰기 생략)
+static u32 hw_last_frames = 0;
+static u32 hw_frame_seen_us = 0;
+
+/* 바이너리 텔레메트리 (telem.h): 제어 주기마다 기록 한 개를 송신 링에 넣고 TX 인터럽트가 전송 */
+static int telem_stream_on = 0;
+static u8  telem_decim = 1;               // 제어 주기 N번에 기록 한 개
+static u8  telem_decim_cnt = 0;
+static u16 telem_seq = 0;
+static u8  telem_flags = 0;               // 이번 제어 주기 이벤트 (TELEM_F_*)
+static u32 telem_cnn_age_us = 0;          // 이번 주기에 사용한 결과의 경과 시간
+static TelemParser cmd_parser;            // UART 수신: 명령 프레임 (프레임 밖 바이트는 텍스트 키)
+
 /* ================= AXI Lite 헬퍼 함수 ================= */
 
 /**
  * AXI Lite 레지스터 읽기
  */
 static inline u32 axi_read_reg(u32 offset) {
-    return Xil_In32(CNN_BASE_ADDR + offset);
+    return hal_read32(CNN_BASE_ADDR + offset);
 }
 
 /**
  * AXI Lite 레지스터 쓰기
  */
 static inline void axi_write_reg(u32 offset, u32 value) {
-    Xil_Out32(CNN_BASE_ADDR + offset, value);
+    hal_write32(CNN_BASE_ADDR + offset, value);
 }
 
 /**
- * CNN 상태 확인
+ * 처리된 프레임 수 읽기
  */
-static int cnn_is_busy(void) {
-    u32 status = axi_read_reg(REG_STATUS);
-    return (status & STATUS_CNN_BUSY) ? 1 : 0;
+static u32 cnn_get_frame_count(void) {
+    return axi_read_reg(REG_FRAME_COUNT);
 }
 
+/* ================= CNN 인터럽트 / 메일박스 ================= */
+
 /**
- * CNN 결과 유효성 확인
+ * CNN 인터럽트 서비스 루틴
+ * 하드웨어 결과 FIFO를 메일박스로 비운 뒤 처리한 ISR 비트만 클리어
+ * (클리어 전에 도착한 결과는 FIFO에 남아 다음 인터럽트에서 함께 처리)
  */
-static int cnn_result_available(void) {
-    u32 status = axi_read_reg(REG_STATUS);
-    return (status & STATUS_RESULT_VALID) ? 1 : 0;
+static void cnn_isr(void *ref) {
+    (void)ref;
+    u32 pending = axi_read_reg(REG_IRQ_STATUS);
+    if (pending == 0) return;
+
+    // W1C 먼저: 비우는 중 도착한 결과는 새 인터럽트로 남음
+    axi_write_reg(REG_IRQ_STATUS, pending);
+
+    if (pending & IRQ_RESULT_DONE) {
+        u32 level = RF_LEVEL(axi_read_reg(REG_RF_STATUS));
+        for (u32 i = 0; i < level; i++) {
+            u32 head = cnn_mbox_head;
+            if ((head - cnn_mbox_tail) < CNN_MBOX_SIZE) {
+                volatile CnnResult *slot = &cnn_mbox[head & CNN_MBOX_MASK];
+                u32 hi = axi_read_reg(REG_RF_RESULT_HI);
+                slot->result_low  = axi_read_reg(REG_RF_RESULT_LO);
+                slot->result_high = hi & 0xFFFF;
+                slot->class_id    = RF_HI_CLASS(hi);
+                slot->overflow    = (hi & RF_HI_OVERFLOW) ? 1 : 0;
+                slot->reused      = (hi & RF_HI_REUSED) ? 1 : 0;
+                slot->seq         = axi_read_reg(REG_RF_SEQ);
+                slot->ts_first    = axi_read_reg(REG_RF_TS_FIRST);
+                slot->ts_result   = axi_read_reg(REG_RF_TS_RESULT);
+                cnn_mbox_head = head + 1;   // 슬롯 기록 후 공개
+            } else {
+                cnn_mbox_drops++;
+            }
+            axi_write_reg(REG_RF_POP, 1);
+        }
+    }
+    cnn_irq_count++;
 }
 
 /**
- * 처리된 프레임 수 읽기
+ * 메일박스의 결과를 모두 꺼내 시퀀스 공백 / 첫 픽셀 → 결과 지연을 집계하고 가장 최근 결과 반환
+ * 반환: 꺼낸 결과 수 (0 = 없음)
  */
-static u32 cnn_get_frame_count(void) {
-    return axi_read_reg(REG_FRAME_COUNT);
+static u32 cnn_mbox_drain(CnnResult *out) {
+    u32 head = cnn_mbox_head;
+    u32 tail = cnn_mbox_tail;
+    u32 n = head - tail;
+    if (n == 0) return 0;
+
+    for (; tail != head; tail++) {
+        volatile CnnResult *slot = &cnn_mbox[tail & CNN_MBOX_MASK];
+        if (cnn_seq_synced && slot->seq != cnn_seq_next) cnn_seq_lost += slot->seq - cnn_seq_next;
+        cnn_seq_next = slot->seq + 1;
+        cnn_seq_synced = 1;
+        cnn_lat_last_cyc = slot->ts_result - slot->ts_first;
+        if (cnn_lat_last_cyc > cnn_lat_max_cyc) cnn_lat_max_cyc = cnn_lat_last_cyc;
+        if (slot->reused) cnn_reused_count++;
+    }
+
+    volatile CnnResult *last = &cnn_mbox[(head - 1) & CNN_MBOX_MASK];
+    out->result_low  = last->result_low;
+    out->result_high = last->result_high;
+    out->class_id    = last->class_id;
+    out->seq         = last->seq;
+    out->ts_first    = last->ts_first;
+    out->ts_result   = last->ts_result;
+    out->overflow    = last->overflow;
+    out->reused      = last->reused;
+    cnn_mbox_tail = head;   // 슬롯 복사 후 반환
+    if (n > cnn_burst_max) cnn_burst_max = n;
+    return n;
+}
+
+/**
+ * 결과 사이클 이후 경과 시간 (us)
+ */
+static u32 cnn_result_age_us(u32 ts_result) {
+    return (axi_read_reg(REG_CYCLE_NOW) - ts_result) / CNN_CLK_MHZ;
+}
+
+/**
+ * CNN 인터럽트를 HAL 인터럽트 컨트롤러에 연결
+ * 실패하면 CNN 태스크가 cnn_isr()를 직접 폴링 (동일한 W1C 경로)
+ */
+static void cnn_irq_init(void) {
+    axi_write_reg(REG_IRQ_ENABLE, 0);
+    axi_write_reg(REG_IRQ_STATUS, 0xFFFFFFFF);   // 잔여 이벤트 클리어
+
+    cnn_irq_ok = (hal_irq_connect(CNN_IRQ_ID, cnn_isr, NULL) == 0);
+    if (!cnn_irq_ok) xil_printf("[CNN] IRQ 연결 실패 → 폴링 모드\r\n");
+
+    axi_write_reg(REG_IRQ_ENABLE, IRQ_RESULT_DONE);
+    xil_printf("[CNN] 결과 통지: %s\r\n", cnn_irq_ok ? "인터럽트" : "폴링");
+}
+
+/* ================= 성능 카운터 ================= */
+
+/**
+ * 스냅샷된 카운터 하나 읽기 (cnn_perf_snapshot 이후 호출)
+ */
+static u32 cnn_perf_read(int idx) {
+    axi_write_reg(REG_PERF_CTRL, PERF_CTRL_SEL(idx));
+    return axi_read_reg(REG_PERF_DATA);
+}
+
+static void cnn_perf_snapshot(void) {
+    axi_write_reg(REG_PERF_CTRL, PERF_CTRL_SNAPSHOT);
+}
+
+static void cnn_perf_clear(void) {
+    axi_write_reg(REG_PERF_CTRL, PERF_CTRL_CLEAR);
+    xil_printf("[CNN_PERF] 카운터 초기화\r\n");
+}
+
+/**
+ * 단계별 busy/stall 비율과 프레임 지연 출력
+ */
+static void cnn_perf_report(void) {
+    static const char *stage_names[PERF_NUM_STAGES] = {"ingest", "conv", "pool", "flatten", "fc"};
+
+    cnn_perf_snapshot();
+    u32 cycles = cnn_perf_read(PERF_CYCLES);
+    u32 frames = cnn_perf_read(PERF_FRAMES);
+
+    xil_printf("[CNN_PERF] %lu cycles, %lu frames, %lu timeouts\r\n",
+               (unsigned long)cycles, (unsigned long)frames, (unsigned long)cnn_perf_read(PERF_TIMEOUTS));
+    for (int s = 0; s < PERF_NUM_STAGES; s++) {
+        u32 busy  = cnn_perf_read(PERF_STAGE_BUSY(s));
+        u32 stall = cnn_perf_read(PERF_STAGE_STALL(s));
+        u32 busy_pct  = cycles ? (u32)(((u64)busy  * 100) / cycles) : 0;
+        u32 stall_pct = cycles ? (u32)(((u64)stall * 100) / cycles) : 0;
+        xil_printf("[CNN_PERF] %-8s busy %10lu (%3lu%%)  stall %10lu (%3lu%%)\r\n", stage_names[s],
+                   (unsigned long)busy, (unsigned long)busy_pct, (unsigned long)stall, (unsigned long)stall_pct);
+    }
+    if (frames) {
+        u32 lat_last = cnn_perf_read(PERF_LAT_LAST);
+        xil_printf("[CNN_PERF] latency last %lu (%lu us), min %lu, max %lu core cycles\r\n",
+                   (unsigned long)lat_last, (unsigned long)(lat_last / CNN_CORE_MHZ),
+                   (unsigned long)cnn_perf_read(PERF_LAT_MIN), (unsigned long)cnn_perf_read(PERF_LAT_MAX));
+        xil_printf("[CNN_PERF] fc last %lu core cycles, %lu inputs issued\r\n",
+                   (unsigned long)cnn_perf_read(PERF_FC_CYCLES), (unsigned long)cnn_perf_read(PERF_FC_NONZERO));
+    } else {
+        xil_printf("[CNN_PERF] latency: 완료된 프레임 없음\r\n");
+    }
+}
+
+/* ================= 프레임별 지연 기록기 =================
+ * 하드웨어가 최근 16프레임의 단계 시각을 계속 기록하다가 트리거 (지연 임계 초과 / 워치독)
+ * 뒤 TR_POST개 결과를 더 기록하고 정지한다. 'J'로 덤프 후 재무장. */
+
+static void cnn_trace_init(void) {
+    axi_write_reg(REG_TR_THRESH, (u32)TR_FREEZE_MS * 1000 * CNN_CLK_MHZ);
+    axi_write_reg(REG_TR_CTRL, TR_CTRL_ENABLE | TR_CTRL_TRIG_LAT | TR_CTRL_TRIG_WDT | TR_CTRL_POST(TR_POST) | TR_CTRL_REARM);
+}
+
+static u32 cnn_trace_read(u32 sel) {
+    axi_write_reg(REG_TR_SEL, sel);
+    return axi_read_reg(REG_TR_DATA);
+}
+
+static int trace_bin(u32 us) {
+    int b = 0;
+    while ((us >> 1) && b < TR_HIST_BINS - 1) { us >>= 1; b++; }
+    return b;
+}
+
+static void trace_hist_print(const char *name, const u16 *hist) {
+    xil_printf("[TRACE] %s\r\n", name);
+    for (int b = 0; b < TR_HIST_BINS; b++) {
+        if (!hist[b]) continue;
+        char bar[TR_ENTRIES + 1];
+        int n = hist[b] > TR_ENTRIES ? TR_ENTRIES : hist[b];
+        for (int i = 0; i < n; i++) bar[i] = '#';
+        bar[n] = '\0';
+        xil_printf("[TRACE]   %6lu us+ |%-16s %u\r\n", (unsigned long)(b ? (1u << b) : 0), bar, (unsigned)hist[b]);
+    }
+}
+
+/**
+ * 기록된 프레임 (오래된 것부터), 지연 히스토그램, 이벤트 출력
+ * 덤프 중에는 기록을 멈추고, 끝나면 설정을 되돌리며 재무장
+ */
+static void cnn_trace_dump(void) {
+    static const char *ev_names[4] = {"?", "WATCHDOG", "OVERFLOW", "LATENCY"};
+    u16 hist_result[TR_HIST_BINS] = {0};
+    u16 hist_read[TR_HIST_BINS] = {0};
+    u32 ctrl = axi_read_reg(REG_TR_CTRL);
+    axi_write_reg(REG_TR_CTRL, ctrl & ~TR_CTRL_ENABLE);
+    u32 st = axi_read_reg(REG_TR_STATUS);
+
+    xil_printf("[TRACE] %s, trigger entry %lu, threshold %lu us, %lu events\r\n",
+               (st & TR_STATUS_FROZEN) ? "FROZEN" : ((st & TR_STATUS_TRIGGERED) ? "TRIGGERED" : "RECORDING"),
+               (unsigned long)TR_STATUS_TRIG(st), (unsigned long)(axi_read_reg(REG_TR_THRESH) / CNN_CLK_MHZ),
+               (unsigned long)TR_STATUS_EVENTS(st));
+    xil_printf("[TRACE]  #  seq   last  result    read | feat  flat fc_in fc_done (us)  flags\r\n");
+    int frames = 0;
+    for (int i = 0; i < TR_ENTRIES; i++) {
+        int e = (TR_STATUS_NEXT(st) + i) % TR_ENTRIES;
+        u32 f = cnn_trace_read(TR_SEL(e, 8));
+        if (!(f & TR_F_VALID)) continue;
+        u32 d_last   = cnn_trace_read(TR_SEL(e, 1)) / CNN_CLK_MHZ;
+        u32 d_result = cnn_trace_read(TR_SEL(e, 2)) / CNN_CLK_MHZ;
+        u32 d_read   = cnn_trace_read(TR_SEL(e, 3)) / CNN_CLK_MHZ;
+        u32 t_core[4];
+        for (int w = 0; w < 4; w++) t_core[w] = cnn_trace_read(TR_SEL(e, 4 + w)) / CNN_CORE_MHZ;
+        frames++;
+        if (f & TR_F_RESULT) {
+            hist_result[trace_bin(d_result)]++;
+            if (f & TR_F_READ) hist_read[trace_bin(d_read - d_result)]++;
+        }
+        xil_printf("[TRACE] %2d %5lu %6lu %7lu %7lu | %5lu %5lu %5lu %7lu  %s%s%s%s%s%s\r\n", e,
+                   (unsigned long)(f >> 16), (unsigned long)d_last,
+                   (unsigned long)((f & TR_F_RESULT) ? d_result : 0), (unsigned long)((f & TR_F_READ) ? d_read : 0),
+                   (unsigned long)t_core[0], (unsigned long)t_core[1], (unsigned long)t_core[2], (unsigned long)t_core[3],
+                   (f & TR_F_TRIGGER) ? "*TRIG " : "", (f & TR_F_WATCHDOG) ? "WDT " : "",
+                   (f & TR_F_OVERFLOW) ? "OVF " : "", (f & TR_F_REUSED) ? "REUSED " : "",
+                   (f & TR_F_SEQ) ? "SEQ " : "", (f & TR_F_RESULT) ? "" : "NO-RESULT");
+    }
+    if (frames) {
+        trace_hist_print("first pixel -> result", hist_result);
+        trace_hist_print("result -> software read", hist_read);
+    } else {
+        xil_printf("[TRACE] 기록된 프레임 없음\r\n");
+    }
+
+    u32 n_ev = TR_STATUS_EVENTS(st) < TR_EVENTS ? TR_STATUS_EVENTS(st) : TR_EVENTS;
+    for (u32 i = 0; i < n_ev; i++) {
+        u32 idx = (TR_STATUS_EV_NEXT(st) + TR_EVENTS - n_ev + i) % TR_EVENTS;
+        u32 ts = cnn_trace_read(TR_SEL_EV(idx, 0));
+        u32 info = cnn_trace_read(TR_SEL_EV(idx, 1));
+        xil_printf("[TRACE] event %-8s cycle %10lu, entry %lu, result #%lu\r\n", ev_names[(info >> 24) & 0x3],
+                   (unsigned long)ts, (unsigned long)((info >> 16) & 0xFF), (unsigned long)(info & 0xFFFF));
+    }
+
+    axi_write_reg(REG_TR_CTRL, ctrl | TR_CTRL_REARM);
+}
+
+/* ================= 런타임 가중치 로드 (이중 뱅크) =================
+ * 쓰기는 항상 섀도 뱅크로 가고, 추론은 활성 뱅크로 계속 진행된다.
+ * 교체 요청은 다음 프레임 시작 시점에 적용되며, 이전 뱅크를 쓰는 프레임이
+ * 모두 끝날 때까지 BUSY가 유지된다 (그동안 섀도 뱅크 쓰기 금지). */
+
+static int cnn_weights_wait_idle(void) {
+    for (int ms = 0; ms < WT_SWAP_TIMEOUT_MS; ms++) {
+        if (!(axi_read_reg(REG_WEIGHT_CTRL) & WT_STATUS_BUSY)) return 1;
+        hal_delay_us(1000);
+    }
+    xil_printf("[CNN_WT] 뱅크 교체 대기 타임아웃\r\n");
+    return 0;
+}
+
+/**
+ * conv 3x3 커널을 섀도 뱅크에 쓰기 (행 우선 9개)
+ */
+static int cnn_load_conv_kernel(const s8 kernel[9]) {
+    if (!cnn_weights_wait_idle()) return 0;
+    axi_write_reg(REG_WEIGHT_ADDR, WT_ADDR_CONV);
+    for (int i = 0; i < 9; i++) axi_write_reg(REG_WEIGHT_DATA, (u32)(s32)kernel[i]);
+    return 1;
+}
+
+/**
+ * FC 뉴런 하나의 가중치 [index, index + count)를 섀도 뱅크에 쓰기 (22비트 부호 있는 값)
+ */
+static int cnn_load_fc_weights(int neuron, int index, const s32 *weights, int count) {
+    if (neuron < 0 || neuron >= WT_FC_NEURONS || index < 0 || count < 1 ||
+        index + count > WT_FC_INPUTS || !cnn_weights_wait_idle()) return 0;
+    axi_write_reg(REG_WEIGHT_ADDR, WT_ADDR_FC(neuron, index));
+    for (int k = 0; k < count; k++) axi_write_reg(REG_WEIGHT_DATA, (u32)weights[k]);
+    return 1;
+}
+
+/**
+ * 섀도 뱅크를 활성화 (다음 프레임부터 적용, 추론 정지 없음)
+ */
+static void cnn_weights_swap(void) {
+    axi_write_reg(REG_WEIGHT_CTRL, WT_CTRL_SWAP);
+    if (cnn_weights_wait_idle()) {
+        xil_printf("[CNN_WT] 활성 뱅크 %lu\r\n",
+                   (unsigned long)((axi_read_reg(REG_WEIGHT_CTRL) & WT_STATUS_BANK) ? 1 : 0));
+    }
+}
+
+/**
+ * conv 커널 프리셋 교대 로드 (Sobel X ↔ Sobel Y) 후 교체
+ */
+static void cnn_kernel_toggle(void) {
+    static const s8 sobel_x[9] = { 1, 0, -1,  2, 0, -2,  1,  0, -1 };
+    static const s8 sobel_y[9] = { 1, 2,  1,  0, 0,  0, -1, -2, -1 };
+    static int use_y = 0;
+
+    use_y = !use_y;
+    if (cnn_load_conv_kernel(use_y ? sobel_y : sobel_x)) {
+        xil_printf("[CNN_WT] conv 커널: Sobel %s\r\n", use_y ? "Y" : "X");
+        cnn_weights_swap();
+    }
+}
+
+/**
+ * Feature → FC 경계 재양자화 설정 (실수 배율 = scale / 2^shift, 다음 프레임부터 적용)
+ * QUANT_MODE = 0(22비트)으로 합성된 경우 하드웨어가 무시
+ */
+static void cnn_set_requant(u16 scale, u8 shift, s8 zero_point) {
+    axi_write_reg(REG_QUANT_CFG, ((u32)(u8)zero_point << 24) | ((u32)(shift & 0x3F) << 16) | scale);
+}
+
+/**
+ * 프레임 크기 / stride / 패딩 설정 (다음 프레임부터 적용, 해상도 ↔ 프레임률 절충)
+ * FC 입력 수 = floor(conv 출력 / 2)^2 로 바뀌므로 크기에 맞는 FC 가중치를 함께 로드해야 함
+ * 반환: FC 입력 수 (범위 밖이면 0, 레지스터 변경 없음)
+ */
+static int cnn_set_geometry(int width, int height, int stride_log2, int same_pad) {
+    if (width < GEO_MIN_DIM || width > GEO_MAX_DIM || height < GEO_MIN_DIM || height > GEO_MAX_DIM ||
+        stride_log2 < 0 || stride_log2 > 2) return 0;
+
+    int cw = ((same_pad ? width  : width  - 2) + (1 << stride_log2) - 1) >> stride_log2;
+    int ch = ((same_pad ? height : height - 2) + (1 << stride_log2) - 1) >> stride_log2;
+    int fc_inputs = (cw / 2) * (ch / 2);
+    if (fc_inputs == 0) return 0;
+
+    axi_write_reg(REG_GEOMETRY, (u32)width | ((u32)height << 8) | ((u32)stride_log2 << 16) |
+                                (same_pad ? GEO_PAD_SAME : 0));
+    xil_printf("[CNN] 프레임 %dx%d, stride %d, %s 패딩 → FC 입력 %d\r\n",
+               width, height, 1 << stride_log2, same_pad ? "same" : "valid", fc_inputs);
+    return fc_inputs;
+}
+
+/**
+ * 카메라 원본 프레임을 CNN 입력 크기로 줄이는 전처리 설정 (다음 스트림 프레임부터 적용)
+ * 출력 = (roi_w / dx) x (roi_h / dy), 나머지 행/열은 버림 → 같은 크기로 cnn_set_geometry 필요
+ * dx = 0이면 전처리 끄기 (바이트 = 픽셀 그대로)
+ * 반환: 출력 폭 | (출력 높이 << 8) (범위 밖이면 0, 레지스터 변경 없음)
+ */
+static u32 cnn_set_preproc(int format, int src_width, int x0, int y0, int roi_w, int roi_h, int dx, int dy) {
+    if (dx == 0) {
+        axi_write_reg(REG_PRE_CTRL, axi_read_reg(REG_PRE_CTRL) & ~PRE_CTRL_ENABLE);
+        return 0;
+    }
+    if (format < PRE_FMT_GRAY8 || format > PRE_FMT_RGB565 || dx < 1 || dx > PRE_MAX_DECIM ||
+        dy < 1 || dy > PRE_MAX_DECIM || src_width < 1 || src_width > PRE_MAX_SRC_DIM ||
+        x0 < 0 || y0 < 0 || roi_w < dx || roi_h < dy || x0 + roi_w > src_width ||
+        y0 + roi_h > PRE_MAX_SRC_DIM) return 0;
+
+    int out_w = roi_w / dx;
+    int out_h = roi_h / dy;
+    if (out_w > PRE_LINE_BUFFER || out_w > GEO_MAX_DIM || out_h > GEO_MAX_DIM) return 0;
+
+    axi_write_reg(REG_PRE_ROI_POS, (u32)x0 | ((u32)y0 << 16));
+    axi_write_reg(REG_PRE_ROI_SIZE, (u32)roi_w | ((u32)roi_h << 16));
+    axi_write_reg(REG_PRE_CTRL, PRE_CTRL_ENABLE | ((u32)format << 1) | ((u32)(dx - 1) << 4) |
+                                ((u32)(dy - 1) << 8) | ((u32)src_width << 16));
+    xil_printf("[CNN] 전처리: 원본 폭 %d, ROI (%d,%d) %dx%d, %dx%d 평균 → %dx%d\r\n",
+               src_width, x0, y0, roi_w, roi_h, dx, dy, out_w, out_h);
+    return (u32)out_w | ((u32)out_h << 8);
+}
+
+/* ================= 레이어 시퀀서 ================= */
+/* 디스크립터 표에 적힌 레이어를 코어의 conv/pool/FC 엔진으로 차례로 실행 (레이어 사이 CPU 개입 없음).
+ * SEQ_CTRL[0] = 1이면 카메라 프레임이 고정 파이프라인 대신 시퀀서로 들어가고,
+ * 마지막 레이어 출력 0~4가 기존 RESULT/CLASS 레지스터로 나온다 (지연은 코어 클럭 사이클).
+ * 커널 메모리에는 conv 커널만, FC 레이어는 코어 FC 가중치 뱅크의 뉴런 0~out_c-1을 쓴다
+ * (입력 최대 WT_FC_INPUTS, 출력 최대 WT_FC_NEURONS). */
+
+typedef struct {
+    u8  op;            // SEQ_OP_*
+    u8  relu;
+    u8  in_shift;      // 22비트 입력 → conv 8비트 픽셀 / FC 활성값 시프트
+    u8  out_shift;     // 누적값 → 22비트 저장 시프트
+    u8  in_w, in_h, in_c, out_c;
+    u16 weight_base;   // conv 커널 메모리 워드 주소 (FC는 무시)
+} CnnLayerDesc;
+
+static int cnn_seq_wait_idle(void) {
+    for (int ms = 0; ms < SEQ_IDLE_TIMEOUT_MS; ms++) {
+        if (!(axi_read_reg(REG_SEQ_STATUS) & SEQ_STATUS_BUSY)) return 1;
+        hal_delay_us(1000);
+    }
+    xil_printf("[CNN_SEQ] idle 대기 타임아웃\r\n");
+    return 0;
+}
+
+/**
+ * 레이어 표 쓰기 (출력 크기는 op에서 계산해 함께 기록 → 하드웨어가 검증)
+ * first부터 count개를 쓰고 레이어 수 = first + count (긴 네트워크는 나눠서 씀)
+ */
+static int cnn_seq_load_network(const CnnLayerDesc *layers, int first, int count) {
+    if (first < 0 || count < 1 || first + count > SEQ_MAX_LAYERS || !cnn_seq_wait_idle()) return 0;
+    axi_write_reg(REG_SEQ_ADDR, (u32)first * 4);
+    for (int i = 0; i < count; i++) {
+        const CnnLayerDesc *l = &layers[i];
+        u32 out_w = 1, out_h = 1;
+        if (l->op == SEQ_OP_CONV3X3)        { out_w = l->in_w - 2;  out_h = l->in_h - 2; }
+        else if (l->op == SEQ_OP_MAXPOOL2X2) { out_w = l->in_w / 2;  out_h = l->in_h / 2; }
+
+        axi_write_reg(REG_SEQ_DATA, (u32)l->op | ((u32)(l->relu ? 1 : 0) << 4) |
+                                    ((u32)(l->in_shift & 0x1F) << 8) | ((u32)(l->out_shift & 0x3F) << 16));
+        axi_write_reg(REG_SEQ_DATA, (u32)l->in_w | ((u32)l->in_h << 8) | ((u32)l->in_c << 16) | ((u32)l->out_c << 24));
+        axi_write_reg(REG_SEQ_DATA, l->weight_base);
+        axi_write_reg(REG_SEQ_DATA, out_w | (out_h << 8));
+    }
+    u32 ctrl = axi_read_reg(REG_SEQ_CTRL) & SEQ_CTRL_ENABLE;
+    axi_write_reg(REG_SEQ_CTRL, ctrl | SEQ_CTRL_LAYERS(first + count));
+    return 1;
+}
+
+/**
+ * 시퀀서 커널 메모리 쓰기 (conv 커널 (출력, 입력) 채널 순 9개씩, 값은 s8 범위)
+ */
+static int cnn_seq_load_weights(u32 base, const s32 *weights, int count) {
+    if (count < 1 || base + (u32)count > SEQ_WMEM_WORDS || !cnn_seq_wait_idle()) return 0;
+    axi_write_reg(REG_SEQ_ADDR, SEQ_ADDR_WMEM | base);
+    for (int i = 0; i < count; i++) axi_write_reg(REG_SEQ_DATA, (u32)weights[i]);
+    return 1;
+}
+
+/**
+ * 프레임 경로를 시퀀서 ↔ 고정 파이프라인으로 전환 (두 경로 모두 idle일 때)
+ */
+static void cnn_seq_enable(int enable) {
+    if (!cnn_seq_wait_idle()) return;
+    u32 ctrl = axi_read_reg(REG_SEQ_CTRL);
+    axi_write_reg(REG_SEQ_CTRL, enable ? (ctrl | SEQ_CTRL_ENABLE) : (ctrl & ~SEQ_CTRL_ENABLE));
+    xil_printf("[CNN_SEQ] %s (%lu layers)\r\n", enable ? "시퀀서 사용" : "고정 파이프라인 사용",
+               (unsigned long)((ctrl >> 8) & 0xF));
+}
+
+/**
+ * 프레임 변화 검출 켜기 / 끄기 (다음 스트림 프레임부터 적용)
+ * 임계값은 현재 프레임 크기 기준 픽셀당 FCD_SAD_PER_PIXEL
+ */
+static void cnn_fcd_enable(int enable) {
+    u32 geo = axi_read_reg(REG_GEOMETRY);
+    u32 pixels = (geo & 0xFF) * ((geo >> 8) & 0xFF);
+    axi_write_reg(REG_FCD_THRESH, pixels * FCD_SAD_PER_PIXEL);
+    axi_write_reg(REG_FCD_CTRL, ((u32)FCD_MAX_SKIP << 8) | (enable ? FCD_CTRL_ENABLE : 0));
+    xil_printf("[CNN_FCD] %s (SAD <= %lu, 연속 생략 최대 %d)\r\n", enable ? "변화 없는 프레임 추론 생략" : "모든 프레임 추론",
+               (unsigned long)(pixels * FCD_SAD_PER_PIXEL), FCD_MAX_SKIP);
+}
+
+/* ================= 하드웨어 조향 루프 (감독 / 오버라이드) ================= */
+
+static void hw_loop_config(void) {
+    axi_write_reg(REG_HW_KP_KI, ((u32)(u16)HW_KI_Q8 << 16) | (u16)HW_KP_Q8);
+    axi_write_reg(REG_HW_KD, ((u32)HW_STEER_RATE << 16) | (u16)HW_KD_Q8);
+    axi_write_reg(REG_HW_INT_LIMIT, HW_INT_LIMIT);
+}
+
+/**
+ * 하드웨어 루프 켜기 / 기본 듀티 변경 (켜기 직후 첫 CNN 결과에서 EN → DIR → DUTY → EN 순서로 출력 시작)
+ */
+static void hw_loop_set(int base_pct) {
+    u32 ctrl = ((u32)CNN_STEER_MAX << 24) | ((u32)clamp(base_pct, 0, DUTY_MAX) << 16) |
+               ((u32)HW_CTRL_ERR_SHIFT << 8) | HW_CTRL_ENABLE;
+    if (!hw_loop_on) {
+        axi_write_reg(REG_HW_CTRL, ctrl | HW_CTRL_CLEAR);
+        hw_last_frames = cnn_get_frame_count();
+        hw_frame_seen_us = hal_now_us();
+    } else if (ctrl != hw_loop_ctrl) {
+        axi_write_reg(REG_HW_CTRL, ctrl);
+    }
+    hw_loop_on = 1;
+    hw_loop_ctrl = ctrl;
+}
+
+/**
+ * PWM 소유권 회수: 하드웨어가 진행 중 쓰기를 마치고 EN=0을 쓸 때까지 대기 (수 us)
+ */
+static void hw_loop_release(void) {
+    if (!hw_loop_on) return;
+    axi_write_reg(REG_HW_CTRL, hw_loop_ctrl & ~HW_CTRL_ENABLE);
+    hw_loop_on = 0;
+    u32 t0 = hal_now_us();
+    while ((axi_read_reg(REG_HW_STATUS) & HW_STATUS_BUSY) && (hal_now_us() - t0) < HW_RELEASE_US) { }
+    prev_dutyL = prev_dutyR = -1;   // 모터가 꺼졌으므로 다음 CPU 명령은 반드시 적용
+}
+
+static void hw_loop_report(void) {
+    u32 st = axi_read_reg(REG_HW_STATUS);
+    xil_printf("[HWLOOP] %s%s, steer %d, duty L %lu R %lu, updates %lu, write errors %lu\r\n",
+               hw_loop_on ? "ON" : "OFF", (st & HW_STATUS_ARMED) ? " (driving)" : "",
+               HW_STATUS_STEER(st), (unsigned long)HW_STATUS_DUTY_L(st), (unsigned long)HW_STATUS_DUTY_R(st),
+               (unsigned long)axi_read_reg(REG_HW_UPDATES), (unsigned long)HW_STATUS_ERRORS(st));
 }
 
 /* ================= CNN 전용 함수 (AXI Lite 기반) ================= */
@@ -144,9 +891,10 @@ static u32 cnn_get_frame_count(void) {
  * CNN 초기화
  */
 static void cnn_init(void) {
-    // 제어 레지스터 초기화
+    // 제어 레지스터 초기화 후 AXI4-Stream 픽셀 입력 활성화
     axi_write_reg(REG_CONTROL, 0x00);
-    usleep(1000);
+    hal_delay_us(1000);
+    axi_write_reg(REG_CONTROL, CTRL_STREAM_ENABLE);
     
     xil_printf("[CNN] AXI Lite 인터페이스 초기화 완료\r\n");
     xil_printf("[CNN] Base Address: 0x%08lx\r\n", (unsigned long)CNN_BASE_ADDR);
@@ -154,56 +902,50 @@ static void cnn_init(void) {
     // 상태 확인
     u32 status = axi_read_reg(REG_STATUS);
     xil_printf("[CNN] 초기 상태: 0x%08lx\r\n", (unsigned long)status);
+    
+    // 양자화 데이터 경로면 레이어 경계 재양자화 설정
+    switch (STATUS_QUANT_MODE(status)) {
+        case 1: cnn_set_requant(CNN_REQUANT_SCALE, CNN_REQUANT_SHIFT_INT16, 0); break;
+        case 2: cnn_set_requant(CNN_REQUANT_SCALE, CNN_REQUANT_SHIFT_INT8, 0);  break;
+        default: break;
+    }
+    hw_loop_config();
+    cnn_trace_init();
 }
 
 /**
- * CNN 48비트 결과를 조향각으로 변환 (AXI Lite 기반)
+ * CNN 48비트 결과를 조향각으로 변환 (메일박스 기반)
+ * 새 결과가 없으면 0, 있으면 cnn_pattern과 *ts_result도 같은 결과로 갱신
  */
-static s32 cnn_read_steering_angle(void) {
-    // 1. 결과 유효성 확인
-    if (!cnn_result_available()) {
+static s32 cnn_read_steering_angle(u32 *ts_result) {
+    // 1. ISR이 쌓은 결과를 모두 꺼내고 최신 결과만 사용
+    CnnResult r;
+    if (!cnn_mbox_drain(&r)) {
         return 0;  // 결과 없음
     }
+    cnn_pattern = (int)(r.class_id & 0x3);
+    *ts_result = r.ts_result;
     
-    // 2. 48비트 CNN 결과 읽기 (AXI Lite)
-    u32 result_low = axi_read_reg(REG_RESULT_LOW);
-    u32 result_high = axi_read_reg(REG_RESULT_HIGH) & 0xFFFF;
-    
-    // 3. 48비트 조합
-    s64 raw_result = ((s64)result_high << 32) | result_low;
+    // 2. 48비트 조합 (bit 47 부호 확장)
+    u64 raw_bits = ((u64)(r.result_high & 0xFFFF) << 32) | r.result_low;
+    s64 raw_result = (s64)(raw_bits << 16) >> 16;
     
-    // 4. 조향각 변환 (추출된 가중치 기반)
+    // 3. 조향각 변환 (추출된 가중치 기반)
     s32 steering_angle = (s32)(raw_result / CNN_OUTPUT_SCALE);
     
-    // 5. 조향각 제한
+    // 4. 조향각 제한
     steering_angle = clamp(steering_angle, -CNN_STEER_MAX, CNN_STEER_MAX);
     
     return steering_angle;
 }
 
 /**
- * CNN 패턴 분류 (업데이트된 임계값)
- */
-static int cnn_classify_pattern(s32 result) {
-    int abs_result = (result < 0) ? -result : result;
-    
-    if (abs_result < 8) {
-        return CNN_PATTERN_STRAIGHT;
-    } else if (result > 25) {
-        return CNN_PATTERN_LEFT_CURVE;
-    } else if (result < -25) {
-        return CNN_PATTERN_RIGHT_CURVE;
-    } else {
-        return CNN_PATTERN_START_END;
-    }
-}
-
-/**
- * CNN 기반 조향 로직
+ * CNN 기반 조향 로직 (cnn_pattern은 같은 결과에서 읽은 FC argmax 클래스)
+ * 클래스 뉴런 가중치(TELEM FC_WT 1~4)를 로드하기 전에는 하드웨어가 차선 값 임계값으로 분류
+ * (|조향| < 8 직진, > 25 좌, < -25 우, 그 외 시작/끝 → 점수 / margin 0)
+ * 하드웨어 루프는 steering_mixer 1단에서 PID 출력에 같은 보정을 적용 (바꾸면 함께 바꿀 것)
  */
 static int cnn_apply_steering_logic(s32 cnn_steer) {
-    cnn_pattern = cnn_classify_pattern(cnn_steer);
-    
     switch (cnn_pattern) {
         case CNN_PATTERN_STRAIGHT:
             return cnn_steer;
@@ -229,12 +971,62 @@ static void cnn_system_status(void) {
     u32 status = axi_read_reg(REG_STATUS);
     u32 frame_count = axi_read_reg(REG_FRAME_COUNT);
     u32 error_code = axi_read_reg(REG_ERROR_CODE);
+    u32 pattern = axi_read_reg(REG_CLASS) & 0x3;
+    u32 margin = axi_read_reg(REG_CLASS_MARGIN);
     
     xil_printf("[CNN_STATUS] Status: 0x%08lx\r\n", (unsigned long)status);
     xil_printf("[CNN_STATUS] Frames: %lu\r\n", (unsigned long)frame_count);
-    xil_printf("[CNN_STATUS] Errors: %lu\r\n", (unsigned long)error_code);
-    xil_printf("[CNN_STATUS] Busy: %s\r\n", (status & STATUS_CNN_BUSY) ? "YES" : "NO");
+    xil_printf("[CNN_STATUS] Timeouts: %lu%s%s%s\r\n", (unsigned long)ERR_TIMEOUTS(error_code),
+               (error_code & ERR_PIX_FIFO_OVF) ? ", 픽셀 FIFO 오버플로" : "",
+               (error_code & ERR_WT_FIFO_OVF) ? ", 가중치 FIFO 오버플로" : "",
+               (error_code & ERR_RES_FIFO_OVF) ? ", 결과 FIFO 오버플로" : "");
+    xil_printf("[CNN_STATUS] Busy: %s, Ready: %s, Tag: %lu\r\n", (status & STATUS_CNN_BUSY) ? "YES" : "NO",
+               (status & STATUS_FRAME_READY) ? "YES" : "NO", (unsigned long)STATUS_FRAME_TAG(status));
     xil_printf("[CNN_STATUS] Result: %s\r\n", (status & STATUS_RESULT_VALID) ? "VALID" : "NONE");
+    xil_printf("[CNN_STATUS] Class: %lu (margin %lu)\r\n", (unsigned long)pattern, (unsigned long)margin);
+    static const char *quant_names[4] = {"INT22", "INT16", "INT8", "?"};
+    u32 qcfg = axi_read_reg(REG_QUANT_CFG);
+    xil_printf("[CNN_STATUS] Datapath: %s, requant scale %lu >> %lu, zp %d\r\n",
+               quant_names[STATUS_QUANT_MODE(status)], (unsigned long)(qcfg & 0xFFFF),
+               (unsigned long)((qcfg >> 16) & 0x3F), (int)(s8)(qcfg >> 24));
+    u32 geo = axi_read_reg(REG_GEOMETRY);
+    xil_printf("[CNN_STATUS] Frame: %lux%lu, stride %lu, %s\r\n", (unsigned long)(geo & 0xFF),
+               (unsigned long)((geo >> 8) & 0xFF), (unsigned long)(1u << ((geo >> 16) & 0x3)),
+               (geo & GEO_PAD_SAME) ? "same" : "valid");
+    u32 pre = axi_read_reg(REG_PRE_CTRL);
+    if (pre & PRE_CTRL_ENABLE) {
+        u32 roi = axi_read_reg(REG_PRE_ROI_SIZE);
+        xil_printf("[CNN_STATUS] Preproc: fmt %lu, ROI %lux%lu, decim %lux%lu\r\n", (unsigned long)((pre >> 1) & 0x3),
+                   (unsigned long)(roi & 0xFFF), (unsigned long)((roi >> 16) & 0xFFF),
+                   (unsigned long)(((pre >> 4) & 0x7) + 1), (unsigned long)(((pre >> 8) & 0x7) + 1));
+    }
+    u32 seq = axi_read_reg(REG_SEQ_STATUS);
+    xil_printf("[CNN_STATUS] Sequencer: %s, %lu layers, layer %lu%s\r\n",
+               (axi_read_reg(REG_SEQ_CTRL) & SEQ_CTRL_ENABLE) ? "ON" : "OFF",
+               (unsigned long)((axi_read_reg(REG_SEQ_CTRL) >> 8) & 0xF), (unsigned long)SEQ_STATUS_LAYER(seq),
+               (seq & SEQ_STATUS_ERROR) ? " (DESC ERROR)" : "");
+    u32 ingest = axi_read_reg(REG_INGEST_STATUS);
+    xil_printf("[CNN_STATUS] Stream: FIFO %lu beats, %lu frames\r\n",
+               (unsigned long)(ingest & 0x1FF), (unsigned long)(ingest >> 16));
+    xil_printf("[CNN_STATUS] IRQ: %s, count %lu, pending %lu, drops %lu\r\n",
+               cnn_irq_ok ? "ON" : "POLL", (unsigned long)cnn_irq_count,
+               (unsigned long)(cnn_mbox_head - cnn_mbox_tail), (unsigned long)cnn_mbox_drops);
+    u32 rf = axi_read_reg(REG_RF_STATUS);
+    xil_printf("[CNN_STATUS] Result FIFO: %lu queued, %lu HW drops, seq %lu, lost %lu, burst max %lu, stale %lu\r\n",
+               (unsigned long)RF_LEVEL(rf), (unsigned long)RF_DROPS(rf), (unsigned long)cnn_seq_next,
+               (unsigned long)cnn_seq_lost, (unsigned long)cnn_burst_max, (unsigned long)cnn_stale_count);
+    xil_printf("[CNN_STATUS] First pixel -> result: last %lu us, max %lu us\r\n",
+               (unsigned long)(cnn_lat_last_cyc / CNN_CLK_MHZ), (unsigned long)(cnn_lat_max_cyc / CNN_CLK_MHZ));
+    xil_printf("[CNN_STATUS] Frame change: %s, last SAD %lu, skipped %lu, reused results %lu\r\n",
+               (axi_read_reg(REG_FCD_CTRL) & FCD_CTRL_ENABLE) ? "ON" : "OFF",
+               (unsigned long)axi_read_reg(REG_FCD_SAD), (unsigned long)axi_read_reg(REG_FCD_SKIPS),
+               (unsigned long)cnn_reused_count);
+    xil_printf("[CNN_STATUS] Ultrasonic: %s, seq %lu, obstacle %d, rejects %lu\r\n",
+               !us_hw_ok ? "IP direct" : (us_hw_fresh ? "HW snapshot" : "HW stale"),
+               (unsigned long)us_last_seq, us_hw_fresh ? ultra_obst : 0,
+               (unsigned long)axi_read_reg(REG_US_REJECTS));
+    hw_loop_report();
+    cnn_perf_report();
 }
 
 /* ================= 기존 모터 제어 함수들 (유지) ================= */
@@ -255,12 +1047,13 @@ static inline u32 pack_duty(u8 d0,u8 d1,u8 d2,u8 d3){
 }
 
 static void set_all(u8 en_mask, u8 dir_rev_mask1bit, u8 d0,u8 d1,u8 d2,u8 d3){
-    Xil_Out32(PWM_BASE + REG_EN, 0x0);
-    usleep(DEAD_US);
+    hw_loop_release();   // CPU 모터 명령은 항상 하드웨어 루프보다 우선
+    hal_write32(PWM_BASE + REG_EN, 0x0);
+    hal_delay_us(DEAD_US);   // 방향 전환 데드타임 (150 us, 블로킹 허용 범위)
     u8 dir_hw = apply_inv_to_dir_bits(dir_rev_mask1bit & 0x0F);
-    Xil_Out32(PWM_BASE + REG_DIR,  dir_hw);
-    Xil_Out32(PWM_BASE + REG_DUTY, pack_duty(d0,d1,d2,d3));
-    Xil_Out32(PWM_BASE + REG_EN,   en_mask & 0x0F);
+    hal_write32(PWM_BASE + REG_DIR,  dir_hw);
+    hal_write32(PWM_BASE + REG_DUTY, pack_duty(d0,d1,d2,d3));
+    hal_write32(PWM_BASE + REG_EN,   en_mask & 0x0F);
 }
 
 static inline int min_nonzero(int a, int b){
@@ -295,10 +1088,33 @@ static void map_lr_to_duty(int dutyL,int dutyR,u8 *d0,u8 *d1,u8 *d2,u8 *d3){
 }
 
 static void stop_all(void){ 
-    Xil_Out32(PWM_BASE + REG_EN, 0x0); 
+    hw_loop_release();
+    hal_write32(PWM_BASE + REG_EN, 0x0); 
     last_mode='X'; 
     auto_mode=0; 
     cnn_active=0; 
+    kick_active=0;
+    auto_phase=AUTO_RUN;
+}
+
+/**
+ * 모터 출력 적용: 킥이 필요하면 킥 듀티만 쓰고 KICK_MS 뒤 모터 태스크가 목표 듀티로 전환
+ * 킥 중 같은 방향 명령은 목표만 갱신, 방향이 바뀌면 킥을 끝내고 바로 적용
+ */
+static void motor_apply(u8 dir_bits, u8 d0, u8 d1, u8 d2, u8 d3, int need_kick){
+    if (kick_active && dir_bits == kick_dir){
+        // 킥 진행 중: 목표만 갱신 (끝나면 최신 목표 적용)
+    } else if (need_kick){
+        u8 kd0,kd1,kd2,kd3; map_lr_to_duty(KICK_DUTY,KICK_DUTY,&kd0,&kd1,&kd2,&kd3);
+        set_all(0x0F, dir_bits, kd0,kd1,kd2,kd3);
+        kick_active = 1;
+        kick_end_us = hal_now_us() + KICK_MS*1000;
+    } else {
+        kick_active = 0;
+        set_all(0x0F, dir_bits, d0,d1,d2,d3);
+    }
+    kick_dir = dir_bits;
+    kick_target[0]=d0; kick_target[1]=d1; kick_target[2]=d2; kick_target[3]=d3;
 }
 
 static void drive_lr_sync(u8 dirL_revbit, u8 dirR_revbit, int dutyL, int dutyR){
@@ -316,12 +1132,7 @@ static void drive_lr_sync(u8 dirL_revbit, u8 dirR_revbit, int dutyL, int dutyR){
     if (dirL_revbit){ dir_bits |= (1<<CH_RL); dir_bits |= (1<<CH_FL); }
     if (dirR_revbit){ dir_bits |= (1<<CH_RR); dir_bits |= (1<<CH_FR); }
     int need_kick = (last_mode=='X') || (dutyL<=DUTY_MIN_TURN) || (dutyR<=DUTY_MIN_TURN);
-    if (need_kick && (dutyL>0 || dutyR>0)){
-        u8 kd0,kd1,kd2,kd3; map_lr_to_duty(KICK_DUTY,KICK_DUTY,&kd0,&kd1,&kd2,&kd3);
-        set_all(0x0F, dir_bits, kd0,kd1,kd2,kd3);
-        usleep(KICK_MS*1000);
-    }
-    set_all(0x0F, dir_bits, d0,d1,d2,d3);
+    motor_apply(dir_bits, d0,d1,d2,d3, need_kick && (dutyL>0 || dutyR>0));
     prev_dutyL = dutyL;
     prev_dutyR = dutyR;
 }
@@ -337,13 +1148,7 @@ static void spin_with_rear_fix(int left) {
         dir_bits |= (1<<CH_FR);
         dir_bits |= (1<<CH_RL);
     }
-    int need_kick = (last_mode=='X');
-    if (need_kick){
-        u8 kd0,kd1,kd2,kd3; map_lr_to_duty(KICK_DUTY, KICK_DUTY, &kd0,&kd1,&kd2,&kd3);
-        set_all(0x0F, dir_bits, kd0,kd1,kd2,kd3);
-        usleep(KICK_MS*1000);
-    }
-    set_all(0x0F, dir_bits, d0,d1,d2,d3);
+    motor_apply(dir_bits, d0,d1,d2,d3, last_mode=='X');
 }
 
 static void go_forward_curved(void){
@@ -367,44 +1172,133 @@ static void reapply_motion(void){
     }
 }
 
-/* ================= 초음파 읽기 (기존 유지) ================= */
+/* ================= 초음파 읽기 ================= */
 static inline u32 ultra_read_once(u32 base){
-    u32 ones = Xil_In32(base + 0x00) & 0xF;
-    u32 tens = Xil_In32(base + 0x04) & 0xF;
+    u32 ones = hal_read32(base + 0x00) & 0xF;
+    u32 tens = hal_read32(base + 0x04) & 0xF;
     return tens*10 + ones;
 }
 
-static u32 ultra_read_avg(u32 base, int n){
-    u32 sum=0, cnt=0;
-    for(int i=0;i<n;i++){
-        u32 v = ultra_read_once(base);
-        if(v>0 && v<=400){ sum+=v; cnt++; }
-        usleep(1000);
+/**
+ * 하드웨어 샘플러 설정 (소프트웨어 필터와 같은 평균 / 범위 / 장애물 상수) 후 존재 확인
+ */
+static void ultra_hw_init(void){
+    u32 ctrl = US_CTRL(US_FILTER_AVG, US_PERIOD_MS, US_MAX_CM);
+    axi_write_reg(REG_US_OBST, (u32)WALL_CM | ((u32)STEER_K << 8) | ((u32)NEAR_BOOST_CM << 16));
+    axi_write_reg(REG_US_CTRL, ctrl);
+    us_hw_ok = (axi_read_reg(REG_US_CTRL) == ctrl);
+    us_last_seq = US_INFO_SEQ(axi_read_reg(REG_US_INFO));
+    us_seq_seen = 0;
+    xil_printf("[ULTRA] %s\r\n", us_hw_ok ? "하드웨어 스냅샷 (평균 3샘플, 5 ms)" : "센서 IP 직접 읽기");
+}
+
+/**
+ * 스냅샷 읽기: 번호 → 거리 → 번호 (같은 번호면 한 스냅샷), 새 스냅샷이 끊기면 0 반환
+ */
+static int ultra_read_snapshot(void){
+    u32 info = axi_read_reg(REG_US_INFO);
+    u32 seq = US_INFO_SEQ(info);
+    if (seq != us_last_seq){
+        us_last_seq = seq;
+        us_seq_seen_us = hal_now_us();
+        us_seq_seen = 1;
+    }
+    if (!us_seq_seen || (hal_now_us() - us_seq_seen_us) >= US_STALE_MS*1000) return 0;
+
+    u32 dist = axi_read_reg(REG_US_DIST);
+    if (US_INFO_SEQ(axi_read_reg(REG_US_INFO)) != seq) return us_hw_fresh;   // 읽는 중 갱신: 이전 값 유지
+    for (int s = 0; s < US_NUM; s++) ultra_cm[s] = US_DIST_CM(dist, s);
+    ultra_obst = US_INFO_OBST(info);
+    return 1;
+}
+
+/**
+ * 센서별 최근 ULTRA_TAPS개 샘플 중 유효값 평균 (기존 1 ms 간격 3회 평균을 태스크 주기로 분산)
+ * 하드웨어 스냅샷이 살아 있으면 같은 필터를 하드웨어가 수행 (레지스터 3번 읽기)
+ */
+static void ultra_sample_all(void){
+    static const u32 base[US_NUM] = { UL_F, UL_R, UL_L };
+    if (us_hw_ok){
+        us_hw_fresh = ultra_read_snapshot();
+        if (us_hw_fresh) return;
     }
-    return (cnt? sum/cnt : 0);
+    for(int s=0; s<US_NUM; s++){
+        u32 v = ultra_read_once(base[s]);
+        ultra_hist[s][ultra_pos] = (v>0 && v<=400) ? v : 0;
+        u32 sum=0, cnt=0;
+        for(int i=0; i<ULTRA_TAPS; i++){
+            if(ultra_hist[s][i]){ sum+=ultra_hist[s][i]; cnt++; }
+        }
+        ultra_cm[s] = cnt ? sum/cnt : 0;
+    }
+    ultra_pos = (ultra_pos + 1) % ULTRA_TAPS;
+}
+
+/**
+ * 좌우 벽 회피 조향 항 (제한 전): 스냅샷이 있으면 하드웨어가 같은 식으로 계산한 값
+ */
+static int ultra_obstacle_steer(u32 R, u32 L){
+    if (us_hw_fresh) return ultra_obst;
+    int s = 0;
+    if (R>0 && R<=WALL_CM) s +=  (WALL_CM - (int)R) * STEER_K;
+    if (L>0 && L<=WALL_CM) s += -(WALL_CM - (int)L) * STEER_K;
+
+    int side_near = min_nonzero((int)R, (int)L);
+    if (side_near>0 && side_near <= NEAR_BOOST_CM){
+        s *= STEER_BOOST;
+    }
+    return s;
 }
 
 /* ================= CNN + 초음파 융합 자율주행 (AXI Lite 기반) ================= */
+static void auto_start(int mode){
+    auto_mode = mode; cnn_active = (mode == 2);
+    auto_phase = AUTO_RUN;
+    cnn_new_valid = 0;
+    speed_pct = AUTO_BASE_PCT; steer = 0;
+    go_forward_curved();
+}
+
+/**
+ * 비상 회피 단계 진행 (단계 종료 시각 전이면 아무것도 하지 않음)
+ * 반환: 1 = 회피 중 (일반 제어 건너뜀)
+ */
+static int auto_escape_step(void){
+    if (auto_phase == AUTO_RUN) return 0;
+    if ((s32)(hal_now_us() - auto_phase_end_us) < 0) return 1;
+
+    if (auto_phase == AUTO_BACKUP){
+        if (auto_left_more) turn_left_spin();
+        else                turn_right_spin();
+        auto_phase = AUTO_SPIN;
+        auto_phase_end_us = hal_now_us() + SPIN_MS*1000;
+        return 1;
+    }
+    speed_pct = AUTO_BASE_PCT;
+    steer = 0;
+    go_forward_curved();
+    auto_phase = AUTO_RUN;
+    return 1;
+}
+
 static void auto_step_with_cnn(void){
-    /* 1) 초음파 센서 읽기 */
-    u32 F = ultra_read_avg(UL_F, 3);
-    u32 R = ultra_read_avg(UL_R, 3);
-    u32 L = ultra_read_avg(UL_L, 3);
+    /* 0) 진행 중인 비상 회피 단계 */
+    if (auto_escape_step()) return;
+
+    /* 1) 초음파 센서 (센서 태스크의 이동 평균) */
+    u32 F = ultra_cm[US_F];
+    u32 R = ultra_cm[US_R];
+    u32 L = ultra_cm[US_L];
 
-    /* 2) 비상상황: 전방 근접 시 기존 로직 우선 */
+    /* 2) 비상상황: 전방 근접 시 후진 시작 (이후 단계는 다음 주기들에서) */
     if (F>0 && F<=PANIC_CM){
-        int left_more_space = (L >= R);
-        int save_spd = speed_pct, save_st = steer;
+        telem_flags |= TELEM_F_PANIC;
+        auto_left_more = (L >= R);
         speed_pct = BACKUP_PCT;
         steer = 0;
         go_backward_curved();
-        usleep(BACKUP_MS * 1000);
-        if (left_more_space) turn_left_spin();
-        else                 turn_right_spin();
-        for(int i=0;i<10 && auto_mode;i++) usleep(100000);
-        speed_pct = AUTO_BASE_PCT;
-        steer = 0;
-        go_forward_curved();
+        auto_phase = AUTO_BACKUP;
+        auto_phase_end_us = hal_now_us() + BACKUP_MS*1000;
         return;
     }
 
@@ -417,24 +1311,27 @@ static void auto_step_with_cnn(void){
     int final_steer = 0;
     
     if (cnn_active) {
-        /* CNN 결과 읽기 (AXI Lite) */
-        s32 cnn_steer = cnn_read_steering_angle();
+        /* 지난 주기 이후 CNN 태스크가 받은 결과 (생성 후 CNN_STALE_MS가 지난 결과는 버림) */
+        s32 cnn_steer = cnn_new_valid ? cnn_new_steer : 0;
+        if (cnn_new_valid) {
+            telem_cnn_age_us = cnn_result_age_us(cnn_new_ts);
+            if (telem_cnn_age_us > CNN_STALE_MS*1000) {
+                cnn_stale_count++;
+                cnn_steer = 0;
+                telem_flags |= TELEM_F_CNN_STALE;
+            }
+        }
+        cnn_new_valid = 0;
         
         if (cnn_steer != 0) {
             /* CNN 결과 가공 */
             int processed_cnn_steer = cnn_apply_steering_logic(cnn_steer);
             last_cnn_result = processed_cnn_steer;
             cnn_timeout_count = 0;
+            telem_flags |= TELEM_F_CNN_NEW;
             
             /* 초음파 장애물 회피 */
-            int obstacle_steer = 0;
-            if (R>0 && R<=WALL_CM) obstacle_steer +=  (WALL_CM - (int)R) * STEER_K;
-            if (L>0 && L<=WALL_CM) obstacle_steer += -(WALL_CM - (int)L) * STEER_K;
-
-            int side_near = min_nonzero((int)R, (int)L);
-            if (side_near>0 && side_near <= NEAR_BOOST_CM){
-                obstacle_steer *= STEER_BOOST;
-            }
+            int obstacle_steer = ultra_obstacle_steer(R, L);
             
             /* 융합 제어 로직 */
             if (abs(obstacle_steer) > 20) {
@@ -449,15 +1346,8 @@ static void auto_step_with_cnn(void){
             /* CNN 결과 없음 → 타임아웃 처리 */
             cnn_timeout_count++;
             if (cnn_timeout_count > 10) {
-                int s = 0;
-                if (R>0 && R<=WALL_CM) s +=  (WALL_CM - (int)R) * STEER_K;
-                if (L>0 && L<=WALL_CM) s += -(WALL_CM - (int)L) * STEER_K;
-                
-                int side_near = min_nonzero((int)R, (int)L);
-                if (side_near>0 && side_near <= NEAR_BOOST_CM){
-                    s *= STEER_BOOST;
-                }
-                final_steer = clamp(s, -80, +80);
+                telem_flags |= TELEM_F_CNN_TIMEOUT;
+                final_steer = clamp(ultra_obstacle_steer(R, L), -80, +80);
                 last_cnn_result = last_cnn_result * 9 / 10;
             } else {
                 final_steer = last_cnn_result;
@@ -465,38 +1355,56 @@ static void auto_step_with_cnn(void){
         }
     } else {
         /* CNN 비활성 → 기존 초음파 로직 */
-        int s = 0;
-        if (R>0 && R<=WALL_CM) s +=  (WALL_CM - (int)R) * STEER_K;
-        if (L>0 && L<=WALL_CM) s += -(WALL_CM - (int)L) * STEER_K;
-
-        int side_near = min_nonzero((int)R, (int)L);
-        if (side_near>0 && side_near <= NEAR_BOOST_CM){
-            s *= STEER_BOOST;
-        }
-        final_steer = clamp(s, -80, +80);
+        final_steer = clamp(ultra_obstacle_steer(R, L), -80, +80);
     }
     
     steer = final_steer;
 
-    /* 5) 최종 적용 */
+    /* 5) 최종 적용 (상태는 제어 태스크가 텔레메트리 기록으로 전송) */
     go_forward_curved();
+}
 
-    /* 6) 디버깅 출력 */
-    static int dbg=0; if(++dbg>=10){ dbg=0;
-        const char* pattern_names[] = {"직선", "좌곡선", "우곡선", "시작종료"};
-        const char* current_pattern = (cnn_pattern >= 0 && cnn_pattern < 4) ? 
-                                    pattern_names[cnn_pattern] : "알수없음";
-        
-        if (cnn_active) {
-            xil_printf("[AUTO+CNN] F=%lu R=%lu L=%lu | SPD=%d STEER=%d | CNN=%d(%s) TO=%d\r\n",
-                       (unsigned long)F, (unsigned long)R, (unsigned long)L,
-                       speed_pct, steer, (int)last_cnn_result, current_pattern, cnn_timeout_count);
-        } else {
-            xil_printf("[AUTO] F=%lu R=%lu L=%lu | SPD=%d STEER=%d\r\n",
-                       (unsigned long)F, (unsigned long)R, (unsigned long)L,
-                       speed_pct, steer);
-        }
+/**
+ * 하드웨어 조향 감독 (auto_mode 3): 조향은 하드웨어가 결과마다 갱신, CPU는 속도 / 비상 / 워치독만
+ * 비상 후진이나 킥은 기존 경로 (set_all이 소유권 회수) → 끝나면 다음 주기에 하드웨어 루프 재개
+ */
+static void auto_step_hw(void){
+    if (auto_escape_step()) return;
+
+    u32 F = ultra_cm[US_F];
+    u32 R = ultra_cm[US_R];
+    u32 L = ultra_cm[US_L];
+
+    if (F>0 && F<=PANIC_CM){
+        telem_flags |= TELEM_F_PANIC;
+        auto_left_more = (L >= R);
+        speed_pct = BACKUP_PCT;
+        steer = 0;
+        go_backward_curved();
+        auto_phase = AUTO_BACKUP;
+        auto_phase_end_us = hal_now_us() + BACKUP_MS*1000;
+        return;
+    }
+
+    if      (F>0 && F<FRONT_SLOW2_CM) speed_pct = FRONT_SLOW2_PCT;
+    else if (F>0 && F<FRONT_SLOW1_CM) speed_pct = FRONT_SLOW1_PCT;
+    else                              speed_pct = AUTO_BASE_PCT;
+
+    /* 새 프레임이 끊기면 하드웨어는 마지막 듀티를 유지하므로 초음파 조향으로 전환 */
+    u32 frames = cnn_get_frame_count();
+    if (frames != hw_last_frames){
+        hw_last_frames = frames;
+        hw_frame_seen_us = hal_now_us();
+    } else if (hw_loop_on && (hal_now_us() - hw_frame_seen_us) >= HW_WATCHDOG_MS*1000){
+        hw_loop_release();
+        auto_mode = 1;
+        steer = 0;
+        go_forward_curved();
+        xil_printf("[HWLOOP] CNN 프레임 없음 %d ms → 초음파 자율주행\r\n", HW_WATCHDOG_MS);
+        return;
     }
+
+    if (!kick_active) hw_loop_set(speed_pct);
 }
 
 /* ================= C 파서 및 기타 함수들 (기존 유지) ================= */
@@ -508,16 +1416,23 @@ static inline int is_dg(char c){ return (c>='0'&&c<='9'); }
 
 static void cparser_reset(void){ cp = (CParser){0, +1, 0, 0, +1, 0, 0}; }
 
+/* 수동 주행 명령 (텍스트 'C <pwm> <steer>'와 바이너리 DRIVE 프레임 공용) */
+static void drive_command(int spd, int st){
+    auto_mode=0; cnn_active=0;
+    spd = clamp(spd, -100, 100);
+    st  = clamp(st,   -80,  80);
+    steer     = st;
+    speed_pct = (spd>=0)? spd : (-spd);
+    if (spd>0)      go_forward_curved();
+    else if (spd<0) go_backward_curved();
+    else            stop_all();
+}
+
 static void cparser_finish(void){
     if (cp.got1 && cp.got2){
-        auto_mode=0; cnn_active=0;
         int spd = clamp(cp.s1*cp.n1, -100, 100);
         int st  = clamp(cp.s2*cp.n2,  -80,  80);
-        steer     = st;
-        speed_pct = (spd>=0)? spd : (-spd);
-        if (spd>0)      go_forward_curved();
-        else if (spd<0) go_backward_curved();
-        else            stop_all();
+        drive_command(spd, st);
         xil_printf("[C] spd=%d steer=%d -> mode=%c\r\n", spd, st, last_mode);
     }
     cparser_reset();
@@ -558,83 +1473,302 @@ static void speed_step(int d){
 }
 
 static void print_help(void){
-    xil_printf("\r\n[Keys] W/A/S/D, X=stop, Z=auto, Y=auto+CNN, +=spd+10, -=spd-10, C <pwm> <steer>\r\n");
+    xil_printf("\r\n[Keys] W/A/S/D, X=stop, Z=auto, Y=auto+CNN, H=auto+HW 조향, +=spd+10, -=spd-10, C <pwm> <steer>\r\n");
     xil_printf("[CNN] AXI Lite 인터페이스, 4패턴 인식, SPI 입력\r\n");
-    xil_printf("[Commands] I=CNN상태, T=시스템테스트\r\n");
+    xil_printf("[Commands] I=CNN상태, T=시스템테스트, P=성능카운터 초기화, B=가중치 뱅크 교체, K=conv 커널 전환, L=레이어 시퀀서 전환, F=프레임 변화 검출 전환, O=스케줄러 통계, G=바이너리 텔레메트리 전환, J=프레임 지연 기록 덤프\r\n");
+}
+
+static void handle_key(char c){
+    if (c=='\r' || c=='\n'){ if (cp.state) cparser_finish(); return; }
+    if (handle_c_char(c)) return;
+
+    switch (c){
+    case 'Z': case 'z':
+        auto_start(1);
+        xil_printf("[AUTO] 초음파만: PWM %d%%\r\n", AUTO_BASE_PCT);
+        break;
+    case 'Y': case 'y':
+        auto_start(2);
+        xil_printf("[AUTO+CNN] AXI Lite 융합모드: PWM %d%%\r\n", AUTO_BASE_PCT);
+        break;
+    case 'H': case 'h':
+        auto_start(3);
+        xil_printf("[AUTO+HW] CNN → PID → PWM 하드웨어 조향, CPU 감독: PWM %d%%\r\n", AUTO_BASE_PCT);
+        break;
+    case 'W': case 'w': auto_mode=0; cnn_active=0; go_forward_curved();  break;
+    case 'S': case 's': case 'R': case 'r': auto_mode=0; cnn_active=0; go_backward_curved(); break;
+    case 'A': case 'a': auto_mode=0; cnn_active=0; turn_left_spin();     break;
+    case 'D': case 'd': auto_mode=0; cnn_active=0; turn_right_spin();    break;
+    case 'X': case 'x': case ' ': stop_all(); xil_printf("STOP\r\n"); break;
+    case '+': speed_step(+10); break;
+    case '-': speed_step(-10); break;
+    case 'I': case 'i': cnn_system_status(); break;  // CNN 상태 확인
+    case 'P': case 'p': cnn_perf_clear(); sched_clear_stats(); break;     // 성능 카운터 + 스케줄러 통계 초기화
+    case 'B': case 'b': cnn_weights_swap(); break;   // 가중치 A/B 뱅크 교체
+    case 'K': case 'k': cnn_kernel_toggle(); break;  // conv 커널 프리셋 로드 + 교체
+    case 'L': case 'l':  // 레이어 시퀀서 ↔ 고정 파이프라인
+        cnn_seq_enable(!(axi_read_reg(REG_SEQ_CTRL) & SEQ_CTRL_ENABLE));
+        break;
+    case 'F': case 'f':  // 변화 없는 프레임 추론 생략 ↔ 모든 프레임 추론
+        cnn_fcd_enable(!(axi_read_reg(REG_FCD_CTRL) & FCD_CTRL_ENABLE));
+        break;
+    case 'O': case 'o': sched_report(); break;       // 태스크별 WCET / 기한 초과
+    case 'J': case 'j': cnn_trace_dump(); break;     // 최근 프레임 단계 시각 + 지연 히스토그램
+    case 'G': case 'g':  // 제어 주기 바이너리 기록 ↔ 텍스트 콘솔만 (sim/telem_tool decode로 해석)
+        telem_stream_on = !telem_stream_on;
+        telem_decim_cnt = 0;
+        xil_printf("[TELEM] 바이너리 기록 %s (제어 주기 %d번마다)\r\n", telem_stream_on ? "ON" : "OFF", telem_decim);
+        break;
+    case 'T': case 't':  // 시스템 테스트
+        xil_printf("[TEST] CNN AXI Lite 연결 테스트\r\n");
+        cnn_system_status();
+        break;
+    default: break;
+    }
+}
+
+/* ================= 바이너리 텔레메트리 / 명령 프레임 ================= */
+
+/* 송신 링에 넣고 바로 반환 (링이 가득 차면 프레임을 버리고 계수, UART를 기다리지 않음) */
+static void telem_emit(u8 type, const u8 *payload, u8 len){
+    telem_tx_send(type, payload, len);
+    hal_uart_tx_kick();
+}
+
+static u16 sat16(u32 v){ return (v > 0xFFFF) ? 0xFFFF : (u16)v; }
+static u16 le16(const u8 *b){ return (u16)(b[0] | (b[1] << 8)); }
+static u32 le32(const u8 *b){ return (u32)le16(b) | ((u32)le16(b + 2) << 16); }
+
+static void telem_send_record(u32 t_us, u32 exec_us){
+    TelemRecord r;
+    u8 buf[TELEM_RECORD_LEN];
+
+    r.t_us = t_us;
+    r.seq = telem_seq++;
+    for (int i = 0; i < US_NUM; i++) r.ultra_cm[i] = (u16)ultra_cm[i];
+    r.cnn_steer = last_cnn_result;
+    r.cnn_seq = cnn_seq_next;
+    r.cnn_age_us = telem_cnn_age_us;
+    r.cnn_class = (s8)cnn_pattern;
+    r.mode = (u8)((auto_mode & 0x3) | (cnn_active ? 0x4 : 0) | (kick_active ? 0x8 : 0) | ((auto_phase & 0x7) << 4));
+    r.flags = telem_flags | (hw_loop_on ? TELEM_F_HW_LOOP : 0) | (us_hw_fresh ? TELEM_F_US_HW : 0);
+    r.speed = (s8)((last_mode=='S') ? -speed_pct : speed_pct);
+    r.steer = (s8)steer;
+    r.duty_l = (u8)((prev_dutyL > 0) ? prev_dutyL : 0);
+    r.duty_r = (u8)((prev_dutyR > 0) ? prev_dutyR : 0);
+    if (hw_loop_on) {
+        /* 하드웨어 루프가 조향 / 듀티 소유 */
+        u32 st = axi_read_reg(REG_HW_STATUS);
+        r.steer = (s8)HW_STATUS_STEER(st);
+        r.duty_l = (u8)HW_STATUS_DUTY_L(st);
+        r.duty_r = (u8)HW_STATUS_DUTY_R(st);
+    }
+    r.reserved = 0;
+    r.exec_us = sat16(exec_us);
+    r.drops = sat16(telem_tx_drops());
+
+    telem_record_pack(buf, &r);
+    telem_emit(TELEM_T_RECORD, buf, TELEM_RECORD_LEN);
+}
+
+/* 'I' 텍스트 출력 대신 한 프레임으로 (카운터만, 설정 레지스터는 'I'로) */
+static void telem_send_status(void){
+    TelemStatus s;
+    u8 buf[TELEM_STATUS_LEN];
+
+    s.cnn_status = axi_read_reg(REG_STATUS);
+    s.cnn_frames = axi_read_reg(REG_FRAME_COUNT);
+    s.cnn_timeouts = ERR_TIMEOUTS(axi_read_reg(REG_ERROR_CODE));
+    s.cnn_seq_lost = cnn_seq_lost;
+    s.cnn_lat_last_cyc = cnn_lat_last_cyc;
+    s.cnn_lat_max_cyc = cnn_lat_max_cyc;
+    s.cnn_stale = cnn_stale_count;
+    s.cnn_reused = cnn_reused_count;
+    s.telem_drops = telem_tx_drops();
+    s.telem_peak = sat16(telem_tx_peak());
+    s.cmd_errors = sat16(cmd_parser.errors);
+
+    telem_status_pack(buf, &s);
+    telem_emit(TELEM_T_STATUS, buf, TELEM_STATUS_LEN);
 }
 
+/* CRC가 맞은 명령 프레임 실행 후 ACK (길이가 틀리면 실행하지 않음) */
+static void telem_handle_cmd(const TelemParser *p){
+    u8 result = TELEM_ACK_OK;
+
+    switch (p->type){
+    case TELEM_C_DRIVE:
+        if (p->len != 2) { result = TELEM_ACK_BAD_LEN; break; }
+        drive_command((s8)p->payload[0], (s8)p->payload[1]);
+        break;
+    case TELEM_C_KEY:
+        if (p->len != 1) { result = TELEM_ACK_BAD_LEN; break; }
+        handle_key((char)p->payload[0]);
+        break;
+    case TELEM_C_STREAM:
+        if (p->len != 2) { result = TELEM_ACK_BAD_LEN; break; }
+        telem_stream_on = (p->payload[0] != 0);
+        telem_decim = p->payload[1] ? p->payload[1] : 1;
+        telem_decim_cnt = 0;
+        break;
+    case TELEM_C_STATUS:
+        if (p->len != 0) { result = TELEM_ACK_BAD_LEN; break; }
+        telem_send_status();
+        break;
+    case TELEM_C_FC_WT: {
+        /* 호스트가 나눠 보내는 FC 가중치 (한 프레임 최대 15개) → 모두 보낸 뒤 'B'로 교체 */
+        s32 w[(TELEM_MAX_PAYLOAD - 3) / 4];
+        int n = (p->len - 3) / 4;
+        if (p->len < 7 || (p->len - 3) % 4) { result = TELEM_ACK_BAD_LEN; break; }
+        for (int i = 0; i < n; i++) w[i] = (s32)le32(&p->payload[3 + 4 * i]);
+        if (!cnn_load_fc_weights(p->payload[0], le16(&p->payload[1]), w, n)) result = TELEM_ACK_REJECTED;
+        break;
+    }
+    case TELEM_C_SEQ_NET: {
+        /* 레이어 디스크립터 (한 프레임 최대 6개, 더 긴 네트워크는 첫 레이어를 바꿔 나눠 보냄) */
+        CnnLayerDesc l[(TELEM_MAX_PAYLOAD - 1) / 10];
+        int n = (p->len - 1) / 10;
+        if (p->len < 11 || (p->len - 1) % 10) { result = TELEM_ACK_BAD_LEN; break; }
+        for (int i = 0; i < n; i++) {
+            const u8 *d = &p->payload[1 + 10 * i];
+            l[i].op = d[0];        l[i].relu = d[1];
+            l[i].in_shift = d[2];  l[i].out_shift = d[3];
+            l[i].in_w = d[4];      l[i].in_h = d[5];
+            l[i].in_c = d[6];      l[i].out_c = d[7];
+            l[i].weight_base = le16(&d[8]);
+        }
+        if (!cnn_seq_load_network(l, p->payload[0], n)) result = TELEM_ACK_REJECTED;
+        break;
+    }
+    case TELEM_C_SEQ_WT: {
+        s32 w[(TELEM_MAX_PAYLOAD - 2) / 4];
+        int n = (p->len - 2) / 4;
+        if (p->len < 6 || (p->len - 2) % 4) { result = TELEM_ACK_BAD_LEN; break; }
+        for (int i = 0; i < n; i++) w[i] = (s32)le32(&p->payload[2 + 4 * i]);
+        if (!cnn_seq_load_weights(le16(&p->payload[0]), w, n)) result = TELEM_ACK_REJECTED;
+        break;
+    }
+    case TELEM_C_GEOMETRY:
+        if (p->len != 4) { result = TELEM_ACK_BAD_LEN; break; }
+        if (!cnn_set_geometry(p->payload[0], p->payload[1], p->payload[2], p->payload[3])) result = TELEM_ACK_REJECTED;
+        break;
+    case TELEM_C_PREPROC: {
+        /* 출력 크기와 같은 geometry는 호스트가 따로 보냄 (전처리 끄기는 항상 성공) */
+        const u8 *d = p->payload;
+        if (p->len != 13) { result = TELEM_ACK_BAD_LEN; break; }
+        if (!cnn_set_preproc(d[0], le16(&d[1]), le16(&d[3]), le16(&d[5]), le16(&d[7]), le16(&d[9]), d[11], d[12]) &&
+            d[11] != 0) result = TELEM_ACK_REJECTED;
+        break;
+    }
+    default:
+        result = TELEM_ACK_UNKNOWN;
+        break;
+    }
+
+    u8 ack[2] = { p->type, result };
+    telem_emit(TELEM_T_ACK, ack, 2);
+}
+
+/* ================= 주기 태스크 (협조형 스케줄러) =================
+ * 모두 블로킹 없이 끝나야 함: 긴 동작은 종료 시각을 기록하고 다음 주기에 확인 */
+#define SCHED_TICK_US    1000
+#define UART_MAX_BYTES   16     // UART 태스크 1회 처리 바이트 상한 (실행 시간 제한)
+
+/* 킥 종료 시 목표 듀티 적용 */
+static void task_motor(void){
+    if (kick_active && (s32)(hal_now_us() - kick_end_us) >= 0){
+        kick_active = 0;
+        set_all(0x0F, kick_dir, kick_target[0], kick_target[1], kick_target[2], kick_target[3]);
+    }
+}
+
+static void task_sensor(void){
+    ultra_sample_all();
+}
+
+/* 인터럽트 미사용 시 결과 폴링 (ISR과 동일 경로) 후 최신 결과를 제어 태스크에 전달 */
+static void task_cnn(void){
+    if (!cnn_irq_ok) cnn_isr(NULL);
+    if (!cnn_active) return;
+    u32 ts = 0;
+    s32 st = cnn_read_steering_angle(&ts);
+    if (st != 0){
+        cnn_new_steer = st;
+        cnn_new_ts = ts;
+        cnn_new_valid = 1;
+    }
+}
+
+/* 제어 후 텔레메트리 기록 (exec_us = 제어 단계만, 기록 작성 제외) */
+static void task_control(void){
+    u32 t0 = hal_now_us();
+    telem_flags = 0;
+    telem_cnn_age_us = 0;
+
+    if (auto_mode == 3)      auto_step_hw();
+    else if (auto_mode >= 1) auto_step_with_cnn();
+
+    if (!telem_stream_on || ++telem_decim_cnt < telem_decim) return;
+    telem_decim_cnt = 0;
+    telem_send_record(t0, hal_now_us() - t0);
+}
+
+/* 수신 바이트는 명령 프레임 파서를 먼저 거치고, 프레임 밖 바이트만 텍스트 키로 처리 */
+static void task_uart(void){
+    for (int n = 0; n < UART_MAX_BYTES && hal_uart_rx_ready(); n++){
+        u8 c = (u8)hal_uart_getc();
+        int r = telem_parser_feed(&cmd_parser, c);
+        if (r > 0)      telem_handle_cmd(&cmd_parser);
+        else if (r < 0) handle_key((char)c);
+    }
+    hal_uart_tx_kick();   // 폴링 송신 모드에서 링 배출 (인터럽트 모드에서는 멈춘 경우만 재시작)
+}
+
+/* 표 순서 = 우선순위 */
+static SchedTask tasks[] = {
+    /* 이름       함수           주기(ms)  기한(us) */
+    { "motor",   task_motor,    1,   500 },
+    { "sensor",  task_sensor,   5,   500 },
+    { "cnn",     task_cnn,      5,  1000 },
+    { "control", task_control, 20,  5000 },
+    { "uart",    task_uart,     2,  2000 },
+};
+
 /* ================= main ================= */
 int main(void)
 {
-    init_platform();
+    hal_init();
     uart_flush_rx();
     uart_puts("AXI Lite CNN READY\r\n");
     print_help();
 
     /* CNN AXI Lite 초기화 */
     cnn_init();
+    cnn_irq_init();
+    ultra_hw_init();
+
+    /* 텔레메트리 송신 링 → UART TX 인터럽트 */
+    telem_parser_reset(&cmd_parser);
+    hal_uart_tx_irq_start(telem_tx_pull);
 
     /* PWM 프로브 */
-    u32 b4 = Xil_In32(PWM_BASE + REG_DIR);
-    Xil_Out32(PWM_BASE + REG_DIR, 0x5);
-    u32 af = Xil_In32(PWM_BASE + REG_DIR);
+    u32 b4 = hal_read32(PWM_BASE + REG_DIR);
+    hal_write32(PWM_BASE + REG_DIR, 0x5);
+    u32 af = hal_read32(PWM_BASE + REG_DIR);
     xil_printf("[PROBE] DIR before=%08lx after=%08lx (ok if different)\r\n",
                (unsigned long)b4, (unsigned long)af);
-    Xil_Out32(PWM_BASE + REG_DIR, b4);
+    hal_write32(PWM_BASE + REG_DIR, b4);
 
     stop_all();
     speed_pct = DUTY_MIN_MOVE;
     steer     = 0;
 
-    int tick_ms = 0;
-
-    while (1){
-        /* ==== UART 처리 ==== */
-        while (!XUartLite_IsReceiveEmpty(UARTB)){
-            char c = XUartLite_RecvByte(UARTB);
-
-            if (c=='\r' || c=='\n'){ if (cp.state) cparser_finish(); continue; }
-            if (handle_c_char(c)) continue;
-
-            switch (c){
-            case 'Z': case 'z':
-                auto_mode=1; cnn_active=0; speed_pct=AUTO_BASE_PCT; steer=0; 
-                go_forward_curved();
-                xil_printf("[AUTO] 초음파만: PWM %d%%\r\n", AUTO_BASE_PCT);
-                break;
-            case 'Y': case 'y':
-                auto_mode=2; cnn_active=1; speed_pct=AUTO_BASE_PCT; steer=0;
-                go_forward_curved();
-                xil_printf("[AUTO+CNN] AXI Lite 융합모드: PWM %d%%\r\n", AUTO_BASE_PCT);
-                break;
-            case 'W': case 'w': auto_mode=0; cnn_active=0; go_forward_curved();  break;
-            case 'S': case 's': case 'R': case 'r': auto_mode=0; cnn_active=0; go_backward_curved(); break;
-            case 'A': case 'a': auto_mode=0; cnn_active=0; turn_left_spin();     break;
-            case 'D': case 'd': auto_mode=0; cnn_active=0; turn_right_spin();    break;
-            case 'X': case 'x': case ' ': stop_all(); xil_printf("STOP\r\n"); break;
-            case '+': speed_step(+10); break;
-            case '-': speed_step(-10); break;
-            case 'I': case 'i': cnn_system_status(); break;  // CNN 상태 확인
-            case 'T': case 't':  // 시스템 테스트
-                xil_printf("[TEST] CNN AXI Lite 연결 테스트\r\n");
-                cnn_system_status();
-                break;
-            default: break;
-            }
-        }
-
-        /* ==== 자율주행 주기 동작 (20ms) ==== */
-        if (auto_mode >= 1){
-            if (tick_ms >= 20){
-                auto_step_with_cnn();
-                tick_ms = 0;
-            }
-        }
+    sched_init(tasks, (int)(sizeof(tasks) / sizeof(tasks[0])), SCHED_TICK_US);
 
-        usleep(1000);   /* 1 ms */
-        tick_ms += 1;
+    while (hal_running()){
+        if (!sched_run_ready()) hal_wait_for_tick();
     }
 
-    cleanup_platform();
+    hal_cleanup();
     return 0;
-}
\ No newline at end of file
+}
@@ -1,90 +1,151 @@
 `timescale 1ns/1ps
+// ===== PID 조향 제어기 (CNN 결과 → 조향 명령) =====
+// 오차 스케일: e = sat16(i_cnn_error >>> i_err_shift) (펌웨어의 raw / CNN_OUTPUT_SCALE와 같은 단위, shift 11 = 2048)
+// 계수 Kp/Ki/Kd: 부호 있는 Q8.8 (0x0100 = 1.0), 출력 = (Kp*e + Ki*Σe + Kd*Δe) >>> 8, ±i_out_limit 포화
+// Anti-windup: 적분은 ±i_int_limit 클램프 + 출력이 포화된 방향으로는 적분 중지 (conditional integration)
+// 첫 샘플 (리셋/i_clear 직후)은 미분 0 → 미분 킥 없음
+// 4단 파이프라인: i_cnn_valid 후 4클럭에 o_pid_valid (결과마다 1회 갱신)
 module PID_Controller(
-    input logic clk,
-    input logic rst,
-    
-    // CNN으로부터의 입력
-    input logic i_cnn_valid,
-    input logic signed [47:0] i_cnn_error, // CNN의 출력을 오차 값으로 사용
-    
-    // 액추에이터로 전달될 출력
-    output logic o_pid_valid,
-    output logic signed [47:0] o_pid_output // 최종 제어 출력 (예: 조향각)
+	input logic clk,
+	input logic rst,   // Active Low
+
+	// ===== 설정 (AXI 레지스터) =====
+	input logic i_clear,                         // 적분 / 이전 오차 초기화
+	input logic [4:0] i_err_shift,
+	input logic signed [15:0] i_kp,
+	input logic signed [15:0] i_ki,
+	input logic signed [15:0] i_kd,
+	input logic [23:0] i_int_limit,              // 적분 누적 한계 (오차 단위)
+	input logic [7:0] i_out_limit,               // 출력 한계 (조향 단위)
+
+	// ===== CNN으로부터의 입력 =====
+	input logic i_cnn_valid,                     // 1클럭 펄스
+	input logic signed [47:0] i_cnn_error,
+
+	// ===== 액추에이터로 전달될 출력 =====
+	output logic o_pid_valid,                    // 1클럭 펄스
+	output logic signed [15:0] o_pid_output
 );
 
-    // Q12.10 고정 소수점 형식의 PID 계수
-    localparam Q_FACTOR = 10;
-    localparam signed [21:0] KP_FIXED = 22'd2048; // Kp = 2.0
-    localparam signed [21:0] KI_FIXED = 22'd512;  // Ki = 0.5
-    localparam signed [21:0] KD_FIXED = 22'd102;  // Kd = 0.1
-
-    // 내부 레지스터 및 와이어
-    logic signed [47:0] error_reg;
-    logic signed [47:0] error_prev;
-    logic signed [63:0] integral_acc; // 오버플로우 방지를 위해 폭을 넓게 설정
-    
-    logic signed [63:0] p_term;
-    logic signed [63:0] i_term;
-    logic signed [63:0] d_term;
-    
-    logic start_pulse;
-    logic i_cnn_valid_d1;
-
-    // 입력 유효 신호를 펄스 형태로 변환
-    always_ff @(posedge clk) begin
-        if(rst) i_cnn_valid_d1 <= 1'b0;
-        else    i_cnn_valid_d1 <= i_cnn_valid;
-    end
-    assign start_pulse = i_cnn_valid & ~i_cnn_valid_d1;
-
-    always_ff @(posedge clk) begin
-        if (rst) begin
-            error_reg       <= '0;
-            error_prev      <= '0;
-            integral_acc    <= '0;
-            p_term          <= '0;
-            i_term          <= '0;
-            d_term          <= '0;
-            o_pid_output    <= '0;
-            o_pid_valid     <= 1'b0;
-        end else begin
-            o_pid_valid <= 1'b0; // 기본적으로는 low 유지
-            
-            if (start_pulse) begin
-                // 1. 새로운 오차 값 등록
-                // CNN 출력이 매우 크므로, 실제 시스템에 맞게 스케일링이 필요할 수 있음
-                // 여기서는 예시로 하위 22비트만 사용
-                error_reg <= i_cnn_error[21:0]; 
-                
-                // 2. 미분(D) 항 계산: (현재 오차 - 이전 오차)
-                logic signed [47:0] derivative = error_reg - error_prev;
-                
-                // 3. 적분(I) 항 누적
-                // Anti-windup: 적분값이 과도하게 커지는 것을 방지 (Saturation)
-                if (integral_acc > 64'h7FFFFFFFFFFFFFFF - error_reg) begin
-                    integral_acc <= 64'h7FFFFFFFFFFFFFFF;
-                end else if (integral_acc < 64'h8000000000000000 + error_reg) begin
-                    integral_acc <= 64'h8000000000000000;
-                end else begin
-                    integral_acc <= integral_acc + error_reg;
-                end
-
-                // 4. 각 텀 계산 (고정 소수점 연산)
-                p_term <= KP_FIXED * error_reg;
-                i_term <= KI_FIXED * integral_acc;
-                d_term <= KD_FIXED * derivative;
-
-                // 5. 최종 PID 출력 계산 및 스케일링 (Q_FACTOR 만큼 시프트)
-                o_pid_output <= (p_term + i_term + d_term) >>> Q_FACTOR;
-                o_pid_valid  <= 1'b1; // 계산 완료, 출력 유효
-                
-                // 6. 현재 오차를 이전 오차로 저장
-                error_prev <= error_reg;
-
-                $display("[PID_DEBUG] Time:%0t Error:%d P_term:%d, I_term:%d, D_term:%d -> Output:%d",
-                         $time, error_reg, (p_term >>> Q_FACTOR), (i_term >>> Q_FACTOR), (d_term >>> Q_FACTOR), o_pid_output);
-            end
-        end
-    end
-
-endmodule
\ No newline at end of file
+	// ===== 1단: 오차 스케일 + 16비트 포화 =====
+	logic signed [47:0] err_shifted;
+	logic v1;
+	logic signed [15:0] e1;
+
+	assign err_shifted = i_cnn_error >>> i_err_shift;
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			v1 <= 1'b0;
+			e1 <= '0;
+		end else begin
+			v1 <= i_cnn_valid & ~i_clear;
+			if(i_cnn_valid) begin
+				if(err_shifted > 48'sd32767)        e1 <= 16'sh7FFF;
+				else if(err_shifted < -48'sd32768)  e1 <= 16'sh8000;
+				else                                e1 <= err_shifted[15:0];
+			end
+		end
+	end
+
+	// ===== 2단: 미분 + 적분 (클램프, 포화 방향 적분 중지) =====
+	logic v2;
+	logic signed [15:0] e2;
+	logic signed [16:0] d2;
+	logic signed [15:0] e_prev;
+	logic have_prev;
+	logic signed [24:0] integ;                   // ±i_int_limit 이내
+	logic sat_hi, sat_lo;                        // 직전 출력 포화 방향
+
+	logic signed [25:0] integ_sum;
+	logic signed [25:0] int_lim;
+	logic hold_int;
+
+	assign integ_sum = integ + e1;
+	assign int_lim   = $signed({2'b00, i_int_limit});
+	assign hold_int  = (sat_hi && e1 > 0) || (sat_lo && e1 < 0);
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			v2 <= 1'b0;
+			e2 <= '0;
+			d2 <= '0;
+			e_prev <= '0;
+			have_prev <= 1'b0;
+			integ <= '0;
+		end else if(i_clear) begin
+			v2 <= 1'b0;
+			e_prev <= '0;
+			have_prev <= 1'b0;
+			integ <= '0;
+		end else begin
+			v2 <= v1;
+			if(v1) begin
+				e2 <= e1;
+				d2 <= have_prev ? (e1 - e_prev) : 17'sd0;
+				e_prev <= e1;
+				have_prev <= 1'b1;
+				if(!hold_int) begin
+					if(integ_sum > int_lim)       integ <= int_lim[24:0];
+					else if(integ_sum < -int_lim) integ <= -int_lim[24:0];
+					else                          integ <= integ_sum[24:0];
+				end
+			end
+		end
+	end
+
+	// ===== 3단: 계수 곱 =====
+	logic v3;
+	logic signed [31:0] p3;
+	logic signed [40:0] i3;
+	logic signed [32:0] d3;
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			v3 <= 1'b0;
+			p3 <= '0;
+			i3 <= '0;
+			d3 <= '0;
+		end else begin
+			v3 <= v2 & ~i_clear;
+			if(v2) begin
+				p3 <= i_kp * e2;
+				i3 <= i_ki * integ;
+				d3 <= i_kd * d2;
+			end
+		end
+	end
+
+	// ===== 4단: 합 → Q8.8 정규화 → 출력 포화 =====
+	logic signed [42:0] sum;
+	logic signed [42:0] sum_q;
+	logic signed [42:0] out_lim;
+
+	assign sum     = p3 + i3 + d3;
+	assign sum_q   = sum >>> 8;
+	assign out_lim = $signed({35'd0, i_out_limit});
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			o_pid_valid <= 1'b0;
+			o_pid_output <= '0;
+			sat_hi <= 1'b0;
+			sat_lo <= 1'b0;
+		end else if(i_clear) begin
+			o_pid_valid <= 1'b0;
+			o_pid_output <= '0;
+			sat_hi <= 1'b0;
+			sat_lo <= 1'b0;
+		end else begin
+			o_pid_valid <= v3;
+			if(v3) begin
+				sat_hi <= (sum_q > out_lim);
+				sat_lo <= (sum_q < -out_lim);
+				if(sum_q > out_lim)       o_pid_output <= out_lim[15:0];
+				else if(sum_q < -out_lim) o_pid_output <= -out_lim[15:0];
+				else                      o_pid_output <= sum_q[15:0];
+			end
+		end
+	end
+
+endmodule
@@ -36,7 +36,9 @@ module RELU_POOL_TOP (
         .pixel_in    ( relu_result_out ), // ReLU의 출력을 받음
         .result_out  ( result_out      ), // Top 모듈의 최종 출력
         .result_valid( result_valid    ), // Top 모듈의 최종 출력
-        .done_signal ( done_signal     )  // Top 모듈의 최종 출력
+        .done_signal ( done_signal     ), // Top 모듈의 최종 출력
+        .i_img_width ( 6'd30           ), // conv 출력 30x30 고정
+        .i_img_height( 6'd30           )
     );
 
 endmodule
\ No newline at end of file
@@ -4,6 +4,7 @@ module Simple_Image_Processor (
     input logic rst_n,
     input logic pixel_valid_in,
     input logic [7:0] pixel_data_in,
+    input logic [15:0] i_frame_pixels,   // 프레임 픽셀 수 (폭 x 높이)
     output logic command_valid,
     output logic [2:0] motor_command_out,
     output logic [3:0] status_led,
@@ -42,7 +43,7 @@ module Simple_Image_Processor (
         next_state = current_state;
         case (current_state)
             IDLE:       if (pixel_valid_in)      next_state = RECEIVING;
-            RECEIVING: if (pixel_count >= 1020) next_state = PROCESSING;  // 조건 완화
+            RECEIVING: if (pixel_count >= i_frame_pixels - 16'd4) next_state = PROCESSING;  // 조건 완화
             PROCESSING: if (result_captured || !cnn_busy) next_state = SENDING;  // 수정
             SENDING:                             next_state = DONE;
             DONE:                                next_state = IDLE;
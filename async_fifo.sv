@@ -0,0 +1,100 @@
+`timescale 1ns/1ps
+// ===== 비동기 FIFO (Gray 코드 포인터, 2단 동기화) =====
+// 쓰기/읽기 클럭이 서로 무관할 때 사용 (예: SPI SCLK → CNN 클럭)
+// full/empty는 상대 포인터가 2클럭 늦게 보이므로 보수적으로 (오버플로/언더플로 없음)
+module async_fifo #(
+	parameter WIDTH = 8,
+	parameter DEPTH = 64   // 2의 거듭제곱
+)(
+	// ===== 쓰기 도메인 =====
+	input logic wr_clk,
+	input logic wr_rst,   // Active Low (negedge)
+	input logic wr_en,
+	input logic [WIDTH-1:0] wr_data,
+	output logic full,
+	output logic [$clog2(DEPTH):0] wr_level,   // 쓰기 쪽에서 본 점유량 (흐름 제어용)
+
+	// ===== 읽기 도메인 =====
+	input logic rd_clk,
+	input logic rd_rst,   // Active Low (negedge)
+	input logic rd_en,
+	output logic [WIDTH-1:0] rd_data,   // First-Word-Fall-Through: empty가 아니면 바로 유효
+	output logic empty,
+	output logic [$clog2(DEPTH):0] rd_level    // 읽기 쪽에서 본 점유량
+);
+	localparam AW = $clog2(DEPTH);
+
+	(* ram_style = "distributed" *) logic [WIDTH-1:0] mem [0:DEPTH-1];
+
+	logic [AW:0] wr_bin, wr_gray, rd_bin, rd_gray;
+	(* ASYNC_REG = "TRUE" *) logic [AW:0] rd_gray_w1, rd_gray_w2;   // 읽기 포인터 → 쓰기 도메인
+	(* ASYNC_REG = "TRUE" *) logic [AW:0] wr_gray_r1, wr_gray_r2;   // 쓰기 포인터 → 읽기 도메인
+
+	function automatic logic [AW:0] bin2gray(input logic [AW:0] b);
+		return b ^ (b >> 1);
+	endfunction
+
+	function automatic logic [AW:0] gray2bin(input logic [AW:0] g);
+		logic [AW:0] b;
+		b[AW] = g[AW];
+		for (int i = AW - 1; i >= 0; i--) b[i] = b[i+1] ^ g[i];
+		return b;
+	endfunction
+
+	// ===== 쓰기 도메인 =====
+	logic do_write;
+	logic [AW:0] wr_bin_next;
+	assign do_write = wr_en && !full;
+	assign wr_bin_next = wr_bin + 1'b1;
+
+	always_ff @(posedge wr_clk) begin
+		if(do_write) mem[wr_bin[AW-1:0]] <= wr_data;
+	end
+
+	always_ff @(posedge wr_clk or negedge wr_rst) begin
+		if(!wr_rst) begin
+			wr_bin <= '0;
+			wr_gray <= '0;
+			rd_gray_w1 <= '0;
+			rd_gray_w2 <= '0;
+		end else begin
+			rd_gray_w1 <= rd_gray;
+			rd_gray_w2 <= rd_gray_w1;
+			if(do_write) begin
+				wr_bin <= wr_bin_next;
+				wr_gray <= bin2gray(wr_bin_next);
+			end
+		end
+	end
+
+	// 최상위 2비트가 반대이고 나머지가 같으면 가득 참 (Gray 코드 비교)
+	assign full = (wr_gray == {~rd_gray_w2[AW:AW-1], rd_gray_w2[AW-2:0]});
+	assign wr_level = wr_bin - gray2bin(rd_gray_w2);
+
+	// ===== 읽기 도메인 =====
+	logic do_read;
+	logic [AW:0] rd_bin_next;
+	assign do_read = rd_en && !empty;
+	assign rd_bin_next = rd_bin + 1'b1;
+
+	always_ff @(posedge rd_clk or negedge rd_rst) begin
+		if(!rd_rst) begin
+			rd_bin <= '0;
+			rd_gray <= '0;
+			wr_gray_r1 <= '0;
+			wr_gray_r2 <= '0;
+		end else begin
+			wr_gray_r1 <= wr_gray;
+			wr_gray_r2 <= wr_gray_r1;
+			if(do_read) begin
+				rd_bin <= rd_bin_next;
+				rd_gray <= bin2gray(rd_bin_next);
+			end
+		end
+	end
+
+	assign rd_data = mem[rd_bin[AW-1:0]];
+	assign empty = (rd_gray == wr_gray_r2);
+	assign rd_level = gray2bin(wr_gray_r2) - rd_bin;
+
+endmodule
@@ -18,11 +18,11 @@ module axi_quad_spi_reader (
     output logic frame_start,              // 프레임 시작
     
     // Control
-    input logic start_reading              // 읽기 시작 신호
+    input logic start_reading,             // 읽기 시작 신호
+    input logic [10:0] i_frame_pixels      // 프레임 픽셀 수 (폭 x 높이, 최대 1024)
 );
 
     // ===== Parameters =====
-    localparam FRAME_SIZE = 1024;          // 32x32 = 1024 pixels
     localparam SPI_RX_FIFO_ADDR = 32'h6C;  // AXI Quad SPI RX FIFO 주소 (예시)
     localparam SPI_STATUS_ADDR = 32'h64;   // AXI Quad SPI 상태 레지스터 주소
     
@@ -87,7 +87,7 @@ module axi_quad_spi_reader (
             CHECK_FIFO: begin
                 if (spi_rx_occupancy > 0) begin
                     next_state = READ_REQUEST;
-                end else if (pixel_counter >= FRAME_SIZE) begin
+                end else if (pixel_counter >= i_frame_pixels) begin
                     next_state = FRAME_DONE;
                 end else begin
                     next_state = WAIT_DATA;
@@ -105,7 +105,7 @@ module axi_quad_spi_reader (
             end
             
             PROCESS_DATA: begin
-                if (pixel_counter >= FRAME_SIZE - 1) begin
+                if (pixel_counter >= i_frame_pixels - 1) begin
                     next_state = FRAME_DONE;
                 end else begin
                     next_state = CHECK_FIFO;
@@ -184,7 +184,7 @@ module axi_quad_spi_reader (
                     pixel_counter <= pixel_counter + 1;
                     
                     // Debug output for first few pixels
-                    if (pixel_counter < 10 || pixel_counter >= FRAME_SIZE - 5) begin
+                    if (pixel_counter < 10 || pixel_counter >= i_frame_pixels - 5) begin
                         $display("[SPI_READER] Pixel[%0d] = 0x%02h", pixel_counter, spi_read_data[7:0]);
                     end
                 end
@@ -206,7 +206,7 @@ module axi_quad_spi_reader (
     // ===== FIFO Monitoring =====
     always @(posedge clk) begin
         if (reading_active) begin
-            if (spi_rx_occupancy == 0 && pixel_counter < FRAME_SIZE && state != FRAME_DONE) begin
+            if (spi_rx_occupancy == 0 && pixel_counter < i_frame_pixels && state != FRAME_DONE) begin
                 $display("[SPI_READER] Warning: FIFO empty during read at pixel %0d", pixel_counter);
             end
         end
@@ -0,0 +1,200 @@
+`timescale 1ns/1ps
+// ===== AXI4-Lite 마스터: 좌/우 듀티 → DC 모터 PWM IP 직접 쓰기 =====
+// PWM IP 레지스터: EN 0x00, DIR 0x04, DUTY 0x08 (펌웨어 PWM_BASE와 같은 맵)
+// 활성화 후 첫 갱신: EN=0 → 데드타임 → DIR=전진 → DUTY → EN=0xF (펌웨어 set_all과 같은 순서)
+// 이후 갱신: DUTY만 쓰기 (같은 값이면 생략), 쓰기 중 도착한 갱신은 최신 값 하나로 합침
+// i_enable 하강: 진행 중인 쓰기를 마친 뒤 EN=0 (모터 정지) → 이후 CPU가 PWM 소유
+module axil_pwm_writer #(
+	parameter [31:0] C_PWM_BASEADDR = 32'h44A1_0000,
+	parameter integer DEAD_CYCLES   = 15000,     // 150 us @ 100 MHz (DEAD_US)
+	parameter [3:0] FWD_DIR         = 4'b0101    // 전진 방향 비트 (MOTOR_INV 반영)
+)(
+	input logic clk,
+	input logic rst,   // Active Low
+
+	input logic i_enable,
+	input logic i_valid,
+	input logic [6:0] i_duty_l,
+	input logic [6:0] i_duty_r,
+
+	output logic o_busy,                     // 쓰기 진행 중 또는 정지 쓰기 대기
+	output logic o_armed,                    // 모터 출력 켜짐 (하드웨어 소유)
+	output logic [7:0] o_err_count,          // BRESP != OKAY 누적 (포화)
+	output logic [31:0] o_update_count,      // DUTY 쓰기 횟수
+
+	// ===== AXI4-Lite Master (쓰기 채널만) =====
+	output logic [31:0] m_axi_awaddr,
+	output logic [2:0] m_axi_awprot,
+	output logic m_axi_awvalid,
+	input logic m_axi_awready,
+	output logic [31:0] m_axi_wdata,
+	output logic [3:0] m_axi_wstrb,
+	output logic m_axi_wvalid,
+	input logic m_axi_wready,
+	input logic [1:0] m_axi_bresp,
+	input logic m_axi_bvalid,
+	output logic m_axi_bready
+);
+	localparam [7:0] PWM_EN   = 8'h00;
+	localparam [7:0] PWM_DIR  = 8'h04;
+	localparam [7:0] PWM_DUTY = 8'h08;
+
+	localparam [2:0] OP_EN_OFF = 3'd0;   // 활성화 시퀀스: EN=0 → 데드타임
+	localparam [2:0] OP_DIR    = 3'd1;
+	localparam [2:0] OP_DUTY   = 3'd2;
+	localparam [2:0] OP_EN_ON  = 3'd3;
+	localparam [2:0] OP_STOP   = 3'd4;   // 비활성화: EN=0
+
+	enum logic [1:0] { S_IDLE, S_WRITE, S_RESP, S_DEAD } state;
+	logic [2:0] op;
+
+	// ===== 갱신 합치기 =====
+	logic pending;
+	logic [31:0] pending_duty;
+	logic [31:0] last_duty;
+	logic enable_d1;
+	logic stop_req;
+
+	// 채널 순서 {RR, RL, FL, FR} = {R, L, L, R}
+	logic [31:0] packed_duty;
+	assign packed_duty = {1'b0, i_duty_r, 1'b0, i_duty_l, 1'b0, i_duty_l, 1'b0, i_duty_r};
+
+	logic [$clog2(DEAD_CYCLES+1)-1:0] dead_cnt;
+	logic aw_done, w_done;
+
+	assign m_axi_awprot = 3'b000;
+	assign m_axi_wstrb  = 4'hF;
+	assign m_axi_bready = (state == S_RESP);
+	assign o_busy = (state != S_IDLE) || stop_req;
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			state <= S_IDLE;
+			op <= OP_EN_OFF;
+			pending <= 1'b0;
+			pending_duty <= '0;
+			last_duty <= '0;
+			enable_d1 <= 1'b0;
+			stop_req <= 1'b0;
+			o_armed <= 1'b0;
+			o_err_count <= '0;
+			o_update_count <= '0;
+			dead_cnt <= '0;
+			aw_done <= 1'b0;
+			w_done <= 1'b0;
+			m_axi_awaddr <= '0;
+			m_axi_awvalid <= 1'b0;
+			m_axi_wdata <= '0;
+			m_axi_wvalid <= 1'b0;
+		end else begin
+			enable_d1 <= i_enable;
+
+			// 비활성 중 갱신은 버림, 하강 에지에서 정지 요청
+			if(i_enable && i_valid) begin
+				pending <= 1'b1;
+				pending_duty <= packed_duty;
+			end
+			if(!i_enable) pending <= 1'b0;
+			if(enable_d1 && !i_enable) stop_req <= 1'b1;
+
+			case(state)
+				S_IDLE: begin
+					if(stop_req) begin
+						stop_req <= 1'b0;
+						o_armed <= 1'b0;
+						op <= OP_STOP;
+						m_axi_awaddr <= C_PWM_BASEADDR + PWM_EN;
+						m_axi_wdata <= 32'h0;
+						m_axi_awvalid <= 1'b1;
+						m_axi_wvalid <= 1'b1;
+						state <= S_WRITE;
+					end else if(i_enable && pending && !o_armed) begin
+						op <= OP_EN_OFF;
+						m_axi_awaddr <= C_PWM_BASEADDR + PWM_EN;
+						m_axi_wdata <= 32'h0;
+						m_axi_awvalid <= 1'b1;
+						m_axi_wvalid <= 1'b1;
+						state <= S_WRITE;
+					end else if(i_enable && pending) begin
+						pending <= i_valid;   // 같은 사이클 갱신은 다음 쓰기로
+						if(pending_duty != last_duty) begin
+							op <= OP_DUTY;
+							m_axi_awaddr <= C_PWM_BASEADDR + PWM_DUTY;
+							m_axi_wdata <= pending_duty;
+							m_axi_awvalid <= 1'b1;
+							m_axi_wvalid <= 1'b1;
+							state <= S_WRITE;
+						end
+					end
+				end
+
+				S_WRITE: begin
+					// 주소 / 데이터 핸드셰이크는 순서 무관
+					if(m_axi_awvalid && m_axi_awready) m_axi_awvalid <= 1'b0;
+					if(m_axi_wvalid && m_axi_wready)   m_axi_wvalid <= 1'b0;
+					if((aw_done || m_axi_awready) && (w_done || m_axi_wready)) begin
+						aw_done <= 1'b0;
+						w_done <= 1'b0;
+						state <= S_RESP;
+					end else begin
+						if(m_axi_awready) aw_done <= 1'b1;
+						if(m_axi_wready)  w_done <= 1'b1;
+					end
+				end
+
+				S_RESP: begin
+					if(m_axi_bvalid) begin
+						if(m_axi_bresp != 2'b00 && o_err_count != 8'hFF) o_err_count <= o_err_count + 1'b1;
+						if(op == OP_DUTY) begin
+							last_duty <= m_axi_wdata;
+							o_update_count <= o_update_count + 1'b1;
+						end
+						state <= S_IDLE;
+						// 활성화 시퀀스 중 비활성화 → 남은 쓰기 생략 (IDLE에서 정지 쓰기)
+						if(i_enable) case(op)
+							OP_EN_OFF: begin
+								dead_cnt <= DEAD_CYCLES;
+								state <= S_DEAD;
+							end
+							OP_DIR: begin
+								op <= OP_DUTY;
+								m_axi_awaddr <= C_PWM_BASEADDR + PWM_DUTY;
+								m_axi_wdata <= pending_duty;
+								m_axi_awvalid <= 1'b1;
+								m_axi_wvalid <= 1'b1;
+								pending <= i_valid;
+								state <= S_WRITE;
+							end
+							OP_DUTY: if(!o_armed) begin
+								op <= OP_EN_ON;
+								m_axi_awaddr <= C_PWM_BASEADDR + PWM_EN;
+								m_axi_wdata <= 32'hF;
+								m_axi_awvalid <= 1'b1;
+								m_axi_wvalid <= 1'b1;
+								state <= S_WRITE;
+							end
+							OP_EN_ON: o_armed <= 1'b1;
+							default: ;   // OP_STOP
+						endcase
+					end
+				end
+
+				S_DEAD: begin
+					if(!i_enable) state <= S_IDLE;   // 데드타임 중 비활성화 → 정지 쓰기
+					else if(dead_cnt != 0) dead_cnt <= dead_cnt - 1'b1;
+					else begin
+						op <= OP_DIR;
+						m_axi_awaddr <= C_PWM_BASEADDR + PWM_DIR;
+						m_axi_wdata <= {28'd0, FWD_DIR};
+						m_axi_awvalid <= 1'b1;
+						m_axi_wvalid <= 1'b1;
+						state <= S_WRITE;
+					end
+				end
+
+				default: state <= S_IDLE;
+			endcase
+		end
+	end
+
+endmodule
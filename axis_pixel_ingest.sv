@@ -0,0 +1,113 @@
+`timescale 1ns/1ps
+module axis_pixel_ingest #(
+	parameter FIFO_DEPTH = 256   // 비트 단위 (256 x 4픽셀 = 32x32 프레임 한 장)
+)(
+	input logic clk,
+	input logic rst,   // Active Low (negedge)
+	input logic i_enable,
+
+	// ===== AXI4-Stream Slave (비트당 픽셀 4개, 리틀 엔디언 바이트 순서) =====
+	input logic [31:0] s_axis_tdata,
+	input logic [3:0]  s_axis_tkeep,
+	input logic        s_axis_tlast,   // 프레임 마지막 비트
+	input logic        s_axis_tvalid,
+	output logic       s_axis_tready,
+
+	// ===== CNN 픽셀 인터페이스 =====
+	input logic        i_frame_ready,  // CNN_TOP이 새 프레임을 받을 수 있음
+	output logic       o_frame_start,  // 프레임 시작 펄스 (CNN start_signal)
+	output logic       o_pixel_valid,
+	output logic [7:0] o_pixel_data,
+	output logic       o_frame_done,   // 프레임 마지막 픽셀 출력 펄스
+
+	// ===== 상태 =====
+	output logic [$clog2(FIFO_DEPTH):0] o_fifo_level,
+	output logic [15:0] o_frame_count,
+	output logic       o_busy,         // 픽셀을 내보낸 사이클
+	output logic       o_stall         // 프레임 중 FIFO 비어 있음 또는 CNN 준비 대기
+);
+	// FIFO 엔트리: {tlast, tkeep, tdata}
+	logic [36:0] fifo_wr_data, fifo_rd_data;
+	logic fifo_full, fifo_empty, fifo_rd_en;
+
+	logic [31:0] beat_data;
+	logic [3:0]  beat_keep;
+	logic        beat_last;
+	logic [1:0]  byte_idx;
+
+	enum logic [1:0] {ST_IDLE, ST_STREAM} state;
+
+	// ===== 입력 FIFO (DMA 버스트를 한 클럭에 한 비트씩 흡수) =====
+	assign fifo_wr_data = {s_axis_tlast, s_axis_tkeep, s_axis_tdata};
+	assign s_axis_tready = !fifo_full;
+
+	sync_fifo #(.WIDTH(37), .DEPTH(FIFO_DEPTH)) u_fifo (
+		.clk(clk),
+		.rst(rst),
+		.wr_en(s_axis_tvalid),
+		.wr_data(fifo_wr_data),
+		.full(fifo_full),
+		.rd_en(fifo_rd_en),
+		.rd_data(fifo_rd_data),
+		.empty(fifo_empty),
+		.level(o_fifo_level)
+	);
+
+	assign {beat_last, beat_keep, beat_data} = fifo_rd_data;
+
+	// 비트의 마지막 바이트를 처리하면 FIFO에서 꺼냄
+	assign fifo_rd_en = (state == ST_STREAM) && !fifo_empty && (byte_idx == 2'd3);
+
+	// ===== 성능 카운터용 상태 =====
+	assign o_busy  = (state == ST_STREAM) && !fifo_empty;
+	assign o_stall = ((state == ST_STREAM) && fifo_empty) ||
+	                 ((state == ST_IDLE) && i_enable && !fifo_empty && !i_frame_ready);
+
+	// ===== 언패커: 비트 → 클럭당 픽셀 1개 =====
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			state <= ST_IDLE;
+			byte_idx <= 2'd0;
+			o_frame_start <= 1'b0;
+			o_pixel_valid <= 1'b0;
+			o_pixel_data <= 8'h00;
+			o_frame_done <= 1'b0;
+			o_frame_count <= 16'h0;
+		end else begin
+			o_frame_start <= 1'b0;
+			o_pixel_valid <= 1'b0;
+			o_frame_done <= 1'b0;
+
+			case(state)
+				ST_IDLE: begin
+					byte_idx <= 2'd0;
+					// 첫 비트가 도착했고 CNN이 준비되면 프레임 시작
+					if(i_enable && !fifo_empty && i_frame_ready) begin
+						o_frame_start <= 1'b1;
+						state <= ST_STREAM;
+					end
+				end
+
+				ST_STREAM: begin
+					if(!fifo_empty) begin
+						if(beat_keep[byte_idx]) begin
+							o_pixel_valid <= 1'b1;
+							o_pixel_data <= beat_data[byte_idx*8 +: 8];
+						end
+						byte_idx <= byte_idx + 2'd1;
+
+						// TLAST 비트의 마지막 바이트 → 프레임 종료
+						if(byte_idx == 2'd3 && beat_last) begin
+							o_frame_done <= 1'b1;
+							o_frame_count <= o_frame_count + 16'd1;
+							state <= ST_IDLE;
+						end
+					end
+				end
+
+				default: state <= ST_IDLE;
+			endcase
+		end
+	end
+
+endmodule
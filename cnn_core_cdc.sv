@@ -0,0 +1,383 @@
+`timescale 1ns/1ps
+// ===== CNN 코어 클럭 도메인 분리 (버스 클럭 ↔ 고속 코어 클럭) =====
+// CNN_TOP_Improved (conv / pool / FC)는 core_clk, 버스 쪽 포트는 CNN_TOP과 같은 형태로 유지
+// - 픽셀 / 시작 / 프레임 설정: async_fifo 하나 (시작 엔트리에 quant / geometry / 시퀀서 설정 동봉 → 순서와 값 일치)
+// - 가중치 쓰기 / 뱅크 교체 요청 / 시퀀서 디스크립터·커널 쓰기: async_fifo 하나 (교체 요청이 앞선 쓰기를 앞지르지 않음)
+// - 결과 묶음: async_fifo → 버스 쪽 1클럭 o_result_valid + 값 유지
+// - 상태 (frame_ready / busy / 뱅크 / 타임아웃 / 단계 busy·stall): 코어 클럭 레지스터 → 2단 동기화
+// 코어 클럭 >= 버스 클럭이면 코어가 클럭당 엔트리 1개씩 비우므로 입력 FIFO는 넘치지 않음
+// (넘치면 쓰기는 버려지고 o_fifo_overflow가 리셋까지 유지, 결과 FIFO도 같음: 버스 쪽이 못 비우면 결과가 버려짐)
+// 지연 / FC 사이클 / 단계 시각 값은 코어 클럭 사이클 수, 단계 busy/stall은 버스 클럭으로 샘플링한 값
+// 코어 클럭 250 MHz (펌웨어 CNN_CORE_MHZ)는 목표값이며 합성 / 배치 타이밍으로 확인한 Fmax가 아님
+// (CORE_RETIME = 1: conv MAC 입력, FC 레인 선택 / RAM 출력, MAC 곱을 모두 등록 → 곱셈기 하나 + 덧셈 한 단이 최장 경로 목표,
+//  구현 타이밍이 못 맞추면 코어 클럭 출력과 CNN_CORE_MHZ를 함께 낮춤)
+module cnn_core_cdc #(
+	parameter QUANT_MODE  = 0,
+	parameter CORE_RETIME = 1,    // MAC 곱 / FC 레인 선택에 레지스터 한 단씩 추가 (CNN_TOP_Improved)
+	parameter PIX_DEPTH   = 16,   // 2의 거듭제곱
+	parameter WT_DEPTH    = 16,
+	parameter RES_DEPTH   = 4
+)(
+	// ===== 버스 클럭 도메인 =====
+	input logic bus_clk,
+	input logic bus_rst,                           // Active Low (AXI 리셋 & ~CNN 소프트 리셋)
+
+	input logic i_start,                           // 상승 에지 = 프레임 시작 (Lite 레벨 / 검출기 펄스)
+	input logic i_pixel_valid,
+	input logic [7:0] i_pixel_in,
+	input logic [31:0] i_quant_cfg,                // 시작 에지에 캡처
+	input logic [31:0] i_geometry,
+	input logic [31:0] i_seq_ctrl,                 // [0] enable, [11:8] 레이어 수만 전달
+
+	input logic i_wt_wr_en,
+	input logic [16:0] i_wt_wr_addr,
+	input logic [31:0] i_wt_wr_data,
+	input logic i_wt_swap_req,
+	input logic i_seq_wr_en,                       // AXI 쓰기라 i_wt_wr_en과 같은 사이클에 오지 않음
+	input logic [16:0] i_seq_wr_addr,
+	input logic [31:0] i_seq_wr_data,
+
+	output logic o_result_valid,                   // 1클럭 펄스, 값은 다음 결과까지 유지
+	output logic signed [47:0] o_lane_result,
+	output logic [1:0] o_class_idx,
+	output logic signed [47:0] o_class_score,
+	output logic [47:0] o_class_margin,
+	output logic [7:0] o_frame_tag,
+	output logic [31:0] o_latency,                 // 코어 클럭 사이클
+	output logic [31:0] o_fc_cycles,               // 코어 클럭 사이클
+	output logic [15:0] o_fc_nonzero,
+	output logic [31:0] o_t_feature,               // 코어 클럭 사이클 (프레임 시작 기준)
+	output logic [31:0] o_t_flatten,
+	output logic [31:0] o_t_fc_start,
+	output logic o_seq_path,                       // 결과가 시퀀서 프레임 (결과와 같이 전달, 현재 SEQ_CTRL과 무관)
+
+	output logic o_frame_ready,                    // 시작 요청이 코어에 반영될 때까지 0
+	output logic o_busy,                           // 코어 동작 중 또는 FIFO에 픽셀 / 결과가 남음
+	output logic [3:0] o_stage_busy,
+	output logic [3:0] o_stage_stall,
+	output logic o_timeout,
+	output logic o_wt_active_bank,
+	output logic o_wt_swap_busy,                   // 교체 요청이 FIFO에 남아 있는 동안에도 1
+	output logic o_seq_busy,
+	output logic o_seq_error,
+	output logic [3:0] o_seq_layer,                // 비트별 동기화: 시퀀서가 멈춰 있을 때 (idle / 오류)만 의미 있음
+	output logic [2:0] o_fifo_overflow,            // [2] 픽셀 FIFO, [1] 가중치 FIFO, [0] 결과 FIFO: full에 쓴 적 있음 (sticky)
+
+	// ===== 코어 클럭 도메인 =====
+	input logic core_clk
+);
+	localparam PIX_W = 1 + 1 + 5 + 8 + 32 + 32;             // {start, valid, seq, pixel, quant, geometry}
+	localparam WT_W  = 1 + 1 + 1 + 17 + 32;                 // {swap, wr_en, seq_wr_en, addr, data}
+	localparam RES_W = 48 + 2 + 48 + 48 + 8 + 32 + 32 + 16 + 3*32 + 1;
+
+	// ===== 코어 리셋 (비동기 어서트, 코어 클럭 동기 해제) =====
+	logic core_rst;
+
+	reset_sync u_core_rst (
+		.clk(core_clk),
+		.async_rst_n(bus_rst),
+		.sync_rst_n(core_rst)
+	);
+
+	// ===== 버스 → 코어: 픽셀 / 시작 =====
+	logic start_d1, start_edge;
+	logic start_tgl;                                // 보낸 시작 요청 (토글)
+	logic [$clog2(PIX_DEPTH):0] pix_wr_level;
+
+	assign start_edge = i_start && !start_d1;
+
+	always_ff @(posedge bus_clk or negedge bus_rst) begin
+		if(!bus_rst) begin
+			start_d1 <= 1'b0;
+			start_tgl <= 1'b0;
+		end else begin
+			start_d1 <= i_start;
+			if(start_edge) start_tgl <= ~start_tgl;
+		end
+	end
+
+	logic pix_empty, pix_full;
+	logic [PIX_W-1:0] pix_rd;
+
+	async_fifo #(
+		.WIDTH(PIX_W),
+		.DEPTH(PIX_DEPTH)
+	) u_pix_fifo (
+		.wr_clk(bus_clk),
+		.wr_rst(bus_rst),
+		.wr_en(start_edge || i_pixel_valid),
+		.wr_data({start_edge, i_pixel_valid, i_seq_ctrl[11:8], i_seq_ctrl[0], i_pixel_in, i_quant_cfg, i_geometry}),
+		.full(pix_full),
+		.wr_level(pix_wr_level),
+		.rd_clk(core_clk),
+		.rd_rst(core_rst),
+		.rd_en(!pix_empty),
+		.rd_data(pix_rd),
+		.empty(pix_empty),
+		.rd_level()
+	);
+
+	// ===== 버스 → 코어: 가중치 쓰기 / 교체 =====
+	logic wt_empty, wt_full;
+	logic [WT_W-1:0] wt_rd;
+	logic [$clog2(WT_DEPTH):0] wt_wr_level;
+
+	async_fifo #(
+		.WIDTH(WT_W),
+		.DEPTH(WT_DEPTH)
+	) u_wt_fifo (
+		.wr_clk(bus_clk),
+		.wr_rst(bus_rst),
+		.wr_en(i_wt_wr_en || i_wt_swap_req || i_seq_wr_en),
+		.wr_data({i_wt_swap_req, i_wt_wr_en, i_seq_wr_en,
+		          i_seq_wr_en ? i_seq_wr_addr : i_wt_wr_addr,
+		          i_seq_wr_en ? i_seq_wr_data : i_wt_wr_data}),
+		.full(wt_full),
+		.wr_level(wt_wr_level),
+		.rd_clk(core_clk),
+		.rd_rst(core_rst),
+		.rd_en(!wt_empty),
+		.rd_data(wt_rd),
+		.empty(wt_empty),
+		.rd_level()
+	);
+
+	// ===== 코어 쪽 입력 레지스터 (FIFO 읽기 → CNN 사이 한 단) =====
+	logic core_start, core_pixel_valid;
+	logic [7:0] core_pixel;
+	logic [31:0] core_quant_cfg, core_geometry, core_seq_ctrl;
+	logic core_wt_wr_en, core_wt_swap, core_seq_wr_en;
+	logic [16:0] core_wt_addr;
+	logic [31:0] core_wt_data;
+	logic start_ack;                                // CNN이 받은 시작 요청 (토글)
+	logic core_start_d;
+
+	always_ff @(posedge core_clk or negedge core_rst) begin
+		if(!core_rst) begin
+			core_start <= 1'b0;
+			core_pixel_valid <= 1'b0;
+			core_pixel <= '0;
+			core_quant_cfg <= '0;
+			core_geometry <= '0;
+			core_seq_ctrl <= '0;
+			core_wt_wr_en <= 1'b0;
+			core_seq_wr_en <= 1'b0;
+			core_wt_swap <= 1'b0;
+			core_wt_addr <= '0;
+			core_wt_data <= '0;
+			start_ack <= 1'b0;
+			core_start_d <= 1'b0;
+		end else begin
+			core_start <= !pix_empty && pix_rd[PIX_W-1];
+			core_pixel_valid <= !pix_empty && pix_rd[PIX_W-2];
+			core_pixel <= pix_rd[64 +: 8];
+			if(!pix_empty && pix_rd[PIX_W-1]) begin
+				core_quant_cfg <= pix_rd[32 +: 32];
+				core_geometry <= pix_rd[0 +: 32];
+				core_seq_ctrl <= {20'd0, pix_rd[73 +: 4], 7'd0, pix_rd[72]};
+			end
+			// CNN이 시작을 본 다음 사이클에 토글 → 등록된 frame_ready (core_st) 변화와 같은 에지
+			core_start_d <= core_start;
+			if(core_start_d) start_ack <= ~start_ack;
+
+			core_wt_swap <= !wt_empty && wt_rd[WT_W-1];
+			core_wt_wr_en <= !wt_empty && wt_rd[WT_W-2];
+			core_seq_wr_en <= !wt_empty && wt_rd[WT_W-3];
+			core_wt_addr <= wt_rd[32 +: 17];
+			core_wt_data <= wt_rd[0 +: 32];
+		end
+	end
+
+	// ===== CNN 코어 =====
+	logic core_result_valid;
+	logic signed [47:0] core_result;
+	logic [1:0] core_class_idx;
+	logic signed [47:0] core_class_score;
+	logic [47:0] core_class_margin;
+	logic [7:0] core_frame_tag;
+	logic core_frame_ready, core_cnn_busy;
+	logic [3:0] core_stage_busy, core_stage_stall;
+	logic [31:0] core_latency, core_fc_cycles;
+	logic [15:0] core_fc_nonzero;
+	logic [31:0] core_t_feature, core_t_flatten, core_t_fc_start;
+	logic core_seq_path;
+	logic core_timeout, core_wt_active_bank, core_wt_swap_busy;
+	logic core_seq_busy, core_seq_error;
+	logic [3:0] core_seq_layer;
+
+	CNN_TOP_Improved #(
+		.QUANT_MODE(QUANT_MODE),
+		.CORE_RETIME(CORE_RETIME)
+	) u_cnn_top (
+		.clk(core_clk),
+		.rst(core_rst),
+		.start_signal(core_start),
+		.pixel_valid(core_pixel_valid),
+		.pixel_in(core_pixel),
+		.final_result_valid(core_result_valid),
+		.final_lane_result(core_result),
+		.final_class_idx(core_class_idx),
+		.final_class_score(core_class_score),
+		.final_class_margin(core_class_margin),
+		.final_frame_tag(core_frame_tag),
+		.frame_ready(core_frame_ready),
+		.cnn_busy(core_cnn_busy),
+		.perf_stage_busy(core_stage_busy),
+		.perf_stage_stall(core_stage_stall),
+		.final_latency(core_latency),
+		.final_fc_cycles(core_fc_cycles),
+		.final_fc_nonzero(core_fc_nonzero),
+		.final_t_feature(core_t_feature),
+		.final_t_flatten(core_t_flatten),
+		.final_t_fc_start(core_t_fc_start),
+		.final_seq_path(core_seq_path),
+		.timeout_error(core_timeout),
+		.i_wt_wr_en(core_wt_wr_en),
+		.i_wt_wr_addr(core_wt_addr),
+		.i_wt_wr_data(core_wt_data),
+		.i_wt_swap_req(core_wt_swap),
+		.o_wt_active_bank(core_wt_active_bank),
+		.o_wt_swap_busy(core_wt_swap_busy),
+		.i_quant_cfg(core_quant_cfg),
+		.i_geometry(core_geometry),
+		.i_seq_ctrl(core_seq_ctrl),
+		.i_seq_wr_en(core_seq_wr_en),
+		.i_seq_wr_addr(core_wt_addr),
+		.i_seq_wr_data(core_wt_data),
+		.o_seq_busy(core_seq_busy),
+		.o_seq_error(core_seq_error),
+		.o_seq_layer(core_seq_layer)
+	);
+
+	// 결과가 결과 FIFO에 들어갈 때까지 busy 유지 (버스 쪽에서 busy가 결과보다 먼저 내려가지 않게)
+	logic core_busy_q;
+
+	always_ff @(posedge core_clk or negedge core_rst) begin
+		if(!core_rst) core_busy_q <= 1'b0;
+		else          core_busy_q <= core_cnn_busy || core_start || core_pixel_valid || core_result_valid;
+	end
+
+	// CNN_TOP 상태 비트는 조합 출력 → 코어 클럭에서 한 번 등록한 뒤 동기화 (글리치가 동기화기로 가지 않게)
+	localparam ST_W = 1 + 4 + 4 + 5 + 6;
+	logic [ST_W-1:0] core_st;
+	logic core_res_ovf;
+
+	always_ff @(posedge core_clk or negedge core_rst) begin
+		if(!core_rst) core_st <= '0;
+		else          core_st <= {core_res_ovf, core_seq_busy, core_seq_error, core_seq_layer,
+		                          core_stage_busy, core_stage_stall, core_frame_ready, core_busy_q, core_timeout,
+		                          core_wt_active_bank, core_wt_swap_busy};
+	end
+
+	// ===== 코어 → 버스: 결과 =====
+	// 결과는 프레임마다 하나, 버스 쪽이 클럭당 하나씩 꺼내므로 RES_DEPTH는 작아도 됨
+	logic res_empty, res_full;
+	logic [RES_W-1:0] res_rd;
+
+	async_fifo #(
+		.WIDTH(RES_W),
+		.DEPTH(RES_DEPTH)
+	) u_res_fifo (
+		.wr_clk(core_clk),
+		.wr_rst(core_rst),
+		.wr_en(core_result_valid),
+		.wr_data({core_result, core_class_idx, core_class_score, core_class_margin, core_frame_tag,
+		          core_latency, core_fc_cycles, core_fc_nonzero, core_t_feature, core_t_flatten, core_t_fc_start,
+		          core_seq_path}),
+		.full(res_full),
+		.wr_level(),
+		.rd_clk(bus_clk),
+		.rd_rst(bus_rst),
+		.rd_en(!res_empty),
+		.rd_data(res_rd),
+		.empty(res_empty),
+		.rd_level()
+	);
+
+	// 결과 FIFO 오버플로 (sticky, 코어 리셋까지): 버스 쪽은 클럭당 하나씩 비우므로 정상 동작에서는 0
+	always_ff @(posedge core_clk or negedge core_rst) begin
+		if(!core_rst)                            core_res_ovf <= 1'b0;
+		else if(core_result_valid && res_full)   core_res_ovf <= 1'b1;
+	end
+
+	always_ff @(posedge bus_clk or negedge bus_rst) begin
+		if(!bus_rst) begin
+			o_result_valid <= 1'b0;
+			o_lane_result <= '0;
+			o_class_idx <= '0;
+			o_class_score <= '0;
+			o_class_margin <= '0;
+			o_frame_tag <= '0;
+			o_latency <= '0;
+			o_fc_cycles <= '0;
+			o_fc_nonzero <= '0;
+			o_t_feature <= '0;
+			o_t_flatten <= '0;
+			o_t_fc_start <= '0;
+			o_seq_path <= 1'b0;
+		end else begin
+			o_result_valid <= !res_empty;
+			if(!res_empty) begin
+				{o_lane_result, o_class_idx, o_class_score, o_class_margin, o_frame_tag,
+				 o_latency, o_fc_cycles, o_fc_nonzero, o_t_feature, o_t_flatten, o_t_fc_start,
+				 o_seq_path} <= res_rd;
+			end
+		end
+	end
+
+	// ===== 코어 → 버스: 상태 동기화 =====
+	// 비트마다 독립인 레벨 신호만 (여러 비트 값은 결과 FIFO로)
+	(* ASYNC_REG = "TRUE" *) logic [ST_W-1:0] st_s1, st_s2;
+	(* ASYNC_REG = "TRUE" *) logic ack_s1, ack_s2;
+	logic ack_d;                                    // 한 단 더: frame_ready / busy 동기화보다 늦게 보이도록
+	logic busy_d;
+	logic wt_inflight_d;
+
+	always_ff @(posedge bus_clk or negedge bus_rst) begin
+		if(!bus_rst) begin
+			st_s1 <= '0;
+			st_s2 <= '0;
+			ack_s1 <= 1'b0;
+			ack_s2 <= 1'b0;
+			ack_d <= 1'b0;
+			busy_d <= 1'b0;
+			wt_inflight_d <= 1'b0;
+		end else begin
+			st_s1 <= core_st;
+			st_s2 <= st_s1;
+			ack_s1 <= start_ack;
+			ack_s2 <= ack_s1;
+			ack_d <= ack_s2;
+			busy_d <= st_s2[3];
+			wt_inflight_d <= (wt_wr_level != 0);
+		end
+	end
+
+	// ===== FIFO 오버플로 (버려진 픽셀 / 가중치 쓰기 / 결과 → 프레임 / 가중치 / 결과가 틀림, CPU가 오류 코드로 확인) =====
+	// 결과 FIFO는 코어 쪽 sticky 비트를 상태 동기화로 받음 (st_s2[ST_W-1])
+	always_ff @(posedge bus_clk or negedge bus_rst) begin
+		if(!bus_rst) begin
+			o_fifo_overflow <= 3'b000;
+		end else begin
+			if((start_edge || i_pixel_valid) && pix_full)                o_fifo_overflow[2] <= 1'b1;
+			if((i_wt_wr_en || i_wt_swap_req || i_seq_wr_en) && wt_full)  o_fifo_overflow[1] <= 1'b1;
+			if(st_s2[ST_W-1])                                            o_fifo_overflow[0] <= 1'b1;
+		end
+	end
+
+	logic start_inflight;
+	assign start_inflight = (start_tgl != ack_d);
+
+	assign o_stage_busy     = st_s2[12:9];
+	assign o_stage_stall    = st_s2[8:5];
+	assign o_frame_ready    = st_s2[4] && !start_inflight;
+	assign o_busy           = busy_d || st_s2[3] || start_inflight || (pix_wr_level != 0) ||
+	                          !res_empty || o_result_valid;
+	assign o_timeout        = st_s2[2];
+	assign o_wt_active_bank = st_s2[1];
+	assign o_wt_swap_busy   = st_s2[0] || (wt_wr_level != 0) || wt_inflight_d;
+	assign o_seq_busy       = st_s2[18];
+	assign o_seq_error      = st_s2[17];
+	assign o_seq_layer      = st_s2[16:13];
+
+endmodule
@@ -0,0 +1,271 @@
+`timescale 1ns/1ps
+// ===== 프레임별 지연 기록기 (최근 DEPTH 프레임 원형 버퍼 + 이벤트 기록, 트리거 시 정지) =====
+// 프레임마다 엔트리 1개: 첫 픽셀 시각 + 마지막 픽셀 / 결과 / 소프트웨어 읽기까지의 버스 사이클,
+//   코어 단계 시각 (feature 완료 / flatten 완료 / FC 시작 / FC 완료, 코어 시작 기준 코어 클럭 사이클)
+// 프레임 순서 = 결과 순서 (결과 FIFO 시각 큐와 같은 가정), 워치독 타임아웃은 대기 중인 가장 오래된 프레임을 잃은 것으로 처리
+// 소프트웨어 읽기: 결과 FIFO pop 시 헤드 시퀀스 번호로 엔트리를 찾음 (FIFO가 가득 차 버린 결과는 읽기 없음)
+// 이벤트 (워치독 / 결과 FIFO overflow / 지연 임계 초과)는 EV_DEPTH개 원형 기록
+// 트리거 (지연 > i_threshold, 워치독, overflow 중 선택) 후 i_post개 결과를 더 기록하고 정지 → i_rearm으로 재개
+// 읽기: i_sel [3:0] 워드, [7:4] 엔트리, [8] 1 = 이벤트 (조합 출력, AXI 슬레이브가 레지스터로 받음)
+module cnn_flight_recorder #(
+	parameter DEPTH    = 16,    // 프레임 엔트리 (2의 거듭제곱, 상태 레지스터 필드는 16 기준)
+	parameter EV_DEPTH = 8,
+	parameter MAP_DEPTH = 16    // 결과 FIFO 깊이 이상 (시퀀스 번호 → 엔트리)
+)(
+	input logic clk,
+	input logic rst,   // Active Low
+
+	// ===== 설정 =====
+	input logic i_enable,
+	input logic i_trig_latency,                 // 첫 픽셀 → 결과 > i_threshold 에서 트리거
+	input logic i_trig_watchdog,
+	input logic i_trig_overflow,
+	input logic [31:0] i_threshold,             // 버스 사이클 (0 = 지연 검사 안 함)
+	input logic [7:0] i_post,                   // 트리거 후 더 기록할 결과 수 (0 = 즉시 정지)
+	input logic i_rearm,                        // 펄스: 정지 해제 + 트리거 재무장
+	input logic i_flush,                        // CNN 리셋: 처리 중 프레임 포기
+
+	// ===== 프레임 이벤트 (버스 클럭) =====
+	input logic i_frame_first,
+	input logic i_frame_last,
+	input logic i_result_valid,
+	input logic i_reused,
+	input logic i_seq_path,                     // 레이어 시퀀서 결과 (코어 단계 시각 없음)
+	input logic [31:0] i_t_feature,             // 코어 클럭 사이클 (코어 프레임 시작 기준)
+	input logic [31:0] i_t_flatten,
+	input logic [31:0] i_t_fc_start,
+	input logic [31:0] i_t_fc_done,
+	input logic i_rf_full,                      // 이 결과는 결과 FIFO에 못 들어감
+	input logic i_pop,
+	input logic [31:0] i_pop_seq,               // pop 직전 헤드 엔트리 시퀀스 번호
+	input logic i_timeout,                      // 워치독 (레벨, 상승 에지 = 이벤트 1개)
+	input logic [31:0] i_now,
+
+	// ===== 읽기 =====
+	input logic [8:0] i_sel,
+	output logic [31:0] o_sel_data,
+	output logic [31:0] o_status
+);
+	localparam AW = $clog2(DEPTH);
+	localparam EW = $clog2(EV_DEPTH);
+	localparam MW = $clog2(MAP_DEPTH);
+
+	localparam EV_WATCHDOG = 8'd1;
+	localparam EV_OVERFLOW = 8'd2;
+	localparam EV_LATENCY  = 8'd3;
+
+	// ===== 프레임 엔트리 (필드별 배열: 이벤트마다 쓰는 필드가 다름) =====
+	logic [31:0] ts_first [0:DEPTH-1];
+	logic [31:0] d_last   [0:DEPTH-1];
+	logic [31:0] d_result [0:DEPTH-1];
+	logic [31:0] d_read   [0:DEPTH-1];
+	logic [31:0] t_feature  [0:DEPTH-1];
+	logic [31:0] t_flatten  [0:DEPTH-1];
+	logic [31:0] t_fc_start [0:DEPTH-1];
+	logic [31:0] t_fc_done  [0:DEPTH-1];
+	logic [15:0] res_seq  [0:DEPTH-1];
+	logic [DEPTH-1:0] f_valid, f_result, f_reused, f_seq, f_read, f_overflow, f_watchdog;
+
+	logic [AW-1:0] seq_map [0:MAP_DEPTH-1];
+	logic [31:0] ev_ts   [0:EV_DEPTH-1];
+	logic [31:0] ev_info [0:EV_DEPTH-1];
+
+	// 포인터 (한 비트 더: 대기 프레임 수 계산)
+	logic [AW:0] wr_ptr, last_ptr, res_ptr;
+	logic [EW-1:0] ev_ptr;
+	logic [7:0] ev_count;
+	logic [31:0] res_cnt;                       // 결과 FIFO 시퀀스 번호와 같은 규칙 (AXI 리셋 후 결과 수)
+
+	logic triggered, frozen;
+	logic [7:0] post_cnt;
+	logic [AW-1:0] trig_entry;
+	logic timeout_d;
+
+	// ===== 이번 사이클 이벤트 =====
+	logic rec, first, res_pending, last_pending;
+	logic do_result, wdt_rise, wdt_lost, ovf, lat_over;
+	logic [AW-1:0] idx_w, idx_l, idx_r, idx_p;
+	logic [31:0] lat;
+	logic pop_hit, trig_now, ev_fire;
+	logic [AW:0] res_tmp, res_nxt, last_tmp, last_nxt, wr_nxt;
+
+	assign rec = i_enable && !frozen;
+	assign first = rec && i_frame_first;
+	assign res_pending = (res_ptr != wr_ptr);
+	assign last_pending = (last_ptr != wr_ptr);
+	assign idx_w = wr_ptr[AW-1:0];
+	assign idx_l = last_ptr[AW-1:0];
+	assign idx_r = res_ptr[AW-1:0];
+	assign idx_p = seq_map[i_pop_seq[MW-1:0]];
+
+	assign do_result = rec && i_result_valid && res_pending;
+	assign wdt_rise  = i_timeout && !timeout_d;
+	assign wdt_lost  = rec && wdt_rise && res_pending && !i_result_valid;
+	assign ovf       = i_result_valid && i_rf_full;
+	assign lat       = i_now - ts_first[idx_r];
+	assign lat_over  = do_result && (i_threshold != 32'd0) && (lat > i_threshold);
+	assign ev_fire   = i_enable && (wdt_rise || ovf || lat_over);
+	assign pop_hit   = rec && i_pop && f_result[idx_p] && !f_read[idx_p] && (res_seq[idx_p] == i_pop_seq[15:0]);
+	assign trig_now  = rec && !triggered &&
+	                   ((i_trig_latency && lat_over) || (i_trig_watchdog && wdt_rise) || (i_trig_overflow && ovf));
+
+	// 포인터 다음 값: 결과 / 잃은 프레임은 res 전진, 대기 프레임이 DEPTH를 넘으면 가장 오래된 것 포기
+	// last는 res보다 뒤처지지 않음 (마지막 픽셀 표시가 없는 경로)
+	always_comb begin
+		wr_nxt = wr_ptr + (first ? 1'b1 : 1'b0);
+		res_tmp = res_ptr + ((do_result || wdt_lost) ? 1'b1 : 1'b0);
+		res_nxt = (first && (wr_ptr - res_tmp) == (AW+1)'(DEPTH)) ? res_tmp + 1'b1 : res_tmp;
+		last_tmp = last_ptr + ((rec && i_frame_last && (last_pending || first)) ? 1'b1 : 1'b0);
+		last_nxt = ((wr_nxt - last_tmp) > (wr_nxt - res_nxt)) ? res_nxt : last_tmp;
+		if (!rec || i_flush) begin
+			res_nxt = wr_nxt;
+			last_nxt = wr_nxt;
+		end
+	end
+
+	// ===== 엔트리 기록 (같은 엔트리면 뒤의 쓰기 우선: 새 프레임 초기화가 마지막) =====
+	always_ff @(posedge clk) begin
+		if (pop_hit) d_read[idx_p] <= i_now - ts_first[idx_p];
+		if (rec && i_frame_last && last_pending) d_last[idx_l] <= i_now - ts_first[idx_l];
+		if (do_result) begin
+			d_result[idx_r]   <= lat;
+			t_feature[idx_r]  <= i_t_feature;
+			t_flatten[idx_r]  <= i_t_flatten;
+			t_fc_start[idx_r] <= i_t_fc_start;
+			t_fc_done[idx_r]  <= i_t_fc_done;
+			res_seq[idx_r]    <= res_cnt[15:0];
+			seq_map[res_cnt[MW-1:0]] <= idx_r;
+		end
+		if (first) begin
+			ts_first[idx_w]   <= i_now;
+			d_last[idx_w]     <= 32'd0;
+			d_result[idx_w]   <= 32'd0;
+			d_read[idx_w]     <= 32'd0;
+			t_feature[idx_w]  <= 32'd0;
+			t_flatten[idx_w]  <= 32'd0;
+			t_fc_start[idx_w] <= 32'd0;
+			t_fc_done[idx_w]  <= 32'd0;
+		end
+		if (ev_fire && !frozen) begin
+			ev_ts[ev_ptr] <= i_now;
+			ev_info[ev_ptr] <= {wdt_rise ? EV_WATCHDOG : (ovf ? EV_OVERFLOW : EV_LATENCY),
+			                    8'(res_pending ? idx_r : idx_w - 1'b1), res_cnt[15:0]};
+		end
+	end
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			f_valid <= '0;
+			f_result <= '0;
+			f_reused <= '0;
+			f_seq <= '0;
+			f_read <= '0;
+			f_overflow <= '0;
+			f_watchdog <= '0;
+			wr_ptr <= '0;
+			last_ptr <= '0;
+			res_ptr <= '0;
+			ev_ptr <= '0;
+			ev_count <= '0;
+			res_cnt <= '0;
+			triggered <= 1'b0;
+			frozen <= 1'b0;
+			post_cnt <= '0;
+			trig_entry <= '0;
+			timeout_d <= 1'b0;
+		end else begin
+			timeout_d <= i_timeout;
+			if (i_result_valid) res_cnt <= res_cnt + 1;
+
+			wr_ptr <= wr_nxt;
+			res_ptr <= res_nxt;
+			last_ptr <= last_nxt;
+
+			if (pop_hit) f_read[idx_p] <= 1'b1;
+			if (do_result) begin
+				f_result[idx_r] <= 1'b1;
+				f_reused[idx_r] <= i_reused;
+				f_seq[idx_r] <= i_seq_path;
+				f_overflow[idx_r] <= i_rf_full;
+			end
+			if (wdt_lost) f_watchdog[idx_r] <= 1'b1;
+			if (first) begin
+				f_valid[idx_w] <= 1'b1;
+				f_result[idx_w] <= 1'b0;
+				f_reused[idx_w] <= 1'b0;
+				f_seq[idx_w] <= 1'b0;
+				f_read[idx_w] <= 1'b0;
+				f_overflow[idx_w] <= 1'b0;
+				f_watchdog[idx_w] <= 1'b0;
+			end
+
+			if (ev_fire) begin
+				if (ev_count != 8'hFF) ev_count <= ev_count + 1'b1;
+				if (!frozen) ev_ptr <= ev_ptr + 1'b1;
+			end
+
+			// 트리거 → i_post개 결과 뒤 정지
+			if (i_rearm) begin
+				triggered <= 1'b0;
+				frozen <= 1'b0;
+				post_cnt <= '0;
+			end else if (trig_now) begin
+				triggered <= 1'b1;
+				trig_entry <= res_pending ? idx_r : idx_w - 1'b1;
+				post_cnt <= i_post;
+				frozen <= (i_post == 8'd0);
+			end else if (triggered && !frozen && do_result) begin
+				post_cnt <= post_cnt - 1'b1;
+				if (post_cnt <= 8'd1) frozen <= 1'b1;
+			end
+		end
+	end
+
+	// ===== 읽기 =====
+	logic [AW-1:0] sel_entry;
+	assign sel_entry = i_sel[4 +: AW];
+
+	always_comb begin
+		if (i_sel[8]) begin
+			case (i_sel[0])
+				1'b0: o_sel_data = ev_ts[i_sel[4 +: EW]];
+				default: o_sel_data = ev_info[i_sel[4 +: EW]];   // [31:24] 종류, [23:16] 엔트리, [15:0] 결과 번호
+			endcase
+		end else begin
+			case (i_sel[3:0])
+				4'd0: o_sel_data = ts_first[sel_entry];
+				4'd1: o_sel_data = d_last[sel_entry];
+				4'd2: o_sel_data = d_result[sel_entry];
+				4'd3: o_sel_data = d_read[sel_entry];
+				4'd4: o_sel_data = t_feature[sel_entry];
+				4'd5: o_sel_data = t_flatten[sel_entry];
+				4'd6: o_sel_data = t_fc_start[sel_entry];
+				4'd7: o_sel_data = t_fc_done[sel_entry];
+				4'd8: o_sel_data = {res_seq[sel_entry],
+				                    8'b0,
+				                    f_valid[sel_entry],
+				                    triggered && (trig_entry == sel_entry),
+				                    f_result[sel_entry],
+				                    f_seq[sel_entry],
+				                    f_read[sel_entry],
+				                    f_overflow[sel_entry],
+				                    f_watchdog[sel_entry],
+				                    f_reused[sel_entry]};
+				default: o_sel_data = 32'd0;
+			endcase
+		end
+	end
+
+	assign o_status = {
+		8'b0,                     // Reserved [31:24]
+		ev_count,                 // EVENTS [23:16] - 기록한 이벤트 수 (포화)
+		2'b0,                     // Reserved [15:14]
+		frozen,                   // FROZEN [13]
+		triggered,                // TRIGGERED [12]
+		1'b0,                     // Reserved [11]
+		3'(ev_ptr),               // EV_NEXT [10:8] - 다음 이벤트 자리 (가득 차면 가장 오래된 것)
+		4'(trig_entry),           // TRIG_ENTRY [7:4]
+		4'(wr_ptr[AW-1:0])        // NEXT [3:0] - 다음 프레임 자리 (가득 차면 가장 오래된 것)
+	};
+
+endmodule
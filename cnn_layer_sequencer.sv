@@ -0,0 +1,523 @@
+`timescale 1ns/1ps
+// ===== 레이어 시퀀서: CNN_TOP_Improved의 conv / pool / FC 엔진을 레이어마다 시간 분할로 구동 =====
+// 엔진은 CNN_TOP_Improved 안의 것을 그대로 쓰고 (mux는 CNN_TOP), 여기에는 디스크립터 표,
+// 레이어 사이 핑퐁 특징 맵, conv 커널 메모리, 제어 FSM만 있음
+module cnn_layer_sequencer #(
+	parameter MAX_LAYERS = 8,
+	parameter MAX_WIDTH  = 32,     // 코어 conv/pool 라인 버퍼 최대 크기
+	parameter MAX_HEIGHT = 32,
+	parameter MAP_WORDS  = 4096,   // 특징 맵 뱅크당 워드 수 (22비트, 핑퐁 2뱅크)
+	parameter WMEM_WORDS = 2048,   // conv 커널 메모리 워드 수 (FC 가중치는 코어 FC 가중치 뱅크)
+	parameter FC_INPUTS  = 256,    // 코어 FC 최대 입력 수 (flatten 뱅크 크기)
+	parameter FC_NEURONS = 5,      // 코어 FC 뉴런 수
+	parameter FC_WIDTH   = 22      // 코어 FC 활성값 폭 (flatten 뱅크 폭)
+)(
+	input logic clk,
+	input logic rst,   // Active Low (negedge)
+
+	// ===== 설정 (MicroBlaze, 시퀀서가 idle일 때만 변경) =====
+	input logic [3:0] i_num_layers,                          // 실행할 레이어 수 (1~MAX_LAYERS)
+	input logic i_desc_wr_en,
+	input logic [$clog2(MAX_LAYERS*4)-1:0] i_desc_wr_addr,   // 레이어 * 4 + 워드
+	input logic [31:0] i_desc_wr_data,
+	input logic i_wmem_wr_en,
+	input logic [$clog2(WMEM_WORDS)-1:0] i_wmem_wr_addr,
+	input logic signed [21:0] i_wmem_wr_data,
+
+	// ===== 프레임 입력 (레이어 0 입력 맵: 채널 순, 채널 안은 행 우선) =====
+	input logic i_frame_start,
+	input logic i_pixel_valid,
+	input logic [7:0] i_pixel_in,
+	output logic o_frame_ready,
+
+	// ===== 결과 (마지막 레이어 출력 0 = 차선, 1~4 = 클래스) =====
+	output logic o_result_valid,
+	output logic signed [47:0] o_lane_result,
+	output logic [1:0] o_class_idx,
+	output logic signed [47:0] o_class_score,
+	output logic [47:0] o_class_margin,
+	output logic [31:0] o_latency,   // 프레임 시작 → 결과 사이클 수 (o_result_valid와 함께 유효)
+
+	output logic o_busy,
+	output logic o_error,          // 디스크립터 오류 / FC 타임아웃 (다음 프레임 시작 시 해제)
+	output logic [3:0] o_layer,    // 실행 중인 레이어 (오류 시 오류가 난 레이어)
+
+	// ===== 코어 엔진 연결 (o_busy 동안 CNN_TOP이 엔진 입력을 이쪽으로 전환) =====
+	output logic [$clog2(MAX_WIDTH):0] o_img_width,     // 이번 패스의 conv / pool 입력 크기
+	output logic [$clog2(MAX_HEIGHT):0] o_img_height,
+	output logic signed [7:0] o_kernel [0:8],           // conv 오버라이드 커널 (이번 (출력, 입력) 채널 쌍)
+	output logic o_conv_start,
+	output logic o_conv_valid,
+	output logic [7:0] o_conv_pixel,
+	input logic signed [21:0] i_conv_result,            // ReLU 전 conv 결과
+	input logic i_conv_valid,
+	output logic o_pool_start,
+	output logic o_pool_valid,
+	output logic signed [21:0] o_pool_pixel,
+	input logic signed [21:0] i_pool_result,
+	input logic i_pool_valid,
+	// FC: 입력 벡터를 flatten 쓰기 뱅크에 한 프레임처럼 쓰면 코어 FC가 계산 (가중치 = 코어 FC 활성 뱅크)
+	output logic o_fc_wr_valid,
+	output logic signed [FC_WIDTH-1:0] o_fc_wr_data,
+	output logic o_fc_wr_done,                          // 마지막 값과 같은 사이클
+	input logic i_fc_result_valid,
+	input logic i_fc_timeout,
+	input logic signed [47:0] i_fc_neuron [0:FC_NEURONS-1]
+);
+	// ===== 디스크립터 형식 (레이어당 32비트 워드 4개) =====
+	//  word0: [1:0] op (0 = conv 3x3 valid, 1 = max pool 2x2, 2 = FC), [4] ReLU,
+	//         [12:8] 입력 시프트 (conv: 22비트 → 8비트 픽셀, FC: 22비트 → FC 활성값 폭), [21:16] 출력 시프트 (누적값 → 22비트)
+	//  word1: [7:0] 입력 폭, [15:8] 입력 높이, [23:16] 입력 채널, [31:24] 출력 채널 (FC: 출력 수, 최대 FC_NEURONS)
+	//  word2: [15:0] conv 커널 베이스 ((출력 채널, 입력 채널) 순 3x3 커널), FC는 무시 (코어 FC 뉴런 0~출력 수-1)
+	//  word3: [7:0] 출력 폭, [15:8] 출력 높이 (op에서 계산한 크기와 다르면 오류)
+	// 레이어 N은 뱅크 N[0]에서 읽고 반대 뱅크에 씀 → 레이어 사이 CPU 개입 없음
+	// FC 입력 수는 코어 flatten 뱅크 크기 (FC_INPUTS) 이하
+	localparam OP_CONV = 2'd0;
+	localparam OP_POOL = 2'd1;
+	localparam OP_FC   = 2'd2;
+	localparam DESC_WORDS = MAX_LAYERS * 4;
+	localparam MAP_AW = $clog2(MAP_WORDS);
+	localparam WMEM_AW = $clog2(WMEM_WORDS);
+	localparam NUM_RESULTS = 5;
+
+	logic [31:0] desc_mem [0:DESC_WORDS-1];
+	logic signed [21:0] wmem [0:WMEM_WORDS-1];
+	logic signed [21:0] fmap0 [0:MAP_WORDS-1];
+	logic signed [21:0] fmap1 [0:MAP_WORDS-1];
+
+	enum logic [3:0] {
+		S_IDLE, S_LOAD, S_SETUP, S_KLOAD, S_STREAM, S_DRAIN, S_FC_WB, S_LDONE, S_RESULT
+	} state;
+
+	// ===== 현재 레이어 디스크립터 (S_SETUP에서 래치) =====
+	logic [3:0] layer, num_layers_r;
+	logic [1:0] op_r;
+	logic relu_r;
+	logic [4:0] in_shift_r;
+	logic [5:0] out_shift_r;
+	logic [7:0] in_w_r, in_h_r, in_c_r, out_c_r;
+	logic [23:0] in_plane_r, out_plane_r;
+
+	// 디코드 (레이어 인덱스로 직접 읽음)
+	logic [31:0] d0, d1, d2, d3;
+	logic [7:0] d_in_w, d_in_h, d_in_c, d_out_c, d_out_w, d_out_h;
+	logic [23:0] d_in_plane, d_out_plane, d_in_words, d_out_words;
+	logic [31:0] d_wt_end;
+	logic desc_ok;
+	logic [23:0] l0_in_words;   // 레이어 0 입력 크기 = 프레임 픽셀 수
+
+	assign d0 = desc_mem[{layer[2:0], 2'd0}];
+	assign d1 = desc_mem[{layer[2:0], 2'd1}];
+	assign d2 = desc_mem[{layer[2:0], 2'd2}];
+	assign d3 = desc_mem[{layer[2:0], 2'd3}];
+	assign d_in_w  = d1[7:0];
+	assign d_in_h  = d1[15:8];
+	assign d_in_c  = d1[23:16];
+	assign d_out_c = (d0[1:0] == OP_POOL) ? d1[23:16] : d1[31:24];
+	assign d_out_w = d3[7:0];
+	assign d_out_h = d3[15:8];
+	assign d_in_plane  = d_in_w * d_in_h;
+	assign d_out_plane = d_out_w * d_out_h;
+	assign d_in_words  = d_in_plane * d_in_c;
+	assign d_out_words = d_out_plane * d_out_c;
+	assign l0_in_words = desc_mem[1][7:0] * desc_mem[1][15:8] * desc_mem[1][23:16];
+	assign d_wt_end = 32'(d2[15:0]) + d_out_c * d_in_c * 9;
+
+	always_comb begin
+		desc_ok = (d_in_c != 0) && (d_out_c != 0) && (d_in_words <= MAP_WORDS) && (d_out_words <= MAP_WORDS);
+		case(d0[1:0])
+			OP_CONV: desc_ok &= (d_in_w >= 3) && (d_in_w <= MAX_WIDTH) && (d_in_h >= 3) && (d_in_h <= MAX_HEIGHT) &&
+			                    (d_out_w == d_in_w - 2) && (d_out_h == d_in_h - 2) && (d_wt_end <= WMEM_WORDS);
+			OP_POOL: desc_ok &= (d_in_w >= 2) && (d_in_w <= MAX_WIDTH) && (d_in_h >= 2) && (d_in_h <= MAX_HEIGHT) &&
+			                    (d_out_w == d_in_w >> 1) && (d_out_h == d_in_h >> 1);
+			OP_FC:   desc_ok &= (d_in_words != 0) && (d_in_words <= FC_INPUTS) && (d_out_c <= FC_NEURONS) &&
+			                    (d_out_w == 1) && (d_out_h == 1);
+			default: desc_ok = 1'b0;
+		endcase
+	end
+
+	// ===== 진행 카운터 =====
+	logic [7:0] oc, ic;                        // 출력 채널(FC 뉴런) / 입력 채널
+	logic [MAP_AW-1:0] src_base, dst_base;
+	logic [WMEM_AW-1:0] wt_ptr;
+	logic [23:0] load_cnt, load_len;
+	logic [23:0] rd_cnt, rd_len;
+	logic rd_active, strm_valid;
+	logic [23:0] out_cnt, fc_cnt;
+	logic [3:0] kcnt;
+	logic signed [7:0] kreg [0:8];              // 이번 (출력, 입력) 채널 쌍의 conv 커널
+	logic src_bank;
+	logic last_layer;
+
+	assign src_bank = layer[0];
+	assign last_layer = (layer == num_layers_r - 1);
+
+	// ===== 코어 엔진 구동 =====
+	logic signed [21:0] stream_data, psum_data;
+	logic signed [21:0] conv_result;
+	logic conv_valid;
+	logic signed [21:0] wmem_q;
+	logic [WMEM_AW-1:0] wmem_rd_addr;
+
+	assign conv_result = i_conv_result;
+	assign conv_valid = i_conv_valid;
+
+	assign o_img_width = in_w_r[$clog2(MAX_WIDTH):0];
+	assign o_img_height = in_h_r[$clog2(MAX_HEIGHT):0];
+	assign o_kernel = kreg;
+	assign o_conv_start = (state == S_STREAM) && (op_r == OP_CONV);
+	assign o_pool_start = (state == S_STREAM) && (op_r == OP_POOL);
+	assign o_conv_valid = strm_valid && (op_r == OP_CONV);
+	assign o_pool_valid = strm_valid && (op_r == OP_POOL);
+	assign o_pool_pixel = stream_data;
+	assign o_fc_wr_valid = strm_valid && (op_r == OP_FC);
+	assign o_fc_wr_done = o_fc_wr_valid && (fc_cnt == rd_len - 1);
+
+	// 22비트 특징 → conv 8비트 입력: 시프트 후 0~255 포화 (첫 레이어는 픽셀 그대로)
+	always_comb begin
+		logic signed [21:0] shifted;
+		shifted = stream_data >>> in_shift_r;
+		if(shifted < 0)         o_conv_pixel = 8'd0;
+		else if(shifted > 255)  o_conv_pixel = 8'd255;
+		else                    o_conv_pixel = shifted[7:0];
+	end
+
+	// 22비트 특징 → FC 활성값: 시프트 후 FC_WIDTH 포화 (22비트 FC면 시프트만)
+	always_comb begin
+		logic signed [21:0] shifted;
+		shifted = stream_data >>> in_shift_r;
+		if(shifted > $signed(22'(2**(FC_WIDTH-1) - 1)))       o_fc_wr_data = {1'b0, {(FC_WIDTH-1){1'b1}}};
+		else if(shifted < $signed(22'(-(2**(FC_WIDTH-1)))))   o_fc_wr_data = {1'b1, {(FC_WIDTH-1){1'b0}}};
+		else                                                  o_fc_wr_data = shifted[FC_WIDTH-1:0];
+	end
+
+	// ===== 출력 후처리: 시프트 → 22비트 포화 → ReLU =====
+	function automatic logic signed [21:0] sat22(input logic signed [47:0] v);
+		if(v > 48'sd2097151)        return 22'sh1FFFFF;
+		else if(v < -48'sd2097152)  return 22'sh200000;
+		else                        return v[21:0];
+	endfunction
+
+	function automatic logic signed [21:0] act_out(input logic signed [47:0] v, input logic [5:0] sh, input logic relu);
+		logic signed [21:0] s;
+		s = sat22(v >>> sh);
+		return (relu && s < 0) ? 22'sd0 : s;
+	endfunction
+
+	// ===== 특징 맵 쓰기 (프레임 로드 / conv / pool / FC 결과) =====
+	logic fm_wr_en, fm_wr_bank;
+	logic [MAP_AW-1:0] fm_wr_addr;
+	logic signed [21:0] fm_wr_data;
+	logic signed [47:0] conv_sum;
+
+	// 입력 채널 누적: 첫 채널은 0부터, 이후 채널은 이전 부분합에 더함 (마지막 채널에서 시프트/ReLU)
+	assign conv_sum = ((ic == 0) ? 48'sd0 : 48'(psum_data)) + 48'(conv_result);
+
+	always_comb begin
+		fm_wr_en = 1'b0;
+		fm_wr_bank = ~src_bank;
+		fm_wr_addr = dst_base + out_cnt[MAP_AW-1:0];
+		fm_wr_data = '0;
+		case(state)
+			S_LOAD: begin
+				fm_wr_en = i_pixel_valid;
+				fm_wr_bank = 1'b0;
+				fm_wr_addr = load_cnt[MAP_AW-1:0];
+				fm_wr_data = 22'(i_pixel_in);
+			end
+			S_DRAIN: begin
+				if(op_r == OP_CONV && conv_valid) begin
+					fm_wr_en = 1'b1;
+					fm_wr_data = (ic == in_c_r - 1) ? act_out(conv_sum, out_shift_r, relu_r) : sat22(conv_sum);
+				end else if(op_r == OP_POOL && i_pool_valid) begin
+					fm_wr_en = 1'b1;
+					fm_wr_data = i_pool_result;
+				end
+			end
+			S_FC_WB: begin
+				fm_wr_en = 1'b1;
+				fm_wr_addr = dst_base;
+				fm_wr_data = act_out(i_fc_neuron[oc], out_shift_r, relu_r);
+			end
+			default: ;
+		endcase
+	end
+
+	// ===== 핑퐁 BRAM (뱅크마다 읽기 1 + 쓰기 1) =====
+	// 원본 뱅크: 스트림 읽기, 대상 뱅크: conv 부분합 읽기 (다음 결과 주소를 미리 읽음)
+	logic [MAP_AW-1:0] stream_addr, psum_addr;
+	logic signed [21:0] rd_q0, rd_q1;
+
+	assign stream_addr = src_base + rd_cnt[MAP_AW-1:0];
+	assign psum_addr = dst_base + out_cnt[MAP_AW-1:0] + MAP_AW'(conv_valid);
+
+	always @(posedge clk) begin
+		if(fm_wr_en && !fm_wr_bank) fmap0[fm_wr_addr] <= fm_wr_data;
+		rd_q0 <= fmap0[src_bank ? psum_addr : stream_addr];
+	end
+
+	always @(posedge clk) begin
+		if(fm_wr_en && fm_wr_bank) fmap1[fm_wr_addr] <= fm_wr_data;
+		rd_q1 <= fmap1[src_bank ? stream_addr : psum_addr];
+	end
+
+	assign stream_data = src_bank ? rd_q1 : rd_q0;
+	assign psum_data   = src_bank ? rd_q0 : rd_q1;
+
+	// ===== 디스크립터 / 커널 메모리 (리셋 없음: 소프트 리셋 후에도 유지) =====
+	assign wmem_rd_addr = wt_ptr + WMEM_AW'(kcnt);
+
+	always @(posedge clk) begin
+		if(i_desc_wr_en) desc_mem[i_desc_wr_addr] <= i_desc_wr_data;
+	end
+
+	always @(posedge clk) begin
+		if(i_wmem_wr_en) wmem[i_wmem_wr_addr] <= i_wmem_wr_data;
+		wmem_q <= wmem[wmem_rd_addr];
+	end
+
+	// 기본 네트워크 = 고정 파이프라인과 같은 구성 (conv 32x32 → pool 30x30 → FC 225x5, FC 가중치는 코어 뱅크)
+	initial begin
+		for(int i = 0; i < DESC_WORDS; i++) desc_mem[i] = 32'h0;
+		desc_mem[0]  = 32'h0000_0010;  desc_mem[1]  = 32'h0101_2020;  desc_mem[2]  = 32'd0;  desc_mem[3]  = 32'h0000_1E1E;
+		desc_mem[4]  = 32'h0000_0001;  desc_mem[5]  = 32'h0101_1E1E;  desc_mem[6]  = 32'd0;  desc_mem[7]  = 32'h0000_0F0F;
+		desc_mem[8]  = 32'h0000_0002;  desc_mem[9]  = 32'h0501_0F0F;  desc_mem[10] = 32'd0;  desc_mem[11] = 32'h0000_0101;
+
+		for(int i = 0; i < WMEM_WORDS; i++) wmem[i] = '0;
+		wmem[0] = 22'sd1;  wmem[1] = 22'sd0;  wmem[2] = -22'sd1;   // Sobel
+		wmem[3] = 22'sd2;  wmem[4] = 22'sd0;  wmem[5] = -22'sd2;
+		wmem[6] = 22'sd1;  wmem[7] = 22'sd0;  wmem[8] = -22'sd1;
+	end
+
+	// ===== 스트림 읽기 =====
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			rd_cnt <= '0;
+			rd_active <= 1'b0;
+			strm_valid <= 1'b0;
+		end else begin
+			strm_valid <= rd_active;   // BRAM 읽기 지연 1사이클
+			if(state == S_STREAM) begin
+				rd_cnt <= '0;
+				rd_active <= 1'b1;
+			end else if(rd_active) begin
+				if(rd_cnt == rd_len - 1) rd_active <= 1'b0;
+				else rd_cnt <= rd_cnt + 1;
+			end
+		end
+	end
+
+	// ===== 레이어 시퀀서 =====
+	logic signed [47:0] res [0:NUM_RESULTS-1];
+	logic [23:0] last_out_words;
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			state <= S_IDLE;
+			layer <= '0;
+			num_layers_r <= '0;
+			op_r <= OP_CONV;
+			relu_r <= 1'b0;
+			in_shift_r <= '0;
+			out_shift_r <= '0;
+			in_w_r <= '0;
+			in_h_r <= '0;
+			in_c_r <= '0;
+			out_c_r <= '0;
+			in_plane_r <= '0;
+			out_plane_r <= '0;
+			oc <= '0;
+			ic <= '0;
+			src_base <= '0;
+			dst_base <= '0;
+			wt_ptr <= '0;
+			load_cnt <= '0;
+			load_len <= '0;
+			rd_len <= '0;
+			out_cnt <= '0;
+			fc_cnt <= '0;
+			kcnt <= '0;
+			kreg <= '{default: '0};
+			last_out_words <= '0;
+			o_error <= 1'b0;
+			for(int i = 0; i < NUM_RESULTS; i++) res[i] <= '0;
+		end else begin
+			// 엔진 출력 계수 (S_DRAIN에서만 발생)
+			if(fm_wr_en && state == S_DRAIN) begin
+				out_cnt <= out_cnt + 1;
+				if(last_layer && (dst_base + out_cnt) < NUM_RESULTS)
+					res[dst_base + out_cnt] <= 48'(fm_wr_data);
+			end
+			if(o_fc_wr_valid) fc_cnt <= fc_cnt + 1;
+
+			case(state)
+				S_IDLE: begin
+					if(i_frame_start) begin
+						layer <= '0;
+						o_error <= 1'b0;
+						num_layers_r <= i_num_layers;
+						load_cnt <= '0;
+						load_len <= l0_in_words;
+						for(int i = 0; i < NUM_RESULTS; i++) res[i] <= '0;
+						if(i_num_layers == 0 || i_num_layers > MAX_LAYERS || l0_in_words > MAP_WORDS || l0_in_words == 0)
+							o_error <= 1'b1;
+						else
+							state <= S_LOAD;
+					end
+				end
+
+				S_LOAD: begin
+					if(i_pixel_valid) begin
+						load_cnt <= load_cnt + 1;
+						if(load_cnt == load_len - 1) state <= S_SETUP;
+					end
+				end
+
+				S_SETUP: begin
+					op_r <= d0[1:0];
+					relu_r <= d0[4];
+					in_shift_r <= d0[12:8];
+					out_shift_r <= d0[21:16];
+					in_w_r <= d_in_w;
+					in_h_r <= d_in_h;
+					in_c_r <= d_in_c;
+					out_c_r <= d_out_c;
+					in_plane_r <= d_in_plane;
+					out_plane_r <= d_out_plane;
+					rd_len <= (d0[1:0] == OP_FC) ? d_in_words : d_in_plane;
+					last_out_words <= d_out_words;
+					oc <= '0;
+					ic <= '0;
+					src_base <= '0;
+					dst_base <= '0;
+					wt_ptr <= d2[WMEM_AW-1:0];
+					kcnt <= '0;
+					if(!desc_ok) begin
+						o_error <= 1'b1;
+						state <= S_IDLE;
+					end else if(d0[1:0] == OP_CONV) state <= S_KLOAD;
+					else state <= S_STREAM;
+				end
+
+				// conv 커널 9개 로드 (커널 메모리 읽기 지연 1사이클 → kcnt 1~9에서 쓰기)
+				S_KLOAD: begin
+					kcnt <= kcnt + 1;
+					if(kcnt != 0) kreg[kcnt - 1] <= wmem_q[7:0];
+					if(kcnt == 4'd9) begin
+						kcnt <= '0;
+						wt_ptr <= wt_ptr + WMEM_AW'(9);
+						state <= S_STREAM;
+					end
+				end
+
+				S_STREAM: begin
+					out_cnt <= '0;
+					fc_cnt <= '0;
+					state <= S_DRAIN;
+				end
+
+				S_DRAIN: begin
+					case(op_r)
+						OP_CONV: if(out_cnt == out_plane_r) begin
+							if(ic != in_c_r - 1) begin
+								ic <= ic + 1;
+								src_base <= src_base + in_plane_r[MAP_AW-1:0];
+								state <= S_KLOAD;
+							end else begin
+								ic <= '0;
+								src_base <= '0;
+								oc <= oc + 1;
+								dst_base <= dst_base + out_plane_r[MAP_AW-1:0];
+								state <= (oc == out_c_r - 1) ? S_LDONE : S_KLOAD;
+							end
+						end
+						OP_POOL: if(out_cnt == out_plane_r) begin
+							oc <= oc + 1;
+							src_base <= src_base + in_plane_r[MAP_AW-1:0];
+							dst_base <= dst_base + out_plane_r[MAP_AW-1:0];
+							state <= (oc == out_c_r - 1) ? S_LDONE : S_STREAM;
+						end
+						// 코어 FC가 flatten 뱅크를 가져가 계산 → 뉴런 값은 다음 FC 시작까지 유지
+						default: if(i_fc_result_valid) state <= S_FC_WB;
+						else if(i_fc_timeout) begin
+							o_error <= 1'b1;
+							state <= S_IDLE;
+						end
+					endcase
+				end
+
+				// FC 출력 하나씩 22비트로 저장, 마지막 레이어면 48비트 누적값을 결과로
+				S_FC_WB: begin
+					if(last_layer && oc < NUM_RESULTS) res[oc] <= i_fc_neuron[oc];
+					oc <= oc + 1;
+					dst_base <= dst_base + 1;
+					state <= (oc == out_c_r - 1) ? S_LDONE : S_FC_WB;
+				end
+
+				S_LDONE: begin
+					if(last_layer) state <= S_RESULT;
+					else begin
+						layer <= layer + 1;
+						state <= S_SETUP;
+					end
+				end
+
+				S_RESULT: state <= S_IDLE;
+
+				default: state <= S_IDLE;
+			endcase
+		end
+	end
+
+	// ===== 결과 헤드 (Fully_Connected_Layer_Fixed와 같은 argmax 규칙) =====
+	logic [1:0] best_idx;
+	logic signed [47:0] best_score, second_score;
+
+	always_comb begin
+		best_idx = '0;
+		best_score = res[1];
+		second_score = {1'b1, 47'b0};
+		for(int c = 1; c < NUM_RESULTS - 1; c++) begin
+			if(1 + c < last_out_words) begin
+				if(res[1 + c] > best_score) begin
+					second_score = best_score;
+					best_score = res[1 + c];
+					best_idx = c[1:0];
+				end else if(res[1 + c] > second_score) begin
+					second_score = res[1 + c];
+				end
+			end
+		end
+	end
+
+	logic [31:0] frame_cycles;
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			o_result_valid <= 1'b0;
+			o_lane_result <= '0;
+			o_class_idx <= '0;
+			o_class_score <= '0;
+			o_class_margin <= '0;
+			o_latency <= '0;
+			frame_cycles <= '0;
+		end else begin
+			if(state == S_IDLE) frame_cycles <= 32'd1;
+			else                frame_cycles <= frame_cycles + 1;
+
+			o_result_valid <= (state == S_RESULT);
+			if(state == S_RESULT) begin
+				o_latency <= frame_cycles;
+				o_lane_result <= res[0];
+				o_class_idx <= best_idx;
+				o_class_score <= best_score;
+				o_class_margin <= (last_out_words > 2) ? 48'(best_score - second_score) : '0;
+			end
+		end
+	end
+
+	assign o_frame_ready = (state == S_IDLE);
+	assign o_busy = (state != S_IDLE);
+	assign o_layer = layer;
+
+endmodule
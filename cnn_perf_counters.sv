@@ -0,0 +1,96 @@
+`timescale 1ns/1ps
+module cnn_perf_counters #(
+	parameter NUM_STAGES = 5   // ingest, conv, pool, flatten, FC
+)(
+	input logic clk,
+	input logic rst,   // Active Low (negedge)
+
+	// ===== 제어 (AXI 제어 레지스터에서 1사이클 펄스) =====
+	input logic i_snapshot,    // 현재 카운터를 스냅샷 뱅크로 복사 (원자적)
+	input logic i_clear,       // 누적 카운터 초기화 (스냅샷은 유지)
+	input logic [4:0] i_sel,   // 읽을 스냅샷 인덱스
+
+	// ===== 측정 입력 =====
+	input logic [NUM_STAGES-1:0] i_stage_busy,
+	input logic [NUM_STAGES-1:0] i_stage_stall,
+	input logic i_result_valid,      // 프레임 결과 펄스
+	input logic [31:0] i_latency,    // i_result_valid와 같은 사이클에 유효한 지연 값
+	input logic [31:0] i_fc_cycles,  // i_result_valid와 같은 사이클: FC 패스 사이클 수
+	input logic [15:0] i_fc_nonzero, // i_result_valid와 같은 사이클: FC가 계산한 0이 아닌 입력 수
+	input logic i_timeout,           // 워치독 타임아웃 (레벨, 상승 에지로 계수)
+
+	// ===== 출력 =====
+	output logic [31:0] o_sel_data,      // 스냅샷[i_sel]
+	output logic [31:0] o_frame_count,   // 실시간 프레임 수
+	output logic [31:0] o_timeout_count  // 실시간 타임아웃 수
+);
+	// ===== 카운터 인덱스 =====
+	//  0..9  : 단계 s의 busy = 2*s, stall = 2*s+1 (ingest, conv, pool, flatten, FC)
+	//  10    : 마지막 프레임 지연 (사이클)
+	//  11/12 : 최소/최대 지연
+	//  13    : 완료 프레임 수
+	//  14    : 타임아웃 수
+	//  15    : 마지막 clear 이후 경과 사이클 (busy/stall 비율 계산용)
+	//  16    : 마지막 프레임 FC 사이클
+	//  17    : 마지막 프레임 FC가 발행한 입력 수 (zero skip 구성이면 0이 아닌 입력만)
+	localparam NUM_COUNTERS = 18;
+	localparam IDX_LAT_LAST = 2 * NUM_STAGES;
+	localparam IDX_LAT_MIN  = IDX_LAT_LAST + 1;
+	localparam IDX_LAT_MAX  = IDX_LAT_LAST + 2;
+	localparam IDX_FRAMES   = IDX_LAT_LAST + 3;
+	localparam IDX_TIMEOUTS = IDX_LAT_LAST + 4;
+	localparam IDX_CYCLES   = IDX_LAT_LAST + 5;
+	localparam IDX_FC_CYCLES  = IDX_LAT_LAST + 6;
+	localparam IDX_FC_NONZERO = IDX_LAT_LAST + 7;
+
+	logic [31:0] live [0:NUM_COUNTERS-1];
+	logic [31:0] snap [0:NUM_COUNTERS-1];
+	logic timeout_d1;
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			for(int i = 0; i < NUM_COUNTERS; i++) live[i] <= 32'h0;
+			live[IDX_LAT_MIN] <= 32'hFFFF_FFFF;
+			timeout_d1 <= 1'b0;
+		end else begin
+			timeout_d1 <= i_timeout;
+
+			if(i_clear) begin
+				for(int i = 0; i < NUM_COUNTERS; i++) live[i] <= 32'h0;
+				live[IDX_LAT_MIN] <= 32'hFFFF_FFFF;
+			end else begin
+				// 단계별 busy/stall (32비트 포화 없이 순환, 100MHz에서 약 42초)
+				for(int s = 0; s < NUM_STAGES; s++) begin
+					if(i_stage_busy[s])  live[2*s]   <= live[2*s] + 1;
+					if(i_stage_stall[s]) live[2*s+1] <= live[2*s+1] + 1;
+				end
+
+				if(i_result_valid) begin
+					live[IDX_LAT_LAST] <= i_latency;
+					if(i_latency < live[IDX_LAT_MIN]) live[IDX_LAT_MIN] <= i_latency;
+					if(i_latency > live[IDX_LAT_MAX]) live[IDX_LAT_MAX] <= i_latency;
+					live[IDX_FRAMES] <= live[IDX_FRAMES] + 1;
+					live[IDX_FC_CYCLES] <= i_fc_cycles;
+					live[IDX_FC_NONZERO] <= 32'(i_fc_nonzero);
+				end
+
+				if(i_timeout && !timeout_d1) live[IDX_TIMEOUTS] <= live[IDX_TIMEOUTS] + 1;
+				live[IDX_CYCLES] <= live[IDX_CYCLES] + 1;
+			end
+		end
+	end
+
+	// ===== 스냅샷: 모든 카운터를 같은 사이클에 복사 → 소프트웨어가 일관된 값 읽음 =====
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			for(int i = 0; i < NUM_COUNTERS; i++) snap[i] <= 32'h0;
+		end else if(i_snapshot) begin
+			for(int i = 0; i < NUM_COUNTERS; i++) snap[i] <= live[i];
+		end
+	end
+
+	assign o_sel_data      = (i_sel < NUM_COUNTERS) ? snap[i_sel] : 32'h0;
+	assign o_frame_count   = live[IDX_FRAMES];
+	assign o_timeout_count = live[IDX_TIMEOUTS];
+
+endmodule
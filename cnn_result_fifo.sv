@@ -0,0 +1,110 @@
+`timescale 1ns/1ps
+// ===== CNN 결과 FIFO (시퀀스 번호 + 사이클 타임스탬프) =====
+// 결과마다 엔트리 1개: 48비트 결과, 클래스, 시퀀스 번호, 첫 픽셀 도착 시각, 결과 시각, overflow / 재사용 플래그
+// 첫 픽셀 시각: i_frame_first마다 시각 큐에 넣고 결과 순서대로 꺼냄 (CNN은 프레임 순서대로 결과 출력)
+//   큐가 비어 있으면 (리셋 직후 등) 결과 시각 - i_latency (프레임 시작 기준)로 대신함
+// 가득 차면 새 결과를 버리고 시퀀스 번호는 계속 증가 → 다음 저장 엔트리에 overflow 플래그 + 번호 공백
+// 읽기: First-Word-Fall-Through, i_pop 펄스로 다음 엔트리
+module cnn_result_fifo #(
+	parameter DEPTH    = 16,    // 결과 엔트리 (2의 거듭제곱)
+	parameter TS_DEPTH = 8      // 처리 중인 프레임의 첫 픽셀 시각
+)(
+	input logic clk,
+	input logic rst,   // Active Low
+
+	input logic i_flush,                        // CNN 리셋: 처리 중 프레임 시각 폐기 (쌓인 결과는 유지)
+	input logic i_frame_first,                  // 프레임 첫 픽셀 수신 펄스
+
+	input logic i_result_valid,                 // 1클럭 펄스
+	input logic signed [47:0] i_result,
+	input logic [1:0] i_class,
+	input logic [31:0] i_latency,
+	input logic i_reused,                       // 프레임 변화 없음 → 이전 결과 재출력
+
+	input logic i_pop,
+	output logic o_empty,
+	output logic [$clog2(DEPTH):0] o_level,
+	output logic signed [47:0] o_result,
+	output logic [1:0] o_class,
+	output logic o_overflow,                    // 이 엔트리 앞에서 결과가 버려짐
+	output logic o_reused,
+	output logic [31:0] o_seq,
+	output logic [31:0] o_ts_first,
+	output logic [31:0] o_ts_result,
+
+	output logic [15:0] o_drop_count,           // 버린 결과 수 (포화)
+	output logic [31:0] o_now                   // 타임스탬프 기준 사이클 카운터
+);
+	localparam EW = 48 + 2 + 1 + 1 + 32 + 32 + 32;
+
+	logic [31:0] cycle_cnt;
+	logic [31:0] seq_cnt;
+	logic overflow_pending;
+
+	// ===== 첫 픽셀 시각 큐 =====
+	logic ts_empty, ts_full;
+	logic [31:0] ts_head;
+	logic [$clog2(TS_DEPTH):0] ts_level;
+
+	sync_fifo #(
+		.WIDTH(32),
+		.DEPTH(TS_DEPTH)
+	) u_ts_queue (
+		.clk(clk),
+		.rst(rst & ~i_flush),
+		.wr_en(i_frame_first),
+		.wr_data(cycle_cnt),
+		.full(ts_full),
+		.rd_en(i_result_valid),
+		.rd_data(ts_head),
+		.empty(ts_empty),
+		.level(ts_level)
+	);
+
+	// ===== 결과 엔트리 =====
+	logic [EW-1:0] wr_entry, rd_entry;
+	logic full;
+	logic [31:0] ts_first;
+
+	assign ts_first = ts_empty ? cycle_cnt - i_latency : ts_head;
+	assign wr_entry = {cycle_cnt, ts_first, seq_cnt, i_reused, overflow_pending, i_class, i_result};
+
+	sync_fifo #(
+		.WIDTH(EW),
+		.DEPTH(DEPTH)
+	) u_entries (
+		.clk(clk),
+		.rst(rst),
+		.wr_en(i_result_valid),
+		.wr_data(wr_entry),
+		.full(full),
+		.rd_en(i_pop),
+		.rd_data(rd_entry),
+		.empty(o_empty),
+		.level(o_level)
+	);
+
+	assign {o_ts_result, o_ts_first, o_seq, o_reused, o_overflow, o_class, o_result} = rd_entry;
+	assign o_now = cycle_cnt;
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			cycle_cnt <= '0;
+			seq_cnt <= '0;
+			overflow_pending <= 1'b0;
+			o_drop_count <= '0;
+		end else begin
+			cycle_cnt <= cycle_cnt + 1;
+			if(i_result_valid) begin
+				seq_cnt <= seq_cnt + 1;
+				if(full) begin
+					overflow_pending <= 1'b1;
+					if(o_drop_count != 16'hFFFF) o_drop_count <= o_drop_count + 1'b1;
+				end else begin
+					overflow_pending <= 1'b0;
+				end
+			end
+		end
+	end
+
+endmodule
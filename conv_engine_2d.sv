@@ -1,49 +1,151 @@
 `timescale 1ns/1ps
-module conv_engine_2d(
+// ===== 3x3 conv 엔진: 라인 버퍼 / 윈도우 한 벌을 필터 F개, 입력 채널 C개가 공유 =====
+// 입력: 픽셀마다 C채널을 한 번에 (레인 p, 채널 c = pixel_in[8*(p*C + c) +: 8], RGB888 패킹과 같은 순서)
+// 출력: 필터마다 Σ채널 Σ3x3 (MAC 9C개 + 가산 트리), 픽셀 안에서 필터 순서로 인터리브
+//       (레인 p, 필터 f = result_out[22*(p*F + f) +: 22]), 22비트 포화
+// 지연: 윈도우 1 + (RETIME) + MAC 1 + $clog2(9C) 가산 단계 (C = 1이면 6클럭, RETIME이면 7클럭)
+module conv_engine_2d #(
+	parameter IMG_WIDTH = 32,    // 라인 버퍼 최대 크기 (실제 크기는 i_img_width/height)
+	parameter IMG_HEIGHT = 32,
+	parameter PPC = 1,           // 비트당 픽셀 수 (1/2/4): 윈도우 PPC개 + MAC 배열 PPC벌, 폭은 PPC 배수
+	parameter NUM_FILTERS = 1,   // 출력 필터 (특징 맵) 수
+	parameter NUM_CHANNELS = 1,  // 입력 채널 수 (RGB = 3, 이전 레이어 맵 수)
+	parameter RETIME = 0         // 1: 마스크 윈도우 / 커널 선택 뒤 레지스터 한 단 (고속 코어 클럭, +1클럭)
+)(
 	input	logic	clk,
 	input	logic	rst,   // Active Low (negedge)
 	input	logic	start_signal,
-	input	logic	[7:0]	pixel_in,
+	input	logic	[8*PPC*NUM_CHANNELS-1:0]	pixel_in,          // 레인 p = 픽셀 x = (비트 번호)*PPC + p
 	input	logic	pixel_valid,
-	output	logic	signed	[21:0]	result_out,
-	output	logic	result_valid,
-	output	logic	done_signal
+	output	logic	signed	[22*PPC*NUM_FILTERS-1:0]	result_out, // 레인별 x 필터별 22비트 결과
+	output	logic	[PPC-1:0]	result_valid,        // 레인별 유효 (경계/stride로 일부 레인만 유효할 수 있음, 필터 공통)
+	output	logic	done_signal,
+	
+	// ===== 런타임 입력 크기 (프레임 동안 고정, 최대 IMG_WIDTH x IMG_HEIGHT) =====
+	input	logic	[$clog2(IMG_WIDTH):0]	i_img_width,
+	input	logic	[$clog2(IMG_HEIGHT):0]	i_img_height,
+	input	logic	[1:0]	i_stride_log2,      // 출력 stride = 1 << i_stride_log2 (1/2/4)
+	input	logic	i_pad_same,                 // 1: same (제로 패딩, 출력 = 입력 크기), 0: valid
+	
+	// ===== 커널 뱅크 (런타임 로드, 프레임 경계에서 교체) =====
+	input	logic	i_kernel_bank,            // 연산에 사용할 뱅크 (프레임 동안 고정)
+	input	logic	i_kernel_wr_en,           // 섀도 뱅크 쓰기
+	input	logic	i_kernel_wr_bank,
+	input	logic	[$clog2(9*NUM_FILTERS*NUM_CHANNELS)-1:0]	i_kernel_wr_idx,    // (필터*C + 채널)*9 + row*3 + col
+	input	logic	signed	[7:0]	i_kernel_wr_data,
+	// ===== 커널 오버라이드 (레이어 시퀀서 작업 커널, 모든 필터/채널 공통, 뱅크 내용은 유지) =====
+	input	logic	i_kernel_ovr,
+	input	logic	signed	[7:0]	i_kernel_ovr_data [0 : 8]    // row*3 + col
 );
 
-	localparam IMG_WIDTH = 32;
-	localparam IMG_HEIGHT = 32;
 	localparam KERNEL_SIZE = 3;
+	localparam NUM_COLS = PPC + KERNEL_SIZE - 1;   // 이전 비트 마지막 2열 + 현재 비트 PPC열
+	localparam BEATS = IMG_WIDTH / PPC;            // 한 행의 최대 비트 수
+	localparam PPC_LOG2 = $clog2(PPC);
+	localparam F = NUM_FILTERS;
+	localparam C = NUM_CHANNELS;
+	localparam TAPS = KERNEL_SIZE * KERNEL_SIZE * C;   // 필터 하나의 곱 수
+	localparam TREE_LEVELS = $clog2(TAPS);
+	localparam SUM_W = 18 + TREE_LEVELS;
+	localparam PIPE = 2 + RETIME + TREE_LEVELS;         // 픽셀 입력 → 결과 클럭 수 (윈도우, (RETIME), MAC, 가산 트리)
+	
+	// 라인 버퍼: 비트 단위 (엔트리 하나에 PPC픽셀 x C채널), 필터 수와 무관하게 한 벌
+	logic	[8*PPC*C-1:0]	line_buffer1 [0:BEATS - 1];
+	logic	[8*PPC*C-1:0]	line_buffer2 [0:BEATS - 1];
+	logic	[7:0]	pixel_window [0 : C - 1][0 : KERNEL_SIZE - 1][0 : NUM_COLS - 1];   // 레인 p 윈도우 = 열 p..p+2
+	// 모든 뱅크 / 필터 / 채널이 Sobel X로 시작 (로드 전 교체해도 결과 동일)
+	logic	signed	[7:0]	kernel_bank [0:1] [0 : F - 1] [0 : C - 1] [0 : KERNEL_SIZE - 1] [0 : KERNEL_SIZE - 1];
+	initial begin
+		for(int b = 0; b < 2; b++)
+			for(int f = 0; f < F; f++)
+				for(int c = 0; c < C; c++)
+					kernel_bank[b][f][c] = '{'{1, 0, -1}, '{2, 0, -2}, '{1, 0, -1}};
+	end
+	logic	signed	[7:0]	kernel [0 : F - 1] [0 : C - 1] [0 : KERNEL_SIZE - 1] [0 : KERNEL_SIZE - 1];
+	logic	signed	[17:0]	mac_out	[0 : PPC - 1] [0 : F - 1] [0 : C - 1] [0 :	KERNEL_SIZE - 1] [0 : KERNEL_SIZE - 1];
+	// cnt_x = 비트 번호 (PPC = 1이면 픽셀), same 패딩의 플러시 구간(가상 행 H, H+1)까지 세도록 1비트 여유
+	logic	[$clog2(BEATS) : 0] cnt_x;
+	logic	[$clog2(IMG_HEIGHT) + 1 : 0] cnt_y;
+	logic	[$clog2(BEATS) : 0] row_beats;
 	
-	logic	[7:0]	line_buffer1 [0:IMG_WIDTH - 1];
-	logic	[7:0]	line_buffer2 [0:IMG_WIDTH - 1];
-	logic	[7:0]	pixel_window [0 : KERNEL_SIZE - 1][0 : KERNEL_SIZE - 1];
-	logic	signed	[7:0]	kernel [0 : KERNEL_SIZE - 1] [0 : KERNEL_SIZE - 1] = '{{1, 0, -1}, {2, 0, -2}, {1, 0, -1}};
-	logic	signed	[17:0]	mac_out	[0 :	KERNEL_SIZE - 1] [0 : KERNEL_SIZE - 1];
-	logic	signed	[18 : 0] sum_stage1 [0 : 4];
-	logic	signed	[19 : 0] sum_stage2 [0 : 2];
-	logic	signed	[20 : 0] sum_stage3 [0 : 1];
-	logic	signed	[21 : 0] final_result;
-	logic	[$clog2(IMG_WIDTH) - 1 : 0] cnt_x;
-	logic	[$clog2(IMG_HEIGHT)  - 1 : 0] cnt_y;
+	// ===== same 패딩: 윈도우 마스크 (경계 밖 위치를 0으로), 레인별 =====
+	logic	win_en;                  // 윈도우 이동 (실제 픽셀 또는 플러시 가상 픽셀)
+	logic	[8*PPC*C-1:0]	win_pixel;
+	logic	[PPC-1:0]	mask_row0, mask_col0, mask_col2;
+	logic	[7:0]	masked_window [0 : PPC - 1][0 : C - 1][0 : KERNEL_SIZE - 1][0 : KERNEL_SIZE - 1];
+	// MAC 입력 (RETIME이면 등록): 마스크 / 커널 뱅크 / 오버라이드 mux → 곱셈기 경로 분리
+	logic	[7:0]	mac_window [0 : PPC - 1][0 : C - 1][0 : KERNEL_SIZE - 1][0 : KERNEL_SIZE - 1];
+	logic	signed	[7:0]	mac_kernel [0 : F - 1] [0 : C - 1] [0 : KERNEL_SIZE - 1] [0 : KERNEL_SIZE - 1];
+	logic	[$clog2(IMG_WIDTH) : 0] lane_x [0 : PPC - 1];
+	logic	[$clog2(IMG_WIDTH) : 0] out_x [0 : PPC - 1];
+	logic	[$clog2(IMG_HEIGHT) + 1 : 0] out_y [0 : PPC - 1];
+	logic	[PPC-1:0]	out_pos_valid;
+	logic	[3:0]	stride_mask;
 	
 	// Multiple Driver 臾몄젣 �빐寃�: valid_in�쓣 議고빀 �떊�샇濡쒕쭔 �궗�슜
-	logic	valid_in_comb;
-	logic	valid_d1, valid_d2, valid_d3, valid_d4, valid_d5;
+	logic	[PPC-1:0]	valid_in_comb;
+	logic	[PPC-1:0]	valid_pipe [0 : PIPE - 1];
+	
+	enum	logic	[1:0]	{IDLE, PROCESSING, FLUSH, DONE} state, next_state;
 	
-	enum	logic	[1:0]	{IDLE, PROCESSING, DONE} state, next_state;
+	// 커널 쓰기 포트 (리셋 없음: CNN 소프트 리셋 후에도 로드한 가중치 유지)
+	logic	[$clog2(9*F*C)-1:0]	wr_fc;   // 필터*C + 채널
+	logic	[3:0]	wr_tap;
+	assign wr_fc  = i_kernel_wr_idx / (KERNEL_SIZE * KERNEL_SIZE);
+	assign wr_tap = i_kernel_wr_idx % (KERNEL_SIZE * KERNEL_SIZE);
 	
-	genvar	i,	j;
+	always @(posedge clk) begin
+		if(i_kernel_wr_en && i_kernel_wr_idx < KERNEL_SIZE * KERNEL_SIZE * F * C)
+			kernel_bank[i_kernel_wr_bank][wr_fc / C][wr_fc % C][wr_tap / KERNEL_SIZE][wr_tap % KERNEL_SIZE] <= i_kernel_wr_data;
+	end
+	
+	always_comb begin
+		kernel = kernel_bank[i_kernel_bank];
+		if(i_kernel_ovr)
+			for(int f = 0; f < F; f++)
+				for(int c = 0; c < C; c++)
+					for(int r = 0; r < KERNEL_SIZE; r++)
+						for(int q = 0; q < KERNEL_SIZE; q++)
+							kernel[f][c][r][q] = i_kernel_ovr_data[r * KERNEL_SIZE + q];
+	end
+	
+	// ===== MAC 입력 레지스터 (RETIME) =====
+	// 윈도우와 커널을 같은 클럭에 등록 → 값은 RETIME = 0과 같고 결과만 한 클럭 늦음
 generate
+	if(RETIME) begin : gen_mac_in_reg
+		always_ff@(posedge clk or negedge rst) begin
+			if(!rst) begin
+				mac_window <= '{default: '0};
+				mac_kernel <= '{default: '0};
+			end else begin
+				mac_window <= masked_window;
+				mac_kernel <= kernel;
+			end
+		end
+	end else begin : gen_mac_in_comb
+		assign mac_window = masked_window;
+		assign mac_kernel = kernel;
+	end
+endgenerate
+	
+	genvar	i,	j,	p,	f,	c;
+generate
+  for(p = 0; p < PPC; p = p + 1) begin : gen_lanes // 레인별 MAC 배열 (윈도우는 필터끼리 공유)
+   for(f = 0; f < F; f = f + 1) begin : gen_filters
+    for(c = 0; c < C; c = c + 1) begin : gen_chans
     for(i = 0; i < KERNEL_SIZE; i = i + 1) begin : gen_rows // 바깥쪽 루프에 이름 부여
         for(j = 0; j < KERNEL_SIZE; j = j + 1) begin : gen_cols // 안쪽 루프에 이름 부여
             compute_unit MAC_INST(
                 .clk(clk), .rst(rst),
-                .pixel_a(pixel_window[i][j]),
-                .weight_b(kernel[i][j]),
-                .sum_out(mac_out[i][j])
+                .pixel_a(mac_window[p][c][i][j]),
+                .weight_b(mac_kernel[f][c][i][j]),
+                .sum_out(mac_out[p][f][c][i][j])
             );
         end
     end
+    end
+   end
+  end
 endgenerate
 	
 	// �뵿�� �쐢�룄�슦 �뾽�뜲�씠�듃
@@ -53,46 +155,72 @@ endgenerate
 			line_buffer2 <= '{default: '0};
 			pixel_window <= '{default: '0};
 		end
-		else if(pixel_valid) begin
+		else if(win_en) begin
 			line_buffer2[cnt_x] <= line_buffer1[cnt_x];	
-			line_buffer1[cnt_x] <= pixel_in;
+			line_buffer1[cnt_x] <= win_pixel;
 			
-			for(int i = 0; i < KERNEL_SIZE; i = i + 1) begin 
-				pixel_window[i][0] <= pixel_window[i][1];					
-				pixel_window[i][1] <= pixel_window[i][2];					
-			end
+			for(int ch = 0; ch < C; ch = ch + 1) begin
+				// 이전 비트의 마지막 2열을 유지 → 레인 0, 1 윈도우가 비트 경계를 넘어 겹침
+				for(int i = 0; i < KERNEL_SIZE; i = i + 1) begin 
+					pixel_window[ch][i][0] <= pixel_window[ch][i][NUM_COLS - 2];					
+					pixel_window[ch][i][1] <= pixel_window[ch][i][NUM_COLS - 1];					
+				end
 
-			pixel_window[2][2] <= pixel_in;				
-			pixel_window[1][2] <= line_buffer1[cnt_x];		
-			pixel_window[0][2] <= line_buffer2[cnt_x];	
+				for(int l = 0; l < PPC; l = l + 1) begin
+					pixel_window[ch][2][l + 2] <= win_pixel[8*(l*C + ch) +: 8];				
+					pixel_window[ch][1][l + 2] <= line_buffer1[cnt_x][8*(l*C + ch) +: 8];		
+					pixel_window[ch][0][l + 2] <= line_buffer2[cnt_x][8*(l*C + ch) +: 8];	
+				end
+			end
 		end
 	end
 	
 	// �뙆�씠�봽�씪�씤 怨꾩궛
+	// 가산 트리: 단계마다 이웃 두 개씩 (9C개 → 1개), 채널 순서로 평탄화 (c*9 + row*3 + col)
+	// C = 1이면 기존 5 / 3 / 2 / 1 쌍 구성과 동일
+generate
+  for(p = 0; p < PPC; p = p + 1) begin : gen_trees
+   for(f = 0; f < F; f = f + 1) begin : gen_filter_trees
+	logic	signed	[SUM_W - 1 : 0] taps [0 : TAPS - 1];
+	logic	signed	[SUM_W - 1 : 0] tree [1 : TREE_LEVELS][0 : TAPS - 1];
+	logic	signed	[SUM_W - 1 : 0] final_result;
+	
+	always_comb begin
+		for(int ch = 0; ch < C; ch++)
+			for(int r = 0; r < KERNEL_SIZE; r++)
+				for(int k = 0; k < KERNEL_SIZE; k++)
+					taps[ch*9 + r*3 + k] = mac_out[p][f][ch][r][k];
+	end
+	
 	always_ff@(posedge clk or negedge rst) begin
 		if(!rst) begin 
-			sum_stage1 <= '{default: '0};
-			sum_stage2 <= '{default: '0};
-			sum_stage3 <= '{default: '0};
-			final_result <= '0;
+			tree <= '{default: '0};
 		end	else begin
-			sum_stage1[0] <= mac_out[0][0] + mac_out[0][1];
-			sum_stage1[1] <= mac_out[0][2] + mac_out[1][0];
-			sum_stage1[2] <= mac_out[1][1] + mac_out[1][2]; 
-			sum_stage1[3] <= mac_out[2][0] + mac_out[2][1];
-			sum_stage1[4] <= mac_out[2][2];
-				
-			sum_stage2[0] <= sum_stage1[0] + sum_stage1[1];
-			sum_stage2[1] <= sum_stage1[2] + sum_stage1[3];
-			sum_stage2[2] <= sum_stage1[4];
-			
-			sum_stage3[0] <= sum_stage2[0] + sum_stage2[1];
-			sum_stage3[1] <= sum_stage2[2];
-				
-			final_result <= sum_stage3[0] + sum_stage3[1];
+			for(int lv = 1; lv <= TREE_LEVELS; lv++) begin
+				// 이전 단계 원소 수 = ceil(TAPS / 2^(lv-1))
+				int n_prev;
+				n_prev = (TAPS + (1 << (lv - 1)) - 1) >> (lv - 1);
+				for(int k = 0; k < TAPS; k++) begin
+					if(2*k + 1 < n_prev)
+						tree[lv][k] <= (lv == 1) ? taps[2*k] + taps[2*k + 1] : tree[lv-1][2*k] + tree[lv-1][2*k + 1];
+					else if(2*k < n_prev)
+						tree[lv][k] <= (lv == 1) ? taps[2*k] : tree[lv-1][2*k];
+					else
+						tree[lv][k] <= '0;
+				end
+			end
 		end
 	end
 	
+	assign final_result = tree[TREE_LEVELS][0];
+	// 22비트 포화 (C = 1이면 SUM_W = 22로 그대로)
+	assign result_out[22*(p*F + f) +: 22] = (final_result > $signed(SUM_W'(22'h1FFFFF)))  ? 22'h1FFFFF :
+	                                         (final_result < -$signed(SUM_W'(22'h200000))) ? 22'h200000 :
+	                                         final_result[21:0];
+   end
+  end
+endgenerate
+	
 	// �긽�깭 癒몄떊
 	always_ff@(posedge clk or negedge rst) begin  
 		if(!rst) state <= IDLE; 
@@ -103,7 +231,10 @@ endgenerate
 		next_state = state;
 		case(state) 
 			IDLE : if(start_signal) next_state = PROCESSING;
-			PROCESSING : if (pixel_valid && (cnt_x == IMG_WIDTH -1 ) && (cnt_y == IMG_HEIGHT - 1)) next_state = DONE;
+			PROCESSING : if (pixel_valid && (cnt_x == row_beats - 1) && (cnt_y == i_img_height - 1))
+				next_state = i_pad_same ? FLUSH : DONE;
+			// 가상 0 픽셀: 행 H 전체 + 비트 (0, H+1) → 마지막 열/행 출력
+			FLUSH : if (cnt_x == 0 && cnt_y == i_img_height + 1) next_state = DONE;
 			DONE : next_state = IDLE;
 		endcase
 	end
@@ -116,8 +247,8 @@ endgenerate
 		end else if(state == IDLE) begin
 			cnt_x <= '0;
 			cnt_y <= '0;
-		end else if (pixel_valid && state == PROCESSING) begin
-			if(cnt_x == IMG_WIDTH - 1) begin
+		end else if ((pixel_valid && state == PROCESSING) || state == FLUSH) begin
+			if(cnt_x == row_beats - 1) begin
 				cnt_x <= '0;
 				cnt_y <= cnt_y + 1'd1;
 			end else cnt_x <= cnt_x + 1'd1;
@@ -125,28 +256,76 @@ endgenerate
 	end
 	
 	// Valid �떊�샇 �깮�꽦 (議고빀 濡쒖쭅�쑝濡쒕쭔)
-	assign valid_in_comb = (state == PROCESSING) && (cnt_x >= 2) && (cnt_y >= 2);
+	// 픽셀이 실제로 들어온 사이클에만 유효 (스트림 입력에 빈 사이클이 있어도 중복 출력 없음)
+	// valid: 픽셀 (x, y) → 출력 (x-2, y-2)
+	// same: 픽셀 (x, y) → 출력 (x-1, y-1), 다음 행 첫 픽셀 (0, y)에서 이전 행 마지막 열 (W-1, y-2)
+	// PPC > 1: 레인 p의 픽셀 x = cnt_x*PPC + p, 규칙은 레인마다 동일
+	assign row_beats = i_img_width >> PPC_LOG2;
+	assign win_en = pixel_valid || (state == FLUSH);
+	assign win_pixel = (state == FLUSH) ? '0 : pixel_in;
+	
+	// stride: 출력 좌표가 stride 배수인 위치만 유지
+	assign stride_mask = (4'd1 << i_stride_log2) - 1'b1;
+	
+	always_comb begin
+		for(int l = 0; l < PPC; l++) begin
+			lane_x[l] = (cnt_x << PPC_LOG2) + l;
+			if(!i_pad_same) begin
+				out_x[l] = lane_x[l] - 2'd2;
+				out_y[l] = cnt_y - 2'd2;
+				out_pos_valid[l] = (lane_x[l] >= 2) && (cnt_y >= 2);
+			end else if(lane_x[l] == 0) begin
+				out_x[l] = i_img_width - 1'b1;
+				out_y[l] = cnt_y - 2'd2;
+				out_pos_valid[l] = (cnt_y >= 2);
+			end else begin
+				out_x[l] = lane_x[l] - 1'b1;
+				out_y[l] = cnt_y - 1'b1;
+				out_pos_valid[l] = (cnt_y >= 1) && (cnt_y <= i_img_height);
+			end
+			
+			valid_in_comb[l] = win_en && (state == PROCESSING || state == FLUSH) && out_pos_valid[l] &&
+			                   ((out_x[l][3:0] & stride_mask) == 0) && ((out_y[l][3:0] & stride_mask) == 0);
+		end
+	end
+	
+	// 마스크는 윈도우와 같은 사이클에 갱신 → compute_unit이 같은 윈도우로 계산
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			mask_row0 <= '0;
+			mask_col0 <= '0;
+			mask_col2 <= '0;
+		end else if(win_en) begin
+			for(int l = 0; l < PPC; l++) begin
+				mask_row0[l] <= i_pad_same && ((lane_x[l] == 0) ? (cnt_y == 2) : (cnt_y == 1));   // 위쪽 패딩
+				mask_col0[l] <= i_pad_same && (lane_x[l] == 1);                                     // 왼쪽 패딩
+				mask_col2[l] <= i_pad_same && (lane_x[l] == 0);                                     // 오른쪽 패딩
+			end
+		end
+	end
+	
+	always_comb begin
+		for(int l = 0; l < PPC; l++)
+			for(int ch = 0; ch < C; ch++)
+				for(int r = 0; r < KERNEL_SIZE; r++)
+					for(int c = 0; c < KERNEL_SIZE; c++)
+						masked_window[l][ch][r][c] = ((r == 0 && mask_row0[l]) || (c == 0 && mask_col0[l]) || (c == 2 && mask_col2[l])) ?
+						                             8'd0 : pixel_window[ch][r][l + c];
+	end
 	
 	// Valid �뙆�씠�봽�씪�씤 (�닚李� 濡쒖쭅)
+	// 데이터 레지스터 수와 같게: 윈도우 1 + (RETIME) + MAC 1 + 가산 트리 단계
 	always_ff @(posedge clk or negedge rst) begin 
         if (!rst) begin  
-            valid_d1 <= 1'b0;
-            valid_d2 <= 1'b0;
-            valid_d3 <= 1'b0;
-            valid_d4 <= 1'b0;
-			valid_d5 <= 1'b0;
+            valid_pipe <= '{default: '0};
         end else begin
-            valid_d1 <= valid_in_comb;  // 議고빀 �떊�샇 �궗�슜
-            valid_d2 <= valid_d1;
-            valid_d3 <= valid_d2;
-			valid_d4 <= valid_d3;
-			valid_d5 <= valid_d4;
+            valid_pipe[0] <= valid_in_comb;  // 議고빀 �떊�샇 �궗�슜
+            for (int k = 1; k < PIPE; k++) valid_pipe[k] <= valid_pipe[k-1];
         end
     end
 	
 	// 異쒕젰 �븷�떦
-	assign result_valid = valid_d5;
-	assign result_out = final_result;
+	assign result_valid = valid_pipe[PIPE - 1];
 	assign done_signal = (state == DONE);
 	
 endmodule
\ No newline at end of file
@@ -0,0 +1,61 @@
+`timescale 1ns/1ps
+module fc_adder_tree #(
+	parameter NUM_IN = 8,   // 입력 개수 (2의 거듭제곱이 아니면 0으로 패딩)
+	parameter WIDTH  = 48
+)(
+	input logic clk,
+	input logic rst,
+	input logic i_valid,
+	input logic signed [WIDTH-1:0] i_data [0:NUM_IN-1],
+	output logic o_valid,
+	output logic signed [WIDTH-1:0] o_sum
+);
+	localparam LEVELS = (NUM_IN > 1) ? $clog2(NUM_IN) : 1;
+	localparam PADDED = 1 << LEVELS;
+
+	// 레벨마다 한 단씩 레지스터 (레벨당 덧셈 1개 → 타이밍 여유 확보)
+	logic signed [WIDTH-1:0] in_pad [0:PADDED-1];
+	logic signed [WIDTH-1:0] stage [1:LEVELS][0:PADDED-1];
+	logic valid_pipe [1:LEVELS];
+
+	always_comb begin
+		for(int i = 0; i < PADDED; i++) begin
+			in_pad[i] = (i < NUM_IN) ? i_data[i] : '0;
+		end
+	end
+
+	genvar lv;
+	generate
+		for(lv = 0; lv < LEVELS; lv = lv + 1) begin : gen_level
+			if(lv == 0) begin : gen_first
+				always_ff @(posedge clk or negedge rst) begin
+					if(!rst) begin
+						for(int i = 0; i < (PADDED >> 1); i++) stage[1][i] <= '0;
+						valid_pipe[1] <= 1'b0;
+					end else begin
+						for(int i = 0; i < (PADDED >> 1); i++) begin
+							stage[1][i] <= in_pad[2*i] + in_pad[2*i+1];
+						end
+						valid_pipe[1] <= i_valid;
+					end
+				end
+			end else begin : gen_next
+				always_ff @(posedge clk or negedge rst) begin
+					if(!rst) begin
+						for(int i = 0; i < (PADDED >> (lv + 1)); i++) stage[lv+1][i] <= '0;
+						valid_pipe[lv+1] <= 1'b0;
+					end else begin
+						for(int i = 0; i < (PADDED >> (lv + 1)); i++) begin
+							stage[lv+1][i] <= stage[lv][2*i] + stage[lv][2*i+1];
+						end
+						valid_pipe[lv+1] <= valid_pipe[lv];
+					end
+				end
+			end
+		end
+	endgenerate
+
+	assign o_sum   = stage[LEVELS][0];
+	assign o_valid = valid_pipe[LEVELS];
+
+endmodule
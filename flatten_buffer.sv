@@ -1,41 +1,87 @@
-module flatten_buffer(
+module flatten_buffer #(
+    parameter DATA_WIDTH = 22,                       // 양자화 모드에서는 8/16 → 뱅크 폭 축소
+    parameter BUFFER_SIZE = 225                      // 뱅크 최대 크기 (실제 길이는 프레임 크기에 따름)
+)(
     input logic clk,
     input logic rst,
     input logic i_data_valid,
-    input logic signed [21:0] i_data_in,
-    output logic o_buffer_full,
-    output logic signed [21:0] o_flattened_data [0:224]
+    input logic signed [DATA_WIDTH-1:0] i_data_in,
+    input logic i_frame_done,                        // 프레임 마지막 값 (같은 사이클 쓰기 포함) → 뱅크 완료
+    input logic i_bank_release,                      // FC가 읽기 뱅크 사용 완료 → 뱅크 반환
+    output logic o_buffer_full,                      // 읽기 뱅크에 완성된 프레임 존재
+    output logic o_bank_free,                        // 쓰기 뱅크 비어 있음 (다음 프레임 수신 가능)
+    output logic o_wr_bank,                          // 현재 쓰기 뱅크 번호
+    output logic o_rd_bank,                          // 현재 읽기 뱅크 번호
+    output logic [$clog2(BUFFER_SIZE+1)-1:0] o_length,   // 읽기 뱅크의 유효 값 개수
+    output logic signed [DATA_WIDTH-1:0] o_flattened_data [0:BUFFER_SIZE-1],
+    // ===== 0이 아닌 값의 인덱스 목록 (쓰는 순서대로, FC zero skip용) =====
+    output logic [$clog2(BUFFER_SIZE)-1:0] o_nz_index [0:BUFFER_SIZE-1],
+    output logic [$clog2(BUFFER_SIZE+1)-1:0] o_nz_count      // 읽기 뱅크의 0이 아닌 값 개수
 );
 
-// ===== LUT 최적화: 파라미터와 카운터 단순화 =====
-parameter BUFFER_SIZE = 225;
-logic [7:0] write_ptr;     // 카운터 크기 축소
-logic buffer_full_reg;
+// ===== 핑퐁 뱅크: Feature Extractor가 한 뱅크를 채우는 동안 FC는 다른 뱅크를 읽음 =====
+// 길이는 고정값이 아니라 프레임 완료 시점의 쓰기 개수 → 런타임 프레임 크기를 그대로 따라감
+logic signed [DATA_WIDTH-1:0] bank_data [0:1][0:BUFFER_SIZE-1];
+logic [$clog2(BUFFER_SIZE+1)-1:0] write_ptr;
+logic [$clog2(BUFFER_SIZE+1)-1:0] bank_len [0:1];
+logic wr_accept;
+// ReLU + pooling 뒤에는 0이 많음 → 쓰면서 0이 아닌 값의 위치만 따로 모아 둠 (추가 패스 없음)
+logic [$clog2(BUFFER_SIZE)-1:0] nz_index [0:1][0:BUFFER_SIZE-1];
+logic [$clog2(BUFFER_SIZE+1)-1:0] nz_ptr;
+logic [$clog2(BUFFER_SIZE+1)-1:0] bank_nz [0:1];
+logic nz_accept;
+logic [1:0] bank_full;
+logic wr_bank, rd_bank;
 
-always_ff @(posedge clk or negedge rst) begin  
-    if (!rst) begin  
-        write_ptr <= 8'b0;
-        buffer_full_reg <= 1'b0;
+always_ff @(posedge clk or negedge rst) begin
+    if (!rst) begin
+        write_ptr <= '0;
+        nz_ptr <= '0;
+        bank_len <= '{default: '0};
+        bank_nz <= '{default: '0};
+        bank_full <= 2'b00;
+        wr_bank <= 1'b0;
+        rd_bank <= 1'b0;
         // 초기화 루프 제거 (synthesis 최적화를 위해)
     end else begin
-        if (i_data_valid && !buffer_full_reg) begin
-            o_flattened_data[write_ptr] <= i_data_in;
-            
-            if (write_ptr == (BUFFER_SIZE - 1)) begin
-                buffer_full_reg <= 1'b1;
-                write_ptr <= 8'b0;  // 리셋
-            end else begin
-                write_ptr <= write_ptr + 1;
-            end
+        // 쓰기: 가득 찬 뱅크에는 쓰지 않음 (상위 컨트롤러가 o_bank_free로 시작을 막음)
+        // 최대 크기를 넘는 값은 버림 (상위에서 프레임 크기를 최대값으로 제한)
+        if (wr_accept) begin
+            bank_data[wr_bank][write_ptr] <= i_data_in;
+            write_ptr <= write_ptr + 1'b1;
         end
-        
-        // 버퍼 초기화 조건 단순화
-        if (!i_data_valid && buffer_full_reg) begin
-            buffer_full_reg <= 1'b0;
+        if (nz_accept) begin
+            nz_index[wr_bank][nz_ptr] <= write_ptr[$clog2(BUFFER_SIZE)-1:0];
+            nz_ptr <= nz_ptr + 1'b1;
+        end
+
+        if (i_frame_done && !bank_full[wr_bank]) begin
+            bank_full[wr_bank] <= 1'b1;
+            bank_len[wr_bank] <= write_ptr + wr_accept;
+            bank_nz[wr_bank] <= nz_ptr + nz_accept;
+            wr_bank <= ~wr_bank;
+            write_ptr <= '0;  // 리셋
+            nz_ptr <= '0;
+        end
+
+        // 반환: 읽기 뱅크 비우고 다음 뱅크로
+        if (i_bank_release && bank_full[rd_bank]) begin
+            bank_full[rd_bank] <= 1'b0;
+            rd_bank <= ~rd_bank;
         end
     end
 end
 
-assign o_buffer_full = buffer_full_reg;
+assign wr_accept = i_data_valid && !bank_full[wr_bank] && (write_ptr < BUFFER_SIZE);
+assign nz_accept = wr_accept && (i_data_in != '0);
+
+assign o_buffer_full = bank_full[rd_bank];
+assign o_length = bank_len[rd_bank];
+assign o_bank_free = !bank_full[wr_bank];
+assign o_wr_bank = wr_bank;
+assign o_rd_bank = rd_bank;
+assign o_flattened_data = bank_data[rd_bank];
+assign o_nz_index = nz_index[rd_bank];
+assign o_nz_count = bank_nz[rd_bank];
 
-endmodule
\ No newline at end of file
+endmodule
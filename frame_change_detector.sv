@@ -0,0 +1,204 @@
+`timescale 1ns/1ps
+// ===== 프레임 변화 검출: 정지 / 거의 같은 프레임은 CNN 추론 생략 =====
+// 스트림 프레임을 버퍼에 받으면서 기준 프레임 (마지막으로 추론한 프레임)과 픽셀 SAD 누적
+// - SAD > 임계값, 크기가 다름, 기준 없음, 연속 생략 한도 도달 → 버퍼를 CNN에 재생 (클럭당 픽셀 1개)
+// - 그 외 → CNN을 건너뛰고 o_reuse 펄스 (이전 결과 재출력), 기준 프레임은 유지 (천천히 변하는 장면도 누적 검출)
+// 버퍼 2뱅크: 한쪽은 기준, 다른 쪽에 새 프레임 기록 → 추론하면 역할 교대
+// 비활성: 입력을 그대로 CNN에 전달 (지연 없음, 기준 무효화)
+// 재출력은 CNN이 idle일 때만 → 처리 중인 프레임 결과보다 앞서지 않음
+module frame_change_detector #(
+	parameter MAX_PIXELS = 1024    // CNN_TOP 최대 프레임 (32x32), 넘는 픽셀은 버리고 항상 추론
+)(
+	input logic clk,
+	input logic rst,   // Active Low
+
+	// ===== 설정 (프레임 시작에 래치) =====
+	input logic i_enable,
+	input logic [31:0] i_threshold,
+	input logic [7:0] i_max_skip,                // 연속 생략 한도 (0 = 제한 없음)
+
+	// ===== 전처리 출력 (픽셀 스트림) =====
+	input logic i_frame_start,
+	input logic i_pixel_valid,
+	input logic [7:0] i_pixel_data,
+	input logic i_frame_done,
+	output logic o_in_ready,                     // 새 프레임 수신 가능 (axis_pixel_ingest i_frame_ready)
+
+	// ===== CNN 쪽 =====
+	input logic i_cnn_ready,                     // CNN 프레임 시작 가능
+	input logic i_cnn_idle,                      // CNN 결과 모두 출력됨
+	output logic o_frame_start,
+	output logic o_pixel_valid,
+	output logic [7:0] o_pixel_data,
+	output logic o_reuse,                        // 1클럭 펄스: 이전 결과 재출력
+
+	// ===== 상태 =====
+	output logic [31:0] o_last_sad,              // 마지막 프레임의 SAD (기준 없으면 0)
+	output logic [31:0] o_skip_count            // 생략한 프레임 수
+);
+	localparam AW = $clog2(MAX_PIXELS);
+
+	enum logic [2:0] { S_IDLE, S_PASS, S_CAPTURE, S_FLUSH, S_DECIDE, S_WAIT_CNN, S_REPLAY, S_WAIT_IDLE } state;
+
+	// ===== 프레임 버퍼 (2뱅크, 쓰기 1 / 읽기 1 포트) =====
+	logic [7:0] frame_mem [0:2*MAX_PIXELS-1];
+	logic ref_bank;                               // 기준 프레임 뱅크 (새 프레임은 반대쪽)
+	logic ref_valid;
+	logic [AW:0] ref_count;
+	logic [AW:0] cap_count;
+	logic cap_overflow;
+
+	logic [AW:0] rd_addr;
+	logic [7:0] rd_data;
+	logic [AW-1:0] mem_rd_idx;
+	logic mem_rd_bank;
+
+	// 수신 중에는 기준 뱅크, 재생 중에는 새 프레임 뱅크를 읽음
+	assign mem_rd_bank = (state == S_REPLAY) ? ~ref_bank : ref_bank;
+	assign mem_rd_idx  = (state == S_REPLAY) ? rd_addr[AW-1:0] : cap_count[AW-1:0];
+
+	// cap_count는 S_IDLE에서 항상 0 (프레임 시작 사이클 픽셀도 주소 0에 기록)
+	logic cap_write;
+	assign cap_write = (state == S_CAPTURE || (state == S_IDLE && i_frame_start && i_enable)) &&
+	                   i_pixel_valid && cap_count < MAX_PIXELS;
+
+	always_ff @(posedge clk) begin
+		if(cap_write) frame_mem[{~ref_bank, cap_count[AW-1:0]}] <= i_pixel_data;
+		rd_data <= frame_mem[{mem_rd_bank, mem_rd_idx}];
+	end
+
+	// ===== 바이패스 (비활성 프레임) =====
+	logic pass_start;
+	logic passing;
+	logic rp_start, rp_valid;
+
+	assign pass_start = (state == S_IDLE) && i_frame_start && !i_enable;
+	assign passing    = pass_start || (state == S_PASS);
+
+	assign o_frame_start = pass_start | rp_start;
+	assign o_pixel_valid = passing ? i_pixel_valid : rp_valid;
+	assign o_pixel_data  = passing ? i_pixel_data : rd_data;
+	assign o_in_ready    = (state == S_IDLE) && (i_enable || i_cnn_ready);
+
+	// ===== SAD 누적 (읽기 1클럭 지연) =====
+	logic sad_valid;
+	logic [7:0] sad_pix;
+	logic [31:0] sad;
+	logic [7:0] abs_diff;
+
+	assign abs_diff = (sad_pix > rd_data) ? sad_pix - rd_data : rd_data - sad_pix;
+
+	// ===== 프레임 설정 =====
+	logic [31:0] cfg_threshold;
+	logic [7:0] cfg_max_skip;
+	logic [7:0] skip_run;
+	logic changed;
+
+	assign changed = !ref_valid || cap_overflow || cap_count != ref_count || sad > cfg_threshold ||
+	                 (cfg_max_skip != 0 && skip_run >= cfg_max_skip);
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			state <= S_IDLE;
+			ref_bank <= 1'b0;
+			ref_valid <= 1'b0;
+			ref_count <= '0;
+			cap_count <= '0;
+			cap_overflow <= 1'b0;
+			rd_addr <= '0;
+			rp_start <= 1'b0;
+			rp_valid <= 1'b0;
+			sad_valid <= 1'b0;
+			sad_pix <= '0;
+			sad <= '0;
+			cfg_threshold <= '0;
+			cfg_max_skip <= '0;
+			skip_run <= '0;
+			o_reuse <= 1'b0;
+			o_last_sad <= '0;
+			o_skip_count <= '0;
+		end else begin
+			rp_start <= 1'b0;
+			rp_valid <= 1'b0;
+			o_reuse <= 1'b0;
+
+			// 수신 픽셀과 기준 픽셀이 한 클럭 뒤 만남
+			sad_valid <= cap_write && ref_valid && cap_count < ref_count;
+			sad_pix <= i_pixel_data;
+			if(sad_valid) sad <= sad + abs_diff;
+
+			case(state)
+				S_IDLE: begin
+					if(i_frame_start) begin
+						if(i_enable) begin
+							cfg_threshold <= i_threshold;
+							cfg_max_skip <= i_max_skip;
+							cap_count <= cap_write ? 1 : 0;
+							cap_overflow <= 1'b0;
+							sad <= '0;
+							state <= i_frame_done ? S_FLUSH : S_CAPTURE;
+						end else begin
+							ref_valid <= 1'b0;   // 버퍼를 거치지 않은 프레임 → 기준 무효
+							state <= i_frame_done ? S_IDLE : S_PASS;
+						end
+					end
+				end
+
+				S_PASS: begin
+					if(i_frame_done) state <= S_IDLE;
+				end
+
+				S_CAPTURE: begin
+					if(i_pixel_valid) begin
+						if(cap_count < MAX_PIXELS) cap_count <= cap_count + 1'b1;
+						else                       cap_overflow <= 1'b1;
+					end
+					if(i_frame_done) state <= S_FLUSH;
+				end
+
+				S_FLUSH: state <= S_DECIDE;   // 마지막 픽셀 SAD 누적 대기
+
+				S_DECIDE: begin
+					o_last_sad <= sad;
+					if(cap_count == 0) state <= S_IDLE;   // 픽셀 없는 프레임
+					else if(changed) state <= S_WAIT_CNN;
+					else state <= S_WAIT_IDLE;
+				end
+
+				S_WAIT_CNN: begin
+					if(i_cnn_ready) begin
+						rp_start <= 1'b1;
+						rd_addr <= '0;
+						state <= S_REPLAY;
+					end
+				end
+
+				S_REPLAY: begin
+					rp_valid <= 1'b1;
+					rd_addr <= rd_addr + 1'b1;
+					if(rd_addr == cap_count - 1'b1) begin
+						ref_bank <= ~ref_bank;
+						ref_count <= cap_count;
+						ref_valid <= !cap_overflow;
+						skip_run <= '0;
+						cap_count <= '0;
+						state <= S_IDLE;
+					end
+				end
+
+				S_WAIT_IDLE: begin
+					if(i_cnn_idle) begin
+						o_reuse <= 1'b1;
+						o_skip_count <= o_skip_count + 1'b1;
+						if(skip_run != 8'hFF) skip_run <= skip_run + 1'b1;
+						cap_count <= '0;
+						state <= S_IDLE;
+					end
+				end
+
+				default: state <= S_IDLE;
+			endcase
+		end
+	end
+
+endmodule
@@ -0,0 +1,72 @@
+/* ===== 하드웨어 추상화 계층 (HAL) =====
+ * Microblaze.c와 sched.c는 이 헤더만 사용하고 보드 드라이버를 직접 부르지 않는다.
+ *   - 타깃: hal_microblaze.c (Xil_In32/Out32, UART Lite, AXI Timer 1 kHz 틱, AXI INTC)
+ *   - 호스트: sim/hal_host.c (-DHAL_HOST, 레지스터 스텁 + 가상 시간, 타이밍 시험용) */
+#ifndef HAL_H
+#define HAL_H
+
+#include <stddef.h>
+
+#ifdef HAL_HOST
+  #include <stdint.h>
+  #include <stdio.h>
+  typedef uint8_t  u8;
+  typedef uint16_t u16;
+  typedef uint32_t u32;
+  typedef uint64_t u64;
+  typedef int8_t   s8;
+  typedef int16_t  s16;
+  typedef int32_t  s32;
+  typedef int64_t  s64;
+  #ifndef clamp
+    #define clamp(v, lo, hi) ((v) < (lo) ? (lo) : ((v) > (hi) ? (hi) : (v)))
+  #endif
+
+  /* 호스트 주소 맵 (xparameters.h 대신, 값 자체는 의미 없음) */
+  #define XPAR_CNN_AXI_LITE_WRAPPER_0_BASEADDR 0x44A00000u
+  #define XPAR_DCMOTOR_MYIP_V1_0_BASEADDR      0x44A10000u
+  #define XPAR_ULTRASONIC_MYIP_V1_0_0_BASEADDR 0x44A20000u
+  #define XPAR_ULTRASONIC_MYIP_V1_0_1_BASEADDR 0x44A30000u
+  #define XPAR_ULTRASONIC_MYIP_V1_0_2_BASEADDR 0x44A40000u
+  #define XPAR_MICROBLAZE_0_AXI_INTC_MYIP_CNN_0_O_CNN_INTERRUPT_INTR 0
+
+  int hal_host_printf(const char *fmt, ...);
+  #define xil_printf hal_host_printf
+#else
+  #include "xil_types.h"
+  #include "xparameters.h"
+  #include "xil_printf.h"
+#endif
+
+typedef void (*HalIrqHandler)(void *ref);
+typedef int  (*HalUartTxPull)(u8 *byte);   // 보낼 바이트가 있으면 1
+
+/* ===== 초기화 ===== */
+void hal_init(void);                    // 플랫폼 + 인터럽트 컨트롤러 (인터럽트 전역 허용)
+void hal_cleanup(void);
+int  hal_running(void);                 // 타깃: 항상 1, 호스트: 시뮬레이션 시간 안이면 1
+
+/* ===== 메모리 맵 레지스터 ===== */
+u32  hal_read32(u32 addr);
+void hal_write32(u32 addr, u32 value);
+
+/* ===== 콘솔 UART (폴링, 블로킹 없음: 수신은 준비 확인 후 읽기) ===== */
+int  hal_uart_rx_ready(void);
+char hal_uart_getc(void);
+void hal_uart_putc(char c);
+void hal_uart_flush_rx(void);
+
+/* ===== 콘솔 UART 송신 큐 (TX 인터럽트가 pull로 한 바이트씩 꺼내 FIFO를 채움) ===== */
+int  hal_uart_tx_irq_start(HalUartTxPull pull);   // 실패 시 -1 (hal_uart_tx_kick이 빈 FIFO 자리만큼 폴링 전송)
+void hal_uart_tx_kick(void);                      // 큐에 넣은 뒤 호출: 송신이 멈춰 있으면 다시 시작 (대기 없음)
+
+/* ===== 시간 / 틱 ===== */
+u32  hal_now_us(void);                  // 단조 증가 µs 시계 (u32 랩, 차이는 (s32) 비교), 틱은 주기의 배수 시각
+void hal_delay_us(u32 us);              // 짧은 하드웨어 대기 전용 (모터 데드타임 등)
+int  hal_tick_start(u32 period_us, HalIrqHandler isr, void *ref);   // 주기 인터럽트, 실패 시 -1 (폴링 틱)
+void hal_wait_for_tick(void);           // 다음 틱까지 대기 (할 일이 없을 때)
+
+/* ===== 외부 인터럽트 ===== */
+int  hal_irq_connect(u32 irq_id, HalIrqHandler isr, void *ref);     // 실패 시 -1 (호출 측이 폴링)
+
+#endif /* HAL_H */
@@ -0,0 +1,234 @@
+/* ===== HAL: MicroBlaze 보드 구현 =====
+ * AXI Timer 0번 카운터를 1 kHz 자동 재적재 다운 카운터로 쓰고,
+ * µs 시계 = 틱 수 * 주기 + 현재 주기 안의 경과 카운트로 만든다 (별도 자유 계수 카운터 불필요).
+ * 타이머가 없거나 초기화에 실패하면 usleep 기반 폴링 틱으로 동작 (µs 시계 해상도 = 틱). */
+#include "hal.h"
+#include "platform.h"
+#include "xil_io.h"
+#include "xuartlite_l.h"
+#include "sleep.h"
+#include "xintc.h"
+#include "xtmrctr.h"
+#include "xil_exception.h"
+
+/* ================= 장치 설정 ================= */
+#ifndef UARTB
+  #if defined(XPAR_AXI_UARTLITE_1_BASEADDR)
+    #define UARTB XPAR_AXI_UARTLITE_1_BASEADDR
+  #elif defined(XPAR_UARTLITE_1_BASEADDR)
+    #define UARTB XPAR_UARTLITE_1_BASEADDR
+  #else
+    #define UARTB STDIN_BASEADDRESS
+  #endif
+#endif
+#ifndef HAL_INTC_DEVICE_ID
+  #define HAL_INTC_DEVICE_ID XPAR_INTC_0_DEVICE_ID
+#endif
+#ifndef HAL_TIMER_DEVICE_ID
+  #define HAL_TIMER_DEVICE_ID XPAR_TMRCTR_0_DEVICE_ID
+#endif
+#ifndef HAL_TIMER_IRQ_ID
+  #define HAL_TIMER_IRQ_ID XPAR_MICROBLAZE_0_AXI_INTC_AXI_TIMER_0_INTERRUPT_INTR
+#endif
+#ifndef HAL_TIMER_CLOCK_HZ
+  #if defined(XPAR_TMRCTR_0_CLOCK_FREQ_HZ)
+    #define HAL_TIMER_CLOCK_HZ XPAR_TMRCTR_0_CLOCK_FREQ_HZ
+  #else
+    #define HAL_TIMER_CLOCK_HZ XPAR_CPU_CORE_CLOCK_FREQ_HZ
+  #endif
+#endif
+#define HAL_TIMER_CNT_PER_US (HAL_TIMER_CLOCK_HZ / 1000000u)
+#ifndef HAL_UART_IRQ_ID
+  #define HAL_UART_IRQ_ID XPAR_MICROBLAZE_0_AXI_INTC_AXI_UARTLITE_1_INTERRUPT_INTR
+#endif
+
+static XIntc hal_intc;
+static int hal_intc_ok = 0;
+
+static XTmrCtr hal_timer;
+static int hal_timer_ok = 0;
+static u32 hal_tick_period_us = 1000;
+static u32 hal_tick_load;                 // 카운터 재적재 값 (주기 - 1 카운트)
+static volatile u32 hal_ticks = 0;
+static HalIrqHandler hal_tick_isr = NULL;
+static void *hal_tick_ref = NULL;
+
+static HalUartTxPull hal_tx_pull = NULL;
+static int hal_tx_irq_ok = 0;
+static volatile int hal_tx_idle = 1;      // 1: FIFO가 비어 다음 TX 인터럽트가 오지 않음 → kick이 재시작
+
+/* ================= 초기화 ================= */
+
+void hal_init(void) {
+    init_platform();
+
+    hal_intc_ok = 0;
+    if (XIntc_Initialize(&hal_intc, HAL_INTC_DEVICE_ID) != XST_SUCCESS) {
+        xil_printf("[HAL] INTC 초기화 실패 → 인터럽트 없음\r\n");
+    } else if (XIntc_Start(&hal_intc, XIN_REAL_MODE) != XST_SUCCESS) {
+        xil_printf("[HAL] INTC 시작 실패 → 인터럽트 없음\r\n");
+    } else {
+        Xil_ExceptionInit();
+        Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_INT,
+                                     (Xil_ExceptionHandler)XIntc_InterruptHandler, &hal_intc);
+        Xil_ExceptionEnable();
+        hal_intc_ok = 1;
+    }
+}
+
+void hal_cleanup(void) {
+    if (hal_timer_ok) XTmrCtr_Stop(&hal_timer, 0);
+    cleanup_platform();
+}
+
+int hal_running(void) {
+    return 1;
+}
+
+/* ================= 레지스터 / UART ================= */
+
+u32 hal_read32(u32 addr) {
+    return Xil_In32(addr);
+}
+
+void hal_write32(u32 addr, u32 value) {
+    Xil_Out32(addr, value);
+}
+
+int hal_uart_rx_ready(void) {
+    return !XUartLite_IsReceiveEmpty(UARTB);
+}
+
+char hal_uart_getc(void) {
+    return (char)XUartLite_RecvByte(UARTB);
+}
+
+void hal_uart_putc(char c) {
+    XUartLite_SendByte(UARTB, (u8)c);
+}
+
+void hal_uart_flush_rx(void) {
+    while (!XUartLite_IsReceiveEmpty(UARTB)) (void)XUartLite_RecvByte(UARTB);
+}
+
+/* ================= UART 송신 큐 =================
+ * UART Lite는 TX FIFO가 비는 순간 인터럽트 (16바이트 FIFO, 115200 bps에서 약 1.4 ms마다)
+ * → ISR이 FIFO를 다시 채우고, 채울 것이 없으면 idle로 두었다가 다음 kick에서 재시작.
+ * xil_printf도 같은 FIFO에 쓰므로 프레임 사이에 텍스트가 섞일 수 있음 (수신 측 CRC로 걸러짐) */
+
+static void hal_uart_tx_fill(void) {
+    u8 b;
+    int n = 0;
+    while (!XUartLite_IsTransmitFull(UARTB) && hal_tx_pull(&b)) {
+        XUartLite_WriteReg(UARTB, XUL_TX_FIFO_OFFSET, b);
+        n++;
+    }
+    hal_tx_idle = (n == 0);
+}
+
+static void hal_uart_isr(void *ref) {
+    (void)ref;
+    if (hal_tx_pull) hal_uart_tx_fill();   // 수신 인터럽트도 같은 선 (수신은 폴링, 여기서는 무시)
+}
+
+int hal_uart_tx_irq_start(HalUartTxPull pull) {
+    hal_tx_pull = pull;
+    hal_tx_idle = 1;
+    hal_tx_irq_ok = 0;
+    if (!hal_intc_ok || XIntc_Connect(&hal_intc, HAL_UART_IRQ_ID, hal_uart_isr, NULL) != XST_SUCCESS) {
+        xil_printf("[HAL] UART TX 인터럽트 없음 → 폴링 송신\r\n");
+        return -1;
+    }
+    XIntc_Enable(&hal_intc, HAL_UART_IRQ_ID);
+    XUartLite_EnableIntr(UARTB);
+    hal_tx_irq_ok = 1;
+    return 0;
+}
+
+/**
+ * 인터럽트 모드: INTC에서 UART 인터럽트만 잠시 막고 (대기 중 요청은 INTC가 유지) idle이면 채움
+ * 폴링 모드: 지금 빈 FIFO 자리만큼만 보냄 (나머지는 큐에 남아 다음 kick에서)
+ */
+void hal_uart_tx_kick(void) {
+    if (!hal_tx_pull) return;
+    if (!hal_tx_irq_ok) {
+        hal_uart_tx_fill();
+        return;
+    }
+    XIntc_Disable(&hal_intc, HAL_UART_IRQ_ID);
+    if (hal_tx_idle) hal_uart_tx_fill();
+    XIntc_Enable(&hal_intc, HAL_UART_IRQ_ID);
+}
+
+/* ================= 틱 / 시간 ================= */
+
+static void hal_timer_handler(void *ref, u8 counter) {
+    (void)ref;
+    (void)counter;
+    hal_ticks++;
+    if (hal_tick_isr) hal_tick_isr(hal_tick_ref);
+}
+
+int hal_tick_start(u32 period_us, HalIrqHandler isr, void *ref) {
+    hal_tick_period_us = period_us;
+    hal_tick_isr = isr;
+    hal_tick_ref = ref;
+    hal_tick_load = period_us * HAL_TIMER_CNT_PER_US - 1;
+
+    hal_timer_ok = 0;
+    if (!hal_intc_ok || XTmrCtr_Initialize(&hal_timer, HAL_TIMER_DEVICE_ID) != XST_SUCCESS) {
+        xil_printf("[HAL] 타이머 없음 → 폴링 틱 %lu us\r\n", (unsigned long)period_us);
+        return -1;
+    }
+    XTmrCtr_SetHandler(&hal_timer, hal_timer_handler, NULL);
+    XTmrCtr_SetOptions(&hal_timer, 0, XTC_INT_MODE_OPTION | XTC_AUTO_RELOAD_OPTION | XTC_DOWN_COUNT_OPTION);
+    XTmrCtr_SetResetValue(&hal_timer, 0, hal_tick_load);
+    if (XIntc_Connect(&hal_intc, HAL_TIMER_IRQ_ID, (XInterruptHandler)XTmrCtr_InterruptHandler,
+                      &hal_timer) != XST_SUCCESS) {
+        xil_printf("[HAL] 타이머 IRQ 연결 실패 → 폴링 틱\r\n");
+        return -1;
+    }
+    XIntc_Enable(&hal_intc, HAL_TIMER_IRQ_ID);
+    XTmrCtr_Start(&hal_timer, 0);
+    hal_timer_ok = 1;
+    xil_printf("[HAL] 타이머 틱 %lu us\r\n", (unsigned long)period_us);
+    return 0;
+}
+
+/**
+ * µs 시계: 틱 수와 다운 카운터를 일관되게 읽기 (읽는 도중 틱이 지나가면 다시 읽음)
+ */
+u32 hal_now_us(void) {
+    if (!hal_timer_ok) return hal_ticks * hal_tick_period_us;
+
+    u32 ticks, count;
+    do {
+        ticks = hal_ticks;
+        count = XTmrCtr_GetValue(&hal_timer, 0);
+    } while (ticks != hal_ticks);
+    return ticks * hal_tick_period_us + (hal_tick_load - count) / HAL_TIMER_CNT_PER_US;
+}
+
+void hal_delay_us(u32 us) {
+    usleep(us);
+}
+
+void hal_wait_for_tick(void) {
+    if (!hal_timer_ok) {
+        usleep(hal_tick_period_us);
+        hal_ticks++;
+        if (hal_tick_isr) hal_tick_isr(hal_tick_ref);
+        return;
+    }
+    u32 t = hal_ticks;
+    while (hal_ticks == t) { }
+}
+
+/* ================= 외부 인터럽트 ================= */
+
+int hal_irq_connect(u32 irq_id, HalIrqHandler isr, void *ref) {
+    if (!hal_intc_ok) return -1;
+    if (XIntc_Connect(&hal_intc, (u8)irq_id, (XInterruptHandler)isr, ref) != XST_SUCCESS) return -1;
+    XIntc_Enable(&hal_intc, (u8)irq_id);
+    return 0;
+}
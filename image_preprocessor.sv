@@ -0,0 +1,282 @@
+`timescale 1ns/1ps
+// ===== 입력 전처리: 그레이스케일 변환 + ROI 크롭 + 박스 필터 축소 =====
+// 카메라 원본 프레임 (예: 640x480 RGB565)을 CNN 입력 크기로 줄이는 스트리밍 단계
+// - 픽셀 포맷: 0 = Gray8, 1 = RGB888 (R, G, B 순), 2 = RGB565 (상위 바이트 먼저)
+// - 그레이: Y = (77R + 150G + 29B + 128) >> 8 (Gray8은 R = G = B로 두어 그대로 통과)
+// - ROI 안의 픽셀만 dx x dy 블록 평균 (dx, dy = 1..8), 블록이 다 차지 않는 나머지 행/열은 버림
+// - 프레임 버퍼 없이 라인 버퍼 한 줄 (출력 열마다 세로 누적 합)만 사용, 클럭당 바이트 1개
+// - 비활성화 시 바이트 스트림을 그대로 통과 (기존 32x32 Gray8 경로)
+module image_preprocessor #(
+	parameter MAX_OUT_WIDTH = 64   // 라인 버퍼 크기 = ROI 폭 / dx 최대값
+)(
+	input logic clk,
+	input logic rst,   // Active Low (negedge)
+
+	// ===== 설정 (프레임 시작에 래치) =====
+	input logic [31:0] i_ctrl,      // [0] enable, [2:1] format, [6:4] dx-1, [10:8] dy-1, [27:16] 원본 폭
+	input logic [31:0] i_roi_pos,   // [11:0] x0, [27:16] y0
+	input logic [31:0] i_roi_size,  // [11:0] 폭, [27:16] 높이
+
+	// ===== 원본 바이트 스트림 (axis_pixel_ingest) =====
+	input logic        i_frame_start,
+	input logic        i_byte_valid,
+	input logic [7:0]  i_byte,
+	input logic        i_frame_done,
+
+	// ===== CNN 픽셀 인터페이스 =====
+	output logic       o_frame_start,  // 비활성: 입력 시작 그대로, 활성: ROI 첫 픽셀 도착 시
+	output logic       o_pixel_valid,
+	output logic [7:0] o_pixel_data,
+	output logic       o_frame_done
+);
+	localparam FMT_GRAY8  = 2'd0;
+	localparam FMT_RGB888 = 2'd1;
+	localparam FMT_RGB565 = 2'd2;
+	localparam PIPE_DEPTH = 5;   // 바이트 입력 → 축소 픽셀 출력 지연
+	localparam COL_BITS = $clog2(MAX_OUT_WIDTH);
+
+	// ===== 프레임 설정 래치 =====
+	logic        cfg_enable;
+	logic [1:0]  cfg_format;
+	logic [2:0]  cfg_dx_m1, cfg_dy_m1;
+	logic [11:0] cfg_src_w;
+	logic [11:0] cfg_x0, cfg_y0;
+	logic [12:0] cfg_x1, cfg_y1;   // ROI 끝 (미포함)
+	logic [20:0] cfg_recip;        // 2^20 / (dx*dy) 올림 → 평균 = (합 + n/2) * recip >> 20
+	logic [5:0]  cfg_half;         // (dx*dy) / 2 반올림 항
+
+	// 역수 테이블: n = 1..64, 합 <= 255n 범위에서 나눗셈과 비트 단위로 동일
+	logic [20:0] recip_rom [1:64];
+	initial begin
+		for (int n = 1; n <= 64; n++) recip_rom[n] = 21'(((1 << 20) + n - 1) / n);
+	end
+
+	logic [6:0] block_n;
+	assign block_n = (7'(i_ctrl[6:4]) + 7'd1) * (7'(i_ctrl[10:8]) + 7'd1);
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			cfg_enable <= 1'b0;
+			cfg_format <= FMT_GRAY8;
+			cfg_dx_m1 <= 3'd0;
+			cfg_dy_m1 <= 3'd0;
+			cfg_src_w <= 12'd32;
+			cfg_x0 <= 12'd0;
+			cfg_y0 <= 12'd0;
+			cfg_x1 <= 13'd32;
+			cfg_y1 <= 13'd32;
+			cfg_recip <= 21'(1 << 20);
+			cfg_half <= 6'd0;
+		end else if(i_frame_start) begin
+			cfg_enable <= i_ctrl[0];
+			cfg_format <= i_ctrl[2:1];
+			cfg_dx_m1 <= i_ctrl[6:4];
+			cfg_dy_m1 <= i_ctrl[10:8];
+			cfg_src_w <= i_ctrl[27:16];
+			cfg_x0 <= i_roi_pos[11:0];
+			cfg_y0 <= i_roi_pos[27:16];
+			cfg_x1 <= 13'(i_roi_pos[11:0]) + 13'(i_roi_size[11:0]);
+			cfg_y1 <= 13'(i_roi_pos[27:16]) + 13'(i_roi_size[27:16]);
+			cfg_recip <= recip_rom[block_n];
+			cfg_half <= 6'(block_n >> 1);
+		end
+	end
+
+	// ===== 1단: 바이트 → RGB 픽셀 =====
+	logic [1:0] byte_phase;
+	logic [7:0] byte_r, byte_hi;
+	logic       s1_valid;
+	logic [7:0] s1_r, s1_g, s1_b;
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			byte_phase <= 2'd0;
+			byte_r <= 8'h00;
+			byte_hi <= 8'h00;
+			s1_valid <= 1'b0;
+			s1_r <= 8'h00; s1_g <= 8'h00; s1_b <= 8'h00;
+		end else begin
+			s1_valid <= 1'b0;
+			if(i_frame_start) begin
+				byte_phase <= 2'd0;
+			end else if(i_byte_valid) begin
+				case(cfg_format)
+					FMT_RGB888: begin
+						if(byte_phase == 2'd0) byte_r <= i_byte;
+						if(byte_phase == 2'd1) byte_hi <= i_byte;   // G
+						if(byte_phase == 2'd2) begin
+							s1_valid <= 1'b1;
+							{s1_r, s1_g, s1_b} <= {byte_r, byte_hi, i_byte};
+							byte_phase <= 2'd0;
+						end else begin
+							byte_phase <= byte_phase + 2'd1;
+						end
+					end
+					FMT_RGB565: begin
+						if(byte_phase == 2'd0) begin
+							byte_hi <= i_byte;
+							byte_phase <= 2'd1;
+						end else begin
+							// {R5 G6 B5} → 상위 비트 복제로 8비트 확장
+							s1_valid <= 1'b1;
+							s1_r <= {byte_hi[7:3], byte_hi[7:5]};
+							s1_g <= {byte_hi[2:0], i_byte[7:5], byte_hi[2:1]};
+							s1_b <= {i_byte[4:0], i_byte[4:2]};
+							byte_phase <= 2'd0;
+						end
+					end
+					default: begin   // Gray8
+						s1_valid <= 1'b1;
+						{s1_r, s1_g, s1_b} <= {3{i_byte}};
+					end
+				endcase
+			end
+		end
+	end
+
+	// ===== 2단: 그레이스케일 (BT.601 근사, 계수 합 256) =====
+	logic       s2_valid;
+	logic [7:0] s2_gray;
+	logic [15:0] luma;
+	assign luma = 16'd77 * s1_r + 16'd150 * s1_g + 16'd29 * s1_b + 16'd128;
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			s2_valid <= 1'b0;
+			s2_gray <= 8'h00;
+		end else begin
+			s2_valid <= s1_valid;
+			s2_gray <= luma[15:8];
+		end
+	end
+
+	// ===== 3단: 원본 좌표, ROI 판정, 가로 누적 (dx 픽셀) =====
+	logic [11:0] src_x, src_y;
+	logic [2:0]  px_phase, py_phase;
+	logic [COL_BITS:0] out_col;
+	logic [10:0] h_acc;
+	logic        in_roi;
+	logic [10:0] h_sum;
+
+	logic        s3_valid;
+	logic [COL_BITS-1:0] s3_col;
+	logic [10:0] s3_hsum;
+	logic        s3_first_row, s3_last_row;
+	logic        roi_start;
+
+	assign in_roi = (src_x >= cfg_x0) && (13'(src_x) < cfg_x1) &&
+	                (src_y >= cfg_y0) && (13'(src_y) < cfg_y1);
+	assign h_sum = ((px_phase == 3'd0) ? 11'd0 : h_acc) + 11'(s2_gray);
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			src_x <= 12'd0;
+			src_y <= 12'd0;
+			px_phase <= 3'd0;
+			py_phase <= 3'd0;
+			out_col <= '0;
+			h_acc <= 11'd0;
+			s3_valid <= 1'b0;
+			s3_col <= '0;
+			s3_hsum <= 11'd0;
+			s3_first_row <= 1'b0;
+			s3_last_row <= 1'b0;
+			roi_start <= 1'b0;
+		end else begin
+			s3_valid <= 1'b0;
+			roi_start <= 1'b0;
+			if(i_frame_start) begin
+				src_x <= 12'd0;
+				src_y <= 12'd0;
+				px_phase <= 3'd0;
+				py_phase <= 3'd0;
+				out_col <= '0;
+			end else if(s2_valid) begin
+				if(in_roi) begin
+					// ROI 첫 픽셀 = 축소 프레임 시작 (출력 픽셀보다 항상 앞섬)
+					if(src_x == cfg_x0 && src_y == cfg_y0) roi_start <= 1'b1;
+					h_acc <= h_sum;
+					if(px_phase == cfg_dx_m1) begin
+						px_phase <= 3'd0;
+						out_col <= out_col + 1'b1;
+						// 라인 버퍼 범위를 넘는 열은 버림
+						if(out_col < MAX_OUT_WIDTH) begin
+							s3_valid <= 1'b1;
+							s3_col <= COL_BITS'(out_col);
+							s3_hsum <= h_sum;
+							s3_first_row <= (py_phase == 3'd0);
+							s3_last_row <= (py_phase == cfg_dy_m1);
+						end
+					end else begin
+						px_phase <= px_phase + 3'd1;
+					end
+				end
+
+				// 원본 행 끝: 좌표 이동, ROI 행이면 세로 위상 진행
+				if(src_x == cfg_src_w - 12'd1) begin
+					src_x <= 12'd0;
+					src_y <= src_y + 12'd1;
+					px_phase <= 3'd0;
+					out_col <= '0;
+					if(src_y >= cfg_y0 && 13'(src_y) < cfg_y1)
+						py_phase <= (py_phase == cfg_dy_m1) ? 3'd0 : py_phase + 3'd1;
+				end else begin
+					src_x <= src_x + 12'd1;
+				end
+			end
+		end
+	end
+
+	// ===== 4단: 세로 누적 라인 버퍼 (출력 열마다 dy 행 합) =====
+	logic [13:0] col_sum [0:MAX_OUT_WIDTH-1];
+	logic [13:0] v_sum;
+	logic        s4_valid;
+	logic [13:0] s4_sum;
+
+	assign v_sum = (s3_first_row ? 14'd0 : col_sum[s3_col]) + 14'(s3_hsum);
+
+	always_ff @(posedge clk) begin
+		if(s3_valid) col_sum[s3_col] <= v_sum;
+	end
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			s4_valid <= 1'b0;
+			s4_sum <= 14'd0;
+		end else begin
+			s4_valid <= s3_valid && s3_last_row;
+			s4_sum <= v_sum;
+		end
+	end
+
+	// ===== 5단: 블록 평균 (역수 곱셈) + 출력 선택 =====
+	logic [34:0] avg_product;
+	assign avg_product = 35'(s4_sum + 14'(cfg_half)) * 35'(cfg_recip);
+
+	logic [PIPE_DEPTH-1:0] done_pipe;
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			o_frame_start <= 1'b0;
+			o_pixel_valid <= 1'b0;
+			o_pixel_data <= 8'h00;
+			o_frame_done <= 1'b0;
+			done_pipe <= '0;
+		end else begin
+			done_pipe <= {done_pipe[PIPE_DEPTH-2:0], i_frame_done};
+			if(i_frame_start ? !i_ctrl[0] : !cfg_enable) begin
+				// 바이패스: 1클럭 지연으로 그대로 전달
+				o_frame_start <= i_frame_start;
+				o_pixel_valid <= i_byte_valid;
+				o_pixel_data <= i_byte;
+				o_frame_done <= i_frame_done;
+			end else begin
+				o_frame_start <= roi_start;
+				o_pixel_valid <= s4_valid;
+				o_pixel_data <= avg_product[27:20];
+				o_frame_done <= done_pipe[PIPE_DEPTH-2];
+			end
+		end
+	end
+
+endmodule
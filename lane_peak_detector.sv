@@ -0,0 +1,189 @@
+`timescale 1ns/1ps
+// ===== 스트리밍 차선 피크 검출기 =====
+// conv 출력이 나오는 즉시 임계값 비교 + 피크 추적 (top_controller의 FIND_LANES 스캔 제거)
+// 행 마지막 출력(i_last)에서 피크 집합을 스냅샷하고 바로 다음 행 추적 시작 → 행 간 공백 없이 연속 입력 가능
+// 피크 쌍 선택: 모든 쌍 (MAX_PEAKS=4면 6쌍)을 동시에 계산, last_center와의 거리를 비교 트리 한 번으로 최소 선택
+// 결과: i_last 후 2클럭에 o_valid (행당 1개, 라인 레이트)
+module lane_peak_detector #(
+	parameter DATA_WIDTH = 18,
+	parameter MAX_PEAKS  = 4,
+	parameter signed [DATA_WIDTH-1:0] THRESHOLD = 100,   // 차선으로 인식할 최소 응답 크기
+	parameter CENTER_INIT = 15                            // 첫 행의 기준 중심 (0~29의 가운데)
+)(
+	input logic clk,
+	input logic rst,   // Active Low
+
+	// ===== conv 출력 스트림 (행 우선, 위치 0부터) =====
+	input logic i_valid,
+	input logic signed [DATA_WIDTH-1:0] i_data,
+	input logic i_last,                     // 행의 마지막 conv 출력
+
+	// ===== 행별 결과 =====
+	output logic o_valid,                   // 1클럭 펄스
+	output logic [7:0] o_center,            // 차선 중심 위치 (쌍이 없으면 이전 중심 유지)
+	output logic [7:0] o_confidence,        // 두 피크 세기 합 (쌍이 없으면 0)
+	output logic [$clog2(MAX_PEAKS+1)-1:0] o_peak_count,
+	output logic o_pair_found
+);
+	localparam CNT_W = $clog2(MAX_PEAKS+1);
+	localparam NUM_PAIRS = MAX_PEAKS * (MAX_PEAKS - 1) / 2;
+	localparam TREE_LEAVES = 1 << $clog2(NUM_PAIRS);   // 비교 트리 잎 수 (2의 거듭제곱으로 채움)
+
+	// ===== 1단: 샘플별 피크 추적 =====
+	logic [7:0] pos;                                    // 현재 행 안의 출력 위치
+	logic [7:0] peak_pos [0:MAX_PEAKS-1];
+	logic [DATA_WIDTH-1:0] peak_val [0:MAX_PEAKS-1];    // 절댓값 (부호 없음, 최소값도 표현 가능)
+	logic [CNT_W-1:0] peak_cnt;
+
+	logic [DATA_WIDTH-1:0] abs_data;
+	logic hit;
+	assign abs_data = i_data[DATA_WIDTH-1] ? (~i_data + 1'b1) : i_data;
+	assign hit = (abs_data > THRESHOLD) && (peak_cnt < MAX_PEAKS);
+
+	// 이번 샘플까지 반영한 피크 집합 (i_last에서 스냅샷에 그대로 사용)
+	logic [7:0] next_pos [0:MAX_PEAKS-1];
+	logic [DATA_WIDTH-1:0] next_val [0:MAX_PEAKS-1];
+	logic [CNT_W-1:0] next_cnt;
+
+	always_comb begin
+		next_pos = peak_pos;
+		next_val = peak_val;
+		next_cnt = peak_cnt;
+		if(hit) begin
+			next_pos[peak_cnt] = pos;
+			next_val[peak_cnt] = abs_data;
+			next_cnt = peak_cnt + 1'b1;
+		end
+	end
+
+	// 스냅샷 (2단 입력)
+	logic snap_valid;
+	logic [7:0] snap_pos [0:MAX_PEAKS-1];
+	logic [DATA_WIDTH-1:0] snap_val [0:MAX_PEAKS-1];
+	logic [CNT_W-1:0] snap_cnt;
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			pos <= '0;
+			peak_pos <= '{default: '0};
+			peak_val <= '{default: '0};
+			peak_cnt <= '0;
+			snap_valid <= 1'b0;
+			snap_pos <= '{default: '0};
+			snap_val <= '{default: '0};
+			snap_cnt <= '0;
+		end else begin
+			snap_valid <= 1'b0;
+			if(i_valid) begin
+				if(i_last) begin
+					// 행 종료: 스냅샷 후 다음 행을 위해 즉시 초기화
+					snap_valid <= 1'b1;
+					snap_pos <= next_pos;
+					snap_val <= next_val;
+					snap_cnt <= next_cnt;
+					pos <= '0;
+					peak_cnt <= '0;
+				end else begin
+					pos <= pos + 8'd1;
+					peak_pos <= next_pos;
+					peak_val <= next_val;
+					peak_cnt <= next_cnt;
+				end
+			end
+		end
+	end
+
+	// ===== 2단: 모든 쌍 동시 평가 + 비교 트리 =====
+	logic [7:0] last_center_pos;
+
+	// 쌍 목록 (p1 < p2, 사전순 → 동점이면 앞 쌍 유지: 기존 SELECT_PAIR 순차 탐색과 같은 선택)
+	logic pair_ok [0:TREE_LEAVES-1];
+	logic [7:0] pair_diff [0:TREE_LEAVES-1];
+	logic [$clog2(MAX_PEAKS)-1:0] pair_p1 [0:TREE_LEAVES-1];
+	logic [$clog2(MAX_PEAKS)-1:0] pair_p2 [0:TREE_LEAVES-1];
+
+	always_comb begin
+		int n;
+		logic [8:0] sum;
+		logic [7:0] center;
+		n = 0;
+		for(int t = 0; t < TREE_LEAVES; t++) begin
+			pair_ok[t] = 1'b0;
+			pair_diff[t] = 8'hFF;
+			pair_p1[t] = '0;
+			pair_p2[t] = '0;
+		end
+		for(int a = 0; a < MAX_PEAKS; a++) begin
+			for(int b = a + 1; b < MAX_PEAKS; b++) begin
+				sum = snap_pos[a] + snap_pos[b];
+				center = sum[8:1];
+				pair_ok[n] = (b < snap_cnt);
+				pair_diff[n] = (center > last_center_pos) ? (center - last_center_pos) : (last_center_pos - center);
+				pair_p1[n] = a;
+				pair_p2[n] = b;
+				n++;
+			end
+		end
+	end
+
+	// 힙 배열 비교 트리: 잎 = TREE_LEAVES..2*TREE_LEAVES-1, 노드 k = 자식 2k, 2k+1 중 작은 쪽 (동점이면 왼쪽)
+	logic node_ok [1:2*TREE_LEAVES-1];
+	logic [7:0] node_diff [1:2*TREE_LEAVES-1];
+	logic [$clog2(TREE_LEAVES)-1:0] node_idx [1:2*TREE_LEAVES-1];
+
+	always_comb begin
+		for(int t = 0; t < TREE_LEAVES; t++) begin
+			node_ok[TREE_LEAVES + t] = pair_ok[t];
+			node_diff[TREE_LEAVES + t] = pair_diff[t];
+			node_idx[TREE_LEAVES + t] = t;
+		end
+		for(int k = TREE_LEAVES - 1; k >= 1; k--) begin
+			if(node_ok[2*k+1] && (!node_ok[2*k] || node_diff[2*k+1] < node_diff[2*k])) begin
+				node_ok[k] = node_ok[2*k+1];
+				node_diff[k] = node_diff[2*k+1];
+				node_idx[k] = node_idx[2*k+1];
+			end else begin
+				node_ok[k] = node_ok[2*k];
+				node_diff[k] = node_diff[2*k];
+				node_idx[k] = node_idx[2*k];
+			end
+		end
+	end
+
+	// 피크 세기 → 신뢰도 기여분 (255 초과는 127로 포화)
+	function automatic logic [7:0] conf_term(input logic [DATA_WIDTH-1:0] v);
+		return (v > 255) ? 8'd127 : {1'b0, v[7:1]};
+	endfunction
+
+	logic [7:0] best_p1_pos, best_p2_pos;
+	logic [8:0] best_sum;
+	assign best_p1_pos = snap_pos[pair_p1[node_idx[1]]];
+	assign best_p2_pos = snap_pos[pair_p2[node_idx[1]]];
+	assign best_sum = best_p1_pos + best_p2_pos;
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			last_center_pos <= CENTER_INIT;
+			o_valid <= 1'b0;
+			o_center <= CENTER_INIT;
+			o_confidence <= '0;
+			o_peak_count <= '0;
+			o_pair_found <= 1'b0;
+		end else begin
+			o_valid <= snap_valid;
+			if(snap_valid) begin
+				o_peak_count <= snap_cnt;
+				o_pair_found <= node_ok[1];
+				if(node_ok[1]) begin
+					o_center <= best_sum[8:1];
+					o_confidence <= conf_term(snap_val[pair_p1[node_idx[1]]]) + conf_term(snap_val[pair_p2[node_idx[1]]]);
+					last_center_pos <= best_sum[8:1];
+				end else begin
+					o_center <= last_center_pos;
+					o_confidence <= 8'd0;
+				end
+			end
+		end
+	end
+
+endmodule
@@ -0,0 +1,48 @@
+`timescale 1ns/1ps
+module mac_int8x2(
+	input logic clk,
+	input logic rst,
+	input logic i_valid,
+	input logic signed [7:0] data_in_a,     // 공유 활성값
+	input logic signed [7:0] weight_lo,     // 뉴런 n
+	input logic signed [7:0] weight_hi,     // 뉴런 n+1
+	output logic o_valid,
+	output logic signed [47:0] prod_lo,     // a * weight_lo (부호 확장)
+	output logic signed [47:0] prod_hi      // a * weight_hi (부호 확장)
+);
+	// ===== DSP 패킹: 곱셈기 하나로 INT8 곱 두 개 =====
+	// (weight_hi << 16) + weight_lo 를 DSP48E1 25비트 포트에, a를 18비트 포트에 넣으면
+	//   P = a*weight_hi*2^16 + a*weight_lo
+	// |a*weight_lo| <= 2^14 이므로 하위 16비트에 그대로 들어가고,
+	// 하위 곱이 음수면 상위 필드에서 1을 빌려 가므로 P[15]를 더해 보정
+	// 지연은 MAC_unit과 같은 3사이클 (입력 / 곱 / 출력 레지스터)
+	logic signed [7:0] data_a_reg;
+	logic signed [24:0] packed_b_reg;
+	logic signed [32:0] mul_result_reg;
+	logic i_valid_d1, i_valid_d2;
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			data_a_reg <= '0;
+			packed_b_reg <= '0;
+			mul_result_reg <= '0;
+			prod_lo <= '0;
+			prod_hi <= '0;
+			i_valid_d1 <= 1'b0;
+			i_valid_d2 <= 1'b0;
+			o_valid <= 1'b0;
+		end else begin
+			data_a_reg <= data_in_a;
+			packed_b_reg <= (25'(weight_hi) <<< 16) + 25'(weight_lo);
+			i_valid_d1 <= i_valid;
+
+			mul_result_reg <= data_a_reg * packed_b_reg;
+			i_valid_d2 <= i_valid_d1;
+
+			prod_lo <= 48'(signed'(mul_result_reg[15:0]));
+			prod_hi <= 48'(mul_result_reg >>> 16) + 48'(mul_result_reg[15]);
+			o_valid <= i_valid_d2;
+		end
+	end
+
+endmodule
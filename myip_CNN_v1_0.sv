@@ -3,7 +3,16 @@
 module myip_CNN_v1_0 #
 (
 	parameter integer C_S00_AXI_CNN_DATA_WIDTH	= 32,
-	parameter integer C_S00_AXI_CNN_ADDR_WIDTH	= 5
+	parameter integer C_S00_AXI_CNN_ADDR_WIDTH	= 8,
+	
+	// CNN 데이터 경로: 0 = 22비트 (기존), 1 = INT16, 2 = INT8 (FC DSP 패킹)
+	parameter integer C_CNN_QUANT_MODE	= 0,
+	
+	// 하드웨어 조향 루프가 쓰는 DC 모터 PWM IP 주소 (XPAR_DCMOTOR_MYIP_V1_0_BASEADDR)
+	parameter [31:0] C_M00_AXI_PWM_BASEADDR	= 32'h44A1_0000,
+	
+	// 초음파 샘플 주기 분주용 (s00_axi_cnn_aclk 주파수)
+	parameter integer C_S00_AXI_CNN_CLK_HZ	= 100_000_000
 )
 (
 	// ===== 외부 연결용 포트들 (선택적) =====
@@ -12,8 +21,45 @@ module myip_CNN_v1_0 #
 	output wire              o_cnn_done,          // CNN 완료
 	output wire              o_frame_processing,  // 프레임 처리 중
 	output wire [7:0]        o_debug_state,       // 디버그 상태
-	output wire              o_cnn_interrupt,     // CNN 완료 인터럽트
 	*/
+	output wire              o_cnn_interrupt,     // CNN 인터럽트 (레벨, AXI INTC 연결)
+	
+	// ===== 초음파 IP 3개의 BCD 거리 출력: [11:8] 백, [7:4] 십, [3:0] 일 (없는 자리는 0으로 연결) =====
+	input wire [11:0]        us_bcd_front,
+	input wire [11:0]        us_bcd_right,
+	input wire [11:0]        us_bcd_left,
+	
+	// ===== CNN 코어 클럭 (conv / pool / FC, 버스 클럭과 무관, 예: clk_wiz_0 clk_out1) =====
+	input wire               cnn_core_clk,
+	
+	// ===== AXI4-Stream Slave (픽셀 버스트 입력, S00_AXI_CNN 클럭 사용) =====
+	input wire [31 : 0] s00_axis_pix_tdata,
+	input wire [3 : 0] s00_axis_pix_tkeep,
+	input wire  s00_axis_pix_tlast,
+	input wire  s00_axis_pix_tvalid,
+	output wire  s00_axis_pix_tready,
+
+	// ===== AXI4-Lite Master (CNN 결과 → PID → PWM IP, 쓰기 전용, S00_AXI_CNN 클럭 사용) =====
+	output wire [31 : 0] m00_axi_pwm_awaddr,
+	output wire [2 : 0] m00_axi_pwm_awprot,
+	output wire  m00_axi_pwm_awvalid,
+	input wire  m00_axi_pwm_awready,
+	output wire [31 : 0] m00_axi_pwm_wdata,
+	output wire [3 : 0] m00_axi_pwm_wstrb,
+	output wire  m00_axi_pwm_wvalid,
+	input wire  m00_axi_pwm_wready,
+	input wire [1 : 0] m00_axi_pwm_bresp,
+	input wire  m00_axi_pwm_bvalid,
+	output wire  m00_axi_pwm_bready,
+	output wire [31 : 0] m00_axi_pwm_araddr,
+	output wire [2 : 0] m00_axi_pwm_arprot,
+	output wire  m00_axi_pwm_arvalid,
+	input wire  m00_axi_pwm_arready,
+	input wire [31 : 0] m00_axi_pwm_rdata,
+	input wire [1 : 0] m00_axi_pwm_rresp,
+	input wire  m00_axi_pwm_rvalid,
+	output wire  m00_axi_pwm_rready,
+
 	// ===== AXI Slave Bus Interface S00_AXI_CNN =====
 	input wire  s00_axi_cnn_aclk,
 	input wire  s00_axi_cnn_aresetn,
@@ -46,12 +92,166 @@ module myip_CNN_v1_0 #
     wire cnn_core_busy;                
     wire cnn_core_result_valid;        // CNN에서만 구동
     wire signed [47:0] cnn_core_result;
+    wire [1:0] cnn_core_class_idx;
+    wire signed [47:0] cnn_core_class_score;
+    wire [47:0] cnn_core_class_margin;
+    wire [7:0] cnn_core_frame_tag;      // 결과가 속한 프레임 번호
+    wire cnn_core_frame_ready;          // 다음 프레임 수신 가능
+    wire [3:0] cnn_core_stage_busy;     // conv, pool, flatten, FC
+    wire [3:0] cnn_core_stage_stall;
+    wire [31:0] cnn_core_latency;       // 마지막 결과의 프레임 지연 (사이클)
+    wire [31:0] cnn_core_fc_cycles;     // 마지막 결과의 FC 패스 사이클
+    wire [15:0] cnn_core_fc_nonzero;    // 마지막 결과의 0이 아닌 FC 입력 수
+    wire cnn_core_timeout;              // 워치독 타임아웃
+    wire cnn_core_wt_active_bank;       // 새 프레임이 사용할 가중치 뱅크
+    wire cnn_core_wt_swap_busy;         // 가중치 뱅크 교체 진행 중
+    wire [2:0] cnn_core_fifo_ovf;       // 코어 FIFO 오버플로 ([2] 픽셀, [1] 가중치, [0] 결과, sticky)
+    wire [31:0] cnn_core_t_feature;     // 마지막 결과의 단계 시각 (코어 시작 기준 코어 사이클)
+    wire [31:0] cnn_core_t_flatten;
+    wire [31:0] cnn_core_t_fc_start;
+    wire cnn_core_seq_path;             // 마지막 결과가 시퀀서 프레임 (결과와 함께 래치, 현재 SEQ_CTRL과 무관)
 	
 	// MicroBlaze controlled pixel interface (복원)
     wire ctrl_pixel_valid;             
     wire [7:0] ctrl_pixel_data;        
     wire ctrl_frame_start;             
     wire ctrl_frame_complete;  
+    wire ctrl_stream_enable;           // AXI4-Stream 입력 사용
+	
+	// AXI4-Stream ingest signals (원본 바이트 → 전처리 → stream_*)
+    wire ingest_frame_start;
+    wire ingest_byte_valid;
+    wire [7:0] ingest_byte;
+    wire ingest_frame_done;
+    wire stream_frame_start;
+    wire stream_pixel_valid;
+    wire [7:0] stream_pixel_data;
+    wire stream_frame_done;
+    wire [8:0] stream_fifo_level;
+    wire [15:0] stream_frame_count;
+    wire stream_busy;
+    wire stream_stall;
+	
+	// Performance counters
+    wire perf_snapshot;
+    wire perf_clear;
+    wire [4:0] perf_sel;
+    wire [31:0] perf_data;
+	
+	// Runtime weight load
+    wire wt_wr_en;
+    wire [16:0] wt_wr_addr;
+    wire [31:0] wt_wr_data;
+    wire wt_swap_req;
+    wire [31:0] quant_cfg;          // Feature → FC 재양자화 설정
+    wire [31:0] geometry;           // 프레임 크기 / stride / 패딩 (다음 프레임부터)
+    wire [31:0] preproc_ctrl;       // 전처리: 포맷 / 축소 비율 / 원본 폭
+    wire [31:0] preproc_roi_pos;
+    wire [31:0] preproc_roi_size;
+	
+	// Layer sequencer (디스크립터 기반 다층 네트워크, SEQ_CTRL[0]으로 프레임 경로 선택, 코어 안에서 엔진 공유)
+    wire [31:0] seq_ctrl;
+    wire seq_enable;
+    wire seq_wr_en;
+    wire [16:0] seq_wr_addr;
+    wire [31:0] seq_wr_data;
+    wire seq_busy;
+    wire seq_error;
+    wire [3:0] seq_layer;
+    wire [31:0] axi_seq_status;
+	
+	// 프레임 변화 검출 (정지 / 같은 프레임은 추론 생략, 이전 결과 재출력)
+    wire [31:0] fcd_ctrl;
+    wire [31:0] fcd_thresh;
+    wire fcd_in_ready;
+    wire fcd_frame_start;
+    wire fcd_pixel_valid;
+    wire [7:0] fcd_pixel_data;
+    wire fcd_reuse;
+    wire [31:0] fcd_sad;
+    wire [31:0] fcd_skips;
+	
+	// 초음파 스냅샷 (센서 태스크가 레지스터 몇 개만 읽음)
+    wire [31:0] us_ctrl;
+    wire [31:0] us_obst_cfg;
+    wire [2:0][9:0] us_cm;
+    wire [2:0] us_valid;
+    wire signed [15:0] us_obstacle;
+    wire [31:0] us_ts;
+    wire [7:0] us_seq;
+    wire [15:0] us_rejects;
+    wire [31:0] axi_us_dist;
+    wire [31:0] axi_us_info;
+	
+	// 추론 결과 (고정 파이프라인 또는 시퀀서)
+    wire infer_result_valid;
+    wire signed [47:0] infer_result;
+    wire [1:0] infer_class_idx;
+    wire signed [47:0] infer_class_score;
+    wire [47:0] infer_class_margin;
+    wire [31:0] infer_latency;
+    wire infer_seq_path;
+	
+	// 결과 경로 (추론 결과 또는 재출력)
+    wire out_result_valid;
+    wire signed [47:0] out_result;
+    wire [1:0] out_class_idx;
+    wire signed [47:0] out_class_score;
+    wire [47:0] out_class_margin;
+    wire [31:0] out_latency;
+    wire out_seq_path;                  // 결과가 시퀀서 프레임 (재출력이면 재사용한 결과의 경로)
+    wire out_frame_ready;
+    wire out_busy;
+	
+	// 하드웨어 조향 루프 (PID → 조향/듀티 → PWM IP)
+    wire [31:0] hw_ctrl;
+    wire hw_clear;
+    wire [31:0] hw_kp_ki;
+    wire [31:0] hw_kd;
+    wire [31:0] hw_int_limit;
+    wire hw_enable;
+    wire hw_pid_valid;
+    wire signed [15:0] hw_pid_out;
+    wire [1:0] hw_pid_class;            // hw_pid_valid와 같은 결과의 패턴 클래스
+    wire hw_mix_valid;
+    wire signed [7:0] hw_steer;
+    wire [6:0] hw_duty_l;
+    wire [6:0] hw_duty_r;
+    wire hw_pwm_busy;
+    wire hw_pwm_armed;
+    wire [7:0] hw_pwm_errors;
+    wire [31:0] hw_pwm_updates;
+    wire [31:0] axi_hw_status;
+	
+	// 결과 FIFO (시퀀스 번호 + 첫 픽셀 / 결과 사이클 타임스탬프)
+    wire frame_first;               // 프레임 첫 픽셀 수신 (Stream 첫 비트 또는 Lite 시작)
+    wire rf_pop;
+    wire rf_empty;
+    wire [4:0] rf_level;
+    wire signed [47:0] rf_result;
+    wire [1:0] rf_class;
+    wire rf_overflow;
+    wire rf_reused;
+    wire [31:0] rf_seq;
+    wire [31:0] rf_ts_first;
+    wire [31:0] rf_ts_result;
+    wire [15:0] rf_drops;
+    wire [31:0] cycle_now;
+    wire [31:0] axi_rf_status;
+    wire [31:0] axi_rf_result_hi;
+	
+	// 프레임별 지연 기록기 (최근 16프레임 단계 시각, 트리거 시 정지)
+    wire frame_last;                // 프레임 마지막 픽셀 수신 (Stream TLAST 또는 Lite 완료 비트)
+    wire [31:0] tr_ctrl;
+    wire tr_rearm;
+    wire [31:0] tr_thresh;
+    wire [8:0] tr_sel;
+    wire [31:0] tr_data;
+    wire [31:0] tr_status;
+	
+	// CNN pixel input (Lite 레지스터 또는 Stream 중 선택)
+    wire cnn_pixel_valid;
+    wire [7:0] cnn_pixel_data;
 	
 	// Status and counter signals
    wire [31:0] frame_counter;    
@@ -65,20 +265,384 @@ module myip_CNN_v1_0 #
     wire [31:0] axi_result_high;   
     wire [31:0] axi_frame_count;   
     wire [31:0] axi_error_code;  
+    wire [31:0] axi_class;
+    wire [31:0] axi_class_score;
+    wire [31:0] axi_class_margin;
+    wire [31:0] axi_ingest_status;
+    wire [31:0] axi_irq_set;        // 인터럽트 이벤트 펄스
+    wire [31:0] axi_perf_data;
+    wire [31:0] axi_wt_status;
 
-	// ===== CNN Processing Core (MicroBlaze 제어) =====
+	// ===== CNN Processing Core (MicroBlaze 제어, 코어 클럭 도메인) =====
+	// 픽셀 / 시작 / 가중치는 비동기 FIFO로 코어 클럭에, 결과 / 상태는 버스 클럭으로 돌아옴
+	// 지연 / FC 사이클 카운터는 코어 클럭 사이클, 단계 busy/stall은 버스 클럭 샘플
 	
-	CNN_TOP u_cnn_top (
-        .clk(s00_axi_cnn_aclk),
-        .rst(s00_axi_cnn_aresetn & ~cnn_core_reset),
-        .start_signal(cnn_core_start),
-        // Control Logic에서 오는 신호들
-        .pixel_valid(ctrl_pixel_valid),
-        .pixel_in(ctrl_pixel_data),
+	cnn_core_cdc #(
+        .QUANT_MODE(C_CNN_QUANT_MODE),
+        .CORE_RETIME(1)
+    ) u_cnn_core (
+        .bus_clk(s00_axi_cnn_aclk),
+        .bus_rst(s00_axi_cnn_aresetn & ~cnn_core_reset),
+        .i_start(cnn_core_start | fcd_frame_start),
+        // Control Logic 또는 AXI4-Stream ingest에서 오는 신호들
+        .i_pixel_valid(cnn_pixel_valid),
+        .i_pixel_in(cnn_pixel_data),
+        .i_quant_cfg(quant_cfg),
+        .i_geometry(geometry),
+        .i_seq_ctrl(seq_ctrl),
+        .i_wt_wr_en(wt_wr_en),
+        .i_wt_wr_addr(wt_wr_addr),
+        .i_wt_wr_data(wt_wr_data),
+        .i_wt_swap_req(wt_swap_req),
+        .i_seq_wr_en(seq_wr_en),
+        .i_seq_wr_addr(seq_wr_addr),
+        .i_seq_wr_data(seq_wr_data),
         // CNN에서만 구동하는 출력들
-        .final_result_valid(cnn_core_result_valid),  // CNN만 구동
-        .final_lane_result(cnn_core_result),
-		.cnn_busy(cnn_core_busy)
+        .o_result_valid(cnn_core_result_valid),  // CNN만 구동
+        .o_lane_result(cnn_core_result),
+        .o_class_idx(cnn_core_class_idx),
+        .o_class_score(cnn_core_class_score),
+        .o_class_margin(cnn_core_class_margin),
+        .o_frame_tag(cnn_core_frame_tag),
+        .o_latency(cnn_core_latency),
+        .o_fc_cycles(cnn_core_fc_cycles),
+        .o_fc_nonzero(cnn_core_fc_nonzero),
+        .o_t_feature(cnn_core_t_feature),
+        .o_t_flatten(cnn_core_t_flatten),
+        .o_t_fc_start(cnn_core_t_fc_start),
+        .o_seq_path(cnn_core_seq_path),
+        .o_frame_ready(cnn_core_frame_ready),
+		.o_busy(cnn_core_busy),
+        .o_stage_busy(cnn_core_stage_busy),
+        .o_stage_stall(cnn_core_stage_stall),
+        .o_timeout(cnn_core_timeout),
+        .o_wt_active_bank(cnn_core_wt_active_bank),
+        .o_wt_swap_busy(cnn_core_wt_swap_busy),
+        // 레이어 시퀀서 (코어 안에서 conv / pool / FC 엔진을 레이어마다 시간 분할)
+        .o_seq_busy(seq_busy),
+        .o_seq_error(seq_error),
+        .o_seq_layer(seq_layer),
+        .o_fifo_overflow(cnn_core_fifo_ovf),
+        .core_clk(cnn_core_clk)
+	);
+	
+	assign seq_enable = seq_ctrl[0];
+	
+	// 시퀀서 프레임도 코어 결과 경로로 나옴 (지연은 코어 클럭 사이클)
+	assign infer_result_valid = cnn_core_result_valid;
+	assign infer_result       = cnn_core_result;
+	assign infer_class_idx    = cnn_core_class_idx;
+	assign infer_class_score  = cnn_core_class_score;
+	assign infer_class_margin = cnn_core_class_margin;
+	assign infer_latency      = cnn_core_latency;
+	assign infer_seq_path     = cnn_core_seq_path;
+	assign out_frame_ready    = cnn_core_frame_ready;
+	assign out_busy           = cnn_core_busy;
+
+	// ===== 결과 재출력 (변화 없는 프레임 → 마지막 추론 결과를 재사용 표시와 함께 한 번 더) =====
+	// 검출기가 CNN idle을 확인한 뒤 펄스 → 추론 결과와 같은 사이클에 겹치지 않음
+	
+	reg reuse_valid;
+	reg signed [47:0] reuse_result;
+	reg [1:0] reuse_class_idx;
+	reg signed [47:0] reuse_class_score;
+	reg [47:0] reuse_class_margin;
+	reg [31:0] reuse_latency;
+	reg reuse_seq_path;
+	always @(posedge s00_axi_cnn_aclk) begin
+		if (s00_axi_cnn_aresetn == 1'b0) begin
+			reuse_valid <= 1'b0;
+			reuse_result <= 48'sd0;
+			reuse_class_idx <= 2'd0;
+			reuse_class_score <= 48'sd0;
+			reuse_class_margin <= 48'd0;
+			reuse_latency <= 32'd0;
+			reuse_seq_path <= 1'b0;
+		end else begin
+			reuse_valid <= fcd_reuse;
+			if (infer_result_valid) begin
+				reuse_result <= infer_result;
+				reuse_class_idx <= infer_class_idx;
+				reuse_class_score <= infer_class_score;
+				reuse_class_margin <= infer_class_margin;
+				reuse_latency <= infer_latency;
+				reuse_seq_path <= infer_seq_path;
+			end
+		end
+	end
+	
+	assign out_result_valid = infer_result_valid | reuse_valid;
+	assign out_result       = reuse_valid ? reuse_result       : infer_result;
+	assign out_class_idx    = reuse_valid ? reuse_class_idx    : infer_class_idx;
+	assign out_class_score  = reuse_valid ? reuse_class_score  : infer_class_score;
+	assign out_class_margin = reuse_valid ? reuse_class_margin : infer_class_margin;
+	assign out_latency      = reuse_valid ? reuse_latency      : infer_latency;
+	assign out_seq_path     = reuse_valid ? reuse_seq_path     : infer_seq_path;
+
+	// ===== AXI4-Stream Pixel Ingest (32비트 비트당 픽셀 4개, TLAST = 프레임 끝) =====
+	
+	axis_pixel_ingest #(
+		.FIFO_DEPTH(256)
+	) u_pixel_ingest (
+		.clk(s00_axi_cnn_aclk),
+		.rst(s00_axi_cnn_aresetn & ~cnn_core_reset),
+		.i_enable(ctrl_stream_enable),
+		.s_axis_tdata(s00_axis_pix_tdata),
+		.s_axis_tkeep(s00_axis_pix_tkeep),
+		.s_axis_tlast(s00_axis_pix_tlast),
+		.s_axis_tvalid(s00_axis_pix_tvalid),
+		.s_axis_tready(s00_axis_pix_tready),
+		.i_frame_ready(fcd_in_ready),
+		.o_frame_start(ingest_frame_start),
+		.o_pixel_valid(ingest_byte_valid),
+		.o_pixel_data(ingest_byte),
+		.o_frame_done(ingest_frame_done),
+		.o_fifo_level(stream_fifo_level),
+		.o_frame_count(stream_frame_count),
+		.o_busy(stream_busy),
+		.o_stall(stream_stall)
+	);
+
+	// ===== 입력 전처리 (그레이스케일 + ROI 크롭 + 박스 축소, 비활성 시 바이패스) =====
+	
+	image_preprocessor #(
+		.MAX_OUT_WIDTH(64)
+	) u_preprocessor (
+		.clk(s00_axi_cnn_aclk),
+		.rst(s00_axi_cnn_aresetn & ~cnn_core_reset),
+		.i_ctrl(preproc_ctrl),
+		.i_roi_pos(preproc_roi_pos),
+		.i_roi_size(preproc_roi_size),
+		.i_frame_start(ingest_frame_start),
+		.i_byte_valid(ingest_byte_valid),
+		.i_byte(ingest_byte),
+		.i_frame_done(ingest_frame_done),
+		.o_frame_start(stream_frame_start),
+		.o_pixel_valid(stream_pixel_valid),
+		.o_pixel_data(stream_pixel_data),
+		.o_frame_done(stream_frame_done)
+	);
+	
+	// ===== 프레임 변화 검출 (스트림 경로만, Lite 픽셀 경로는 항상 추론) =====
+	// 활성: 프레임을 버퍼에 받으며 마지막 추론 프레임과 SAD 비교 → 재생 또는 결과 재출력
+	
+	frame_change_detector #(
+		.MAX_PIXELS(1024)
+	) u_frame_change (
+		.clk(s00_axi_cnn_aclk),
+		.rst(s00_axi_cnn_aresetn & ~cnn_core_reset),
+		.i_enable(fcd_ctrl[0]),
+		.i_threshold(fcd_thresh),
+		.i_max_skip(fcd_ctrl[15:8]),
+		.i_frame_start(stream_frame_start),
+		.i_pixel_valid(stream_pixel_valid),
+		.i_pixel_data(stream_pixel_data),
+		.i_frame_done(stream_frame_done),
+		.o_in_ready(fcd_in_ready),
+		.i_cnn_ready(out_frame_ready),
+		.i_cnn_idle(~out_busy),
+		.o_frame_start(fcd_frame_start),
+		.o_pixel_valid(fcd_pixel_valid),
+		.o_pixel_data(fcd_pixel_data),
+		.o_reuse(fcd_reuse),
+		.o_last_sad(fcd_sad),
+		.o_skip_count(fcd_skips)
+	);
+	
+	assign cnn_pixel_valid = fcd_pixel_valid | ctrl_pixel_valid;
+	assign cnn_pixel_data = fcd_pixel_valid ? fcd_pixel_data : ctrl_pixel_data;
+
+	// ===== 하드웨어 조향 루프 (CPU 개입 없이 결과마다 PWM 갱신, MicroBlaze는 감독만) =====
+	// 비활성 중에는 PID 적분 / 조향 변화량 기준을 계속 초기화 → 활성화 시 0에서 시작
+	
+	assign hw_enable = hw_ctrl[0];
+	
+	PID_Controller u_pid (
+		.clk(s00_axi_cnn_aclk),
+		.rst(s00_axi_cnn_aresetn),
+		.i_clear(hw_clear | ~hw_enable),
+		.i_err_shift(hw_ctrl[12:8]),
+		.i_kp(hw_kp_ki[15:0]),
+		.i_ki(hw_kp_ki[31:16]),
+		.i_kd(hw_kd[15:0]),
+		.i_int_limit(hw_int_limit[23:0]),
+		.i_out_limit(hw_ctrl[31:24]),
+		.i_cnn_valid(out_result_valid),
+		.i_cnn_error(out_result),
+		.o_pid_valid(hw_pid_valid),
+		.o_pid_output(hw_pid_out)
+	);
+	
+	// 결과 클래스를 PID 지연 (4클럭)만큼 밀어 hw_pid_valid와 맞춤 → 믹서에서 펌웨어와 같은 클래스 보정
+	reg [1:0] hw_class_pipe [0:3];
+	always @(posedge s00_axi_cnn_aclk) begin
+		if (s00_axi_cnn_aresetn == 1'b0) begin
+			hw_class_pipe <= '{default: 2'd0};
+		end else begin
+			hw_class_pipe[0] <= out_class_idx;
+			for (int k = 1; k < 4; k++) hw_class_pipe[k] <= hw_class_pipe[k-1];
+		end
+	end
+	assign hw_pid_class = hw_class_pipe[3];
+	
+	steering_mixer u_steer_mixer (
+		.clk(s00_axi_cnn_aclk),
+		.rst(s00_axi_cnn_aresetn),
+		.i_clear(hw_clear | ~hw_enable),
+		.i_base(hw_ctrl[23:16]),
+		.i_steer_max(hw_ctrl[31:24]),
+		.i_rate(hw_kd[23:16]),
+		.i_valid(hw_pid_valid),
+		.i_steer(hw_pid_out),
+		.i_class(hw_pid_class),
+		.o_valid(hw_mix_valid),
+		.o_steer(hw_steer),
+		.o_duty_l(hw_duty_l),
+		.o_duty_r(hw_duty_r)
+	);
+	
+	axil_pwm_writer #(
+		.C_PWM_BASEADDR(C_M00_AXI_PWM_BASEADDR)
+	) u_pwm_writer (
+		.clk(s00_axi_cnn_aclk),
+		.rst(s00_axi_cnn_aresetn),
+		.i_enable(hw_enable),
+		.i_valid(hw_mix_valid),
+		.i_duty_l(hw_duty_l),
+		.i_duty_r(hw_duty_r),
+		.o_busy(hw_pwm_busy),
+		.o_armed(hw_pwm_armed),
+		.o_err_count(hw_pwm_errors),
+		.o_update_count(hw_pwm_updates),
+		.m_axi_awaddr(m00_axi_pwm_awaddr),
+		.m_axi_awprot(m00_axi_pwm_awprot),
+		.m_axi_awvalid(m00_axi_pwm_awvalid),
+		.m_axi_awready(m00_axi_pwm_awready),
+		.m_axi_wdata(m00_axi_pwm_wdata),
+		.m_axi_wstrb(m00_axi_pwm_wstrb),
+		.m_axi_wvalid(m00_axi_pwm_wvalid),
+		.m_axi_wready(m00_axi_pwm_wready),
+		.m_axi_bresp(m00_axi_pwm_bresp),
+		.m_axi_bvalid(m00_axi_pwm_bvalid),
+		.m_axi_bready(m00_axi_pwm_bready)
+	);
+	
+	// 읽기 채널 미사용
+	assign m00_axi_pwm_araddr  = 32'b0;
+	assign m00_axi_pwm_arprot  = 3'b000;
+	assign m00_axi_pwm_arvalid = 1'b0;
+	assign m00_axi_pwm_rready  = 1'b1;
+
+	// ===== 결과 FIFO (결과마다 엔트리, 소프트웨어가 한 번에 비움) =====
+	// 첫 픽셀: AXI4-Stream 프레임 첫 비트 수신 (CNN 대기 시간 포함) 또는 Lite 경로 시작 비트 상승
+	
+	reg axis_in_frame;
+	reg cnn_core_start_d1;
+	reg ctrl_frame_complete_d1;
+	always @(posedge s00_axi_cnn_aclk) begin
+		if (s00_axi_cnn_aresetn == 1'b0) begin
+			axis_in_frame <= 1'b0;
+			cnn_core_start_d1 <= 1'b0;
+			ctrl_frame_complete_d1 <= 1'b0;
+		end else begin
+			if (s00_axis_pix_tvalid && s00_axis_pix_tready) axis_in_frame <= ~s00_axis_pix_tlast;
+			cnn_core_start_d1 <= cnn_core_start;
+			ctrl_frame_complete_d1 <= ctrl_frame_complete;
+		end
+	end
+	
+	assign frame_first = (s00_axis_pix_tvalid && s00_axis_pix_tready && !axis_in_frame) ||
+	                     (cnn_core_start && !cnn_core_start_d1);
+	assign frame_last  = (s00_axis_pix_tvalid && s00_axis_pix_tready && s00_axis_pix_tlast) ||
+	                     (ctrl_frame_complete && !ctrl_frame_complete_d1);
+	
+	cnn_result_fifo #(
+		.DEPTH(16),
+		.TS_DEPTH(8)
+	) u_result_fifo (
+		.clk(s00_axi_cnn_aclk),
+		.rst(s00_axi_cnn_aresetn),
+		.i_flush(cnn_core_reset),
+		.i_frame_first(frame_first),
+		.i_result_valid(out_result_valid),
+		.i_result(out_result),
+		.i_class(out_class_idx),
+		.i_latency(out_latency),
+		.i_reused(reuse_valid),
+		.i_pop(rf_pop),
+		.o_empty(rf_empty),
+		.o_level(rf_level),
+		.o_result(rf_result),
+		.o_class(rf_class),
+		.o_overflow(rf_overflow),
+		.o_reused(rf_reused),
+		.o_seq(rf_seq),
+		.o_ts_first(rf_ts_first),
+		.o_ts_result(rf_ts_result),
+		.o_drop_count(rf_drops),
+		.o_now(cycle_now)
+	);
+
+	// ===== 프레임별 지연 기록기 (첫 픽셀 / 마지막 픽셀 / 코어 단계 / 결과 / 소프트웨어 읽기) =====
+	// 코어 단계 시각은 고정 파이프라인 추론 결과만 (재출력 / 시퀀서 결과는 0)
+	// AXI 리셋으로만 초기화 → CNN 리셋 전후 기록 유지 (처리 중 프레임만 포기)
+	
+	cnn_flight_recorder #(
+		.DEPTH(16),
+		.EV_DEPTH(8),
+		.MAP_DEPTH(16)
+	) u_flight_recorder (
+		.clk(s00_axi_cnn_aclk),
+		.rst(s00_axi_cnn_aresetn),
+		.i_enable(tr_ctrl[0]),
+		.i_trig_latency(tr_ctrl[1]),
+		.i_trig_watchdog(tr_ctrl[2]),
+		.i_trig_overflow(tr_ctrl[3]),
+		.i_threshold(tr_thresh),
+		.i_post(tr_ctrl[15:8]),
+		.i_rearm(tr_rearm),
+		.i_flush(cnn_core_reset),
+		.i_frame_first(frame_first),
+		.i_frame_last(frame_last),
+		.i_result_valid(out_result_valid),
+		.i_reused(reuse_valid),
+		.i_seq_path(out_seq_path),
+		.i_t_feature((reuse_valid | out_seq_path) ? 32'd0 : cnn_core_t_feature),
+		.i_t_flatten((reuse_valid | out_seq_path) ? 32'd0 : cnn_core_t_flatten),
+		.i_t_fc_start((reuse_valid | out_seq_path) ? 32'd0 : cnn_core_t_fc_start),
+		.i_t_fc_done((reuse_valid | out_seq_path) ? 32'd0 : cnn_core_latency),
+		.i_rf_full(rf_level == 5'd16),
+		.i_pop(rf_pop),
+		.i_pop_seq(rf_seq),
+		.i_timeout(cnn_core_timeout),
+		.i_now(cycle_now),
+		.i_sel(tr_sel),
+		.o_sel_data(tr_data),
+		.o_status(tr_status)
+	);
+
+	// ===== 초음파 샘플링 / 필터 (CPU 읽기 없이 주기마다, 타임스탬프는 결과 FIFO와 같은 카운터) =====
+	
+	ultrasonic_snapshot #(
+		.CLK_HZ(C_S00_AXI_CNN_CLK_HZ)
+	) u_ultrasonic (
+		.clk(s00_axi_cnn_aclk),
+		.rst(s00_axi_cnn_aresetn),
+		.i_enable(us_ctrl[0]),
+		.i_filter(us_ctrl[2:1]),
+		.i_period_ms(us_ctrl[15:8]),
+		.i_max_cm(us_ctrl[25:16]),
+		.i_wall_cm(us_obst_cfg[7:0]),
+		.i_steer_k(us_obst_cfg[15:8]),
+		.i_near_cm(us_obst_cfg[23:16]),
+		.i_bcd({us_bcd_left, us_bcd_right, us_bcd_front}),
+		.i_now(cycle_now),
+		.o_cm(us_cm),
+		.o_valid(us_valid),
+		.o_obstacle(us_obstacle),
+		.o_ts(us_ts),
+		.o_seq(us_seq),
+		.o_rejects(us_rejects)
 	);
 
 	// ===== Control Logic (픽셀 처리 복원) =====
@@ -120,29 +684,141 @@ assign ctrl_pixel_data = axi_pixel_reg[7:0];
 
 assign cnn_core_start = axi_control_reg[0];        // 직접 연결
 assign cnn_core_reset = axi_control_reg[1];        // 직접 연결
+assign ctrl_stream_enable = axi_control_reg[5];    // AXI4-Stream 입력 사용
 
-assign frame_counter = 32'h12345678;
-assign error_code = 32'h87654321;
+	// ===== 성능 카운터 (단계: 0 ingest, 1 conv, 2 pool, 3 flatten, 4 FC) =====
+	// 실제 프레임/타임아웃 수도 여기서 계수 (CNN 리셋과 무관하게 AXI 리셋으로만 초기화)
+	// 재출력 결과는 제외 → 프레임 수 / 지연은 실제 추론한 프레임만 (생략 수는 FCD_SKIPS)
+	
+	cnn_perf_counters #(
+		.NUM_STAGES(5)
+	) u_perf_counters (
+		.clk(s00_axi_cnn_aclk),
+		.rst(s00_axi_cnn_aresetn),
+		.i_snapshot(perf_snapshot),
+		.i_clear(perf_clear),
+		.i_sel(perf_sel),
+		.i_stage_busy({cnn_core_stage_busy, stream_busy}),
+		.i_stage_stall({cnn_core_stage_stall, stream_stall}),
+		.i_result_valid(infer_result_valid),
+		.i_latency(infer_latency),
+		.i_fc_cycles(cnn_core_seq_path ? 32'd0 : cnn_core_fc_cycles),   // 시퀀서 결과는 FC 통계 없음 (결과에 실린 경로 비트)
+		.i_fc_nonzero(cnn_core_seq_path ? 16'd0 : cnn_core_fc_nonzero),
+		.i_timeout(cnn_core_timeout),
+		.o_sel_data(perf_data),
+		.o_frame_count(frame_counter),
+		.o_timeout_count(error_code)
+	);
 	// ===== AXI Lite Register Mapping =====
 	
 	// Status register mapping (MicroBlaze 기반)
     assign axi_status_reg = {
-        27'b0,                    // Reserved bits [31:5]
+        14'b0,                    // Reserved bits [31:18]
+        2'(C_CNN_QUANT_MODE),     // QUANT_MODE [17:16] - 합성된 데이터 경로 (0 = 22비트, 1 = INT16, 2 = INT8)
+        cnn_core_frame_tag,       // FRAME_TAG [15:8] - 마지막 결과의 프레임 번호
+        2'b0,                     // Reserved bits [7:6]
+        out_frame_ready,          // FRAME_READY [5] - 다음 프레임 수신 가능
         ctrl_frame_complete,      // FRAME_COMPLETE [4]
         ctrl_frame_start,         // FRAME_START [3] 
         ctrl_pixel_valid,         // PIXEL_VALID [2]
-        cnn_core_result_valid,    // RESULT_VALID [1] - CNN 출력 직접 사용
-        cnn_core_busy             // CNN_BUSY [0] - CNN 출력 직접 사용
+        out_result_valid,         // RESULT_VALID [1] - CNN 출력 직접 사용
+        out_busy                  // CNN_BUSY [0] - CNN 또는 시퀀서 동작 중
     };
 	
 	
 	// Result register mapping
-    assign axi_result_low = cnn_core_result[31:0];           
-    assign axi_result_high = {16'b0, cnn_core_result[47:32]}; 
+    assign axi_result_low = out_result[31:0];           
+    assign axi_result_high = {16'b0, out_result[47:32]}; 
 	
 	// Frame count and error code
     assign axi_frame_count = frame_counter;
-    assign axi_error_code = error_code;
+    // [31] 픽셀 FIFO 오버플로, [30] 가중치 FIFO 오버플로 (CNN 리셋까지 유지), [29:0] 워치독 타임아웃 누적 수
+    assign axi_error_code = {cnn_core_fifo_ovf, error_code[28:0]};
+    assign axi_perf_data = perf_data;
+	
+	// Weight bank status
+    assign axi_wt_status = {
+        30'b0,                    // Reserved [31:2]
+        cnn_core_wt_active_bank,  // ACTIVE_BANK [1] - 새 프레임이 사용할 뱅크 (쓰기는 반대 뱅크로)
+        cnn_core_wt_swap_busy     // SWAP_BUSY [0] - 1이면 섀도 뱅크 쓰기 금지
+    };
+	
+	// FC argmax head (48비트 점수는 32비트로 포화)
+    assign axi_class = {30'b0, out_class_idx};
+    assign axi_class_score = (out_class_score > 48'sh00007FFFFFFF)  ? 32'h7FFFFFFF :
+                             (out_class_score < -48'sh000080000000) ? 32'h80000000 :
+                             out_class_score[31:0];
+    assign axi_class_margin = (|out_class_margin[47:32]) ? 32'hFFFFFFFF : out_class_margin[31:0];
+	
+	// Layer sequencer status
+    assign axi_seq_status = {
+        24'b0,                    // Reserved [31:8]
+        seq_layer,                // LAYER [7:4] - 실행 중인 레이어 (오류 시 오류 레이어)
+        seq_enable,               // ENABLED [3]
+        cnn_core_frame_ready,     // FRAME_READY [2]
+        seq_error,                // DESC_ERROR [1] - 디스크립터 검증 실패 / FC 타임아웃
+        seq_busy                  // BUSY [0]
+    };
+	
+	// HW steering loop status
+    assign axi_hw_status = {
+        hw_pwm_errors,            // WRITE_ERRORS [31:24] - PWM IP 쓰기 오류 (포화)
+        hw_pwm_busy,              // BUSY [23] - PWM 쓰기 진행 중 (0이 된 뒤 CPU가 PWM 사용)
+        hw_duty_r,                // DUTY_R [22:16]
+        hw_pwm_armed,             // ARMED [15] - 하드웨어가 모터 출력 중
+        hw_duty_l,                // DUTY_L [14:8]
+        hw_steer                  // STEER [7:0] - 제한 후 조향 (signed)
+    };
+	
+	// Result FIFO status / head entry
+    assign axi_rf_status = {
+        rf_drops,                 // DROPPED [31:16] - FIFO가 가득 차 버린 결과 수 (포화)
+        11'b0,                    // Reserved [15:5]
+        rf_level                  // LEVEL [4:0] - 대기 중인 엔트리 수
+    };
+    assign axi_rf_result_hi = {
+        rf_overflow,              // OVERFLOW [31] - 이 엔트리 앞에서 결과가 버려짐
+        rf_reused,                // REUSED [30] - 프레임 변화 없음, 이전 결과 재출력
+        12'b0,                    // Reserved [29:18]
+        rf_class,                 // CLASS [17:16]
+        rf_result[47:32]          // RESULT_HIGH [15:0]
+    };
+	
+	// Ultrasonic snapshot
+    assign axi_us_dist = {
+        2'b0,                     // Reserved [31:30]
+        us_cm[2],                 // LEFT [29:20] - cm (0 = 유효 샘플 없음)
+        us_cm[1],                 // RIGHT [19:10]
+        us_cm[0]                  // FRONT [9:0]
+    };
+    assign axi_us_info = {
+        us_seq,                   // SEQ [31:24] - 스냅샷마다 +1 (앞뒤로 읽어 같으면 일관된 스냅샷)
+        5'b0,                     // Reserved [23:19]
+        us_valid,                 // VALID [18:16] - 왼쪽 / 오른쪽 / 전방
+        us_obstacle               // OBSTACLE [15:0] - 벽 회피 조향 항 (signed, 제한 전)
+    };
+	
+	// AXI4-Stream ingest status
+    assign axi_ingest_status = {
+        stream_frame_count,       // STREAM_FRAMES [31:16] - 수신한 프레임 수
+        7'b0,                     // Reserved [15:9]
+        stream_fifo_level         // FIFO_LEVEL [8:0] - FIFO 비트 수
+    };
+
+	// Interrupt sources (ISR 비트)
+	//   [0] RESULT_DONE  - 새 CNN 결과 래치됨
+	//   [1] FRAME_READY  - 다음 프레임 수신 가능 (상승 에지)
+	reg cnn_frame_ready_d1;
+	always @(posedge s00_axi_cnn_aclk) begin
+		if (s00_axi_cnn_aresetn == 1'b0) cnn_frame_ready_d1 <= 1'b0;
+		else                             cnn_frame_ready_d1 <= out_frame_ready;
+	end
+	
+    assign axi_irq_set = {
+        30'b0,                                          // Reserved [31:2]
+        out_frame_ready & ~cnn_frame_ready_d1,          // FRAME_READY [1]
+        out_result_valid                                // RESULT_DONE [0]
+    };
 
 	// ===== AXI Lite Slave Interface (픽셀 레지스터 포함) =====
 	
@@ -179,7 +855,63 @@ assign error_code = 32'h87654321;
         .result_low_in(axi_result_low),
         .result_high_in(axi_result_high),
         .frame_count_in(axi_frame_count),
-        .error_code_in(axi_error_code)
+        .error_code_in(axi_error_code),
+        .class_in(axi_class),
+        .class_score_in(axi_class_score),
+        .class_margin_in(axi_class_margin),
+        .ingest_status_in(axi_ingest_status),
+        .irq_set_in(axi_irq_set),
+        .irq_out(o_cnn_interrupt),
+        .perf_data_in(axi_perf_data),
+        .perf_snapshot_out(perf_snapshot),
+        .perf_clear_out(perf_clear),
+        .perf_sel_out(perf_sel),
+        .wt_wr_en_out(wt_wr_en),
+        .wt_wr_addr_out(wt_wr_addr),
+        .wt_wr_data_out(wt_wr_data),
+        .wt_swap_out(wt_swap_req),
+        .wt_status_in(axi_wt_status),
+        .quant_cfg_out(quant_cfg),
+        .seq_ctrl_out(seq_ctrl),
+        .seq_wr_en_out(seq_wr_en),
+        .seq_wr_addr_out(seq_wr_addr),
+        .seq_wr_data_out(seq_wr_data),
+        .seq_status_in(axi_seq_status),
+        .geometry_out(geometry),
+        .preproc_ctrl_out(preproc_ctrl),
+        .preproc_roi_pos_out(preproc_roi_pos),
+        .preproc_roi_size_out(preproc_roi_size),
+        .hw_ctrl_out(hw_ctrl),
+        .hw_clear_out(hw_clear),
+        .hw_kp_ki_out(hw_kp_ki),
+        .hw_kd_out(hw_kd),
+        .hw_int_limit_out(hw_int_limit),
+        .hw_status_in(axi_hw_status),
+        .hw_updates_in(hw_pwm_updates),
+        .rf_status_in(axi_rf_status),
+        .rf_result_lo_in(rf_result[31:0]),
+        .rf_result_hi_in(axi_rf_result_hi),
+        .rf_seq_in(rf_seq),
+        .rf_ts_first_in(rf_ts_first),
+        .rf_ts_result_in(rf_ts_result),
+        .rf_pop_out(rf_pop),
+        .cycle_now_in(cycle_now),
+        .fcd_ctrl_out(fcd_ctrl),
+        .fcd_thresh_out(fcd_thresh),
+        .fcd_sad_in(fcd_sad),
+        .fcd_skips_in(fcd_skips),
+        .us_ctrl_out(us_ctrl),
+        .us_obst_cfg_out(us_obst_cfg),
+        .us_dist_in(axi_us_dist),
+        .us_info_in(axi_us_info),
+        .us_ts_in(us_ts),
+        .us_rejects_in({16'b0, us_rejects}),
+        .tr_ctrl_out(tr_ctrl),
+        .tr_rearm_out(tr_rearm),
+        .tr_thresh_out(tr_thresh),
+        .tr_sel_out(tr_sel),
+        .tr_data_in(tr_data),
+        .tr_status_in(tr_status)
 	);
 
 
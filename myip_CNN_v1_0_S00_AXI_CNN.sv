@@ -3,7 +3,7 @@
 module myip_CNN_v1_0_S00_AXI_CNN #
 (
 	parameter integer C_S_AXI_DATA_WIDTH	= 32,
-	parameter integer C_S_AXI_ADDR_WIDTH	= 5
+	parameter integer C_S_AXI_ADDR_WIDTH	= 8
 )
 (
 	// ===== Register interface for CNN control (픽셀 레지스터 복원) =====
@@ -14,6 +14,62 @@ module myip_CNN_v1_0_S00_AXI_CNN #
 	input wire [C_S_AXI_DATA_WIDTH-1:0] result_high_in,     // Result high 16-bit input (R/O)
 	input wire [C_S_AXI_DATA_WIDTH-1:0] frame_count_in,     // Frame count input (R/O)
 	input wire [C_S_AXI_DATA_WIDTH-1:0] error_code_in,      // Error code input (R/O)
+	input wire [C_S_AXI_DATA_WIDTH-1:0] class_in,           // FC argmax class index (R/O)
+	input wire [C_S_AXI_DATA_WIDTH-1:0] class_score_in,     // FC top class score (R/O)
+	input wire [C_S_AXI_DATA_WIDTH-1:0] class_margin_in,    // FC top-2 score margin (R/O)
+	input wire [C_S_AXI_DATA_WIDTH-1:0] ingest_status_in,   // AXI4-Stream ingest status (R/O)
+	input wire [C_S_AXI_DATA_WIDTH-1:0] irq_set_in,         // Interrupt event pulses (bit per source)
+	output wire irq_out,                                    // Level interrupt = |(ISR & IER)
+	input wire [C_S_AXI_DATA_WIDTH-1:0] perf_data_in,       // Selected perf counter snapshot (R/O)
+	output wire perf_snapshot_out,                          // 1-cycle pulse: PERF_CTRL bit0 written
+	output wire perf_clear_out,                             // 1-cycle pulse: PERF_CTRL bit1 written
+	output wire [4:0] perf_sel_out,                         // PERF_CTRL[12:8] counter select
+	output wire wt_wr_en_out,                               // 1-cycle pulse: WEIGHT_DATA written
+	output wire [16:0] wt_wr_addr_out,                      // WEIGHT_ADDR at the time of the write
+	output wire [C_S_AXI_DATA_WIDTH-1:0] wt_wr_data_out,    // WEIGHT_DATA write value
+	output wire wt_swap_out,                                // 1-cycle pulse: WEIGHT_CTRL bit0 written
+	input wire [C_S_AXI_DATA_WIDTH-1:0] wt_status_in,       // Weight bank status (R/O)
+	output wire [C_S_AXI_DATA_WIDTH-1:0] quant_cfg_out,     // Requantization config (R/W)
+	output wire [C_S_AXI_DATA_WIDTH-1:0] seq_ctrl_out,      // Layer sequencer control (R/W)
+	output wire seq_wr_en_out,                              // 1-cycle pulse: SEQ_DATA written
+	output wire [16:0] seq_wr_addr_out,                     // SEQ_ADDR at the time of the write
+	output wire [C_S_AXI_DATA_WIDTH-1:0] seq_wr_data_out,   // SEQ_DATA write value
+	input wire [C_S_AXI_DATA_WIDTH-1:0] seq_status_in,      // Layer sequencer status (R/O)
+	output wire [C_S_AXI_DATA_WIDTH-1:0] geometry_out,      // Frame geometry (R/W)
+	output wire [C_S_AXI_DATA_WIDTH-1:0] preproc_ctrl_out,  // Preprocessor control (R/W)
+	output wire [C_S_AXI_DATA_WIDTH-1:0] preproc_roi_pos_out,  // Preprocessor ROI origin (R/W)
+	output wire [C_S_AXI_DATA_WIDTH-1:0] preproc_roi_size_out, // Preprocessor ROI size (R/W)
+	output wire [C_S_AXI_DATA_WIDTH-1:0] hw_ctrl_out,       // HW steering loop control (R/W)
+	output wire hw_clear_out,                               // 1-cycle pulse: HW_CTRL bit1 written
+	output wire [C_S_AXI_DATA_WIDTH-1:0] hw_kp_ki_out,      // PID Kp / Ki (R/W)
+	output wire [C_S_AXI_DATA_WIDTH-1:0] hw_kd_out,         // PID Kd / rate limit (R/W)
+	output wire [C_S_AXI_DATA_WIDTH-1:0] hw_int_limit_out,  // PID integral limit (R/W)
+	input wire [C_S_AXI_DATA_WIDTH-1:0] hw_status_in,       // HW loop status (R/O)
+	input wire [C_S_AXI_DATA_WIDTH-1:0] hw_updates_in,      // HW loop duty write count (R/O)
+	input wire [C_S_AXI_DATA_WIDTH-1:0] rf_status_in,       // Result FIFO status (R/O)
+	input wire [C_S_AXI_DATA_WIDTH-1:0] rf_result_lo_in,    // Result FIFO head entry (R/O)
+	input wire [C_S_AXI_DATA_WIDTH-1:0] rf_result_hi_in,
+	input wire [C_S_AXI_DATA_WIDTH-1:0] rf_seq_in,
+	input wire [C_S_AXI_DATA_WIDTH-1:0] rf_ts_first_in,
+	input wire [C_S_AXI_DATA_WIDTH-1:0] rf_ts_result_in,
+	output wire rf_pop_out,                                 // 1-cycle pulse: RF_POP written
+	input wire [C_S_AXI_DATA_WIDTH-1:0] cycle_now_in,       // Timestamp cycle counter (R/O)
+	output wire [C_S_AXI_DATA_WIDTH-1:0] fcd_ctrl_out,      // Frame change detector control (R/W)
+	output wire [C_S_AXI_DATA_WIDTH-1:0] fcd_thresh_out,    // Frame change SAD threshold (R/W)
+	input wire [C_S_AXI_DATA_WIDTH-1:0] fcd_sad_in,         // Last frame SAD (R/O)
+	input wire [C_S_AXI_DATA_WIDTH-1:0] fcd_skips_in,       // Skipped frame count (R/O)
+	output wire [C_S_AXI_DATA_WIDTH-1:0] us_ctrl_out,       // Ultrasonic sampler control (R/W)
+	output wire [C_S_AXI_DATA_WIDTH-1:0] us_obst_cfg_out,   // Obstacle steer config (R/W)
+	input wire [C_S_AXI_DATA_WIDTH-1:0] us_dist_in,         // Ultrasonic snapshot F/R/L (R/O)
+	input wire [C_S_AXI_DATA_WIDTH-1:0] us_info_in,         // Snapshot obstacle term / valid / seq (R/O)
+	input wire [C_S_AXI_DATA_WIDTH-1:0] us_ts_in,           // Snapshot sample cycle (R/O)
+	input wire [C_S_AXI_DATA_WIDTH-1:0] us_rejects_in,      // Rejected sample count (R/O)
+	output wire [C_S_AXI_DATA_WIDTH-1:0] tr_ctrl_out,       // Flight recorder control (R/W)
+	output wire tr_rearm_out,                               // 1-cycle pulse: TR_CTRL bit4 written
+	output wire [C_S_AXI_DATA_WIDTH-1:0] tr_thresh_out,     // Flight recorder latency trigger (R/W)
+	output wire [8:0] tr_sel_out,                           // TR_SEL entry / word select
+	input wire [C_S_AXI_DATA_WIDTH-1:0] tr_data_in,         // Selected trace word (R/O)
+	input wire [C_S_AXI_DATA_WIDTH-1:0] tr_status_in,       // Flight recorder status (R/O)
 
 	// ===== AXI4LITE Standard Interface =====
 	input wire  S_AXI_ACLK,
@@ -52,20 +108,69 @@ module myip_CNN_v1_0_S00_AXI_CNN #
 	reg  	axi_rvalid;
 
 	localparam integer ADDR_LSB = (C_S_AXI_DATA_WIDTH/32) + 1;
-	localparam integer OPT_MEM_ADDR_BITS = 2;
+	localparam integer OPT_MEM_ADDR_BITS = 5;
 	
 	//----------------------------------------------
 	//-- CNN Register Map (픽셀 레지스터 포함)
 	//------------------------------------------------
-	localparam REG_CONTROL_ADDR     = 3'h0;  // 0x00 - Control register (R/W)
-	localparam REG_PIXEL_DATA_ADDR  = 3'h1;  // 0x04 - Pixel data register (W/O) - 복원
-	localparam REG_STATUS_ADDR      = 3'h2;  // 0x08 - Status register (R/O)
-	localparam REG_RESULT_LOW_ADDR  = 3'h3;  // 0x0C - Result low 32-bit (R/O)
-	localparam REG_RESULT_HIGH_ADDR = 3'h4;  // 0x10 - Result high 16-bit (R/O)
-	localparam REG_FRAME_COUNT_ADDR = 3'h5;  // 0x14 - Frame count (R/O)
-	localparam REG_ERROR_CODE_ADDR  = 3'h6;  // 0x18 - Error code (R/O)
+	localparam REG_CONTROL_ADDR      = 6'h00;  // 0x00 - Control register (R/W)
+	localparam REG_PIXEL_DATA_ADDR   = 6'h01;  // 0x04 - Pixel data register (W/O) - 복원
+	localparam REG_STATUS_ADDR       = 6'h02;  // 0x08 - Status register (R/O)
+	localparam REG_RESULT_LOW_ADDR   = 6'h03;  // 0x0C - Result low 32-bit (R/O)
+	localparam REG_RESULT_HIGH_ADDR  = 6'h04;  // 0x10 - Result high 16-bit (R/O)
+	localparam REG_FRAME_COUNT_ADDR  = 6'h05;  // 0x14 - Frame count (R/O)
+	localparam REG_ERROR_CODE_ADDR   = 6'h06;  // 0x18 - Error code: [31] pixel FIFO overflow, [30] weight FIFO overflow, [29] result FIFO overflow, [28:0] timeouts (R/O)
+	localparam REG_CLASS_ADDR        = 6'h07;  // 0x1C - Pattern class index (R/O)
+	localparam REG_CLASS_SCORE_ADDR  = 6'h08;  // 0x20 - Top class score (R/O)
+	localparam REG_CLASS_MARGIN_ADDR = 6'h09;  // 0x24 - Top-2 class margin (R/O)
+	localparam REG_INGEST_STATUS_ADDR = 6'h0A; // 0x28 - AXI4-Stream ingest status (R/O)
+	localparam REG_IRQ_ENABLE_ADDR   = 6'h0B;  // 0x2C - Interrupt enable (R/W)
+	localparam REG_IRQ_STATUS_ADDR   = 6'h0C;  // 0x30 - Interrupt status (R/W1C)
+	localparam REG_PERF_CTRL_ADDR    = 6'h0D;  // 0x34 - Perf control: [0] snapshot, [1] clear (self-clearing), [12:8] select
+	localparam REG_PERF_DATA_ADDR    = 6'h0E;  // 0x38 - Selected perf counter snapshot (R/O)
+	localparam REG_WEIGHT_ADDR_ADDR  = 6'h0F;  // 0x3C - Weight address: [11:0] index, [15:12] neuron, [16] 1=conv kernel (R/W, auto-increment)
+	localparam REG_WEIGHT_DATA_ADDR  = 6'h10;  // 0x40 - Weight data, written to shadow bank (W)
+	localparam REG_WEIGHT_CTRL_ADDR  = 6'h11;  // 0x44 - W: [0] bank swap request / R: bank status
+	localparam REG_QUANT_CFG_ADDR    = 6'h12;  // 0x48 - Requant: [15:0] scale, [21:16] shift, [31:24] zero point (R/W)
+	localparam REG_SEQ_CTRL_ADDR     = 6'h13;  // 0x4C - Sequencer: [0] enable, [11:8] layer count (R/W)
+	localparam REG_SEQ_ADDR_ADDR     = 6'h14;  // 0x50 - Sequencer address: [12:0] index, [16] 1=conv kernel memory / 0=descriptor (R/W, auto-increment)
+	localparam REG_SEQ_DATA_ADDR     = 6'h15;  // 0x54 - Sequencer descriptor/kernel data (W)
+	localparam REG_SEQ_STATUS_ADDR   = 6'h16;  // 0x58 - Sequencer status (R/O)
+	localparam REG_GEOMETRY_ADDR     = 6'h17;  // 0x5C - Frame: [7:0] width, [15:8] height, [17:16] log2 stride, [18] same padding (R/W)
+	localparam REG_PRE_CTRL_ADDR     = 6'h18;  // 0x60 - Preproc: [0] enable, [2:1] format, [6:4] dx-1, [10:8] dy-1, [27:16] source width (R/W)
+	localparam REG_PRE_ROI_POS_ADDR  = 6'h19;  // 0x64 - ROI origin: [11:0] x0, [27:16] y0 (R/W)
+	localparam REG_PRE_ROI_SIZE_ADDR = 6'h1A;  // 0x68 - ROI size: [11:0] width, [27:16] height (R/W)
+	localparam REG_HW_CTRL_ADDR      = 6'h1B;  // 0x6C - HW loop: [0] enable, [1] clear (self-clearing), [12:8] err shift, [23:16] base duty, [31:24] steer max (R/W)
+	localparam REG_HW_KP_KI_ADDR     = 6'h1C;  // 0x70 - PID Kp [15:0], Ki [31:16], signed Q8.8 (R/W)
+	localparam REG_HW_KD_ADDR        = 6'h1D;  // 0x74 - PID Kd [15:0] signed Q8.8, [23:16] steer rate limit (R/W)
+	localparam REG_HW_INT_LIMIT_ADDR = 6'h1E;  // 0x78 - PID integral limit [23:0] (R/W)
+	localparam REG_HW_STATUS_ADDR    = 6'h1F;  // 0x7C - HW loop status (R/O)
+	localparam REG_HW_UPDATES_ADDR   = 6'h20;  // 0x80 - HW loop PWM duty writes (R/O)
+	localparam REG_RF_STATUS_ADDR    = 6'h21;  // 0x84 - Result FIFO: [4:0] level, [31:16] dropped results (R/O)
+	localparam REG_RF_RESULT_LO_ADDR = 6'h22;  // 0x88 - Head entry result [31:0] (R/O)
+	localparam REG_RF_RESULT_HI_ADDR = 6'h23;  // 0x8C - Head entry: [15:0] result [47:32], [17:16] class, [30] reused, [31] overflow (R/O)
+	localparam REG_RF_SEQ_ADDR       = 6'h24;  // 0x90 - Head entry sequence number (R/O)
+	localparam REG_RF_TS_FIRST_ADDR  = 6'h25;  // 0x94 - Head entry first pixel cycle (R/O)
+	localparam REG_RF_TS_RESULT_ADDR = 6'h26;  // 0x98 - Head entry result cycle (R/O)
+	localparam REG_RF_POP_ADDR       = 6'h27;  // 0x9C - Write: pop head entry
+	localparam REG_CYCLE_NOW_ADDR    = 6'h28;  // 0xA0 - Timestamp cycle counter (R/O)
+	localparam REG_FCD_CTRL_ADDR     = 6'h29;  // 0xA4 - Frame change detector: [0] enable, [15:8] max consecutive skips (0 = no limit) (R/W)
+	localparam REG_FCD_THRESH_ADDR   = 6'h2A;  // 0xA8 - Skip inference when frame SAD <= threshold (R/W)
+	localparam REG_FCD_SAD_ADDR      = 6'h2B;  // 0xAC - Last frame SAD against reference frame (R/O)
+	localparam REG_FCD_SKIPS_ADDR    = 6'h2C;  // 0xB0 - Frames answered with reused result (R/O)
+	localparam REG_US_CTRL_ADDR      = 6'h2D;  // 0xB4 - Ultrasonic: [0] enable, [2:1] filter, [15:8] period ms, [25:16] max cm (R/W)
+	localparam REG_US_OBST_ADDR      = 6'h2E;  // 0xB8 - Obstacle steer: [7:0] wall cm, [15:8] gain, [23:16] near boost cm (R/W)
+	localparam REG_US_DIST_ADDR      = 6'h2F;  // 0xBC - Snapshot: [9:0] front, [19:10] right, [29:20] left cm (R/O)
+	localparam REG_US_INFO_ADDR      = 6'h30;  // 0xC0 - Snapshot: [15:0] obstacle steer, [18:16] valid, [31:24] seq (R/O)
+	localparam REG_US_TS_ADDR        = 6'h31;  // 0xC4 - Snapshot sample cycle (R/O)
+	localparam REG_US_REJECTS_ADDR   = 6'h32;  // 0xC8 - Out-of-range / bad BCD samples (R/O)
+	localparam REG_TR_CTRL_ADDR      = 6'h33;  // 0xCC - Flight recorder: [0] enable, [1] latency / [2] watchdog / [3] overflow trigger, [4] rearm, [15:8] post frames (R/W)
+	localparam REG_TR_THRESH_ADDR    = 6'h34;  // 0xD0 - Latency trigger, first pixel → result cycles (R/W)
+	localparam REG_TR_SEL_ADDR       = 6'h35;  // 0xD4 - Trace select: [3:0] word, [7:4] entry, [8] event ring (R/W)
+	localparam REG_TR_DATA_ADDR      = 6'h36;  // 0xD8 - Selected trace word (R/O)
+	localparam REG_TR_STATUS_ADDR    = 6'h37;  // 0xDC - Recorder status: next / trigger entry, frozen, events (R/O)
 	
-	//-- Slave Registers (7개 레지스터)
+	//-- Slave Registers (44개 레지스터, 0x9C RF_POP은 쓰기 펄스만)
 	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg0;  // Control register (R/W)
 	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg1;  // Pixel data register (W/O) - 복원
 	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg2;  // Status register (R/O) 
@@ -73,6 +178,56 @@ module myip_CNN_v1_0_S00_AXI_CNN #
 	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg4;  // Result high (R/O)
 	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg5;  // Frame count (R/O)
 	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg6;  // Error code (R/O)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg7;  // Class index (R/O)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg8;  // Class score (R/O)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg9;  // Class margin (R/O)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg10; // Ingest status (R/O)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg11; // Interrupt enable (R/W)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg12; // Interrupt status (R/W1C)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg13; // Perf control (R/W, 명령 비트는 저장 안 함)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg14; // Perf data (R/O)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg15; // Weight address (R/W)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg16; // Weight data (W, 마지막 값 읽기 가능)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg17; // Weight bank status (R/O)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg18; // Requantization config (R/W)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg19; // Sequencer control (R/W)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg20; // Sequencer address (R/W)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg21; // Sequencer data (W, 마지막 값 읽기 가능)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg22; // Sequencer status (R/O)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg23; // Frame geometry (R/W)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg24; // Preprocessor control (R/W)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg25; // Preprocessor ROI origin (R/W)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg26; // Preprocessor ROI size (R/W)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg27; // HW loop control (R/W, clear 비트는 저장 안 함)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg28; // PID Kp / Ki (R/W)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg29; // PID Kd / rate limit (R/W)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg30; // PID integral limit (R/W)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg31; // HW loop status (R/O)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg32; // HW loop updates (R/O)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg33; // Result FIFO status (R/O)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg34; // Result FIFO result low (R/O)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg35; // Result FIFO result high / class / overflow (R/O)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg36; // Result FIFO sequence (R/O)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg37; // Result FIFO first pixel cycle (R/O)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg38; // Result FIFO result cycle (R/O)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg40; // Cycle counter (R/O)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg41; // Frame change detector control (R/W)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg42; // Frame change SAD threshold (R/W)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg43; // Last frame SAD (R/O)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg44; // Skipped frames (R/O)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg45; // Ultrasonic control (R/W)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg46; // Obstacle steer config (R/W)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg47; // Ultrasonic snapshot F/R/L (R/O)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg48; // Ultrasonic snapshot info (R/O)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg49; // Ultrasonic snapshot timestamp (R/O)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg50; // Ultrasonic rejected samples (R/O)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg51; // Flight recorder control (R/W, rearm 비트는 저장 안 함)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg52; // Flight recorder latency trigger (R/W)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg53; // Trace select (R/W)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg54; // Selected trace word (R/O)
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg55; // Flight recorder status (R/O)
+	
+	wire [C_S_AXI_DATA_WIDTH-1:0]	irq_clear_mask;  // W1C 마스크 (ISR 쓰기)
 	
 	wire	 slv_reg_rden;
 	wire	 slv_reg_wren;
@@ -93,6 +248,29 @@ module myip_CNN_v1_0_S00_AXI_CNN #
 	// ===== Register Interface Assignments =====
 	assign control_reg_out = slv_reg0;  // Control register output to CNN logic
 	assign pixel_reg_out = slv_reg1;     // Pixel data register output to CNN logic - 복원
+	assign irq_out = |(slv_reg12 & slv_reg11);  // 인에이블된 펜딩 이벤트가 있으면 인터럽트
+	assign perf_sel_out = slv_reg13[12:8];
+	assign wt_wr_addr_out = slv_reg15[16:0];
+	assign wt_wr_data_out = S_AXI_WDATA;
+	assign quant_cfg_out = slv_reg18;
+	assign seq_ctrl_out = slv_reg19;
+	assign seq_wr_addr_out = slv_reg20[16:0];
+	assign seq_wr_data_out = S_AXI_WDATA;
+	assign geometry_out = slv_reg23;
+	assign preproc_ctrl_out = slv_reg24;
+	assign preproc_roi_pos_out = slv_reg25;
+	assign preproc_roi_size_out = slv_reg26;
+	assign hw_ctrl_out = slv_reg27;
+	assign hw_kp_ki_out = slv_reg28;
+	assign hw_kd_out = slv_reg29;
+	assign hw_int_limit_out = slv_reg30;
+	assign fcd_ctrl_out = slv_reg41;
+	assign fcd_thresh_out = slv_reg42;
+	assign us_ctrl_out = slv_reg45;
+	assign us_obst_cfg_out = slv_reg46;
+	assign tr_ctrl_out = slv_reg51;
+	assign tr_thresh_out = slv_reg52;
+	assign tr_sel_out = slv_reg53[8:0];
 
 	// ===== AXI4LITE Write Address Ready Generation =====
 	always @( posedge S_AXI_ACLK )
@@ -160,6 +338,40 @@ module myip_CNN_v1_0_S00_AXI_CNN #
 	// ===== Memory Mapped Register Write Logic =====
 	assign slv_reg_wren = axi_wready && S_AXI_WVALID && axi_awready && S_AXI_AWVALID;
 
+	// PERF_CTRL 명령 비트: 쓰기 사이클에만 1사이클 펄스
+	assign perf_snapshot_out = slv_reg_wren && axi_awaddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] == REG_PERF_CTRL_ADDR &&
+	                           S_AXI_WSTRB[0] && S_AXI_WDATA[0];
+	assign perf_clear_out    = slv_reg_wren && axi_awaddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] == REG_PERF_CTRL_ADDR &&
+	                           S_AXI_WSTRB[0] && S_AXI_WDATA[1];
+
+	// WEIGHT_DATA 쓰기 → 섀도 뱅크 쓰기 펄스 (주소는 쓰기 후 자동 증가)
+	assign wt_wr_en_out = slv_reg_wren && axi_awaddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] == REG_WEIGHT_DATA_ADDR;
+	assign wt_swap_out  = slv_reg_wren && axi_awaddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] == REG_WEIGHT_CTRL_ADDR &&
+	                      S_AXI_WSTRB[0] && S_AXI_WDATA[0];
+
+	// SEQ_DATA 쓰기 → 디스크립터/가중치 메모리 쓰기 펄스 (주소는 쓰기 후 자동 증가)
+	assign seq_wr_en_out = slv_reg_wren && axi_awaddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] == REG_SEQ_DATA_ADDR;
+
+	// RF_POP 쓰기 → 결과 FIFO 헤드 엔트리 제거 (값 무관)
+	assign rf_pop_out = slv_reg_wren && axi_awaddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] == REG_RF_POP_ADDR;
+
+	// HW_CTRL clear 비트: PID 적분 / 조향 변화량 기준 초기화 펄스
+	assign hw_clear_out = slv_reg_wren && axi_awaddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] == REG_HW_CTRL_ADDR &&
+	                      S_AXI_WSTRB[0] && S_AXI_WDATA[1];
+
+	// TR_CTRL rearm 비트: 트리거 정지 해제 펄스
+	assign tr_rearm_out = slv_reg_wren && axi_awaddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] == REG_TR_CTRL_ADDR &&
+	                      S_AXI_WSTRB[0] && S_AXI_WDATA[4];
+
+	genvar strb_index;
+	generate
+	  for ( strb_index = 0; strb_index < (C_S_AXI_DATA_WIDTH/8); strb_index = strb_index+1 ) begin : gen_irq_clear
+	    assign irq_clear_mask[(strb_index*8) +: 8] =
+	      (slv_reg_wren && axi_awaddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] == REG_IRQ_STATUS_ADDR && S_AXI_WSTRB[strb_index]) ?
+	      S_AXI_WDATA[(strb_index*8) +: 8] : 8'h00;
+	  end
+	endgenerate
+
 	always @( posedge S_AXI_ACLK )
 	begin
 	  if ( S_AXI_ARESETN == 1'b0 )
@@ -171,6 +383,54 @@ module myip_CNN_v1_0_S00_AXI_CNN #
 	      slv_reg4 <= 0;  // Result high (read-only)
 	      slv_reg5 <= 0;  // Frame count (read-only)
 	      slv_reg6 <= 0;  // Error code (read-only)
+	      slv_reg7 <= 0;  // Class index (read-only)
+	      slv_reg8 <= 0;  // Class score (read-only)
+	      slv_reg9 <= 0;  // Class margin (read-only)
+	      slv_reg10 <= 0; // Ingest status (read-only)
+	      slv_reg11 <= 0; // Interrupt enable
+	      slv_reg12 <= 0; // Interrupt status
+	      slv_reg13 <= 0; // Perf control
+	      slv_reg14 <= 0; // Perf data (read-only)
+	      slv_reg15 <= 0; // Weight address
+	      slv_reg16 <= 0; // Weight data
+	      slv_reg17 <= 0; // Weight bank status (read-only)
+	      slv_reg18 <= 32'h0000_0001; // Requant: scale 1, shift 0, zero point 0 (포화만)
+	      slv_reg19 <= 32'h0000_0300; // Sequencer: 비활성, 기본 3레이어 (conv → pool → FC)
+	      slv_reg20 <= 0; // Sequencer address
+	      slv_reg21 <= 0; // Sequencer data
+	      slv_reg22 <= 0; // Sequencer status (read-only)
+	      slv_reg23 <= 32'h0000_2020; // Geometry: 32x32, stride 1, valid 패딩 (기존 고정 크기)
+	      slv_reg24 <= 32'h0020_0000; // Preproc: 비활성 (바이패스), 원본 폭 32
+	      slv_reg25 <= 0;             // ROI origin (0, 0)
+	      slv_reg26 <= 32'h0020_0020; // ROI 32x32
+	      slv_reg27 <= 32'h5032_0B00; // HW loop: 비활성, err >>> 11 (CNN_OUTPUT_SCALE), base 50%, steer max 80
+	      slv_reg28 <= 32'h0000_0100; // Kp 1.0, Ki 0
+	      slv_reg29 <= 32'h000A_0000; // Kd 0, 갱신당 조향 변화 10
+	      slv_reg30 <= 32'h0000_2000; // 적분 한계 8192
+	      slv_reg31 <= 0; // HW loop status (read-only)
+	      slv_reg32 <= 0; // HW loop updates (read-only)
+	      slv_reg33 <= 0; // Result FIFO status (read-only)
+	      slv_reg34 <= 0; // Result FIFO head entry (read-only)
+	      slv_reg35 <= 0;
+	      slv_reg36 <= 0;
+	      slv_reg37 <= 0;
+	      slv_reg38 <= 0;
+	      slv_reg40 <= 0; // Cycle counter (read-only)
+	      slv_reg41 <= 32'h0000_0800; // Frame change: 비활성, 연속 8프레임 생략 후 강제 추론
+	      slv_reg42 <= 0;             // SAD 임계값 0 (완전히 같은 프레임만 생략)
+	      slv_reg43 <= 0; // Last frame SAD (read-only)
+	      slv_reg44 <= 0; // Skipped frames (read-only)
+	      slv_reg45 <= 32'h0190_0503; // Ultrasonic: 활성, 유효 샘플 평균, 5 ms, 최대 400 cm (기존 펌웨어 동작)
+	      slv_reg46 <= 32'h0023_1632; // 벽 50 cm, 이득 22, 35 cm 이하 2배 (WALL_CM / STEER_K / NEAR_BOOST_CM)
+	      slv_reg47 <= 0; // Ultrasonic snapshot (read-only)
+	      slv_reg48 <= 0;
+	      slv_reg49 <= 0;
+	      slv_reg50 <= 0;
+	      slv_reg51 <= 32'h0000_0405; // Flight recorder: 활성, 워치독 트리거, 트리거 후 4프레임 기록
+	      slv_reg52 <= 0;             // 지연 트리거 없음
+	      slv_reg53 <= 0; // Trace select
+	      slv_reg54 <= 0; // Trace data (read-only)
+	      slv_reg55 <= 0; // Recorder status (read-only)
 	    end 
 	  else begin
 	    if (slv_reg_wren)
@@ -186,7 +446,119 @@ module myip_CNN_v1_0_S00_AXI_CNN #
 	              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
 	                slv_reg1[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
 	              end  
-	          // All other registers are read-only
+	          REG_IRQ_ENABLE_ADDR:  // Interrupt enable register is writable
+	            for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+	              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+	                slv_reg11[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+	              end  
+	          REG_PERF_CTRL_ADDR:  // Counter select만 저장 (snapshot/clear는 펄스)
+	            if ( S_AXI_WSTRB[1] == 1 ) begin
+	              slv_reg13[12:8] <= S_AXI_WDATA[12:8];
+	            end
+	          REG_WEIGHT_ADDR_ADDR:  // Weight address is writable
+	            for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+	              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+	                slv_reg15[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+	              end  
+	          REG_QUANT_CFG_ADDR:  // Requantization config is writable
+	            for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+	              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+	                slv_reg18[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+	              end  
+	          REG_WEIGHT_DATA_ADDR: begin  // 데이터 저장 + 인덱스 자동 증가 (연속 로드)
+	            slv_reg16 <= S_AXI_WDATA;
+	            slv_reg15[11:0] <= slv_reg15[11:0] + 1;
+	          end
+	          REG_SEQ_CTRL_ADDR:  // Sequencer control is writable
+	            for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+	              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+	                slv_reg19[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+	              end  
+	          REG_SEQ_ADDR_ADDR:  // Sequencer address is writable
+	            for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+	              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+	                slv_reg20[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+	              end  
+	          REG_SEQ_DATA_ADDR: begin  // 데이터 저장 + 인덱스 자동 증가
+	            slv_reg21 <= S_AXI_WDATA;
+	            slv_reg20[12:0] <= slv_reg20[12:0] + 1;
+	          end
+	          REG_GEOMETRY_ADDR:  // Frame geometry is writable (다음 프레임부터 적용)
+	            for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+	              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+	                slv_reg23[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+	              end  
+	          REG_PRE_CTRL_ADDR:  // Preprocessor control is writable (다음 프레임부터 적용)
+	            for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+	              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+	                slv_reg24[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+	              end  
+	          REG_PRE_ROI_POS_ADDR:  // ROI origin is writable
+	            for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+	              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+	                slv_reg25[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+	              end  
+	          REG_PRE_ROI_SIZE_ADDR:  // ROI size is writable
+	            for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+	              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+	                slv_reg26[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+	              end  
+	          REG_HW_CTRL_ADDR:  // HW loop control (clear 비트 제외)
+	            for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+	              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+	                slv_reg27[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8] & ((byte_index == 0) ? 8'hFD : 8'hFF);
+	              end  
+	          REG_HW_KP_KI_ADDR:  // PID Kp / Ki is writable (다음 결과부터 적용)
+	            for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+	              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+	                slv_reg28[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+	              end  
+	          REG_HW_KD_ADDR:  // PID Kd / rate limit is writable
+	            for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+	              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+	                slv_reg29[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+	              end  
+	          REG_HW_INT_LIMIT_ADDR:  // PID integral limit is writable
+	            for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+	              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+	                slv_reg30[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+	              end  
+	          REG_FCD_CTRL_ADDR:  // Frame change control is writable (다음 프레임부터)
+	            for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+	              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+	                slv_reg41[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+	              end  
+	          REG_FCD_THRESH_ADDR:  // SAD threshold is writable
+	            for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+	              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+	                slv_reg42[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+	              end  
+	          REG_US_CTRL_ADDR:  // Ultrasonic sampler control is writable
+	            for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+	              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+	                slv_reg45[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+	              end  
+	          REG_US_OBST_ADDR:  // Obstacle steer config is writable
+	            for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+	              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+	                slv_reg46[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+	              end  
+	          REG_TR_CTRL_ADDR:  // Flight recorder control (rearm 비트 제외)
+	            for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+	              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+	                slv_reg51[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8] & ((byte_index == 0) ? 8'hEF : 8'hFF);
+	              end  
+	          REG_TR_THRESH_ADDR:  // Latency trigger is writable
+	            for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+	              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+	                slv_reg52[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+	              end  
+	          REG_TR_SEL_ADDR:  // Trace select is writable
+	            for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+	              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+	                slv_reg53[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+	              end  
+	          // All other registers are read-only (ISR는 아래에서 W1C 처리)
 	          default : begin
 	                      // No write operation for read-only registers
 	                    end
@@ -199,6 +571,33 @@ module myip_CNN_v1_0_S00_AXI_CNN #
 	      slv_reg4 <= result_high_in;     // Result high
 	      slv_reg5 <= frame_count_in;     // Frame count
 	      slv_reg6 <= error_code_in;      // Error code
+	      slv_reg7 <= class_in;           // Class index
+	      slv_reg8 <= class_score_in;     // Class score
+	      slv_reg9 <= class_margin_in;    // Class margin
+	      slv_reg10 <= ingest_status_in;  // Ingest status
+	      
+	      // Interrupt status: 새 이벤트가 같은 사이클의 클리어보다 우선 (이벤트 유실 방지)
+	      slv_reg12 <= (slv_reg12 & ~irq_clear_mask) | irq_set_in;
+	      slv_reg14 <= perf_data_in;      // Perf data
+	      slv_reg17 <= wt_status_in;      // Weight bank status
+	      slv_reg22 <= seq_status_in;     // Sequencer status
+	      slv_reg31 <= hw_status_in;      // HW loop status
+	      slv_reg32 <= hw_updates_in;     // HW loop updates
+	      slv_reg33 <= rf_status_in;      // Result FIFO status
+	      slv_reg34 <= rf_result_lo_in;   // Result FIFO head entry
+	      slv_reg35 <= rf_result_hi_in;
+	      slv_reg36 <= rf_seq_in;
+	      slv_reg37 <= rf_ts_first_in;
+	      slv_reg38 <= rf_ts_result_in;
+	      slv_reg40 <= cycle_now_in;      // Cycle counter
+	      slv_reg43 <= fcd_sad_in;        // Last frame SAD
+	      slv_reg44 <= fcd_skips_in;      // Skipped frames
+	      slv_reg47 <= us_dist_in;        // Ultrasonic snapshot (같은 사이클에 함께 갱신)
+	      slv_reg48 <= us_info_in;
+	      slv_reg49 <= us_ts_in;
+	      slv_reg50 <= us_rejects_in;
+	      slv_reg54 <= tr_data_in;        // Selected trace word (TR_SEL 쓰기 다음 사이클부터)
+	      slv_reg55 <= tr_status_in;      // Recorder status
 	  end
 	end    
 
@@ -285,6 +684,54 @@ module myip_CNN_v1_0_S00_AXI_CNN #
 	        REG_RESULT_HIGH_ADDR : reg_data_out <= slv_reg4;  // Result high
 	        REG_FRAME_COUNT_ADDR : reg_data_out <= slv_reg5;  // Frame count
 	        REG_ERROR_CODE_ADDR  : reg_data_out <= slv_reg6;  // Error code
+	        REG_CLASS_ADDR       : reg_data_out <= slv_reg7;  // Class index
+	        REG_CLASS_SCORE_ADDR : reg_data_out <= slv_reg8;  // Class score
+	        REG_CLASS_MARGIN_ADDR: reg_data_out <= slv_reg9;  // Class margin
+	        REG_INGEST_STATUS_ADDR: reg_data_out <= slv_reg10; // Ingest status
+	        REG_IRQ_ENABLE_ADDR  : reg_data_out <= slv_reg11; // Interrupt enable
+	        REG_IRQ_STATUS_ADDR  : reg_data_out <= slv_reg12; // Interrupt status
+	        REG_PERF_CTRL_ADDR   : reg_data_out <= slv_reg13; // Perf control
+	        REG_PERF_DATA_ADDR   : reg_data_out <= slv_reg14; // Perf data
+	        REG_WEIGHT_ADDR_ADDR : reg_data_out <= slv_reg15; // Weight address
+	        REG_WEIGHT_DATA_ADDR : reg_data_out <= slv_reg16; // Weight data
+	        REG_WEIGHT_CTRL_ADDR : reg_data_out <= slv_reg17; // Weight bank status
+	        REG_QUANT_CFG_ADDR   : reg_data_out <= slv_reg18; // Requantization config
+	        REG_SEQ_CTRL_ADDR    : reg_data_out <= slv_reg19; // Sequencer control
+	        REG_SEQ_ADDR_ADDR    : reg_data_out <= slv_reg20; // Sequencer address
+	        REG_SEQ_DATA_ADDR    : reg_data_out <= slv_reg21; // Sequencer data
+	        REG_SEQ_STATUS_ADDR  : reg_data_out <= slv_reg22; // Sequencer status
+	        REG_GEOMETRY_ADDR    : reg_data_out <= slv_reg23; // Frame geometry
+	        REG_PRE_CTRL_ADDR    : reg_data_out <= slv_reg24; // Preprocessor control
+	        REG_PRE_ROI_POS_ADDR : reg_data_out <= slv_reg25; // Preprocessor ROI origin
+	        REG_PRE_ROI_SIZE_ADDR: reg_data_out <= slv_reg26; // Preprocessor ROI size
+	        REG_HW_CTRL_ADDR     : reg_data_out <= slv_reg27; // HW loop control
+	        REG_HW_KP_KI_ADDR    : reg_data_out <= slv_reg28; // PID Kp / Ki
+	        REG_HW_KD_ADDR       : reg_data_out <= slv_reg29; // PID Kd / rate limit
+	        REG_HW_INT_LIMIT_ADDR: reg_data_out <= slv_reg30; // PID integral limit
+	        REG_HW_STATUS_ADDR   : reg_data_out <= slv_reg31; // HW loop status
+	        REG_HW_UPDATES_ADDR  : reg_data_out <= slv_reg32; // HW loop updates
+	        REG_RF_STATUS_ADDR   : reg_data_out <= slv_reg33; // Result FIFO status
+	        REG_RF_RESULT_LO_ADDR: reg_data_out <= slv_reg34; // Result FIFO result low
+	        REG_RF_RESULT_HI_ADDR: reg_data_out <= slv_reg35; // Result FIFO result high / class / overflow
+	        REG_RF_SEQ_ADDR      : reg_data_out <= slv_reg36; // Result FIFO sequence
+	        REG_RF_TS_FIRST_ADDR : reg_data_out <= slv_reg37; // Result FIFO first pixel cycle
+	        REG_RF_TS_RESULT_ADDR: reg_data_out <= slv_reg38; // Result FIFO result cycle
+	        REG_CYCLE_NOW_ADDR   : reg_data_out <= slv_reg40; // Cycle counter
+	        REG_FCD_CTRL_ADDR    : reg_data_out <= slv_reg41; // Frame change control
+	        REG_FCD_THRESH_ADDR  : reg_data_out <= slv_reg42; // Frame change SAD threshold
+	        REG_FCD_SAD_ADDR     : reg_data_out <= slv_reg43; // Last frame SAD
+	        REG_FCD_SKIPS_ADDR   : reg_data_out <= slv_reg44; // Skipped frames
+	        REG_US_CTRL_ADDR     : reg_data_out <= slv_reg45; // Ultrasonic control
+	        REG_US_OBST_ADDR     : reg_data_out <= slv_reg46; // Obstacle steer config
+	        REG_US_DIST_ADDR     : reg_data_out <= slv_reg47; // Ultrasonic snapshot F/R/L
+	        REG_US_INFO_ADDR     : reg_data_out <= slv_reg48; // Ultrasonic snapshot info
+	        REG_US_TS_ADDR       : reg_data_out <= slv_reg49; // Ultrasonic snapshot timestamp
+	        REG_US_REJECTS_ADDR  : reg_data_out <= slv_reg50; // Ultrasonic rejected samples
+	        REG_TR_CTRL_ADDR     : reg_data_out <= slv_reg51; // Flight recorder control
+	        REG_TR_THRESH_ADDR   : reg_data_out <= slv_reg52; // Flight recorder latency trigger
+	        REG_TR_SEL_ADDR      : reg_data_out <= slv_reg53; // Trace select
+	        REG_TR_DATA_ADDR     : reg_data_out <= slv_reg54; // Selected trace word
+	        REG_TR_STATUS_ADDR   : reg_data_out <= slv_reg55; // Flight recorder status
 	        default : reg_data_out <= 0;
 	      endcase
 	end
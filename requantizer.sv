@@ -0,0 +1,53 @@
+`timescale 1ns/1ps
+module requantizer #(
+	parameter IN_WIDTH  = 22,
+	parameter OUT_WIDTH = 8     // INT8 = 8, INT16 = 16
+)(
+	input logic clk,
+	input logic rst,   // Active Low (negedge)
+
+	// ===== 레이어별 설정 (프레임 동안 고정) =====
+	input logic [15:0] i_scale,               // 정수 배율 (실수 배율 = scale / 2^shift)
+	input logic [5:0] i_shift,                // 오른쪽 시프트 (반올림 포함)
+	input logic signed [7:0] i_zero_point,    // 출력 영점
+
+	input logic i_valid,
+	input logic signed [IN_WIDTH-1:0] i_data,
+	output logic o_valid,
+	output logic signed [OUT_WIDTH-1:0] o_data
+);
+	// simple_quantizer(상위 비트 절삭)와 달리 반올림 + 포화 → 양자화 오차 최소화
+	// 2단 파이프라인: 곱 → 시프트/반올림/영점/포화
+	localparam PROD_WIDTH = IN_WIDTH + 17;
+	localparam signed [PROD_WIDTH-1:0] OUT_MAX = (1 <<< (OUT_WIDTH - 1)) - 1;
+	localparam signed [PROD_WIDTH-1:0] OUT_MIN = -(1 <<< (OUT_WIDTH - 1));
+
+	logic signed [PROD_WIDTH-1:0] prod_reg;
+	logic valid_d1;
+	logic signed [PROD_WIDTH-1:0] rounded;
+
+	// 반올림: 2^(shift-1) 더한 뒤 산술 시프트 (half-up)
+	always_comb begin
+		if(i_shift == 0) rounded = prod_reg;
+		else rounded = (prod_reg + (PROD_WIDTH'(1) <<< (i_shift - 1))) >>> i_shift;
+		rounded = rounded + PROD_WIDTH'(i_zero_point);
+	end
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			prod_reg <= '0;
+			valid_d1 <= 1'b0;
+			o_data <= '0;
+			o_valid <= 1'b0;
+		end else begin
+			prod_reg <= i_data * signed'({1'b0, i_scale});
+			valid_d1 <= i_valid;
+
+			if(rounded > OUT_MAX)      o_data <= OUT_MAX[OUT_WIDTH-1:0];
+			else if(rounded < OUT_MIN) o_data <= OUT_MIN[OUT_WIDTH-1:0];
+			else                       o_data <= rounded[OUT_WIDTH-1:0];
+			o_valid <= valid_d1;
+		end
+	end
+
+endmodule
@@ -0,0 +1,100 @@
+/* ===== 협조형 주기 스케줄러 (sched.h) ===== */
+#include "sched.h"
+
+static SchedTask *sched_tasks = NULL;
+static int sched_count = 0;
+static u32 sched_tick_us = 1000;
+static volatile u32 sched_ticks = 0;
+static int sched_tick_irq = 0;          // 0이면 폴링 틱
+
+void sched_tick_isr(void *ref) {
+    (void)ref;
+    sched_ticks++;
+}
+
+void sched_init(SchedTask *tasks, int count, u32 tick_us) {
+    sched_tasks = tasks;
+    sched_count = count;
+    sched_tick_us = tick_us;
+    sched_tick_irq = (hal_tick_start(tick_us, sched_tick_isr, NULL) == 0);
+
+    // 릴리스를 틱 경계에 맞춤 (hal_now_us는 틱 주기의 배수에서 틱 발생) → 틱 직후 바로 실행
+    u32 now = hal_now_us();
+    u32 first = now - (now % tick_us);
+    for (int i = 0; i < count; i++) tasks[i].next_release_us = first;
+    sched_clear_stats();
+}
+
+void sched_clear_stats(void) {
+    for (int i = 0; i < sched_count; i++) {
+        SchedTask *t = &sched_tasks[i];
+        t->runs = 0;
+        t->overruns = 0;
+        t->skips = 0;
+        t->wcet_us = 0;
+        t->max_resp_us = 0;
+    }
+}
+
+/**
+ * 릴리스된 태스크 중 우선순위가 가장 높은 것 하나를 실행
+ * 실행이 끝날 때마다 표 처음부터 다시 찾음 (그 사이 릴리스된 상위 태스크 우선)
+ */
+int sched_run_ready(void) {
+    int ran = 0;
+    for (;;) {
+        u32 now = hal_now_us();
+        SchedTask *t = NULL;
+        for (int i = 0; i < sched_count; i++) {
+            if ((s32)(now - sched_tasks[i].next_release_us) >= 0) {
+                t = &sched_tasks[i];
+                break;
+            }
+        }
+        if (!t) return ran;
+
+        // 한 주기 이상 밀렸으면 놓친 릴리스는 건너뛰고 가장 최근 릴리스로 실행
+        u32 period_us = t->period_ms * 1000;
+        u32 late = now - t->next_release_us;
+        if (late >= period_us) {
+            u32 missed = late / period_us;
+            t->skips += missed;
+            t->next_release_us += missed * period_us;
+        }
+
+        u32 release = t->next_release_us;
+        t->fn();
+        u32 end = hal_now_us();
+
+        u32 exec = end - now;
+        u32 resp = end - release;
+        if (exec > t->wcet_us) t->wcet_us = exec;
+        if (resp > t->max_resp_us) t->max_resp_us = resp;
+        if (resp > t->deadline_us) t->overruns++;
+        t->runs++;
+        t->next_release_us = release + period_us;
+        ran++;
+    }
+}
+
+void sched_report(void) {
+    xil_printf("[SCHED] tick %lu us (%s), %lu ticks\r\n", (unsigned long)sched_tick_us,
+               sched_tick_irq ? "IRQ" : "POLL", (unsigned long)sched_ticks);
+    xil_printf("[SCHED] %-8s %6s %8s %8s %8s %8s %6s %6s\r\n",
+               "task", "period", "deadline", "runs", "wcet", "resp", "over", "skip");
+    for (int i = 0; i < sched_count; i++) {
+        const SchedTask *t = &sched_tasks[i];
+        xil_printf("[SCHED] %-8s %4lums %6luus %8lu %6luus %6luus %6lu %6lu\r\n", t->name,
+                   (unsigned long)t->period_ms, (unsigned long)t->deadline_us, (unsigned long)t->runs,
+                   (unsigned long)t->wcet_us, (unsigned long)t->max_resp_us,
+                   (unsigned long)t->overruns, (unsigned long)t->skips);
+    }
+}
+
+int sched_task_count(void) {
+    return sched_count;
+}
+
+const SchedTask *sched_task(int idx) {
+    return (idx >= 0 && idx < sched_count) ? &sched_tasks[idx] : NULL;
+}
@@ -0,0 +1,33 @@
+/* ===== 협조형 주기 스케줄러 =====
+ * 타이머 틱 인터럽트가 CPU를 깨우고, 메인 루프가 릴리스 시각이 지난 태스크를 우선순위(표 순서)대로 실행.
+ * 태스크는 블로킹 없이 짧게 끝나야 한다 (긴 동작은 상태 + 타임스탬프로 나눠서 다음 주기에 이어감).
+ * 태스크별 WCET, 최대 응답 시간, 기한 초과(overrun), 건너뛴 릴리스(skip)를 기록. */
+#ifndef SCHED_H
+#define SCHED_H
+
+#include "hal.h"
+
+typedef struct {
+    const char *name;
+    void (*fn)(void);
+    u32 period_ms;
+    u32 deadline_us;       // 릴리스 시각부터 완료까지 허용 시간
+
+    /* 런타임 (sched_init이 초기화) */
+    u32 next_release_us;
+    u32 runs;
+    u32 overruns;          // 기한을 넘겨 완료한 횟수
+    u32 skips;             // 한 주기 이상 밀려 건너뛴 릴리스 수
+    u32 wcet_us;           // 최대 실행 시간 (시작 → 완료)
+    u32 max_resp_us;       // 최대 응답 시간 (릴리스 → 완료)
+} SchedTask;
+
+void sched_init(SchedTask *tasks, int count, u32 tick_us);   // 틱 인터럽트 시작 + 첫 릴리스 = 현재
+int  sched_run_ready(void);            // 준비된 태스크 모두 실행, 실행 수 반환 (0이면 틱 대기)
+void sched_tick_isr(void *ref);        // 타이머 ISR 콜백
+void sched_clear_stats(void);
+void sched_report(void);
+int  sched_task_count(void);
+const SchedTask *sched_task(int idx);
+
+#endif /* SCHED_H */
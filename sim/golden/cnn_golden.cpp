@@ -0,0 +1,180 @@
+#include "cnn_golden.hpp"
+
+#include <fstream>
+#include <regex>
+#include <sstream>
+
+namespace cnn_golden {
+
+int64_t wrap_signed(int64_t v, int bits) {
+    const uint64_t mask = (bits >= 64) ? ~0ULL : ((1ULL << bits) - 1);
+    uint64_t u = static_cast<uint64_t>(v) & mask;
+    if (bits < 64 && (u >> (bits - 1)) & 1) u |= ~mask;   // 부호 확장
+    return static_cast<int64_t>(u);
+}
+
+Weights::Weights() {
+    static const int8_t sobel[3][3] = {{1, 0, -1}, {2, 0, -2}, {1, 0, -1}};
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++) kernel[i][j] = sobel[i][j];
+    for (auto &n : fc) n.assign(FC_MAX_INPUTS, 0);
+}
+
+Weights Weights::sobel_zero() { return Weights(); }
+
+uint32_t QuantConfig::pack() const {
+    return (static_cast<uint32_t>(static_cast<uint8_t>(zero_point)) << 24) |
+           (static_cast<uint32_t>(shift & 0x3F) << 16) | scale;
+}
+
+uint32_t Geometry::pack() const {
+    return static_cast<uint32_t>(width & 0xFF) | (static_cast<uint32_t>(height & 0xFF) << 8) |
+           (static_cast<uint32_t>(stride_log2 & 0x3) << 16) | (same_pad ? (1u << 18) : 0u);
+}
+
+// ===== conv_engine_2d =====
+// valid: 출력 (ox, oy) 윈도우 = img[oy..oy+2][ox..ox+2]
+// same:  출력 (ox, oy) 윈도우 = img[oy-1..oy+1][ox-1..ox+1], 경계 밖은 0
+// stride: ox, oy가 stride 배수인 출력만 (행 우선 순서 유지)
+// compute_unit: {0, pixel} * weight (18비트), 덧셈 트리 19/20/21/22비트
+std::vector<int32_t> conv2d(const std::vector<uint8_t> &img, const int8_t kernel[3][3], const Geometry &g) {
+    const int full_w = g.same_pad ? g.width : g.width - 2;
+    const int full_h = g.same_pad ? g.height : g.height - 2;
+    const int off = g.same_pad ? -1 : 0;
+    const int s = 1 << g.stride_log2;
+    std::vector<int32_t> out;
+    out.reserve(g.conv_w() * g.conv_h());
+    for (int oy = 0; oy < full_h; oy += s) {
+        for (int ox = 0; ox < full_w; ox += s) {
+            int64_t mac[3][3];
+            for (int i = 0; i < 3; i++)
+                for (int j = 0; j < 3; j++) {
+                    const int y = oy + off + i, x = ox + off + j;
+                    const bool inside = x >= 0 && x < g.width && y >= 0 && y < g.height;
+                    mac[i][j] = inside ? wrap_signed(int64_t(img[y * g.width + x]) * kernel[i][j], 18) : 0;
+                }
+
+            // sum_stage1..3 / final_result 순서 그대로 (RTL 폭에서 절삭)
+            int64_t s1[5] = {
+                wrap_signed(mac[0][0] + mac[0][1], 19), wrap_signed(mac[0][2] + mac[1][0], 19),
+                wrap_signed(mac[1][1] + mac[1][2], 19), wrap_signed(mac[2][0] + mac[2][1], 19),
+                wrap_signed(mac[2][2], 19)};
+            int64_t s2[3] = {wrap_signed(s1[0] + s1[1], 20), wrap_signed(s1[2] + s1[3], 20), wrap_signed(s1[4], 20)};
+            int64_t s3[2] = {wrap_signed(s2[0] + s2[1], 21), wrap_signed(s2[2], 21)};
+            out.push_back(static_cast<int32_t>(wrap_signed(s3[0] + s3[1], 22)));
+        }
+    }
+    return out;
+}
+
+// ===== Activation_Function: 음수 → 0 =====
+std::vector<int32_t> relu(const std::vector<int32_t> &in) {
+    std::vector<int32_t> out(in.size());
+    for (size_t i = 0; i < in.size(); i++) out[i] = in[i] < 0 ? 0 : in[i];
+    return out;
+}
+
+// ===== Max_Pooling: 2x2 stride 2, 행 우선 출력 (홀수 크기면 마지막 행/열 버림) =====
+std::vector<int32_t> max_pool(const std::vector<int32_t> &in, int in_w, int in_h) {
+    const int pw = in_w / 2, ph = in_h / 2;
+    std::vector<int32_t> out(pw * ph);
+    for (int py = 0; py < ph; py++) {
+        for (int px = 0; px < pw; px++) {
+            const int y = 2 * py, x = 2 * px;
+            int32_t top = std::max(in[y * in_w + x], in[y * in_w + x + 1]);
+            int32_t bot = std::max(in[(y + 1) * in_w + x], in[(y + 1) * in_w + x + 1]);
+            out[py * pw + px] = std::max(top, bot);
+        }
+    }
+    return out;
+}
+
+// ===== requantizer: (x * scale + 2^(shift-1)) >>> shift + zp, 포화 =====
+int32_t requantize(int32_t x, const QuantConfig &q) {
+    if (q.mode == 0) return x;
+    const int w = q.act_width();
+    const int prod_w = 22 + 17;
+    int64_t prod = wrap_signed(int64_t(x) * q.scale, prod_w);
+    int64_t r = prod;
+    if (q.shift != 0) r = wrap_signed(prod + (int64_t(1) << (q.shift - 1)), prod_w) >> q.shift;
+    r = wrap_signed(r + q.zero_point, prod_w);
+    const int64_t hi = (int64_t(1) << (w - 1)) - 1, lo = -(int64_t(1) << (w - 1));
+    if (r > hi) r = hi;
+    if (r < lo) r = lo;
+    return static_cast<int32_t>(r);
+}
+
+// ===== Fully_Connected_Layer_Fixed: 48비트 누적 + argmax =====
+void fully_connected(const std::vector<int32_t> &in, const Weights &w, int data_width, FrameResult &r) {
+    for (int n = 0; n < NUM_NEURONS; n++) {
+        int64_t acc = 0;
+        for (size_t k = 0; k < in.size(); k++) {
+            int64_t a = wrap_signed(in[k], data_width);
+            int64_t b = wrap_signed(w.fc[n][k], data_width);   // 가중치 RAM 폭으로 절삭
+            acc = wrap_signed(acc + a * b, 48);
+        }
+        r.neuron[n] = acc;
+    }
+    r.lane_result = r.neuron[0];
+
+    // RTL과 같은 순서: 동점이면 앞 클래스 유지
+    int best = 0;
+    int64_t best_score = r.neuron[1];
+    int64_t second = -(int64_t(1) << 47);
+    for (int c = 1; c < NUM_CLASSES; c++) {
+        int64_t v = r.neuron[1 + c];
+        if (v > best_score) {
+            second = best_score;
+            best_score = v;
+            best = c;
+        } else if (v > second) {
+            second = v;
+        }
+    }
+    r.class_idx = best;
+    r.class_score = best_score;
+    r.class_margin = wrap_signed(best_score - second, 48) & ((int64_t(1) << 48) - 1);
+
+    // 클래스 가중치 미로드: 차선 회귀 값의 조향각 임계값으로 분류 (CNN_TOP_Improved lane_class)
+    if (!w.class_loaded) {
+        const int64_t steer = r.lane_result / (int64_t(1) << CLASS_FALLBACK_SHIFT);
+        r.class_idx = (steer > -8 && steer < 8) ? 0 : (steer > 25) ? 1 : (steer < -25) ? 2 : 3;
+        r.class_score = 0;
+        r.class_margin = 0;
+    }
+}
+
+FrameResult run_frame(const std::vector<uint8_t> &img, const Weights &w, const QuantConfig &q, const Geometry &g) {
+    FrameResult r;
+    r.conv = conv2d(img, w.kernel, g);
+    r.relu = relu(r.conv);
+    r.pool = max_pool(r.relu, g.conv_w(), g.conv_h());
+    r.fc_in.resize(r.pool.size());
+    for (size_t i = 0; i < r.pool.size(); i++) {
+        r.fc_in[i] = requantize(r.pool[i], q);
+        if (r.fc_in[i] != 0) r.fc_nonzero++;
+    }
+    fully_connected(r.fc_in, w, q.act_width(), r);
+    return r;
+}
+
+bool load_rom_weights(const std::string &fc_source_path, Weights &w) {
+    std::ifstream f(fc_source_path);
+    if (!f) return false;
+    std::stringstream ss;
+    ss << f.rdbuf();
+    const std::string src = ss.str();
+
+    static const std::regex re(R"(weight_ROM\[0\]\[(\d+)\]\s*=\s*22'h([0-9A-Fa-f]+))");
+    int found = 0;
+    for (auto it = std::sregex_iterator(src.begin(), src.end(), re); it != std::sregex_iterator(); ++it) {
+        int k = std::stoi((*it)[1]);
+        if (k < 0 || k >= FC_INPUTS) continue;
+        w.fc[0][k] = static_cast<int32_t>(wrap_signed(std::stoll((*it)[2], nullptr, 16), 22));
+        found++;
+    }
+    w.class_loaded = false;
+    return found == FC_INPUTS;
+}
+
+}  // namespace cnn_golden
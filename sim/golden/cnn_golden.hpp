@@ -0,0 +1,90 @@
+// ===== Mini_NPU 고정소수점 골든 모델 =====
+// CNN_TOP_Improved 데이터 경로를 비트 단위로 재현:
+//   conv_engine_2d (3x3, valid/same, stride 1/2/4) → Activation_Function (ReLU) → Max_Pooling (2x2, stride 2)
+//   → [requantizer] → flatten_buffer (행 우선, 기본 225) → Fully_Connected_Layer_Fixed (+ argmax)
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cnn_golden {
+
+// 기본 프레임 크기 (= CNN_TOP_Improved MAX_IMG_WIDTH/HEIGHT, GEOMETRY 리셋값)
+constexpr int IMG_W = 32;
+constexpr int IMG_H = 32;
+constexpr int CONV_W = IMG_W - 2;        // 30
+constexpr int CONV_H = IMG_H - 2;
+constexpr int POOL_W = CONV_W / 2;       // 15
+constexpr int POOL_H = CONV_H / 2;
+constexpr int FC_INPUTS = POOL_W * POOL_H;   // 225 (하드코딩된 ROM 가중치 수)
+constexpr int FC_MAX_INPUTS = (IMG_W / 2) * (IMG_H / 2);   // 256 (same 패딩, stride 1)
+constexpr int NUM_CLASSES = 4;
+constexpr int NUM_NEURONS = 1 + NUM_CLASSES;  // 뉴런 0 = 차선 회귀, 1~4 = 클래스
+constexpr int CLASS_FALLBACK_SHIFT = 11;      // CNN_TOP_Improved 임계값 분류 스케일 (CNN_OUTPUT_SCALE 2048)
+
+// RTL 폭에 맞춘 2의 보수 절삭 (부호 확장 포함)
+int64_t wrap_signed(int64_t v, int bits);
+
+struct Weights {
+    int8_t kernel[3][3];                               // conv_engine_2d 커널 (행 우선)
+    std::array<std::vector<int32_t>, NUM_NEURONS> fc;  // 뉴런별 FC_MAX_INPUTS개 (22비트 부호 있는 값)
+    bool class_loaded = true;                          // false: 클래스 뉴런 미로드 → 임계값 분류 폴백
+
+    Weights();                                         // Sobel + 0 가중치
+    static Weights sobel_zero();
+};
+
+struct QuantConfig {
+    int mode = 0;            // 0: 22비트, 1: INT16, 2: INT8 (CNN_TOP_Improved QUANT_MODE)
+    uint16_t scale = 1;
+    uint8_t shift = 0;
+    int8_t zero_point = 0;
+
+    int act_width() const { return mode == 2 ? 8 : mode == 1 ? 16 : 22; }
+    uint32_t pack() const;   // i_quant_cfg / QUANT_CFG 레지스터 형식
+};
+
+// CNN_TOP_Improved i_geometry / GEOMETRY 레지스터
+struct Geometry {
+    int width = IMG_W;
+    int height = IMG_H;
+    int stride_log2 = 0;     // stride = 1 << stride_log2 (0~2)
+    bool same_pad = false;   // true: 제로 패딩 (conv 출력 = 입력 크기)
+
+    int conv_w() const { return ((same_pad ? width : width - 2) + (1 << stride_log2) - 1) >> stride_log2; }
+    int conv_h() const { return ((same_pad ? height : height - 2) + (1 << stride_log2) - 1) >> stride_log2; }
+    int fc_inputs() const { return (conv_w() / 2) * (conv_h() / 2); }
+    uint32_t pack() const;
+};
+
+struct FrameResult {
+    std::vector<int32_t> conv;                 // conv 출력 (기본 30x30)
+    std::vector<int32_t> relu;                 // ReLU 출력
+    std::vector<int32_t> pool;                 // pooling 출력 (flatten 순서, 기본 15x15)
+    std::vector<int32_t> fc_in;                // 재양자화 후 FC 입력
+    int fc_nonzero = 0;                        // 0이 아닌 FC 입력 수 (하드웨어 zero skip 발행 수)
+    std::array<int64_t, NUM_NEURONS> neuron;   // 48비트 누적값
+    int64_t lane_result = 0;                   // 뉴런 0
+    int class_idx = 0;
+    int64_t class_score = 0;
+    int64_t class_margin = 0;
+};
+
+// ===== 단계별 모델 =====
+std::vector<int32_t> conv2d(const std::vector<uint8_t> &img, const int8_t kernel[3][3],
+                            const Geometry &g = Geometry{});
+std::vector<int32_t> relu(const std::vector<int32_t> &in);
+std::vector<int32_t> max_pool(const std::vector<int32_t> &in, int in_w = CONV_W, int in_h = CONV_H);
+int32_t requantize(int32_t x, const QuantConfig &q);
+void fully_connected(const std::vector<int32_t> &in, const Weights &w, int data_width, FrameResult &r);
+
+// 한 프레임 전체 (img: g.width x g.height 행 우선)
+FrameResult run_frame(const std::vector<uint8_t> &img, const Weights &w, const QuantConfig &q,
+                      const Geometry &g = Geometry{});
+
+// Fully_Connected_Layer.sv의 하드코딩된 뉴런 0 가중치 읽기 (RTL 초기값과 동일하게 맞춤, 클래스는 폴백)
+bool load_rom_weights(const std::string &fc_source_path, Weights &w);
+
+}  // namespace cnn_golden
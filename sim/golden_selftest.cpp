@@ -0,0 +1,124 @@
+// ===== 골든 모델 자체 점검 (Verilator 없이 g++만으로 실행) =====
+// 손으로 계산 가능한 입력으로 단계별 모델을 확인
+#include <cstdio>
+#include <vector>
+
+#include "golden/cnn_golden.hpp"
+
+using namespace cnn_golden;
+
+static int error_count = 0;
+
+static void check(bool ok, const char *name) {
+    std::printf("%s %s\n", ok ? "✓" : "✗", name);
+    if (!ok) error_count++;
+}
+
+int main() {
+    std::printf("=== Golden Model Self-Test ===\n");
+    Weights w;   // Sobel 커널, FC 가중치 0
+
+    // 1. 균일 이미지: Sobel 응답 0 → 모든 단계 0
+    {
+        std::vector<uint8_t> img(IMG_W * IMG_H, 100);
+        FrameResult r = run_frame(img, w, QuantConfig{});
+        bool zero = true;
+        for (int32_t v : r.conv) zero &= (v == 0);
+        check(zero && r.lane_result == 0, "flat image -> zero conv/FC");
+    }
+
+    // 2. 수직 에지 (x < 16: 200, x >= 16: 0): Sobel {1,0,-1;2,0,-2;1,0,-1} = 4 * 200 = 800
+    std::vector<uint8_t> edge(IMG_W * IMG_H);
+    for (int y = 0; y < IMG_H; y++)
+        for (int x = 0; x < IMG_W; x++) edge[y * IMG_W + x] = (x < 16) ? 200 : 0;
+    FrameResult r = run_frame(edge, w, QuantConfig{});
+    {
+        // 윈도우 열 x-2..x 중 왼쪽만 밝음 → conv 출력 열 (x-2) = 14, 15에서 800
+        bool ok = r.conv[14] == 800 && r.conv[15] == 800 && r.conv[13] == 0 && r.conv[16] == 0;
+        check(ok, "vertical edge -> conv 800 at columns 14/15");
+        check(r.pool[7] == 800 && r.pool[6] == 0 && r.pool[8] == 0, "max pool keeps edge at pooled column 7");
+        check(r.fc_nonzero == POOL_H, "zero skip: one nonzero FC input per pooled row");
+    }
+
+    // 3. 반전 에지: 음수 응답 → ReLU 0
+    {
+        std::vector<uint8_t> inv(edge);
+        for (auto &p : inv) p = static_cast<uint8_t>(200 - p);
+        FrameResult ri = run_frame(inv, w, QuantConfig{});
+        check(ri.conv[14] == -800 && ri.relu[14] == 0, "inverted edge -> conv -800, ReLU 0");
+    }
+
+    // 4. FC + argmax: 클래스 2 가중치만 1 → 에지 합이 클래스 2 점수
+    {
+        Weights wf;
+        for (int k = 0; k < FC_INPUTS; k++) {
+            wf.fc[0][k] = -1;
+            wf.fc[3][k] = 1;   // 클래스 2 (뉴런 3)
+        }
+        FrameResult rf = run_frame(edge, wf, QuantConfig{});
+        const int64_t sum = 800 * POOL_H;
+        check(rf.lane_result == -sum, "neuron 0 = -sum(edge)");
+        check(rf.class_idx == 2 && rf.class_score == sum && rf.class_margin == sum, "argmax picks class 2");
+
+        // 동점: 가장 앞 클래스 유지, margin 0
+        for (int k = 0; k < FC_INPUTS; k++) wf.fc[1][k] = 1;
+        FrameResult rt = run_frame(edge, wf, QuantConfig{});
+        check(rt.class_idx == 0 && rt.class_margin == 0, "tie keeps lowest class index");
+
+        // 클래스 가중치 미로드: 차선 값 -sum(edge) / 2048 의 임계값 분류, 점수 0
+        wf.class_loaded = false;
+        FrameResult rb = run_frame(edge, wf, QuantConfig{});
+        const int64_t steer = -sum / 2048;
+        const int exp_cls = (steer > -8 && steer < 8) ? 0 : (steer > 25) ? 1 : (steer < -25) ? 2 : 3;
+        check(rb.class_idx == exp_cls && rb.class_score == 0 && rb.class_margin == 0,
+              "class fallback thresholds lane result when class weights not loaded");
+        for (int k = 0; k < FC_INPUTS; k++) wf.fc[0][k] = -30;
+        FrameResult rr = run_frame(edge, wf, QuantConfig{});
+        check(rr.class_idx == 2, "class fallback: lane < -25 * 2048 -> RIGHT_CURVE");
+    }
+
+    // 5. 재양자화: 반올림 + 영점 + 포화
+    {
+        QuantConfig q;
+        q.mode = 2;
+        q.scale = 3;
+        q.shift = 2;
+        check(requantize(5, q) == 4, "requant (5*3 + 2) >> 2 = 4");
+        check(requantize(800, q) == 127, "requant saturates to INT8 max");
+        q.zero_point = -10;
+        check(requantize(6, q) == -5, "requant zero point");
+        check(requantize(-2, q) == -11, "requant rounds negative half up");
+    }
+
+    // 6. same 패딩: 균일 이미지라도 좌/우 경계에서 0 패딩 때문에 Sobel 응답 ∓400
+    {
+        Geometry g;
+        g.same_pad = true;
+        std::vector<uint8_t> flat(IMG_W * IMG_H, 100);
+        FrameResult rs = run_frame(flat, w, QuantConfig{}, g);
+        const int row = 16 * IMG_W;
+        check(rs.conv.size() == size_t(IMG_W * IMG_H) && rs.pool.size() == size_t(FC_MAX_INPUTS), "same padding keeps 32x32");
+        check(rs.conv[row] == -400 && rs.conv[row + IMG_W - 1] == 400 && rs.conv[row + 5] == 0,
+              "same padding -> zero border response");
+    }
+
+    // 7. stride 2 = stride 1 출력의 짝수 좌표
+    {
+        Geometry g2;
+        g2.stride_log2 = 1;
+        FrameResult r2 = run_frame(edge, w, QuantConfig{}, g2);
+        bool ok = g2.conv_w() == 15 && g2.fc_inputs() == 49 && r2.conv.size() == 225;
+        for (int y = 0; ok && y < 15; y++)
+            for (int x = 0; x < 15; x++) ok &= r2.conv[y * 15 + x] == r.conv[(2 * y) * CONV_W + 2 * x];
+        check(ok, "stride 2 subsamples stride 1 conv");
+    }
+
+    // 8. 폭 절삭: 22비트 가중치의 부호 확장
+    check(wrap_signed(0x3FFFFF, 22) == -1 && wrap_signed(0x200000, 22) == -(1 << 21), "22-bit sign wrap");
+
+    if (error_count == 0)
+        std::printf("✓ TEST PASSED\n");
+    else
+        std::printf("✗ TEST FAILED: %d checks\n", error_count);
+    return error_count == 0 ? 0 : 1;
+}
@@ -0,0 +1,214 @@
+/* ===== HAL: 호스트 스텁 구현 (-DHAL_HOST) =====
+ * 가상 µs 시계: hal_delay_us / hal_wait_for_tick과 레지스터 접근 비용으로만 진행 (재현 가능)
+ * CPU 연산과 콘솔 출력 시간은 0으로 본다 → WCET는 레지스터 접근 + 대기의 하한
+ * 틱 경계를 지날 때마다 등록된 틱 ISR 호출, 예약된 이벤트도 같은 시점에 실행 */
+#include <stdarg.h>
+#include <string.h>
+
+#include "hal_host.h"
+
+#define HOST_REGS         256
+#define HOST_EVENTS       64
+#define HOST_UART_FIFO    256
+#define HOST_REG_ACCESS_NS 100    // AXI-Lite 접근 한 번 (MicroBlaze 100 MHz 기준 약 10클럭)
+#define HOST_UART_BYTE_US  87     // 115200 bps, 10비트/바이트
+
+typedef struct { u32 addr, value; } HostReg;
+typedef struct { u32 at_us; HalHostEvent fn; void *arg; int done; } HostEvent;
+
+static HostReg regs[HOST_REGS];
+static int reg_count;
+static HostEvent events[HOST_EVENTS];
+static int event_count;
+static char uart_fifo[HOST_UART_FIFO];
+static int uart_head, uart_tail;
+
+static u32 now_us, now_ns_frac;
+static u32 run_until_us;
+static int quiet;
+static HalHostWriteHook write_hook;
+
+static HalUartTxPull tx_pull;             // 송신 큐: 선로 속도로 한 바이트씩 꺼냄 (TX 인터럽트 모델)
+static HalHostTxHook tx_hook;
+static int tx_busy;
+static u32 tx_next_us;
+
+static u32 tick_period_us = 1000;
+static u32 next_tick_us;
+static HalIrqHandler tick_isr;
+static void *tick_ref;
+
+void hal_host_reset(void) {
+    reg_count = 0;
+    event_count = 0;
+    uart_head = uart_tail = 0;
+    now_us = now_ns_frac = 0;
+    run_until_us = 0;
+    write_hook = NULL;
+    tx_pull = NULL;
+    tx_hook = NULL;
+    tx_busy = 0;
+    tick_isr = NULL;
+    tick_ref = NULL;
+    next_tick_us = tick_period_us;
+}
+
+void hal_host_run_for_ms(u32 ms) { run_until_us = now_us + ms * 1000; }
+void hal_host_set_quiet(int q)   { quiet = q; }
+void hal_host_on_write(HalHostWriteHook hook) { write_hook = hook; }
+void hal_host_on_uart_tx(HalHostTxHook hook)   { tx_hook = hook; }
+
+void hal_host_at_ms(u32 ms, HalHostEvent fn, void *arg) {
+    if (event_count < HOST_EVENTS) events[event_count++] = (HostEvent){ms * 1000, fn, arg, 0};
+}
+
+void hal_host_uart_send(const char *s) {
+    hal_host_uart_send_bytes((const u8 *)s, (int)strlen(s));
+}
+
+void hal_host_uart_send_bytes(const u8 *p, int n) {
+    for (int i = 0; i < n && ((uart_head + 1) % HOST_UART_FIFO) != uart_tail; i++) {
+        uart_fifo[uart_head] = (char)p[i];
+        uart_head = (uart_head + 1) % HOST_UART_FIFO;
+    }
+}
+
+static HostReg *find_reg(u32 addr, int create) {
+    for (int i = 0; i < reg_count; i++)
+        if (regs[i].addr == addr) return &regs[i];
+    if (!create || reg_count == HOST_REGS) return NULL;
+    regs[reg_count] = (HostReg){addr, 0};
+    return &regs[reg_count++];
+}
+
+void hal_host_poke(u32 addr, u32 value) {
+    HostReg *r = find_reg(addr, 1);
+    if (r) r->value = value;
+}
+
+/* ================= 가상 시간 ================= */
+
+static void fire_events(void) {
+    for (int i = 0; i < event_count; i++) {
+        if (!events[i].done && (s32)(now_us - events[i].at_us) >= 0) {
+            events[i].done = 1;
+            events[i].fn(events[i].arg);
+        }
+    }
+}
+
+// 송신 큐에서 upto 시각까지 선로로 나간 바이트 (큐가 비면 다음 kick까지 정지)
+static void drain_tx(u32 upto) {
+    u8 b;
+    while (tx_busy && (s32)(upto - tx_next_us) >= 0) {
+        if (!tx_pull(&b)) {
+            tx_busy = 0;
+            break;
+        }
+        if (tx_hook) tx_hook(tx_next_us, b);
+        tx_next_us += HOST_UART_BYTE_US;
+    }
+}
+
+static void advance_us(u32 us) {
+    u32 target = now_us + us;
+    while ((s32)(target - next_tick_us) >= 0) {
+        drain_tx(next_tick_us);
+        now_us = next_tick_us;
+        next_tick_us += tick_period_us;
+        fire_events();
+        if (tick_isr) tick_isr(tick_ref);
+    }
+    drain_tx(target);
+    now_us = target;
+    fire_events();
+}
+
+static void advance_ns(u32 ns) {
+    now_ns_frac += ns;
+    if (now_ns_frac >= 1000) {
+        u32 us = now_ns_frac / 1000;
+        now_ns_frac %= 1000;
+        advance_us(us);
+    }
+}
+
+/* ================= HAL 구현 ================= */
+
+void hal_init(void) { }
+void hal_cleanup(void) { }
+
+int hal_running(void) {
+    return (s32)(run_until_us - now_us) > 0;
+}
+
+u32 hal_read32(u32 addr) {
+    advance_ns(HOST_REG_ACCESS_NS);
+    HostReg *r = find_reg(addr, 0);
+    return r ? r->value : 0;
+}
+
+void hal_write32(u32 addr, u32 value) {
+    advance_ns(HOST_REG_ACCESS_NS);
+    hal_host_poke(addr, value);
+    if (write_hook) write_hook(now_us, addr, value);
+}
+
+int hal_uart_rx_ready(void) { return uart_head != uart_tail; }
+
+char hal_uart_getc(void) {
+    if (uart_head == uart_tail) return 0;
+    char c = uart_fifo[uart_tail];
+    uart_tail = (uart_tail + 1) % HOST_UART_FIFO;
+    return c;
+}
+
+void hal_uart_putc(char c) {
+    if (!quiet) putchar(c);
+}
+
+void hal_uart_flush_rx(void) { uart_tail = uart_head; }
+
+int hal_uart_tx_irq_start(HalUartTxPull pull) {
+    tx_pull = pull;
+    tx_busy = 0;
+    return 0;
+}
+
+void hal_uart_tx_kick(void) {
+    if (!tx_pull || tx_busy) return;
+    tx_busy = 1;
+    tx_next_us = now_us;
+}
+
+int hal_host_printf(const char *fmt, ...) {
+    if (quiet) return 0;
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vprintf(fmt, ap);
+    va_end(ap);
+    return n;
+}
+
+u32 hal_now_us(void) { return now_us; }
+
+void hal_delay_us(u32 us) { advance_us(us); }
+
+int hal_tick_start(u32 period_us, HalIrqHandler isr, void *ref) {
+    tick_period_us = period_us;
+    next_tick_us = (now_us / period_us + 1) * period_us;
+    tick_isr = isr;
+    tick_ref = ref;
+    return 0;
+}
+
+void hal_wait_for_tick(void) {
+    advance_us(next_tick_us - now_us);
+}
+
+int hal_irq_connect(u32 irq_id, HalIrqHandler isr, void *ref) {
+    (void)irq_id;
+    (void)isr;
+    (void)ref;
+    return -1;   // 외부 인터럽트 없음 → 펌웨어가 폴링 경로 사용
+}
@@ -0,0 +1,22 @@
+/* ===== 호스트 HAL 시험 인터페이스 (hal_host.c) =====
+ * 가상 시간 위에서 펌웨어를 돌리며 레지스터 값 주입 / UART 입력 / 쓰기 관찰 */
+#ifndef HAL_HOST_H
+#define HAL_HOST_H
+
+#include "hal.h"
+
+typedef void (*HalHostEvent)(void *arg);
+typedef void (*HalHostWriteHook)(u32 now_us, u32 addr, u32 value);
+typedef void (*HalHostTxHook)(u32 now_us, u8 byte);
+
+void hal_host_reset(void);
+void hal_host_run_for_ms(u32 ms);                      // hal_running()이 1인 가상 시간
+void hal_host_set_quiet(int quiet);                    // 1: 펌웨어 콘솔 출력 숨김
+void hal_host_poke(u32 addr, u32 value);               // 스텁 레지스터 값 설정 (펌웨어 쓰기 없이)
+void hal_host_on_write(HalHostWriteHook hook);
+void hal_host_on_uart_tx(HalHostTxHook hook);          // 송신 큐 바이트가 선로로 나가는 시각 (115200 bps)
+void hal_host_at_ms(u32 ms, HalHostEvent fn, void *arg);
+void hal_host_uart_send(const char *s);                // 수신 FIFO에 즉시 추가
+void hal_host_uart_send_bytes(const u8 *p, int n);     // 바이너리 (명령 프레임)
+
+#endif /* HAL_HOST_H */
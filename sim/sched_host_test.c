@@ -0,0 +1,123 @@
+/* ===== 스케줄러 호스트 타이밍 시험 (보드 없이 gcc만으로 실행) =====
+ * Microblaze.c 전체를 스텁 HAL + 가상 시간 위에서 2초 동안 실행:
+ *   자율주행 시작 (킥) → 전방 근접 (비상 후진) → 후진 중 UART 정지 → 재시작
+ * 태스크 기한 초과 / 건너뜀이 없고, 킥과 비상 회피 중에도 UART 명령이 즉시 처리되는지 확인 */
+#include <stdio.h>
+#include <string.h>
+
+#include "hal_host.h"
+#include "sched.h"
+
+int firmware_main(void);   // Microblaze.c main (-Dmain=firmware_main)
+
+#define RUN_MS     2000
+#define PWM_BASE   XPAR_DCMOTOR_MYIP_V1_0_BASEADDR
+#define PWM_EN     (PWM_BASE + 0x00)
+#define PWM_DIR    (PWM_BASE + 0x04)
+#define PWM_DUTY   (PWM_BASE + 0x08)
+#define KICK_DUTY_PACKED 0x46464646u   // 4채널 70%
+
+static const u32 ultra_base[3] = {
+    XPAR_ULTRASONIC_MYIP_V1_0_0_BASEADDR,   // 전방
+    XPAR_ULTRASONIC_MYIP_V1_0_1_BASEADDR,   // 오른쪽
+    XPAR_ULTRASONIC_MYIP_V1_0_2_BASEADDR,   // 왼쪽
+};
+
+static int error_count = 0;
+
+static void check(int ok, const char *name) {
+    printf("%s %s\n", ok ? "✓" : "✗", name);
+    if (!ok) error_count++;
+}
+
+/* ===== PWM 쓰기 기록 ===== */
+typedef struct { u32 t_us, addr, value; } PwmWrite;
+static PwmWrite pwm_log[4096];
+static int pwm_count = 0;
+
+static void on_write(u32 now_us, u32 addr, u32 value) {
+    if (addr >= PWM_BASE && addr <= PWM_DUTY && pwm_count < (int)(sizeof(pwm_log) / sizeof(pwm_log[0])))
+        pwm_log[pwm_count++] = (PwmWrite){now_us, addr, value};
+}
+
+// from_us 이후 addr에 대한 첫 쓰기 (value_match = 1이면 값도 일치, -1이면 값이 다른 쓰기)
+static const PwmWrite *find_write(u32 from_us, u32 addr, int value_match, u32 value) {
+    for (int i = 0; i < pwm_count; i++) {
+        const PwmWrite *w = &pwm_log[i];
+        if (w->t_us < from_us || w->addr != addr) continue;
+        if (value_match == 1 && w->value != value) continue;
+        if (value_match == -1 && w->value == value) continue;
+        return w;
+    }
+    return NULL;
+}
+
+/* ===== 시나리오 이벤트 ===== */
+static void set_ultra(u32 base, u32 cm) {
+    hal_host_poke(base + 0x00, cm % 10);
+    hal_host_poke(base + 0x04, cm / 10);
+}
+
+static void ev_uart(void *arg)       { hal_host_uart_send((const char *)arg); }
+static void ev_front_near(void *arg) { (void)arg; set_ultra(ultra_base[0], 15); }
+static void ev_front_clear(void *arg){ (void)arg; set_ultra(ultra_base[0], 90); }
+
+int main(void) {
+    printf("=== Scheduler Host Timing Test ===\n");
+    hal_host_reset();
+    hal_host_set_quiet(1);
+    hal_host_on_write(on_write);
+    for (int i = 0; i < 3; i++) set_ultra(ultra_base[i], 90);
+
+    hal_host_at_ms(50, ev_uart, "Y");          // 자율주행 + CNN (정지 상태 → 킥)
+    hal_host_at_ms(400, ev_front_near, NULL);  // 전방 15 cm → 비상 후진
+    hal_host_at_ms(600, ev_uart, "X");         // 후진 중 정지 명령
+    hal_host_at_ms(700, ev_front_clear, NULL);
+    hal_host_at_ms(900, ev_uart, "Z");         // 초음파 자율주행 재시작
+    hal_host_run_for_ms(RUN_MS);
+
+    firmware_main();
+
+    // 1. 킥: 킥 듀티 쓰기 후 KICK_MS(120) 뒤 모터 태스크가 목표 듀티 적용
+    const PwmWrite *kick = find_write(50000, PWM_DUTY, 1, KICK_DUTY_PACKED);
+    const PwmWrite *after_kick = kick ? find_write(kick->t_us, PWM_DUTY, -1, KICK_DUTY_PACKED) : NULL;
+    u32 kick_us = (kick && after_kick) ? after_kick->t_us - kick->t_us : 0;
+    printf("  kick %u us\n", kick_us);
+    check(kick_us >= 120000 && kick_us <= 121500, "kick ends after 120 ms without blocking");
+
+    // 2. 비상: 전방 근접 후 방향 전환 (후진)
+    const PwmWrite *fwd_dir = kick ? find_write(kick->t_us - 1000, PWM_DIR, 0, 0) : NULL;
+    const PwmWrite *rev_dir = fwd_dir ? find_write(400000, PWM_DIR, -1, fwd_dir->value) : NULL;
+    check(rev_dir && rev_dir->t_us < 450000, "panic backup starts within 50 ms of obstacle");
+
+    // 3. 후진 중 'X' → 2 태스크 주기 안에 정지, 이후 회피 단계 재개 없음
+    const PwmWrite *stop = find_write(600000, PWM_EN, 1, 0);
+    const PwmWrite *resume = find_write(600000, PWM_EN, -1, 0);
+    if (stop) printf("  stop latency %u us\n", stop->t_us - 600000);
+    check(stop && stop->t_us - 600000 <= 4000, "UART stop handled during panic backup (<= 4 ms)");
+    check(resume && resume->t_us >= 900000, "escape sequence cancelled by stop");
+
+    // 4. 태스크 통계
+    int over = 0, skip = 0;
+    u32 max_wcet = 0;
+    int runs_ok = 1;
+    for (int i = 0; i < sched_task_count(); i++) {
+        const SchedTask *t = sched_task(i);
+        over += t->overruns;
+        skip += t->skips;
+        if (t->wcet_us > max_wcet) max_wcet = t->wcet_us;
+        int expect = RUN_MS / t->period_ms;
+        if (t->runs + 3 < (u32)expect || t->runs > (u32)expect + 1) runs_ok = 0;
+    }
+    hal_host_set_quiet(0);
+    sched_report();
+    check(over == 0 && skip == 0, "no deadline overruns or skipped releases");
+    check(runs_ok, "every task released once per period");
+    check(max_wcet < 1000, "worst-case task execution below one tick");
+
+    if (error_count == 0)
+        printf("✓ TEST PASSED\n");
+    else
+        printf("✗ TEST FAILED: %d checks\n", error_count);
+    return error_count == 0 ? 0 : 1;
+}
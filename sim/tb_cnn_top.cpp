@@ -0,0 +1,396 @@
+// ===== CNN_TOP_Improved Verilator 회귀 + 사이클 벤치마크 =====
+// 이미지 세트를 CNN_TOP_Improved에 연속으로 흘려 넣고 골든 모델과 비트 단위 비교
+//   - 결과는 final_frame_tag로 프레임과 매칭 (파이프라인 겹침 허용)
+//   - 프레임당 사이클, 단계별 busy/stall, 지연, 주어진 클럭에서 frames/s 출력
+//
+// 사용법: ./obj_dir/VCNN_TOP_Improved [--frames N] [--seed S] [--gap G] [--clock-mhz F]
+//                                    [--rom-weights] [--scale X --shift Y --zp Z]
+//                                    [--width W --height H --stride-log2 S --same] [image.pgm ...]
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "VCNN_TOP_Improved.h"
+#include "verilated.h"
+#include "golden/cnn_golden.hpp"
+
+#ifndef QUANT_MODE
+#define QUANT_MODE 0
+#endif
+#ifndef FC_ZERO_SKIP
+#define FC_ZERO_SKIP 0
+#endif
+
+using namespace cnn_golden;
+
+namespace {
+
+constexpr int NUM_PERF_STAGES = 4;   // conv, pool, flatten, FC (perf_stage_busy 비트 순서)
+const char *const STAGE_NAMES[NUM_PERF_STAGES] = {"conv", "pool", "flatten", "fc"};
+constexpr uint64_t FRAME_TIMEOUT = 200000;
+
+struct Options {
+    int frames = 16;
+    uint32_t seed = 1;
+    int gap = 0;               // 픽셀 사이 유휴 사이클 (카메라 속도 모사)
+    double clock_mhz = 100.0;
+    bool rom_weights = false;
+    QuantConfig quant;
+    Geometry geo;
+    std::vector<std::string> images;
+};
+
+struct Pending {
+    uint8_t tag;
+    uint64_t start_cycle;
+    FrameResult expect;
+};
+
+class Harness {
+public:
+    explicit Harness(VerilatedContext *ctx) : top_(new VCNN_TOP_Improved(ctx)) {}
+    ~Harness() {
+        top_->final();
+        delete top_;
+    }
+
+    VCNN_TOP_Improved *top() { return top_; }
+    uint64_t cycles() const { return cycles_; }
+
+    void reset(uint32_t quant_cfg, uint32_t geometry) {
+        top_->clk = 0;
+        top_->rst = 0;   // Active Low
+        top_->start_signal = 0;
+        top_->pixel_valid = 0;
+        top_->pixel_in = 0;
+        top_->i_wt_wr_en = 0;
+        top_->i_wt_wr_addr = 0;
+        top_->i_wt_wr_data = 0;
+        top_->i_wt_swap_req = 0;
+        top_->i_quant_cfg = quant_cfg;
+        top_->i_geometry = geometry;
+        top_->i_seq_ctrl = 0;
+        top_->i_seq_wr_en = 0;
+        top_->i_seq_wr_addr = 0;
+        top_->i_seq_wr_data = 0;
+        top_->eval();
+        for (int i = 0; i < 5; i++) tick();
+        top_->rst = 1;
+        for (int i = 0; i < 2; i++) tick();
+    }
+
+    // 입력은 상승 에지 직전에 설정, 출력은 에지 직후 샘플
+    void tick() {
+        top_->clk = 1;
+        top_->eval();
+        cycles_++;
+        sample();
+        top_->clk = 0;
+        top_->eval();
+    }
+
+    // 섀도 뱅크에 쓰고 다음 프레임 경계에서 교체
+    void load_weights(const Weights &w) {
+        for (int i = 0; i < 9; i++)
+            write_weight((1u << 16) | i, static_cast<uint8_t>(w.kernel[i / 3][i % 3]));
+        for (int n = 0; n < NUM_NEURONS; n++)
+            for (int k = 0; k < FC_MAX_INPUTS; k++)
+                write_weight((uint32_t(n) << 12) | k, static_cast<uint32_t>(w.fc[n][k]));
+        top_->i_wt_swap_req = 1;
+        tick();
+        top_->i_wt_swap_req = 0;
+        while (top_->o_wt_swap_busy) tick();
+    }
+
+    std::vector<uint32_t> busy_cnt = std::vector<uint32_t>(NUM_PERF_STAGES, 0);
+    std::vector<uint32_t> stall_cnt = std::vector<uint32_t>(NUM_PERF_STAGES, 0);
+
+    struct Result {
+        uint64_t cycle;
+        uint8_t tag;
+        int64_t lane, score;
+        uint64_t margin;
+        int cls;
+        uint32_t latency;
+        uint32_t fc_cycles;
+        int fc_nonzero;
+    };
+    std::deque<Result> results;
+
+private:
+    static int64_t sext48(uint64_t v) { return wrap_signed(static_cast<int64_t>(v), 48); }
+
+    void write_weight(uint32_t addr, uint32_t data) {
+        top_->i_wt_wr_en = 1;
+        top_->i_wt_wr_addr = addr;
+        top_->i_wt_wr_data = data;
+        tick();
+        top_->i_wt_wr_en = 0;
+    }
+
+    void sample() {
+        for (int s = 0; s < NUM_PERF_STAGES; s++) {
+            if ((top_->perf_stage_busy >> s) & 1) busy_cnt[s]++;
+            if ((top_->perf_stage_stall >> s) & 1) stall_cnt[s]++;
+        }
+        if (top_->final_result_valid) {
+            results.push_back({cycles_, static_cast<uint8_t>(top_->final_frame_tag), sext48(top_->final_lane_result),
+                               sext48(top_->final_class_score), top_->final_class_margin & ((1ULL << 48) - 1),
+                               static_cast<int>(top_->final_class_idx), top_->final_latency, top_->final_fc_cycles,
+                               static_cast<int>(top_->final_fc_nonzero)});
+        }
+    }
+
+    VCNN_TOP_Improved *top_;
+    uint64_t cycles_ = 0;
+};
+
+bool load_pgm(const std::string &path, const Geometry &g, std::vector<uint8_t> &img) {
+    std::ifstream f(path, std::ios::binary);
+    std::string magic;
+    int w, h, maxv;
+    if (!(f >> magic >> w >> h >> maxv) || magic != "P5" || w != g.width || h != g.height || maxv > 255) return false;
+    f.get();
+    img.resize(g.width * g.height);
+    return static_cast<bool>(f.read(reinterpret_cast<char *>(img.data()), img.size()));
+}
+
+// 합성 이미지: 랜덤 노이즈 위에 기울어진 차선 두 개 (conv/pool 값 범위를 고르게 사용)
+std::vector<uint8_t> synth_image(std::mt19937 &rng, const Geometry &g) {
+    std::vector<uint8_t> img(g.width * g.height);
+    std::uniform_int_distribution<int> noise(0, 40), pos(1, g.width - 2), slope(-2, 2), style(0, 3);
+    const int x0 = pos(rng), x1 = pos(rng), s = slope(rng), mode = style(rng);
+    for (int y = 0; y < g.height; y++) {
+        for (int x = 0; x < g.width; x++) {
+            int v = noise(rng);
+            int lx0 = x0 + s * y / 8, lx1 = x1 - s * y / 8;
+            if (x == lx0 || x == lx0 + 1 || x == lx1) v = 200 + noise(rng);
+            if (mode == 3) v = static_cast<int>(rng() & 0xFF);   // 완전 랜덤 (포화/경계 확인)
+            img[y * g.width + x] = static_cast<uint8_t>(v);
+        }
+    }
+    return img;
+}
+
+Weights random_weights(std::mt19937 &rng) {
+    Weights w;
+    std::uniform_int_distribution<int> k8(-128, 127), w22(-(1 << 21), (1 << 21) - 1);
+    for (auto &row : w.kernel)
+        for (auto &k : row) k = static_cast<int8_t>(k8(rng));
+    for (auto &n : w.fc)
+        for (auto &v : n) v = (QUANT_MODE == 2) ? k8(rng) : (QUANT_MODE == 1 ? k8(rng) * 97 : w22(rng));
+    return w;
+}
+
+bool parse_args(int argc, char **argv, Options &o) {
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        auto next = [&]() -> const char * { return (i + 1 < argc) ? argv[++i] : nullptr; };
+        const char *v = nullptr;
+        if (a == "--frames" && (v = next())) o.frames = std::atoi(v);
+        else if (a == "--seed" && (v = next())) o.seed = static_cast<uint32_t>(std::strtoul(v, nullptr, 0));
+        else if (a == "--gap" && (v = next())) o.gap = std::atoi(v);
+        else if (a == "--clock-mhz" && (v = next())) o.clock_mhz = std::atof(v);
+        else if (a == "--rom-weights") o.rom_weights = true;
+        else if (a == "--scale" && (v = next())) o.quant.scale = static_cast<uint16_t>(std::atoi(v));
+        else if (a == "--shift" && (v = next())) o.quant.shift = static_cast<uint8_t>(std::atoi(v));
+        else if (a == "--zp" && (v = next())) o.quant.zero_point = static_cast<int8_t>(std::atoi(v));
+        else if (a == "--width" && (v = next())) o.geo.width = std::atoi(v);
+        else if (a == "--height" && (v = next())) o.geo.height = std::atoi(v);
+        else if (a == "--stride-log2" && (v = next())) o.geo.stride_log2 = std::atoi(v);
+        else if (a == "--same") o.geo.same_pad = true;
+        else if (a.rfind("+verilator", 0) == 0) continue;
+        else if (a[0] != '-') o.images.push_back(a);
+        else return false;
+    }
+    // RTL이 범위를 제한하므로 모델과 어긋나지 않게 같은 범위만 허용
+    const bool geo_ok = o.geo.width >= 4 && o.geo.width <= IMG_W && o.geo.height >= 4 && o.geo.height <= IMG_H &&
+                        o.geo.stride_log2 >= 0 && o.geo.stride_log2 <= 2 && o.geo.fc_inputs() > 0;
+    return o.frames > 0 && o.gap >= 0 && o.clock_mhz > 0 && geo_ok;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    Options opt;
+    opt.quant.mode = QUANT_MODE;
+    if (QUANT_MODE != 0 && opt.quant.shift == 0) {
+        opt.quant.scale = 1;   // 기본: 하위 비트 반올림 시프트로 INT 범위에 맞춤
+        opt.quant.shift = (QUANT_MODE == 2) ? 10 : 4;
+    }
+    if (!parse_args(argc, argv, opt)) {
+        std::fprintf(stderr, "usage: %s [--frames N] [--seed S] [--gap G] [--clock-mhz F] [--rom-weights]\n"
+                             "          [--scale X --shift Y --zp Z] [--width W --height H --stride-log2 S --same]\n"
+                             "          [image.pgm ...]\n", argv[0]);
+        return 2;
+    }
+
+    auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
+    Harness h(ctx.get());
+    std::mt19937 rng(opt.seed);
+
+    // ===== 가중치 준비 =====
+    Weights w;
+    if (opt.rom_weights) {
+        if (!load_rom_weights("../Fully_Connected_Layer.sv", w)) {
+            std::fprintf(stderr, "✗ cannot read weight_ROM from ../Fully_Connected_Layer.sv\n");
+            return 2;
+        }
+    } else {
+        w = random_weights(rng);
+    }
+
+    h.reset(opt.quant.pack(), opt.geo.pack());
+    if (!opt.rom_weights) h.load_weights(w);
+
+    // ===== 입력 이미지 세트 =====
+    std::vector<std::vector<uint8_t>> images;
+    for (const auto &path : opt.images) {
+        std::vector<uint8_t> img;
+        if (!load_pgm(path, opt.geo, img)) {
+            std::fprintf(stderr, "✗ %s: expected binary PGM (P5) %dx%d\n", path.c_str(), opt.geo.width, opt.geo.height);
+            return 2;
+        }
+        images.push_back(std::move(img));
+    }
+    const int total = images.empty() ? opt.frames : static_cast<int>(images.size());
+
+    std::printf("=== CNN_TOP_Improved regression: %d frames, QUANT_MODE=%d, %s weights, gap=%d ===\n", total,
+                QUANT_MODE, opt.rom_weights ? "ROM" : "random", opt.gap);
+    std::printf("=== frame %dx%d, stride %d, %s padding, %d FC inputs ===\n", opt.geo.width, opt.geo.height,
+                1 << opt.geo.stride_log2, opt.geo.same_pad ? "same" : "valid", opt.geo.fc_inputs());
+
+    // ===== 프레임 스트리밍 =====
+    VCNN_TOP_Improved *top = h.top();
+    std::deque<Pending> pending;
+    std::vector<uint64_t> done_cycles;
+    std::vector<uint32_t> latencies;
+    uint64_t fc_cycle_sum = 0, fc_nonzero_sum = 0, fc_input_sum = 0;
+    uint8_t next_tag = 0;
+    int errors = 0, checked = 0;
+    const uint64_t bench_start = h.cycles();
+
+    auto drain = [&]() {
+        while (!h.results.empty()) {
+            Harness::Result r = h.results.front();
+            h.results.pop_front();
+            if (pending.empty() || pending.front().tag != r.tag) {
+                std::printf("✗ unexpected result tag %u at cycle %" PRIu64 "\n", r.tag, r.cycle);
+                errors++;
+                continue;
+            }
+            const Pending p = pending.front();
+            pending.pop_front();
+            const FrameResult &e = p.expect;
+            const uint64_t e_margin = static_cast<uint64_t>(e.class_margin);
+            checked++;
+            if (r.lane != e.lane_result || r.cls != e.class_idx || r.score != e.class_score || r.margin != e_margin) {
+                std::printf("✗ MISMATCH frame tag %u: lane %" PRId64 " (exp %" PRId64 "), class %d (exp %d), "
+                            "score %" PRId64 " (exp %" PRId64 "), margin %" PRIu64 " (exp %" PRIu64 ")\n",
+                            r.tag, r.lane, e.lane_result, r.cls, e.class_idx, r.score, e.class_score, r.margin,
+                            e_margin);
+                errors++;
+            }
+            const int e_issued = FC_ZERO_SKIP ? e.fc_nonzero : static_cast<int>(e.fc_in.size());
+            if (r.fc_nonzero != e_issued) {
+                std::printf("✗ frame tag %u: FC issued %d inputs (exp %d)\n", r.tag, r.fc_nonzero, e_issued);
+                errors++;
+            }
+            done_cycles.push_back(r.cycle);
+            latencies.push_back(r.latency);
+            fc_cycle_sum += r.fc_cycles;
+            fc_nonzero_sum += r.fc_nonzero;
+            fc_input_sum += e.fc_in.size();
+        }
+    };
+
+    for (int f = 0; f < total; f++) {
+        const std::vector<uint8_t> img = images.empty() ? synth_image(rng, opt.geo) : images[f];
+
+        uint64_t waited = 0;
+        while (!top->frame_ready) {
+            h.tick();
+            drain();
+            if (++waited > FRAME_TIMEOUT) {
+                std::printf("✗ TIMEOUT waiting for frame_ready (frame %d)\n", f);
+                return 1;
+            }
+        }
+
+        pending.push_back({next_tag++, h.cycles(), run_frame(img, w, opt.quant, opt.geo)});
+        top->start_signal = 1;
+        h.tick();
+        top->start_signal = 0;
+        drain();
+
+        for (int i = 0; i < opt.geo.width * opt.geo.height; i++) {
+            top->pixel_valid = 1;
+            top->pixel_in = img[i];
+            h.tick();
+            top->pixel_valid = 0;
+            for (int g = 0; g < opt.gap; g++) h.tick();
+            drain();
+        }
+    }
+
+    uint64_t waited = 0;
+    while (!pending.empty() && waited++ < FRAME_TIMEOUT) {
+        h.tick();
+        drain();
+    }
+    if (!pending.empty()) {
+        std::printf("✗ TIMEOUT: %zu frames without result\n", pending.size());
+        errors += static_cast<int>(pending.size());
+    }
+    if (top->timeout_error) {
+        std::printf("✗ watchdog timeout_error asserted\n");
+        errors++;
+    }
+
+    // ===== 벤치마크 보고 =====
+    const uint64_t elapsed = h.cycles() - bench_start;
+    if (!done_cycles.empty()) {
+        uint32_t lat_min = UINT32_MAX, lat_max = 0;
+        uint64_t lat_sum = 0;
+        for (uint32_t l : latencies) {
+            lat_min = std::min(lat_min, l);
+            lat_max = std::max(lat_max, l);
+            lat_sum += l;
+        }
+        // 정상 상태 간격: 첫 결과 이후 결과 간 평균 사이클 (파이프라인 채움 제외)
+        const double interval = done_cycles.size() > 1
+                                    ? double(done_cycles.back() - done_cycles.front()) / (done_cycles.size() - 1)
+                                    : double(elapsed);
+        std::printf("--- Cycles @ %.1f MHz ---\n", opt.clock_mhz);
+        std::printf("  total            : %" PRIu64 " cycles for %zu frames (%.1f cycles/frame)\n", elapsed,
+                    done_cycles.size(), double(elapsed) / done_cycles.size());
+        std::printf("  steady interval  : %.1f cycles/frame -> %.1f frames/s\n", interval,
+                    opt.clock_mhz * 1e6 / interval);
+        std::printf("  latency          : min %u / avg %.1f / max %u cycles (%.2f us avg)\n", lat_min,
+                    double(lat_sum) / latencies.size(), lat_max, double(lat_sum) / latencies.size() / opt.clock_mhz);
+        // 발행 입력 수 (zero skip 구성이면 0이 아닌 입력만), 8레인 기준 dense 비트 수 = ceil(입력 / 8)
+        std::printf("  fc (%s)  : %.1f cycles/frame, %.1f of %.1f inputs issued (dense %.1f beats)\n",
+                    FC_ZERO_SKIP ? "zero skip" : "dense    ",
+                    double(fc_cycle_sum) / done_cycles.size(), double(fc_nonzero_sum) / done_cycles.size(),
+                    double(fc_input_sum) / done_cycles.size(), double(fc_input_sum) / done_cycles.size() / 8.0);
+        std::printf("--- Per-stage cycles per frame (busy / stall) ---\n");
+        for (int s = 0; s < NUM_PERF_STAGES; s++)
+            std::printf("  %-8s : %8.1f / %8.1f\n", STAGE_NAMES[s], double(h.busy_cnt[s]) / done_cycles.size(),
+                        double(h.stall_cnt[s]) / done_cycles.size());
+    }
+
+    if (errors == 0 && checked == total)
+        std::printf("✓ TEST PASSED: %d frames bit-exact against golden model\n", checked);
+    else
+        std::printf("✗ TEST FAILED: %d errors, %d/%d frames checked\n", errors, checked, total);
+    return (errors == 0 && checked == total) ? 0 : 1;
+}
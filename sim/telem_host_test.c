@@ -0,0 +1,161 @@
+/* ===== 텔레메트리 호스트 시험 (보드 없이 gcc만으로 실행) =====
+ * Microblaze.c 전체를 스텁 HAL + 가상 시간 위에서 1초 동안 실행하고 UART 송신 바이트를 선로 속도로 수집:
+ *   바이너리 STREAM 명령 → 자율주행 'Y' → DRIVE 명령 → STATUS 명령 → CRC 오류 프레임 → STATUS
+ * 제어 주기마다 기록 한 개가 공백 / 버림 없이 도착하고, 명령이 ACK와 함께 반영되는지 확인 */
+#include <stdio.h>
+#include <string.h>
+
+#include "hal_host.h"
+#include "sched.h"
+#include "telem.h"
+
+int firmware_main(void);   // Microblaze.c main (-Dmain=firmware_main)
+
+#define RUN_MS        1000
+#define STREAM_AT_MS  10
+#define AUTO_AT_MS    50
+#define DRIVE_AT_MS   300
+#define STATUS_AT_MS  500
+#define CORRUPT_AT_MS 600
+#define STATUS2_AT_MS 700
+#define CONTROL_MS    20
+
+static const u32 ultra_base[3] = {
+    XPAR_ULTRASONIC_MYIP_V1_0_0_BASEADDR,   // 전방
+    XPAR_ULTRASONIC_MYIP_V1_0_1_BASEADDR,   // 오른쪽
+    XPAR_ULTRASONIC_MYIP_V1_0_2_BASEADDR,   // 왼쪽
+};
+
+static int error_count = 0;
+
+static void check(int ok, const char *name) {
+    printf("%s %s\n", ok ? "✓" : "✗", name);
+    if (!ok) error_count++;
+}
+
+/* ===== 송신 바이트 → 프레임 ===== */
+static TelemParser rx;
+static TelemRecord records[256];
+static int record_count = 0;
+static TelemStatus status[4];
+static int status_count = 0;
+static u8 acks[8][2];
+static int ack_count = 0;
+static u32 last_byte_us = 0;
+
+static void on_tx(u32 now_us, u8 byte) {
+    last_byte_us = now_us;
+    if (telem_parser_feed(&rx, byte) <= 0) return;
+    if (rx.type == TELEM_T_RECORD && rx.len == TELEM_RECORD_LEN && record_count < 256)
+        telem_record_unpack(&records[record_count++], rx.payload);
+    else if (rx.type == TELEM_T_STATUS && rx.len == TELEM_STATUS_LEN && status_count < 4)
+        telem_status_unpack(&status[status_count++], rx.payload);
+    else if (rx.type == TELEM_T_ACK && rx.len == 2 && ack_count < 8)
+        memcpy(acks[ack_count++], rx.payload, 2);
+}
+
+/* ===== 명령 주입 ===== */
+static void send_frame(u8 type, const u8 *payload, u8 len) {
+    u8 frame[TELEM_MAX_PAYLOAD + TELEM_OVERHEAD];
+    int n = telem_frame_encode(frame, type, payload, len);
+    hal_host_uart_send_bytes(frame, n);
+}
+
+static void ev_stream(void *arg) { (void)arg; u8 p[2] = {1, 1}; send_frame(TELEM_C_STREAM, p, 2); }
+static void ev_auto(void *arg)   { (void)arg; hal_host_uart_send("Y"); }
+static void ev_drive(void *arg)  { (void)arg; u8 p[2] = {40, (u8)(s8)-20}; send_frame(TELEM_C_DRIVE, p, 2); }
+static void ev_status(void *arg) { (void)arg; send_frame(TELEM_C_STATUS, NULL, 0); }
+
+static void ev_corrupt(void *arg) {
+    (void)arg;
+    u8 frame[TELEM_MAX_PAYLOAD + TELEM_OVERHEAD];
+    u8 p[1] = {'X'};
+    int n = telem_frame_encode(frame, TELEM_C_KEY, p, 1);
+    frame[n - 1] ^= 0x5A;   // CRC 손상 → 실행되면 정지해 버림
+    hal_host_uart_send_bytes(frame, n);
+}
+
+static void set_ultra(u32 base, u32 cm) {
+    hal_host_poke(base + 0x00, cm % 10);
+    hal_host_poke(base + 0x04, cm / 10);
+}
+
+static const TelemRecord *record_after(u32 t_us) {
+    for (int i = 0; i < record_count; i++)
+        if (records[i].t_us >= t_us) return &records[i];
+    return NULL;
+}
+
+int main(void) {
+    printf("=== Telemetry Host Test ===\n");
+    hal_host_reset();
+    hal_host_set_quiet(1);
+    hal_host_on_uart_tx(on_tx);
+    telem_parser_reset(&rx);
+    for (int i = 0; i < 3; i++) set_ultra(ultra_base[i], 90);
+
+    hal_host_at_ms(STREAM_AT_MS, ev_stream, NULL);
+    hal_host_at_ms(AUTO_AT_MS, ev_auto, NULL);
+    hal_host_at_ms(DRIVE_AT_MS, ev_drive, NULL);
+    hal_host_at_ms(STATUS_AT_MS, ev_status, NULL);
+    hal_host_at_ms(CORRUPT_AT_MS, ev_corrupt, NULL);
+    hal_host_at_ms(STATUS2_AT_MS, ev_status, NULL);
+    hal_host_run_for_ms(RUN_MS);
+
+    firmware_main();
+
+    // 1. 스트림 시작 후 제어 주기마다 기록 한 개, 번호 공백 / 링 버림 / CRC 오류 없음
+    int expect = (RUN_MS - STREAM_AT_MS) / CONTROL_MS;
+    printf("  %d records (expect ~%d), %u bad frames\n", record_count, expect, rx.errors);
+    check(record_count >= expect - 2 && record_count <= expect + 1, "one record per control period");
+    int seq_ok = 1, period_ok = 1, drops = 0;
+    u32 max_exec = 0;
+    for (int i = 0; i < record_count; i++) {
+        if (i > 0) {
+            s32 dt = (s32)(records[i].t_us - records[i - 1].t_us) - CONTROL_MS * 1000;
+            if (records[i].seq != (u16)(records[i - 1].seq + 1)) seq_ok = 0;
+            if (dt < -500 || dt > 500) period_ok = 0;   // 같은 틱의 앞 태스크만큼 시작 지터
+        }
+        if (records[i].exec_us > max_exec) max_exec = records[i].exec_us;
+        drops = records[i].drops;
+    }
+    check(seq_ok && records[0].seq == 0, "record sequence contiguous from 0");
+    check(period_ok, "records one control period apart (start jitter < 0.5 ms)");
+    check(drops == 0 && rx.errors == 0, "no ring drops or corrupted frames on the wire");
+    check(last_byte_us < RUN_MS * 1000, "ring drained at line rate within the run");
+
+    // 2. 기록 내용: 센서, 자율주행 모드, 수동 주행 명령 반영
+    const TelemRecord *a = record_after((AUTO_AT_MS + 2 * CONTROL_MS) * 1000);
+    check(a && a->ultra_cm[0] == 90 && a->ultra_cm[1] == 90 && a->ultra_cm[2] == 90, "ultrasonic readings in record");
+    check(a && (a->mode & 0x3) == 2 && (a->mode & 0x4) && a->speed > 0, "auto+CNN mode reported after 'Y'");
+    const TelemRecord *d = record_after((DRIVE_AT_MS + CONTROL_MS) * 1000);
+    check(d && (d->mode & 0x3) == 0 && d->speed == 40 && d->steer == -20, "binary DRIVE applied (speed 40, steer -20)");
+    const TelemRecord *c = record_after((CORRUPT_AT_MS + CONTROL_MS) * 1000);
+    check(c && c->speed == 40, "corrupted KEY 'X' frame not executed");
+    check(max_exec < 1000, "control step execution below one tick");
+
+    // 3. ACK / 상태 응답
+    int acks_ok = ack_count == 4;
+    static const u8 ack_cmds[4] = { TELEM_C_STREAM, TELEM_C_DRIVE, TELEM_C_STATUS, TELEM_C_STATUS };
+    for (int i = 0; i < ack_count && i < 4; i++)
+        if (acks[i][0] != ack_cmds[i] || acks[i][1] != TELEM_ACK_OK) acks_ok = 0;
+    check(acks_ok, "every valid command acknowledged OK, corrupted one silently dropped");
+    check(status_count == 2 && status[0].cmd_errors == 0 && status[1].cmd_errors == 1,
+          "STATUS response counts the rejected command frame");
+    check(status_count == 2 && status[1].telem_drops == 0 && status[1].telem_peak > 0 &&
+          status[1].telem_peak < TELEM_RING_SIZE, "status reports ring peak without drops");
+
+    // 4. 스케줄러: 텔레메트리가 기한을 깨지 않음
+    int over = 0, skip = 0;
+    for (int i = 0; i < sched_task_count(); i++) {
+        over += sched_task(i)->overruns;
+        skip += sched_task(i)->skips;
+    }
+    check(over == 0 && skip == 0, "no deadline overruns or skipped releases");
+
+    if (error_count == 0)
+        printf("✓ TEST PASSED\n");
+    else
+        printf("✗ TEST FAILED: %d checks\n", error_count);
+    return error_count == 0 ? 0 : 1;
+}
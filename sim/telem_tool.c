@@ -0,0 +1,236 @@
+/* ===== 텔레메트리 디코더 / 명령 프레임 생성 (Linux, 보드 UART 또는 캡처 파일) =====
+ *   ./telem_tool decode [/dev/ttyUSB1 | capture.bin]   : 기록 → CSV (stdout), 텍스트 / 공백 / 요약 → stderr
+ *   ./telem_tool drive <speed> <steer>                   : 명령 프레임을 stdout으로 (> /dev/ttyUSB1)
+ *   ./telem_tool key <c> | stream <on|off> [decim] | status
+ *   ./telem_tool fcwt <neuron> <index> <w0> [w1 ...]      : FC 가중치 (섀도 뱅크, 최대 15개)
+ *   ./telem_tool seqnet <first> <op,relu,ish,osh,w,h,ic,oc,base> ... : 시퀀서 레이어 (최대 6개)
+ *   ./telem_tool seqwt <base> <k0> [k1 ...]              : 시퀀서 conv 커널 메모리 (최대 15개)
+ *   ./telem_tool geometry <w> <h> [stride_log2] [same]   : 프레임 크기 (다음 프레임부터)
+ *   ./telem_tool preproc <fmt> <src_w> <x0> <y0> <roi_w> <roi_h> <dx> <dy> | preproc off
+ * tty 입력은 115200 8N1 raw로 설정. 입력이 없으면 stdin에서 읽음. */
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "telem.h"
+
+static int open_input(const char *path) {
+    if (!path || !strcmp(path, "-")) return STDIN_FILENO;
+    int fd = open(path, O_RDONLY | O_NOCTTY);
+    if (fd < 0) {
+        fprintf(stderr, "telem_tool: %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    if (isatty(fd)) {
+        struct termios t;
+        if (tcgetattr(fd, &t) == 0) {
+            cfmakeraw(&t);
+            cfsetispeed(&t, B115200);
+            cfsetospeed(&t, B115200);
+            t.c_cflag |= CLOCAL | CREAD;
+            t.c_cc[VMIN] = 1;
+            t.c_cc[VTIME] = 0;
+            tcsetattr(fd, TCSANOW, &t);
+        }
+    }
+    return fd;
+}
+
+/* ================= decode ================= */
+
+typedef struct {
+    u32 records, status, acks, text_bytes;
+    u32 seq_gaps;
+    int have_seq;
+    u16 next_seq;
+} DecodeStats;
+
+static void print_record(const TelemRecord *r) {
+    printf("%u,%u,%u,%u,%u,%d,%u,%u,%d,%u,%u,%u,%u,%u,%d,%d,%u,%u,%u,%u\n",
+           r->t_us, r->seq, r->ultra_cm[0], r->ultra_cm[1], r->ultra_cm[2],
+           r->cnn_steer, r->cnn_seq, r->cnn_age_us, r->cnn_class,
+           r->mode & 0x3, (r->mode >> 2) & 1, (r->mode >> 3) & 1, (r->mode >> 4) & 0x7,
+           r->flags, r->speed, r->steer, r->duty_l, r->duty_r, r->exec_us, r->drops);
+}
+
+static void print_status(const TelemStatus *s) {
+    fprintf(stderr, "[STATUS] cnn 0x%08x frames %u timeouts %u lost %u lat %u/%u cyc stale %u reused %u | "
+                    "telem drops %u peak %u B cmd_err %u\n",
+            s->cnn_status, s->cnn_frames, s->cnn_timeouts, s->cnn_seq_lost, s->cnn_lat_last_cyc,
+            s->cnn_lat_max_cyc, s->cnn_stale, s->cnn_reused, s->telem_drops, s->telem_peak, s->cmd_errors);
+}
+
+static void handle_frame(const TelemParser *p, DecodeStats *st) {
+    if (p->type == TELEM_T_RECORD && p->len == TELEM_RECORD_LEN) {
+        TelemRecord r;
+        telem_record_unpack(&r, p->payload);
+        if (st->have_seq && r.seq != st->next_seq) {
+            fprintf(stderr, "[GAP] seq %u → %u (%u records lost)\n", st->next_seq, r.seq,
+                    (u16)(r.seq - st->next_seq));
+            st->seq_gaps += (u16)(r.seq - st->next_seq);
+        }
+        st->have_seq = 1;
+        st->next_seq = r.seq + 1;
+        st->records++;
+        print_record(&r);
+    } else if (p->type == TELEM_T_STATUS && p->len == TELEM_STATUS_LEN) {
+        TelemStatus s;
+        telem_status_unpack(&s, p->payload);
+        st->status++;
+        print_status(&s);
+    } else if (p->type == TELEM_T_ACK && p->len == 2) {
+        st->acks++;
+        fprintf(stderr, "[ACK] cmd 0x%02x result %u\n", p->payload[0], p->payload[1]);
+    } else {
+        fprintf(stderr, "[?] type 0x%02x len %u\n", p->type, p->len);
+    }
+}
+
+static int cmd_decode(const char *path) {
+    int fd = open_input(path);
+    if (fd < 0) return 1;
+
+    TelemParser p;
+    DecodeStats st;
+    memset(&p, 0, sizeof(p));
+    memset(&st, 0, sizeof(st));
+    telem_parser_reset(&p);
+
+    printf("t_us,seq,front_cm,right_cm,left_cm,cnn_steer,cnn_seq,cnn_age_us,cnn_class,"
+           "auto_mode,cnn,kick,phase,flags,speed,steer,duty_l,duty_r,exec_us,drops\n");
+    u8 buf[256];
+    ssize_t n;
+    while ((n = read(fd, buf, sizeof(buf))) > 0) {
+        for (ssize_t i = 0; i < n; i++) {
+            int r = telem_parser_feed(&p, buf[i]);
+            if (r > 0) {
+                handle_frame(&p, &st);
+            } else if (r < 0) {
+                fputc(buf[i], stderr);   // 콘솔 텍스트 (xil_printf)
+                st.text_bytes++;
+            }
+        }
+        fflush(stdout);
+    }
+    if (fd != STDIN_FILENO) close(fd);
+
+    fprintf(stderr, "[SUMMARY] %u records, %u status, %u acks, %u lost (seq gaps), %u bad frames, %u text bytes\n",
+            st.records, st.status, st.acks, st.seq_gaps, p.errors, st.text_bytes);
+    return 0;
+}
+
+/* ================= 명령 프레임 ================= */
+
+static int write_frame(u8 type, const u8 *payload, u8 len) {
+    u8 frame[TELEM_MAX_PAYLOAD + TELEM_OVERHEAD];
+    int n = telem_frame_encode(frame, type, payload, len);
+    return fwrite(frame, 1, (size_t)n, stdout) == (size_t)n ? 0 : 1;
+}
+
+static int usage(void) {
+    fprintf(stderr, "usage: telem_tool decode [tty|file]\n"
+                    "       telem_tool drive <speed -100..100> <steer -80..80>\n"
+                    "       telem_tool key <c>\n"
+                    "       telem_tool stream <on|off> [decimation]\n"
+                    "       telem_tool status\n"
+                    "       telem_tool fcwt <neuron 0..4> <index> <w0> [w1 ... w14]\n"
+                    "       telem_tool seqnet <first> <op,relu,ish,osh,w,h,ic,oc,base> [... x6]\n"
+                    "       telem_tool seqwt <base> <k0> [k1 ... k14]\n"
+                    "       telem_tool geometry <width 4..32> <height 4..32> [stride_log2 0..2] [same 0|1]\n"
+                    "       telem_tool preproc <fmt 0..2> <src_w> <x0> <y0> <roi_w> <roi_h> <dx> <dy> | preproc off\n");
+    return 2;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) return usage();
+    const char *cmd = argv[1];
+
+    if (!strcmp(cmd, "decode")) return cmd_decode(argc > 2 ? argv[2] : NULL);
+
+    if (!strcmp(cmd, "drive") && argc == 4) {
+        int spd = atoi(argv[2]), st = atoi(argv[3]);
+        if (spd < -100 || spd > 100 || st < -80 || st > 80) return usage();
+        u8 p[2] = { (u8)(s8)spd, (u8)(s8)st };
+        return write_frame(TELEM_C_DRIVE, p, 2);
+    }
+    if (!strcmp(cmd, "key") && argc == 3 && argv[2][0]) {
+        u8 p[1] = { (u8)argv[2][0] };
+        return write_frame(TELEM_C_KEY, p, 1);
+    }
+    if (!strcmp(cmd, "stream") && (argc == 3 || argc == 4)) {
+        int decim = argc == 4 ? atoi(argv[3]) : 1;
+        if (decim < 1 || decim > 255) return usage();
+        u8 p[2] = { (u8)(strcmp(argv[2], "off") != 0), (u8)decim };
+        return write_frame(TELEM_C_STREAM, p, 2);
+    }
+    if (!strcmp(cmd, "status") && argc == 2) return write_frame(TELEM_C_STATUS, NULL, 0);
+    if (!strcmp(cmd, "fcwt") && argc >= 5 && argc - 4 <= (TELEM_MAX_PAYLOAD - 3) / 4) {
+        u8 p[TELEM_MAX_PAYLOAD];
+        int idx = atoi(argv[3]);
+        if (idx < 0 || idx > 0xFFFF) return usage();
+        p[0] = (u8)atoi(argv[2]);
+        p[1] = (u8)idx;
+        p[2] = (u8)(idx >> 8);
+        for (int i = 4; i < argc; i++) {
+            u32 w = (u32)strtol(argv[i], NULL, 0);
+            for (int b = 0; b < 4; b++) p[3 + 4 * (i - 4) + b] = (u8)(w >> (8 * b));
+        }
+        return write_frame(TELEM_C_FC_WT, p, (u8)(3 + 4 * (argc - 4)));
+    }
+    if (!strcmp(cmd, "seqnet") && argc >= 4 && argc - 3 <= (TELEM_MAX_PAYLOAD - 1) / 10) {
+        u8 p[TELEM_MAX_PAYLOAD];
+        p[0] = (u8)atoi(argv[2]);
+        for (int i = 3; i < argc; i++) {
+            unsigned f[9];
+            u8 *d = &p[1 + 10 * (i - 3)];
+            if (sscanf(argv[i], "%u,%u,%u,%u,%u,%u,%u,%u,%u", &f[0], &f[1], &f[2], &f[3], &f[4],
+                       &f[5], &f[6], &f[7], &f[8]) != 9 || f[8] > 0xFFFF) return usage();
+            for (int b = 0; b < 8; b++) d[b] = (u8)f[b];
+            d[8] = (u8)f[8];
+            d[9] = (u8)(f[8] >> 8);
+        }
+        return write_frame(TELEM_C_SEQ_NET, p, (u8)(1 + 10 * (argc - 3)));
+    }
+    if (!strcmp(cmd, "seqwt") && argc >= 4 && argc - 3 <= (TELEM_MAX_PAYLOAD - 2) / 4) {
+        u8 p[TELEM_MAX_PAYLOAD];
+        int base = atoi(argv[2]);
+        if (base < 0 || base > 0xFFFF) return usage();
+        p[0] = (u8)base;
+        p[1] = (u8)(base >> 8);
+        for (int i = 3; i < argc; i++) {
+            u32 w = (u32)strtol(argv[i], NULL, 0);
+            for (int b = 0; b < 4; b++) p[2 + 4 * (i - 3) + b] = (u8)(w >> (8 * b));
+        }
+        return write_frame(TELEM_C_SEQ_WT, p, (u8)(2 + 4 * (argc - 3)));
+    }
+    if (!strcmp(cmd, "geometry") && argc >= 4 && argc <= 6) {
+        int w = atoi(argv[2]), h = atoi(argv[3]);
+        int st = argc > 4 ? atoi(argv[4]) : 0;
+        if (w < 1 || w > 255 || h < 1 || h > 255 || st < 0 || st > 2) return usage();
+        u8 p[4] = { (u8)w, (u8)h, (u8)st, (u8)(argc > 5 && atoi(argv[5]) != 0) };
+        return write_frame(TELEM_C_GEOMETRY, p, 4);
+    }
+    if (!strcmp(cmd, "preproc") && (argc == 10 || (argc == 3 && !strcmp(argv[2], "off")))) {
+        u8 p[13] = { 0 };
+        if (argc == 10) {
+            int v[8];
+            for (int i = 0; i < 8; i++) v[i] = atoi(argv[2 + i]);
+            if (v[0] < 0 || v[0] > 2 || v[6] < 1 || v[6] > 255 || v[7] < 1 || v[7] > 255) return usage();
+            p[0] = (u8)v[0];
+            for (int i = 0; i < 5; i++) {
+                if (v[1 + i] < 0 || v[1 + i] > 0xFFFF) return usage();
+                p[1 + 2 * i] = (u8)v[1 + i];
+                p[2 + 2 * i] = (u8)(v[1 + i] >> 8);
+            }
+            p[11] = (u8)v[6];
+            p[12] = (u8)v[7];
+        }
+        return write_frame(TELEM_C_PREPROC, p, 13);
+    }
+
+    return usage();
+}
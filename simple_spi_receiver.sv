@@ -2,10 +2,12 @@ module CNN_System_Simple_SPI(
     input logic clk,
     input logic rst_n,
     
-    // SPI SLAVE - 라즈베리파이로부터 이미지 수신
+    // SPI SLAVE - 라즈베리파이로부터 이미지 수신 (SCLK 도메인 캡처, 쿼드 모드 시 io1~3도 데이터)
     input logic spi_slave_sclk,   
     input logic spi_slave_mosi,   
-    output logic spi_slave_miso,  
+    inout wire spi_slave_miso,    // io1: 1비트 모드 = 상태 바이트 출력, 쿼드 모드 = 데이터 입력
+    input logic spi_slave_io2,
+    input logic spi_slave_io3,
     input logic spi_slave_ss,     
     
     // SPI MASTER - 모터보드로 명령 전송  
@@ -27,15 +29,18 @@ module CNN_System_Simple_SPI(
     logic signed [47:0] cnn_result;
     
     // ===== SPI 관련 신호들 =====
-    logic [7:0] spi_rx_data;
-    logic spi_rx_valid;
+    logic rx_frame_start, rx_frame_done, rx_frame_ok;
+    logic rx_pixel_valid;
+    logic [7:0] rx_pixel_data;
+    logic spi_miso_out, spi_miso_oe;
+    logic cnn_frame_ready;
     logic [7:0] spi_tx_data;
     logic spi_tx_start, spi_tx_busy;
     
     // ===== 제어 신호들 =====
-    logic [31:0] pixel_count;
     logic [2:0] motor_command;
-    logic image_complete;
+    logic frame_ok;        // 수신 프레임 CRC 일치 (불량 프레임 결과는 모터로 보내지 않음)
+    logic result_seen;     // CRC 확인 전에 CNN 결과가 먼저 나온 경우
     
     // ===== 상태 머신 =====
     enum logic [2:0] {
@@ -46,17 +51,31 @@ module CNN_System_Simple_SPI(
         DONE       = 3'b100
     } current_state, next_state;
 
-    // ===== 간단한 SPI SLAVE 모듈 =====
-    simple_spi_slave spi_slave_inst (
+    // ===== SPI 프레임 수신기 (헤더 + CRC, 비동기 FIFO) =====
+    spi_frame_receiver #(
+        .FIFO_DEPTH(64)
+    ) spi_slave_inst (
         .clk(clk),
-        .rst_n(rst_n),
-        .spi_clk(spi_slave_sclk),
-        .spi_mosi(spi_slave_mosi),
-        .spi_miso(spi_slave_miso),
-        .spi_ss(spi_slave_ss),
-        .rx_data(spi_rx_data),
-        .rx_valid(spi_rx_valid)
+        .rst(rst_n),
+        .i_sclk(spi_slave_sclk),
+        .i_ss_n(spi_slave_ss),
+        .i_io({spi_slave_io3, spi_slave_io2, spi_slave_miso, spi_slave_mosi}),
+        .o_miso(spi_miso_out),
+        .o_miso_oe(spi_miso_oe),
+        .i_expected_len(16'd1024),   // 32x32 고정 (i_geometry 기본값)
+        .i_frame_ready(cnn_frame_ready && current_state == IDLE),   // 이전 결과 전송까지 FIFO에서 대기
+        .o_frame_start(rx_frame_start),
+        .o_pixel_valid(rx_pixel_valid),
+        .o_pixel_data(rx_pixel_data),
+        .o_frame_done(rx_frame_done),
+        .o_frame_ok(rx_frame_ok),
+        .o_seq(),
+        .o_frame_count(),
+        .o_error_count(),
+        .o_busy()
     );
+
+    assign spi_slave_miso = spi_miso_oe ? spi_miso_out : 1'bz;
     
     // ===== 간단한 SPI MASTER 모듈 =====
     simple_spi_master spi_master_inst (
@@ -80,7 +99,23 @@ module CNN_System_Simple_SPI(
         .pixel_in(cnn_pixel_data),
         .final_result_valid(cnn_result_valid),
         .final_lane_result(cnn_result),
-        .cnn_busy(cnn_busy)
+        .frame_ready(cnn_frame_ready),
+        .cnn_busy(cnn_busy),
+        // 가중치는 합성 시 초기값 사용 (런타임 로드 없음)
+        .i_wt_wr_en(1'b0),
+        .i_wt_wr_addr(17'd0),
+        .i_wt_wr_data(32'd0),
+        .i_wt_swap_req(1'b0),
+        .i_quant_cfg(32'h0000_0001),
+        .i_geometry(32'h0000_2020),
+        // 레이어 시퀀서 미사용 (고정 파이프라인)
+        .i_seq_ctrl(32'd0),
+        .i_seq_wr_en(1'b0),
+        .i_seq_wr_addr(17'd0),
+        .i_seq_wr_data(32'd0),
+        .o_seq_busy(),
+        .o_seq_error(),
+        .o_seq_layer()
     );
 
     // ===== 상태 전환 =====
@@ -88,13 +123,13 @@ module CNN_System_Simple_SPI(
         next_state = current_state;
         case (current_state)
             IDLE: begin
-                if (spi_rx_valid) next_state = RECEIVING;
+                if (rx_frame_start) next_state = RECEIVING;
             end
             RECEIVING: begin
-                if (image_complete) next_state = PROCESSING;
+                if (rx_frame_done) next_state = PROCESSING;
             end
             PROCESSING: begin
-                if (cnn_result_valid) next_state = SENDING;
+                if (cnn_result_valid || result_seen) next_state = frame_ok ? SENDING : DONE;
             end
             SENDING: begin
                 if (!spi_tx_busy) next_state = DONE;
@@ -113,48 +148,25 @@ module CNN_System_Simple_SPI(
         end
     end
     
-    // ===== 픽셀 데이터 처리 =====
+    // ===== 픽셀 데이터 처리 (수신기가 헤더/CRC를 처리하고 픽셀만 전달) =====
+    assign cnn_start = rx_frame_start;
+    assign cnn_pixel_valid = rx_pixel_valid;
+    assign cnn_pixel_data = rx_pixel_data;
+
     always_ff @(posedge clk or negedge rst_n) begin
         if (!rst_n) begin
-            pixel_count <= 0;
-            cnn_start <= 0;
-            cnn_pixel_valid <= 0;
-            cnn_pixel_data <= 0;
-            image_complete <= 0;
+            frame_ok <= 0;
+            result_seen <= 0;
         end else begin
             case (current_state)
                 IDLE: begin
-                    pixel_count <= 0;
-                    image_complete <= 0;
-                    cnn_start <= 0;
+                    result_seen <= 0;
                 end
-                
                 RECEIVING: begin
-                    if (spi_rx_valid) begin
-                        cnn_pixel_data <= spi_rx_data;
-                        cnn_pixel_valid <= 1;
-                        
-                        if (pixel_count == 0) begin
-                            cnn_start <= 1;
-                        end else begin
-                            cnn_start <= 0;
-                        end
-                        
-                        pixel_count <= pixel_count + 1;
-                        
-                        if (pixel_count >= 1023) begin // 32x32 = 1024
-                            image_complete <= 1;
-                        end
-                    end else begin
-                        cnn_pixel_valid <= 0;
-                        cnn_start <= 0;
-                    end
-                end
-                
-                default: begin
-                    cnn_pixel_valid <= 0;
-                    cnn_start <= 0;
+                    if (cnn_result_valid) result_seen <= 1;
+                    if (rx_frame_done) frame_ok <= rx_frame_ok;
                 end
+                default: ;
             endcase
         end
     end
@@ -167,7 +179,7 @@ module CNN_System_Simple_SPI(
             spi_tx_start <= 0;
         end else begin
             case (current_state)
-                PROCESSING: begin
+                RECEIVING, PROCESSING: begin
                     if (cnn_result_valid) begin
                         // 간단한 결과 분석
                         if (cnn_result > 0) begin
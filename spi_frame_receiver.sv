@@ -0,0 +1,295 @@
+`timescale 1ns/1ps
+// ===== SPI 프레임 수신기 (SCLK 도메인 캡처 + 비동기 FIFO + 프레임 파서) =====
+// 기존 SPI 슬레이브는 SCLK를 시스템 클럭으로 오버샘플링해서 링크 속도가 sysclk/4 이하로 제한됨
+// 여기서는 SCLK 자체로 비트를 받아 바이트 단위로 비동기 FIFO에 넣고, CNN 클럭에서 파싱
+//
+// 트랜잭션 (SPI 모드 0, SS 한 번 = 프레임 한 장):
+//   [명령 1바이트, 항상 1비트 모드] 0x05 = 상태만 읽기, 0x02 = 프레임 쓰기, 0x32 = 프레임 쓰기 (쿼드)
+//   [데이터] 0xA5 0x5A | seq | len_lo len_hi | 픽셀 len개 | crc_hi crc_lo
+//   - 쿼드 모드: 명령 뒤 데이터는 SCLK당 4비트 (io[3] = MSB, 상위 니블 먼저), io1은 입력으로 전환
+//   - CRC-16/CCITT-FALSE (다항식 0x1021, 초기값 0xFFFF), 범위 = seq부터 마지막 픽셀까지
+//   - 명령 바이트 동안 MISO로 상태 바이트 출력 (모든 트랜잭션이 상태를 돌려줌)
+// 동기 헤더를 찾을 때까지 바이트를 버리므로, 바이트가 빠진 프레임 뒤에도 다음 프레임에서 재동기
+// 프레임 도중 트랜잭션이 끝나면 남은 픽셀을 0으로 채워 CNN 프레임을 끝내고 불량으로 보고
+// 제약: SS 하강 → 첫 SCLK 상승까지 시스템 클럭 3주기 이상 (상태 바이트 고정 시간)
+module spi_frame_receiver #(
+	parameter FIFO_DEPTH = 64   // 바이트, 2의 거듭제곱
+)(
+	input logic clk,
+	input logic rst,   // Active Low (negedge)
+
+	// ===== SPI 슬레이브 핀 =====
+	input logic       i_sclk,
+	input logic       i_ss_n,
+	input logic [3:0] i_io,       // io0 = MOSI, 쿼드 모드에서 io1..3 추가
+	output logic      o_miso,     // io1 출력 (상태 바이트)
+	output logic      o_miso_oe,  // 1비트 모드에서만 구동
+
+	// ===== 설정 =====
+	input logic [15:0] i_expected_len,   // CNN 프레임 픽셀 수 (다르면 헤더 거부)
+
+	// ===== CNN 픽셀 인터페이스 =====
+	input logic        i_frame_ready,    // CNN이 새 프레임을 받을 수 있음 (아니면 FIFO에서 대기)
+	output logic       o_frame_start,
+	output logic       o_pixel_valid,
+	output logic [7:0] o_pixel_data,
+	output logic       o_frame_done,     // CRC 확인 또는 채우기 종료 펄스
+	output logic       o_frame_ok,       // o_frame_done과 함께: 1 = CRC 일치
+
+	// ===== 상태 =====
+	output logic [7:0]  o_seq,           // 마지막 정상 프레임 번호
+	output logic [15:0] o_frame_count,   // 정상 프레임 수
+	output logic [15:0] o_error_count,   // CRC 불일치 / 잘린 프레임 / 헤더 거부 수
+	output logic        o_busy           // 프레임 수신 중
+);
+	localparam CMD_STATUS     = 8'h05;
+	localparam CMD_WRITE      = 8'h02;
+	localparam CMD_WRITE_QUAD = 8'h32;
+	localparam SYNC0 = 8'hA5;
+	localparam SYNC1 = 8'h5A;
+	localparam AW = $clog2(FIFO_DEPTH);
+
+	// ===== SCLK 도메인: 명령 + 데이터 비트 수집 (SS 비활성 = 비동기 리셋) =====
+	logic [2:0] bit_cnt;
+	logic [7:0] shift_reg;
+	logic       cmd_done, write_cmd, quad;
+	logic       first_byte;
+	logic [7:0] cmd_byte, rx_byte;
+	logic       byte_done;
+
+	assign cmd_byte = {shift_reg[6:0], i_io[0]};
+	assign rx_byte  = quad ? {shift_reg[3:0], i_io} : {shift_reg[6:0], i_io[0]};
+	assign byte_done = !i_ss_n && cmd_done && write_cmd && (quad ? bit_cnt[0] : (bit_cnt == 3'd7));
+
+	always_ff @(posedge i_sclk or posedge i_ss_n) begin
+		if(i_ss_n) begin
+			bit_cnt <= 3'd0;
+			shift_reg <= 8'h00;
+			cmd_done <= 1'b0;
+			write_cmd <= 1'b0;
+			quad <= 1'b0;
+			first_byte <= 1'b1;
+		end else if(!cmd_done) begin
+			shift_reg <= cmd_byte;
+			bit_cnt <= bit_cnt + 3'd1;
+			if(bit_cnt == 3'd7) begin
+				cmd_done <= 1'b1;
+				write_cmd <= (cmd_byte == CMD_WRITE) || (cmd_byte == CMD_WRITE_QUAD);
+				quad <= (cmd_byte == CMD_WRITE_QUAD);
+			end
+		end else begin
+			shift_reg <= quad ? {shift_reg[3:0], i_io} : cmd_byte;
+			bit_cnt <= quad ? {2'b00, ~bit_cnt[0]} : bit_cnt + 3'd1;
+			if(byte_done) first_byte <= 1'b0;
+		end
+	end
+
+	// MISO: 하강 엣지에서 다음 비트 (마스터는 상승 엣지에서 샘플), 첫 비트는 SS 하강 즉시
+	logic [2:0] tx_bit;
+	logic [7:0] status_hold;
+
+	always_ff @(negedge i_sclk or posedge i_ss_n) begin
+		if(i_ss_n) tx_bit <= 3'd0;
+		else       tx_bit <= tx_bit + 3'd1;
+	end
+
+	assign o_miso = status_hold[3'd7 - tx_bit];
+	assign o_miso_oe = !i_ss_n && !quad;
+
+	// ===== SCLK → CNN 클럭 비동기 FIFO: {트랜잭션 첫 바이트, 데이터} =====
+	logic       fifo_rd_en, fifo_empty;
+	logic [8:0] fifo_rd_data;
+	logic [AW:0] fifo_level;
+	logic       rd_sof;
+	logic [7:0] rd_byte;
+
+	async_fifo #(.WIDTH(9), .DEPTH(FIFO_DEPTH)) u_fifo (
+		.wr_clk(i_sclk),
+		.wr_rst(rst),
+		.wr_en(byte_done),
+		.wr_data({first_byte, rx_byte}),
+		.full(),              // 가득 차면 바이트 유실 → CRC 불일치로 검출
+		.wr_level(),
+		.rd_clk(clk),
+		.rd_rst(rst),
+		.rd_en(fifo_rd_en),
+		.rd_data(fifo_rd_data),
+		.empty(fifo_empty),
+		.rd_level(fifo_level)
+	);
+
+	assign {rd_sof, rd_byte} = fifo_rd_data;
+
+	// ===== CNN 클럭: SS 동기화 + 상태 바이트 =====
+	(* ASYNC_REG = "TRUE" *) logic ss_d1, ss_d2;
+	logic [3:0] idle_cnt;   // SS 비활성 + FIFO 빈 사이클 (포인터 동기화 지연 흡수)
+	logic       last_bad;
+
+	enum logic [3:0] {
+		P_HUNT0, P_HUNT1, P_SEQ, P_LEN0, P_LEN1, P_WAIT, P_PAYLOAD, P_CRC0, P_CRC1, P_PAD
+	} state;
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			ss_d1 <= 1'b1;
+			ss_d2 <= 1'b1;
+			status_hold <= 8'h00;
+		end else begin
+			ss_d1 <= i_ss_n;
+			ss_d2 <= ss_d1;
+			// 트랜잭션 중에는 고정 (SCLK 도메인이 읽는 동안 변하지 않음)
+			if(ss_d2)
+				status_hold <= {(state == P_HUNT0) && i_frame_ready && (fifo_level < FIFO_DEPTH / 2),   // [7] ready
+				                o_busy,                                                                 // [6] busy
+				                last_bad,                                                               // [5] 마지막 프레임 불량
+				                (fifo_level >= FIFO_DEPTH / 2),                                         // [4] FIFO 절반 이상
+				                o_seq[3:0]};                                                            // [3:0] 마지막 seq
+		end
+	end
+
+	// ===== CRC-16/CCITT-FALSE (바이트 단위) =====
+	function automatic logic [15:0] crc16_update(input logic [15:0] crc, input logic [7:0] data);
+		logic [15:0] c;
+		c = crc ^ {data, 8'h00};
+		for (int i = 0; i < 8; i++) c = c[15] ? ((c << 1) ^ 16'h1021) : (c << 1);
+		return c;
+	endfunction
+
+	// ===== 프레임 파서 =====
+	logic [15:0] crc, frame_len, pix_cnt;
+	logic [7:0]  frame_seq, crc_hi;
+	logic        fifo_valid;
+
+	assign fifo_valid = !fifo_empty;
+	// 대기/채우기 중에는 FIFO를 멈춤, 새 트랜잭션 첫 바이트는 헌트 상태에서만 소비
+	assign fifo_rd_en = fifo_valid && (state != P_WAIT) && (state != P_PAD) &&
+	                    (!rd_sof || state == P_HUNT0 || state == P_HUNT1);
+	assign o_busy = (state == P_WAIT) || (state == P_PAYLOAD) || (state == P_CRC0) ||
+	                (state == P_CRC1) || (state == P_PAD);
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			state <= P_HUNT0;
+			crc <= 16'hFFFF;
+			frame_len <= 16'd0;
+			pix_cnt <= 16'd0;
+			frame_seq <= 8'h00;
+			crc_hi <= 8'h00;
+			idle_cnt <= 4'd0;
+			last_bad <= 1'b0;
+			o_frame_start <= 1'b0;
+			o_pixel_valid <= 1'b0;
+			o_pixel_data <= 8'h00;
+			o_frame_done <= 1'b0;
+			o_frame_ok <= 1'b0;
+			o_seq <= 8'h00;
+			o_frame_count <= 16'd0;
+			o_error_count <= 16'd0;
+		end else begin
+			o_frame_start <= 1'b0;
+			o_pixel_valid <= 1'b0;
+			o_frame_done <= 1'b0;
+			o_frame_ok <= 1'b0;
+
+			if(ss_d2 && !fifo_valid) idle_cnt <= (idle_cnt == 4'hF) ? idle_cnt : idle_cnt + 4'd1;
+			else                     idle_cnt <= 4'd0;
+
+			case(state)
+				P_HUNT0: begin
+					if(fifo_valid && rd_byte == SYNC0) state <= P_HUNT1;
+				end
+
+				P_HUNT1: begin
+					if(fifo_valid) begin
+						crc <= 16'hFFFF;
+						state <= (rd_byte == SYNC1) ? P_SEQ : (rd_byte == SYNC0) ? P_HUNT1 : P_HUNT0;
+					end
+				end
+
+				P_SEQ, P_LEN0, P_LEN1: begin
+					if(fifo_valid && rd_sof) begin
+						state <= P_HUNT0;   // 헤더 도중 새 트랜잭션 → 버리고 다시 찾기
+					end else if(fifo_valid) begin
+						crc <= crc16_update(crc, rd_byte);
+						if(state == P_SEQ) begin
+							frame_seq <= rd_byte;
+							state <= P_LEN0;
+						end else if(state == P_LEN0) begin
+							frame_len[7:0] <= rd_byte;
+							state <= P_LEN1;
+						end else if({rd_byte, frame_len[7:0]} == i_expected_len && i_expected_len != 16'd0) begin
+							frame_len[15:8] <= rd_byte;
+							state <= P_WAIT;
+						end else begin
+							o_error_count <= o_error_count + 16'd1;   // 크기가 다른 프레임은 받지 않음
+							last_bad <= 1'b1;
+							state <= P_HUNT0;
+						end
+					end
+				end
+
+				P_WAIT: begin
+					// CNN이 준비될 때까지 FIFO에 쌓아 둠 → 상태 바이트 busy로 호스트가 속도 조절
+					if(i_frame_ready) begin
+						o_frame_start <= 1'b1;
+						pix_cnt <= 16'd0;
+						state <= P_PAYLOAD;
+					end
+				end
+
+				P_PAYLOAD: begin
+					if((fifo_valid && rd_sof) || idle_cnt == 4'hF) begin
+						state <= P_PAD;   // 트랜잭션이 끊김 → 남은 픽셀 0으로 채움
+					end else if(fifo_valid) begin
+						crc <= crc16_update(crc, rd_byte);
+						o_pixel_valid <= 1'b1;
+						o_pixel_data <= rd_byte;
+						pix_cnt <= pix_cnt + 16'd1;
+						if(pix_cnt == frame_len - 16'd1) state <= P_CRC0;
+					end
+				end
+
+				P_PAD: begin
+					o_pixel_valid <= 1'b1;
+					o_pixel_data <= 8'h00;
+					pix_cnt <= pix_cnt + 16'd1;
+					if(pix_cnt == frame_len - 16'd1) begin
+						o_frame_done <= 1'b1;
+						o_error_count <= o_error_count + 16'd1;
+						last_bad <= 1'b1;
+						state <= P_HUNT0;
+					end
+				end
+
+				P_CRC0, P_CRC1: begin
+					if((fifo_valid && rd_sof) || idle_cnt == 4'hF) begin
+						o_frame_done <= 1'b1;   // 픽셀은 모두 받았지만 CRC 없음 → 불량
+						o_error_count <= o_error_count + 16'd1;
+						last_bad <= 1'b1;
+						state <= P_HUNT0;
+					end else if(fifo_valid) begin
+						if(state == P_CRC0) begin
+							crc_hi <= rd_byte;
+							state <= P_CRC1;
+						end else begin
+							o_frame_done <= 1'b1;
+							if({crc_hi, rd_byte} == crc) begin
+								o_frame_ok <= 1'b1;
+								o_seq <= frame_seq;
+								o_frame_count <= o_frame_count + 16'd1;
+								last_bad <= 1'b0;
+							end else begin
+								o_error_count <= o_error_count + 16'd1;
+								last_bad <= 1'b1;
+							end
+							state <= P_HUNT0;
+						end
+					end
+				end
+
+				default: state <= P_HUNT0;
+			endcase
+		end
+	end
+
+endmodule
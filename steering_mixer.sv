@@ -0,0 +1,149 @@
+`timescale 1ns/1ps
+// ===== 조향 → 좌/우 듀티 변환 (펌웨어 cnn_apply_steering_logic + compute_lr_duty와 동일 규칙) =====
+// 1단: 클래스 보정 (좌 +3, 우 -3, 시작/끝 /2 (0 방향 절삭), 직진 그대로)
+//      → ±i_steer_max 클램프 (최대 100) + 갱신당 변화량 ±i_rate 제한 (0이면 제한 없음)
+// 2단: s = steer * STEER_SIGN, L = base*(100+s), R = base*(100-s)
+// 3단: /100 (곱셈 역수: (p*5243)>>19, p <= 40000에서 정확) + DUTY_MAX 클램프
+// 4단: 최소 구동 듀티 (큰 쪽 MIN_MOVE, 작은 쪽 MIN_TURN, 0은 유지)
+// i_valid 후 4클럭에 o_valid
+module steering_mixer #(
+	parameter integer STEER_SIGN = -1,
+	parameter integer DUTY_MAX   = 100,
+	parameter integer MIN_MOVE   = 30,
+	parameter integer MIN_TURN   = 14
+)(
+	input logic clk,
+	input logic rst,   // Active Low
+
+	input logic i_clear,                     // 이전 조향 0으로 (변화량 제한 기준)
+	input logic [7:0] i_base,                // 기본 듀티 (%)
+	input logic [7:0] i_steer_max,
+	input logic [7:0] i_rate,
+
+	input logic i_valid,
+	input logic signed [15:0] i_steer,
+	input logic [1:0] i_class,               // 같은 결과의 패턴 클래스 (0 직진, 1 좌, 2 우, 3 시작/끝), i_valid와 함께 유효
+
+	output logic o_valid,
+	output logic signed [7:0] o_steer,       // 제한 후 조향 (상태 표시용)
+	output logic [6:0] o_duty_l,
+	output logic [6:0] o_duty_r
+);
+
+	// ===== 1단: 클래스 보정 + 클램프 + 변화량 제한 =====
+	logic signed [15:0] st_max;
+	logic signed [15:0] st_class;
+	logic signed [15:0] st_clamped;
+	logic signed [15:0] st_prev;
+	logic signed [15:0] st_delta;
+	logic signed [15:0] st_rate;
+	logic signed [15:0] st_next;
+
+	assign st_max     = (i_steer_max > 8'd100) ? 16'sd100 : $signed({8'd0, i_steer_max});
+	// 보정 뒤 클램프는 펌웨어의 ±CNN_STEER_MAX 클램프와 같음 (i_steer_max = CNN_STEER_MAX)
+	always_comb begin
+		case(i_class)
+			2'd1:    st_class = i_steer + 16'sd3;
+			2'd2:    st_class = i_steer - 16'sd3;
+			2'd3:    st_class = (i_steer + $signed({15'd0, i_steer[15]})) >>> 1;
+			default: st_class = i_steer;
+		endcase
+	end
+
+	assign st_clamped = (st_class > st_max) ? st_max : (st_class < -st_max) ? -st_max : st_class;
+	assign st_delta   = st_clamped - st_prev;
+	assign st_rate    = $signed({8'd0, i_rate});
+	assign st_next    = (i_rate == 8'd0)       ? st_clamped :
+	                    (st_delta > st_rate)   ? st_prev + st_rate :
+	                    (st_delta < -st_rate)  ? st_prev - st_rate : st_clamped;
+
+	logic v1;
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			v1 <= 1'b0;
+			st_prev <= '0;
+		end else if(i_clear) begin
+			v1 <= 1'b0;
+			st_prev <= '0;
+		end else begin
+			v1 <= i_valid;
+			if(i_valid) st_prev <= st_next;
+		end
+	end
+
+	// ===== 2단: 좌/우 곱 =====
+	logic [6:0] base_c;
+	logic signed [8:0] s1;
+	logic signed [8:0] kl, kr;               // 100±s: 0~200
+	logic v2;
+	logic [14:0] pl2, pr2;                   // base*(100±s) <= 100*200
+
+	assign base_c = (i_base > 8'd100) ? 7'd100 : i_base[6:0];
+	assign s1 = (STEER_SIGN < 0) ? -st_prev[8:0] : st_prev[8:0];
+	assign kl = 9'sd100 + s1;
+	assign kr = 9'sd100 - s1;
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			v2 <= 1'b0;
+			pl2 <= '0;
+			pr2 <= '0;
+		end else begin
+			v2 <= v1;
+			if(v1) begin
+				pl2 <= base_c * kl[7:0];
+				pr2 <= base_c * kr[7:0];
+			end
+		end
+	end
+
+	// ===== 3단: /100 + 상한 =====
+	logic v3;
+	logic [7:0] l3, r3;
+	logic [28:0] pl_recip, pr_recip;
+
+	assign pl_recip = pl2 * 14'd5243;
+	assign pr_recip = pr2 * 14'd5243;
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			v3 <= 1'b0;
+			l3 <= '0;
+			r3 <= '0;
+		end else begin
+			v3 <= v2;
+			if(v2) begin
+				l3 <= (pl_recip[28:19] > DUTY_MAX) ? 8'(DUTY_MAX) : pl_recip[26:19];
+				r3 <= (pr_recip[28:19] > DUTY_MAX) ? 8'(DUTY_MAX) : pr_recip[26:19];
+			end
+		end
+	end
+
+	// ===== 4단: 최소 구동 듀티 =====
+	function automatic [7:0] lift(input [7:0] d, input [7:0] min_d);
+		lift = (d != 0 && d < min_d) ? min_d : d;
+	endfunction
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			o_valid <= 1'b0;
+			o_steer <= '0;
+			o_duty_l <= '0;
+			o_duty_r <= '0;
+		end else begin
+			o_valid <= v3;
+			if(v3) begin
+				o_steer <= st_prev[7:0];
+				if(l3 >= r3) begin
+					o_duty_l <= 7'(lift(l3, MIN_MOVE));
+					o_duty_r <= 7'(lift(r3, MIN_TURN));
+				end else begin
+					o_duty_r <= 7'(lift(r3, MIN_MOVE));
+					o_duty_l <= 7'(lift(l3, MIN_TURN));
+				end
+			end
+		end
+	end
+
+endmodule
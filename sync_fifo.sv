@@ -0,0 +1,47 @@
+`timescale 1ns/1ps
+module sync_fifo #(
+	parameter WIDTH = 32,
+	parameter DEPTH = 256   // 2의 거듭제곱
+)(
+	input logic clk,
+	input logic rst,   // Active Low (negedge)
+
+	input logic wr_en,
+	input logic [WIDTH-1:0] wr_data,
+	output logic full,
+
+	input logic rd_en,
+	output logic [WIDTH-1:0] rd_data,   // First-Word-Fall-Through: empty가 아니면 바로 유효
+	output logic empty,
+
+	output logic [$clog2(DEPTH):0] level
+);
+	localparam AW = $clog2(DEPTH);
+
+	(* ram_style = "distributed" *) logic [WIDTH-1:0] mem [0:DEPTH-1];
+	logic [AW:0] wr_ptr, rd_ptr;
+
+	logic do_write, do_read;
+	assign do_write = wr_en && !full;
+	assign do_read  = rd_en && !empty;
+
+	always_ff @(posedge clk) begin
+		if(do_write) mem[wr_ptr[AW-1:0]] <= wr_data;
+	end
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			wr_ptr <= '0;
+			rd_ptr <= '0;
+		end else begin
+			if(do_write) wr_ptr <= wr_ptr + 1'b1;
+			if(do_read)  rd_ptr <= rd_ptr + 1'b1;
+		end
+	end
+
+	assign rd_data = mem[rd_ptr[AW-1:0]];
+	assign level = wr_ptr - rd_ptr;
+	assign empty = (wr_ptr == rd_ptr);
+	assign full  = (wr_ptr[AW] != rd_ptr[AW]) && (wr_ptr[AW-1:0] == rd_ptr[AW-1:0]);
+
+endmodule
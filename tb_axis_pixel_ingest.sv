@@ -0,0 +1,87 @@
+`timescale 1ns/1ps
+module tb_axis_pixel_ingest;
+
+    // 1. DUT 신호 선언
+    logic clk;
+    logic rst;
+    logic i_enable;
+    logic [31:0] s_axis_tdata;
+    logic [3:0]  s_axis_tkeep;
+    logic        s_axis_tlast;
+    logic        s_axis_tvalid;
+    logic        s_axis_tready;
+    logic        i_frame_ready;
+    logic        o_frame_start;
+    logic        o_pixel_valid;
+    logic [7:0]  o_pixel_data;
+    logic        o_frame_done;
+    logic [8:0]  o_fifo_level;
+    logic [15:0] o_frame_count;
+    logic        o_busy;
+    logic        o_stall;
+
+    localparam TOTAL_PIXELS = 32 * 32;
+    localparam TOTAL_BEATS  = TOTAL_PIXELS / 4;
+
+    axis_pixel_ingest #(.FIFO_DEPTH(256)) dut (.*);
+
+    // 2. 클럭 생성
+    initial clk = 0;
+    always #5 clk = ~clk;
+
+    integer pixel_count = 0;
+    integer error_count = 0;
+    integer beats_sent = 0;
+
+    // 3. 테스트 시나리오: 한 프레임을 한 클럭에 한 비트씩 버스트 전송
+    initial begin
+        $display("--- AXI4-Stream Pixel Ingest Test START ---");
+
+        rst = 0;   // Active Low
+        i_enable = 1;
+        i_frame_ready = 1;
+        s_axis_tdata = 0;
+        s_axis_tkeep = 4'hF;
+        s_axis_tlast = 0;
+        s_axis_tvalid = 0;
+        #20;
+        rst = 1;
+        @(posedge clk);
+
+        while (beats_sent < TOTAL_BEATS) begin
+            s_axis_tvalid <= 1;
+            s_axis_tdata  <= {8'(beats_sent*4+3), 8'(beats_sent*4+2), 8'(beats_sent*4+1), 8'(beats_sent*4)};
+            s_axis_tlast  <= (beats_sent == TOTAL_BEATS - 1);
+            @(posedge clk);
+            if (s_axis_tready) beats_sent++;
+        end
+        s_axis_tvalid <= 0;
+        s_axis_tlast  <= 0;
+        $display("Burst complete: %0d beats accepted", beats_sent);
+
+        wait(o_frame_done);
+        @(posedge clk);
+
+        if (pixel_count != TOTAL_PIXELS) begin
+            $display("? TEST FAILED: pixel count %0d (expected %0d)", pixel_count, TOTAL_PIXELS);
+        end else if (error_count == 0) begin
+            $display("? TEST PASSED: %0d pixels in order, frame_count = %0d", pixel_count, o_frame_count);
+        end else begin
+            $display("? TEST FAILED: %0d pixel mismatches", error_count);
+        end
+        $finish;
+    end
+
+    // 4. 출력 픽셀 순서 확인
+    always @(posedge clk) begin
+        if (o_frame_start) $display("Time=%0t, frame start pulse", $time);
+        if (o_pixel_valid) begin
+            if (o_pixel_data !== 8'(pixel_count)) begin
+                $display("? MISMATCH pixel[%0d]: got %0d", pixel_count, o_pixel_data);
+                error_count++;
+            end
+            pixel_count++;
+        end
+    end
+
+endmodule
@@ -0,0 +1,213 @@
+`timescale 1ns/1ps
+module tb_cnn_core_cdc;
+
+    // 1. DUT 신호 선언: 코어 클럭 도메인 CNN vs 버스 클럭에서 바로 돌린 기준 CNN (같은 입력)
+    localparam W = 8, H = 8;
+    localparam N = W * H;
+    localparam GEO = {13'd0, 1'b0, 2'd0, 8'(H), 8'(W)};
+
+    logic bus_clk, core_clk;
+    logic rst;
+    logic start, pixel_valid;
+    logic [7:0] pixel;
+    logic wt_wr_en, wt_swap;
+    logic [16:0] wt_addr;
+    logic [31:0] wt_data;
+
+    logic d_valid, r_valid;
+    logic signed [47:0] d_result, r_result, d_score, r_score;
+    logic [47:0] d_margin, r_margin;
+    logic [1:0] d_class, r_class;
+    logic [7:0] d_tag, r_tag;
+    logic [31:0] d_latency, r_latency, d_fc_cycles, r_fc_cycles;
+    logic [15:0] d_fc_nz, r_fc_nz;
+    logic d_ready, r_ready, d_busy, r_busy;
+    logic d_timeout, r_timeout, d_bank, r_bank, d_swap_busy, r_swap_busy;
+    logic [3:0] d_stage_busy, d_stage_stall, r_stage_busy, r_stage_stall;
+    logic [2:0] d_ovf;
+
+    cnn_core_cdc #(
+        .CORE_RETIME(1)
+    ) dut (
+        .bus_clk(bus_clk), .bus_rst(rst),
+        .i_start(start), .i_pixel_valid(pixel_valid), .i_pixel_in(pixel),
+        .i_quant_cfg(32'd0), .i_geometry(GEO), .i_seq_ctrl(32'd0),
+        .i_wt_wr_en(wt_wr_en), .i_wt_wr_addr(wt_addr), .i_wt_wr_data(wt_data), .i_wt_swap_req(wt_swap),
+        .i_seq_wr_en(1'b0), .i_seq_wr_addr(17'd0), .i_seq_wr_data(32'd0),
+        .o_result_valid(d_valid), .o_lane_result(d_result), .o_class_idx(d_class),
+        .o_class_score(d_score), .o_class_margin(d_margin), .o_frame_tag(d_tag),
+        .o_latency(d_latency), .o_fc_cycles(d_fc_cycles), .o_fc_nonzero(d_fc_nz),
+        .o_frame_ready(d_ready), .o_busy(d_busy),
+        .o_stage_busy(d_stage_busy), .o_stage_stall(d_stage_stall),
+        .o_timeout(d_timeout), .o_wt_active_bank(d_bank), .o_wt_swap_busy(d_swap_busy),
+        .o_seq_busy(), .o_seq_error(), .o_seq_layer(), .o_fifo_overflow(d_ovf),
+        .core_clk(core_clk)
+    );
+
+    CNN_TOP_Improved ref_cnn (
+        .clk(bus_clk), .rst(rst),
+        .start_signal(start), .pixel_valid(pixel_valid), .pixel_in(pixel),
+        .final_result_valid(r_valid), .final_lane_result(r_result), .final_class_idx(r_class),
+        .final_class_score(r_score), .final_class_margin(r_margin), .final_frame_tag(r_tag),
+        .frame_ready(r_ready), .cnn_busy(r_busy),
+        .perf_stage_busy(r_stage_busy), .perf_stage_stall(r_stage_stall),
+        .final_latency(r_latency), .final_fc_cycles(r_fc_cycles), .final_fc_nonzero(r_fc_nz),
+        .timeout_error(r_timeout),
+        .i_wt_wr_en(wt_wr_en), .i_wt_wr_addr(wt_addr), .i_wt_wr_data(wt_data), .i_wt_swap_req(wt_swap),
+        .o_wt_active_bank(r_bank), .o_wt_swap_busy(r_swap_busy),
+        .i_quant_cfg(32'd0), .i_geometry(GEO),
+        .i_seq_ctrl(32'd0), .i_seq_wr_en(1'b0), .i_seq_wr_addr(17'd0), .i_seq_wr_data(32'd0),
+        .o_seq_busy(), .o_seq_error(), .o_seq_layer()
+    );
+
+    // 2. 클럭 생성: 버스 100MHz, 코어 약 270MHz (서로 무관한 주기)
+    initial bus_clk = 0;
+    always #5 bus_clk = ~bus_clk;
+    initial core_clk = 0;
+    always #1.85 core_clk = ~core_clk;
+
+    // 3. 결과 수집 (버스 클럭 기준)
+    typedef struct packed {
+        logic signed [47:0] result;
+        logic [1:0] cls;
+        logic signed [47:0] score;
+        logic [47:0] margin;
+        logic [7:0] tag;
+        logic [15:0] fc_nz;
+        logic [31:0] fc_cycles;
+    } res_t;
+    res_t d_q [$], r_q [$];
+    integer valid_width_err = 0;
+    logic d_valid_d1;
+
+    always @(posedge bus_clk) begin
+        d_valid_d1 <= d_valid;
+        if (d_valid && d_valid_d1) valid_width_err++;   // 결과마다 1클럭 펄스
+        if (d_valid) d_q.push_back('{d_result, d_class, d_score, d_margin, d_tag, d_fc_nz, d_fc_cycles});
+        if (r_valid) r_q.push_back('{r_result, r_class, r_score, r_margin, r_tag, r_fc_nz, r_fc_cycles});
+    end
+
+    // 4. 테스트 유틸
+    integer error_count = 0;
+
+    task automatic check(bit ok, string name);
+        if (ok) $display("✓ %s", name);
+        else begin
+            $display("✗ %s", name);
+            error_count++;
+        end
+    endtask
+
+    // 두 쪽이 모두 준비되면 프레임 전송 (시작 펄스 후 버스 클럭마다 픽셀 1개)
+    task automatic send_frame(output bit ready_dropped);
+        while (!(d_ready && r_ready)) @(negedge bus_clk);
+        start = 1;
+        @(negedge bus_clk);
+        start = 0;
+        ready_dropped = !d_ready;   // 시작 요청이 코어에 닿기 전에도 ready는 바로 내려감
+        for (int i = 0; i < N; i++) begin
+            pixel_valid = 1;
+            pixel = $urandom_range(0, 255);
+            @(negedge bus_clk);
+        end
+        pixel_valid = 0;
+    endtask
+
+    task automatic wait_idle();
+        int t = 0;
+        while ((d_busy || r_busy || r_q.size() != d_q.size()) && t < 200000) begin
+            @(negedge bus_clk);
+            t++;
+        end
+        repeat (10) @(negedge bus_clk);
+    endtask
+
+    function automatic bit results_match(output int n_bad);
+        n_bad = 0;
+        if (d_q.size() != r_q.size()) return 0;
+        for (int i = 0; i < d_q.size(); i++)
+            if (d_q[i].result != r_q[i].result || d_q[i].cls != r_q[i].cls || d_q[i].score != r_q[i].score ||
+                d_q[i].margin != r_q[i].margin || d_q[i].tag != r_q[i].tag || d_q[i].fc_nz != r_q[i].fc_nz)
+                n_bad++;
+        return n_bad == 0;
+    endfunction
+
+    // 5. 테스트 시나리오
+    initial begin
+        bit dropped, all_dropped;
+        int bad;
+        $display("--- CNN Core CDC Test START ---");
+        rst = 0;   // Active Low
+        start = 0; pixel_valid = 0; pixel = 0;
+        wt_wr_en = 0; wt_swap = 0; wt_addr = 0; wt_data = 0;
+        #100;
+        rst = 1;
+        repeat (10) @(negedge bus_clk);
+
+        check(d_ready && !d_busy, "ready and idle after reset (core reset released)");
+
+        // 5-1. 연속 프레임: 결과가 기준과 같은 순서 / 같은 값
+        all_dropped = 1;
+        for (int f = 0; f < 3; f++) begin
+            send_frame(dropped);
+            all_dropped &= dropped;
+        end
+        check(all_dropped, "frame_ready drops on the bus cycle after start");
+        wait_idle();
+        check(results_match(bad) && d_q.size() == 3, $sformatf("3 frames: results match bus-clock reference (%0d/%0d)", d_q.size(), r_q.size()));
+        check(valid_width_err == 0, "result_valid is a single bus-clock pulse");
+        check(d_q.size() > 0 && d_q[$].fc_cycles == r_q[$].fc_cycles + 2, "retimed FC pass takes 2 extra core cycles");
+        check(!d_busy && d_ready, "idle and ready once results are out");
+
+        // 5-2. 가중치 로드 + 교체: 쓰기가 교체 요청보다 먼저 코어에 반영
+        for (int i = 0; i < 16; i++) begin
+            @(negedge bus_clk);
+            wt_wr_en = 1;
+            wt_addr = 17'(i);            // 뉴런 0, 인덱스 i
+            wt_data = 32'(i * 37 - 200);
+            @(negedge bus_clk);
+            wt_wr_en = 0;
+        end
+        wt_swap = 1;
+        @(negedge bus_clk);
+        wt_swap = 0;
+        check(d_swap_busy, "swap busy raised while request is crossing");
+        while (d_swap_busy || r_swap_busy) @(negedge bus_clk);
+        check(d_bank == r_bank && d_bank == 1'b1, "active bank swapped");
+
+        d_q.delete();
+        r_q.delete();
+        send_frame(dropped);
+        send_frame(dropped);
+        wait_idle();
+        check(results_match(bad) && d_q.size() == 2, "results after weight swap match reference");
+        check(d_ovf == 3'b000, "no pixel / weight / result FIFO overflow at bus rate");
+
+        // 5-3. CNN 소프트 리셋: 코어 쪽도 리셋, 이후 정상 동작
+        send_frame(dropped);
+        repeat (5) @(negedge bus_clk);
+        rst = 0;
+        repeat (3) @(negedge bus_clk);
+        rst = 1;
+        repeat (10) @(negedge bus_clk);
+        check(!d_busy && d_ready, "reset mid-frame clears core and FIFOs");
+        d_q.delete();
+        r_q.delete();
+        send_frame(dropped);
+        wait_idle();
+        check(results_match(bad) && d_q.size() == 1, "frame after reset matches reference");
+
+        if (error_count == 0) $display("✓ TEST PASSED");
+        else                  $display("✗ TEST FAILED: %0d errors", error_count);
+        $display("--- CNN Core CDC Test FINISHED ---");
+        $finish;
+    end
+
+    // 타임아웃
+    initial begin
+        #20_000_000;
+        $display("✗ TIMEOUT");
+        $finish;
+    end
+
+endmodule
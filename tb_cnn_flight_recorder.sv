@@ -0,0 +1,251 @@
+`timescale 1ns/1ps
+module tb_cnn_flight_recorder;
+
+    // 1. DUT 신호 선언
+    localparam DEPTH = 16;
+
+    logic clk;
+    logic rst;
+    logic enable, trig_lat, trig_wdt, trig_ovf;
+    logic [31:0] threshold;
+    logic [7:0] post;
+    logic rearm, flush;
+    logic frame_first, frame_last, result_valid, reused, seq_path, rf_full, pop, timeout;
+    logic [31:0] t_feature, t_flatten, t_fc_start, t_fc_done;
+    logic [31:0] pop_seq;
+    logic [31:0] now;
+    logic [8:0] sel;
+    logic [31:0] sel_data, status;
+
+    cnn_flight_recorder #(
+        .DEPTH(DEPTH),
+        .EV_DEPTH(8),
+        .MAP_DEPTH(16)
+    ) dut (
+        .clk(clk), .rst(rst),
+        .i_enable(enable),
+        .i_trig_latency(trig_lat),
+        .i_trig_watchdog(trig_wdt),
+        .i_trig_overflow(trig_ovf),
+        .i_threshold(threshold),
+        .i_post(post),
+        .i_rearm(rearm),
+        .i_flush(flush),
+        .i_frame_first(frame_first),
+        .i_frame_last(frame_last),
+        .i_result_valid(result_valid),
+        .i_reused(reused),
+        .i_seq_path(seq_path),
+        .i_t_feature(t_feature),
+        .i_t_flatten(t_flatten),
+        .i_t_fc_start(t_fc_start),
+        .i_t_fc_done(t_fc_done),
+        .i_rf_full(rf_full),
+        .i_pop(pop),
+        .i_pop_seq(pop_seq),
+        .i_timeout(timeout),
+        .i_now(now),
+        .i_sel(sel),
+        .o_sel_data(sel_data),
+        .o_status(status)
+    );
+
+    // 2. 클럭 생성 + 타임스탬프 카운터
+    initial clk = 0;
+    always #5 clk = ~clk;
+
+    always_ff @(posedge clk or negedge rst) begin
+        if(!rst) now <= 0;
+        else     now <= now + 1;
+    end
+
+    // 3. 테스트 유틸
+    integer error_count = 0;
+    logic [31:0] ent [0:8];    // peek()로 읽은 엔트리 워드
+    logic [31:0] ev [0:1];
+
+    task automatic check(bit ok, string name);
+        if (ok) $display("✓ %s", name);
+        else begin
+            $display("✗ %s", name);
+            error_count++;
+        end
+    endtask
+
+    task automatic pulse_first();
+        @(negedge clk); frame_first = 1;
+        @(negedge clk); frame_first = 0;
+    endtask
+
+    task automatic pulse_last();
+        @(negedge clk); frame_last = 1;
+        @(negedge clk); frame_last = 0;
+    endtask
+
+    task automatic send_result(int feat, int flat, int fcs, int fcd, bit full = 0);
+        @(negedge clk);
+        result_valid = 1;
+        t_feature = feat; t_flatten = flat; t_fc_start = fcs; t_fc_done = fcd;
+        rf_full = full;
+        @(negedge clk);
+        result_valid = 0;
+        rf_full = 0;
+    endtask
+
+    task automatic sw_read(int seq);
+        @(negedge clk);
+        pop = 1; pop_seq = seq;
+        @(negedge clk);
+        pop = 0;
+    endtask
+
+    task automatic idle(int n);
+        repeat (n) @(negedge clk);
+    endtask
+
+    // 선택 레지스터로 엔트리 워드 9개 읽기 (조합 출력, 상태는 바꾸지 않음)
+    task automatic peek(int entry);
+        for (int w = 0; w < 9; w++) begin
+            sel = 9'((entry << 4) | w);
+            #1 ent[w] = sel_data;
+        end
+    endtask
+
+    task automatic peek_ev(int idx);
+        for (int w = 0; w < 2; w++) begin
+            sel = 9'(256 | (idx << 4) | w);
+            #1 ev[w] = sel_data;
+        end
+    endtask
+
+    // 4. 테스트 시나리오
+    initial begin
+        $display("--- CNN Flight Recorder Test START ---");
+        rst = 0;   // Active Low
+        enable = 0; trig_lat = 0; trig_wdt = 0; trig_ovf = 0;
+        threshold = 0; post = 0; rearm = 0; flush = 0;
+        frame_first = 0; frame_last = 0; result_valid = 0; reused = 0; seq_path = 0;
+        rf_full = 0; pop = 0; timeout = 0; pop_seq = 0;
+        t_feature = 0; t_flatten = 0; t_fc_start = 0; t_fc_done = 0;
+        sel = 0;
+        #100;
+        rst = 1;
+        @(negedge clk);
+        enable = 1;
+
+        // 4-1. 프레임 한 개: 첫 픽셀 → 100 → 마지막 픽셀 → 200 → 결과 → 50 → 소프트웨어 읽기
+        pulse_first();          // 엔트리 0
+        idle(98);
+        pulse_last();
+        idle(198);
+        send_result(1000, 1002, 1010, 1500);
+        idle(48);
+        sw_read(0);
+        peek(0);
+        check(ent[1] == 100 && ent[2] == 300 && ent[3] == 350,
+              $sformatf("bus-cycle deltas last/result/read (%0d/%0d/%0d)", ent[1], ent[2], ent[3]));
+        check(ent[4] == 1000 && ent[5] == 1002 && ent[6] == 1010 && ent[7] == 1500,
+              "core stage offsets stored with the frame");
+        check(ent[8][7] && ent[8][5] && ent[8][3] && !ent[8][2] && !ent[8][1] && ent[8][31:16] == 0,
+              "flags: valid, result, read, seq 0");
+        check(status[3:0] == 1, "next entry index advanced");
+
+        // 4-2. 파이프라인: 프레임 2의 첫 픽셀이 프레임 1 결과보다 먼저
+        pulse_first();          // 엔트리 1
+        idle(20);
+        pulse_last();           // +22
+        idle(20);
+        pulse_first();          // 엔트리 2
+        idle(10);
+        send_result(11, 12, 13, 14);   // 엔트리 1의 결과
+        pulse_last();           // 엔트리 2의 마지막 픽셀 (+14)
+        idle(30);
+        send_result(21, 22, 23, 24);   // 엔트리 2
+        sw_read(2);             // 읽기 순서와 무관하게 시퀀스 번호로 엔트리 조회
+        sw_read(1);
+        peek(1);
+        check(ent[7] == 14 && ent[1] == 22 && ent[8][3] && ent[8][31:16] == 1, "overlapping frames: first result to entry 1");
+        peek(2);
+        check(ent[7] == 24 && ent[1] == 14 && ent[8][3] && ent[8][31:16] == 2, "second result and last pixel to entry 2");
+
+        // 4-3. 결과 FIFO overflow: 플래그 + 이벤트
+        pulse_first();          // 엔트리 3
+        idle(5);
+        send_result(1, 2, 3, 4, 1);
+        peek(3);
+        check(ent[8][2], "result dropped by full FIFO flagged");
+        peek_ev(0);
+        check(ev[1][31:24] == 2 && status[23:16] == 1, "overflow event logged");
+
+        // 4-4. 워치독: 대기 중 프레임을 잃음 → 다음 결과는 다음 프레임으로
+        pulse_first();          // 엔트리 4 (타임아웃)
+        pulse_first();          // 엔트리 5
+        @(negedge clk); timeout = 1;
+        @(negedge clk); timeout = 0;
+        idle(5);
+        send_result(51, 52, 53, 54);
+        peek(4);
+        check(ent[8][1] && !ent[8][5], "watchdog marks the oldest pending frame lost");
+        peek(5);
+        check(ent[7] == 54, "next result goes to the next frame");
+        peek_ev(1);
+        check(ev[1][31:24] == 1 && ev[1][23:16] == 4, "watchdog event names the lost entry");
+
+        // 4-5. 지연 임계 트리거: 2개 더 기록 후 정지
+        threshold = 200; trig_lat = 1; post = 2;
+        pulse_first();          // 엔트리 6 (지연 큼)
+        idle(300);
+        send_result(1, 1, 1, 1);
+        check(status[12] && !status[13] && status[7:4] == 6, "latency over threshold triggers at entry 6");
+        peek_ev(2);
+        check(ev[1][31:24] == 3, "latency event logged");
+        repeat (2) begin
+            pulse_first();      // 엔트리 7, 8
+            idle(10);
+            send_result(2, 2, 2, 2);
+        end
+        check(status[13], "frozen after post-trigger results");
+        pulse_first();
+        idle(10);
+        send_result(3, 3, 3, 3);
+        peek(8);
+        check(status[3:0] == 9 && ent[7] == 2, "no recording while frozen");
+        peek(6);
+        check(ent[8][6], "trigger entry flagged");
+
+        // 4-6. 재무장: 다시 기록
+        @(negedge clk); rearm = 1;
+        @(negedge clk); rearm = 0;
+        check(!status[12] && !status[13], "rearm clears trigger and freeze");
+        pulse_first();          // 엔트리 9
+        idle(10);
+        send_result(9, 9, 9, 9);
+        peek(9);
+        check(ent[7] == 9 && ent[2] > 0, "recording resumes after rearm");
+
+        // 4-7. 비활성 중 프레임은 기록 안 함, 재활성 후 대기 프레임 없이 시작
+        enable = 0;
+        pulse_first();
+        enable = 1;
+        send_result(7, 7, 7, 7);        // 비활성 중 시작한 프레임의 결과 → 무시
+        check(status[3:0] == 10, "frames while disabled are not recorded");
+        pulse_first();          // 엔트리 10
+        idle(10);
+        send_result(10, 10, 10, 10);
+        peek(10);
+        check(ent[7] == 10, "stale result after re-enable not misattributed");
+
+        if (error_count == 0) $display("✓ TEST PASSED");
+        else                  $display("✗ TEST FAILED: %0d errors", error_count);
+        $display("--- CNN Flight Recorder Test FINISHED ---");
+        $finish;
+    end
+
+    // 타임아웃
+    initial begin
+        #1_000_000;
+        $display("✗ TIMEOUT");
+        $finish;
+    end
+
+endmodule
@@ -0,0 +1,246 @@
+`timescale 1ns/1ps
+module tb_cnn_layer_sequencer;
+
+    // 1. DUT 신호 선언 (시퀀서는 CNN_TOP_Improved 안에서 코어 엔진을 공유하므로 코어 전체를 구동)
+    logic clk;
+    logic rst;
+    logic start_signal;
+    logic pixel_valid;
+    logic [7:0] pixel_in;
+    logic final_result_valid;
+    logic signed [47:0] final_lane_result;
+    logic [1:0] final_class_idx;
+    logic signed [47:0] final_class_score;
+    logic [47:0] final_class_margin;
+    logic [7:0] final_frame_tag;
+    logic frame_ready;
+    logic cnn_busy;
+    logic [3:0] perf_stage_busy, perf_stage_stall;
+    logic [31:0] final_latency, final_fc_cycles;
+    logic [15:0] final_fc_nonzero;
+    logic [31:0] final_t_feature, final_t_flatten, final_t_fc_start;
+    logic final_seq_path;
+    logic timeout_error;
+    logic i_wt_wr_en;
+    logic [16:0] i_wt_wr_addr;
+    logic [31:0] i_wt_wr_data;
+    logic i_wt_swap_req;
+    logic o_wt_active_bank, o_wt_swap_busy;
+    logic [31:0] i_quant_cfg, i_geometry;
+    logic [31:0] i_seq_ctrl;
+    logic i_seq_wr_en;
+    logic [16:0] i_seq_wr_addr;
+    logic [31:0] i_seq_wr_data;
+    logic o_seq_busy, o_seq_error;
+    logic [3:0] o_seq_layer;
+
+    // 테스트 네트워크: conv 6x6x1 → 4x4x2 (ReLU) → pool 2x2x2 → FC 8 → 5 (FC 가중치 = 코어 FC 뱅크)
+    localparam W = 6, H = 6;
+    localparam CW = W - 2, CH = H - 2;
+    localparam PW = CW / 2, PH = CH / 2;
+    localparam NUM_CH = 2;
+    localparam FC_IN = PW * PH * NUM_CH;
+    localparam FC_OUT = 5;
+
+    CNN_TOP_Improved #(
+        .QUANT_MODE(0)
+    ) dut (.*);
+
+    // 2. 클럭 생성
+    initial clk = 0;
+    always #5 clk = ~clk;
+
+    logic [7:0] img [0:W*H-1];
+    logic signed [7:0] kern [0:NUM_CH-1][0:8];
+    logic signed [21:0] fc_w [0:FC_OUT-1][0:FC_IN-1];
+    integer error_count = 0;
+
+    task automatic seq_write(input logic [16:0] addr, input logic [31:0] data);
+        @(posedge clk);
+        i_seq_wr_en <= 1;
+        i_seq_wr_addr <= addr;
+        i_seq_wr_data <= data;
+        @(posedge clk);
+        i_seq_wr_en <= 0;
+    endtask
+
+    task automatic write_desc(input int layer, input logic [31:0] w0, w1, w2, w3);
+        logic [31:0] words [4] = '{w0, w1, w2, w3};
+        for (int i = 0; i < 4; i++) seq_write(17'(layer * 4 + i), words[i]);
+    endtask
+
+    // FC 가중치: 섀도 뱅크에 쓰고 교체 (시퀀서 FC 레이어도 활성 뱅크 사용)
+    task automatic load_fc_weights();
+        for (int o = 0; o < FC_OUT; o++)
+            for (int i = 0; i < FC_IN; i++) begin
+                @(posedge clk);
+                i_wt_wr_en <= 1;
+                i_wt_wr_addr <= {1'b0, 4'(o), 12'(i)};
+                i_wt_wr_data <= 32'(fc_w[o][i]);
+            end
+        @(posedge clk);
+        i_wt_wr_en <= 0;
+        i_wt_swap_req <= 1;
+        @(posedge clk);
+        i_wt_swap_req <= 0;
+        @(posedge clk);
+        wait (!o_wt_swap_busy);
+    endtask
+
+    task automatic send_frame();
+        wait (frame_ready);
+        @(posedge clk);
+        start_signal <= 1;
+        @(posedge clk);
+        start_signal <= 0;
+        for (int i = 0; i < W*H; i++) begin
+            pixel_valid <= 1;
+            pixel_in <= img[i];
+            @(posedge clk);
+        end
+        pixel_valid <= 0;
+    endtask
+
+    // 3. 기준 모델 (conv → ReLU → pool → FC, 48비트 누적)
+    task automatic check_result(input string name);
+        logic signed [21:0] conv [0:NUM_CH-1][0:CH-1][0:CW-1];
+        logic signed [21:0] pool [0:FC_IN-1];
+        logic signed [47:0] fc [0:FC_OUT-1];
+        logic signed [47:0] best, second;
+        int best_idx;
+
+        for (int c = 0; c < NUM_CH; c++)
+            for (int y = 0; y < CH; y++)
+                for (int x = 0; x < CW; x++) begin
+                    int sum = 0;
+                    for (int i = 0; i < 3; i++)
+                        for (int j = 0; j < 3; j++)
+                            sum += int'(img[(y+i)*W + x+j]) * int'(kern[c][i*3+j]);
+                    conv[c][y][x] = (sum < 0) ? 0 : sum;
+                end
+
+        for (int c = 0; c < NUM_CH; c++)
+            for (int py = 0; py < PH; py++)
+                for (int px = 0; px < PW; px++) begin
+                    logic signed [21:0] m;
+                    m = conv[c][2*py][2*px];
+                    if (conv[c][2*py][2*px+1] > m)   m = conv[c][2*py][2*px+1];
+                    if (conv[c][2*py+1][2*px] > m)   m = conv[c][2*py+1][2*px];
+                    if (conv[c][2*py+1][2*px+1] > m) m = conv[c][2*py+1][2*px+1];
+                    pool[c*PW*PH + py*PW + px] = m;
+                end
+
+        for (int o = 0; o < FC_OUT; o++) begin
+            fc[o] = 0;
+            for (int i = 0; i < FC_IN; i++) fc[o] += pool[i] * fc_w[o][i];
+        end
+
+        best_idx = 0;
+        best = fc[1];
+        second = {1'b1, 47'b0};
+        for (int c = 1; c < 4; c++) begin
+            if (fc[1+c] > best) begin second = best; best = fc[1+c]; best_idx = c; end
+            else if (fc[1+c] > second) second = fc[1+c];
+        end
+
+        wait (final_result_valid);
+        @(negedge clk);
+        if (final_lane_result !== fc[0] || final_class_idx !== 2'(best_idx) || final_class_score !== best ||
+            final_class_margin !== 48'(best - second) || final_seq_path !== 1'b1) begin
+            $display("✗ %s: lane %0d (exp %0d), class %0d (exp %0d), score %0d (exp %0d), seq path %b",
+                     name, final_lane_result, fc[0], final_class_idx, best_idx, final_class_score, best, final_seq_path);
+            error_count++;
+        end else begin
+            $display("✓ %s: lane %0d, class %0d, tag %0d, latency %0d cycles",
+                     name, final_lane_result, final_class_idx, final_frame_tag, final_latency);
+        end
+    endtask
+
+    // 4. 테스트 시나리오
+    initial begin
+        $display("--- Layer Sequencer Test START ---");
+
+        rst = 0;   // Active Low
+        start_signal = 0; pixel_valid = 0; pixel_in = 0;
+        i_wt_wr_en = 0; i_wt_wr_addr = 0; i_wt_wr_data = 0; i_wt_swap_req = 0;
+        i_quant_cfg = 32'h0000_0001;
+        i_geometry = 32'h0000_2020;
+        i_seq_ctrl = 32'h0000_0300 | 32'h1;   // 시퀀서 경로, 3레이어
+        i_seq_wr_en = 0; i_seq_wr_addr = 0; i_seq_wr_data = 0;
+        #20;
+        rst = 1;
+
+        // 가중치: conv 채널 0 = 중앙 1 (항등), 채널 1 = Sobel X, FC = 랜덤 (코어 FC 뱅크)
+        kern[0] = '{0, 0, 0, 0, 1, 0, 0, 0, 0};
+        kern[1] = '{1, 0, -1, 2, 0, -2, 1, 0, -1};
+        for (int c = 0; c < NUM_CH; c++)
+            for (int k = 0; k < 9; k++) seq_write({1'b1, 16'(c*9 + k)}, 32'(kern[c][k]));
+        for (int o = 0; o < FC_OUT; o++)
+            for (int i = 0; i < FC_IN; i++) fc_w[o][i] = $signed(22'($urandom_range(0, 4000))) - 2000;
+        load_fc_weights();
+
+        write_desc(0, 32'h0000_0010, {8'(NUM_CH), 8'd1, 8'(H), 8'(W)}, 32'd0, {16'd0, 8'(CH), 8'(CW)});
+        write_desc(1, 32'h0000_0001, {8'(NUM_CH), 8'(NUM_CH), 8'(CH), 8'(CW)}, 32'd0, {16'd0, 8'(PH), 8'(PW)});
+        write_desc(2, 32'h0000_0002, {8'(FC_OUT), 8'(NUM_CH), 8'(PH), 8'(PW)}, 32'd0, 32'h0000_0101);
+
+        // 프레임 1, 2: 서로 다른 랜덤 이미지
+        for (int f = 0; f < 2; f++) begin
+            for (int i = 0; i < W*H; i++) img[i] = $urandom_range(0, 255);
+            fork
+                send_frame();
+                check_result($sformatf("frame %0d", f));
+            join
+            @(posedge clk);
+        end
+        if (o_seq_busy || o_seq_error) begin
+            $display("✗ sequencer not idle after frames (busy %b, error %b)", o_seq_busy, o_seq_error);
+            error_count++;
+        end
+
+        // 잘못된 디스크립터: pool 출력 크기 불일치 → 오류, 결과 없음
+        write_desc(1, 32'h0000_0001, {8'(NUM_CH), 8'(NUM_CH), 8'(CH), 8'(CW)}, 32'd0, {16'd0, 8'(PH), 8'(PW + 1)});
+        send_frame();
+        repeat (200) @(posedge clk);
+        if (o_seq_error && o_seq_layer == 1 && frame_ready) $display("✓ descriptor error detected at layer %0d", o_seq_layer);
+        else begin
+            $display("✗ descriptor error not reported (error %b, layer %0d)", o_seq_error, o_seq_layer);
+            error_count++;
+        end
+
+        // FC 출력 수가 코어 FC 뉴런 수를 넘으면 오류
+        write_desc(1, 32'h0000_0001, {8'(NUM_CH), 8'(NUM_CH), 8'(CH), 8'(CW)}, 32'd0, {16'd0, 8'(PH), 8'(PW)});
+        write_desc(2, 32'h0000_0002, {8'd6, 8'(NUM_CH), 8'(PH), 8'(PW)}, 32'd0, 32'h0000_0101);
+        send_frame();
+        repeat (400) @(posedge clk);
+        if (o_seq_error && o_seq_layer == 2) $display("✓ FC output count > core neurons rejected");
+        else begin
+            $display("✗ oversized FC not rejected (error %b, layer %0d)", o_seq_error, o_seq_layer);
+            error_count++;
+        end
+
+        // 엔진 공유 확인: 시퀀서를 끄면 같은 엔진으로 고정 파이프라인 프레임이 끝까지 나옴
+        i_seq_ctrl = 32'h0000_0300;
+        i_geometry = {16'd0, 8'(H), 8'(W)};
+        send_frame();
+        wait (final_result_valid);
+        @(negedge clk);
+        if (!o_seq_busy && !final_seq_path) $display("✓ fixed pipeline frame after sequencer (tag %0d)", final_frame_tag);
+        else begin
+            $display("✗ sequencer still busy or result marked as sequencer path in fixed mode");
+            error_count++;
+        end
+
+        if (error_count == 0) $display("✓ TEST PASSED");
+        else                  $display("✗ TEST FAILED: %0d errors", error_count);
+        $display("--- Layer Sequencer Test FINISHED ---");
+        $finish;
+    end
+
+    // 타임아웃
+    initial begin
+        #2_000_000;
+        $display("✗ TIMEOUT");
+        $finish;
+    end
+
+endmodule
@@ -0,0 +1,181 @@
+`timescale 1ns/1ps
+module tb_cnn_result_fifo;
+
+    // 1. DUT 신호 선언
+    localparam DEPTH = 4;
+    localparam TS_DEPTH = 4;
+
+    logic clk;
+    logic rst;
+    logic flush, frame_first;
+    logic result_valid;
+    logic signed [47:0] result;
+    logic [1:0] class_idx;
+    logic [31:0] latency;
+    logic pop;
+
+    logic empty;
+    logic [$clog2(DEPTH):0] level;
+    logic signed [47:0] o_result;
+    logic [1:0] o_class;
+    logic overflow;
+    logic reused, o_reused;
+    logic [31:0] seq, ts_first, ts_result;
+    logic [15:0] drops;
+    logic [31:0] now;
+
+    cnn_result_fifo #(
+        .DEPTH(DEPTH),
+        .TS_DEPTH(TS_DEPTH)
+    ) dut (
+        .clk(clk), .rst(rst),
+        .i_flush(flush),
+        .i_frame_first(frame_first),
+        .i_result_valid(result_valid),
+        .i_result(result),
+        .i_class(class_idx),
+        .i_latency(latency),
+        .i_reused(reused),
+        .i_pop(pop),
+        .o_empty(empty),
+        .o_level(level),
+        .o_result(o_result),
+        .o_class(o_class),
+        .o_overflow(overflow),
+        .o_reused(o_reused),
+        .o_seq(seq),
+        .o_ts_first(ts_first),
+        .o_ts_result(ts_result),
+        .o_drop_count(drops),
+        .o_now(now)
+    );
+
+    // 2. 클럭 생성
+    initial clk = 0;
+    always #5 clk = ~clk;
+
+    // 3. 테스트 유틸
+    integer error_count = 0;
+
+    task automatic check(bit ok, string name);
+        if (ok) $display("✓ %s", name);
+        else begin
+            $display("✗ %s", name);
+            error_count++;
+        end
+    endtask
+
+    // 프레임 첫 픽셀 펄스, 펄스가 들어간 사이클의 o_now 반환
+    task automatic first_pixel(output logic [31:0] t);
+        @(negedge clk);
+        frame_first = 1;
+        t = now;
+        @(negedge clk);
+        frame_first = 0;
+    endtask
+
+    task automatic send_result(longint r, logic [1:0] c, logic [31:0] lat, output logic [31:0] t);
+        @(negedge clk);
+        result_valid = 1;
+        result = r;
+        class_idx = c;
+        latency = lat;
+        t = now;
+        @(negedge clk);
+        result_valid = 0;
+    endtask
+
+    task automatic do_pop();
+        @(negedge clk);
+        pop = 1;
+        @(negedge clk);
+        pop = 0;
+    endtask
+
+    // 4. 테스트 시나리오
+    initial begin
+        logic [31:0] tf [0:7];
+        logic [31:0] tr [0:7];
+        logic [31:0] t;
+        bit ok;
+        $display("--- CNN Result FIFO Test START ---");
+        rst = 0;   // Active Low
+        flush = 0; frame_first = 0; result_valid = 0; pop = 0;
+        result = 0; class_idx = 0; latency = 0; reused = 0;
+        #40;
+        rst = 1;
+        #20;
+
+        check(empty && level == 0 && drops == 0, "empty after reset");
+
+        // 4-1. 파이프라인: 프레임 3개가 겹쳐 진행, 결과는 프레임 순서대로
+        for (int i = 0; i < 3; i++) begin
+            first_pixel(tf[i]);
+            repeat (7) @(posedge clk);
+        end
+        for (int i = 0; i < 3; i++) begin
+            send_result(48'sd1000 * (i + 1) - 48'sd1500, 2'(i), 0, tr[i]);
+            repeat (3) @(posedge clk);
+        end
+        check(level == 3, "three entries queued");
+
+        ok = 1;
+        for (int i = 0; i < 3; i++) begin
+            if (seq != i || ts_first != tf[i] || ts_result != tr[i] || o_class != 2'(i) ||
+                o_result != 48'sd1000 * (i + 1) - 48'sd1500 || overflow) begin
+                $display("  entry %0d: seq %0d first %0d (exp %0d) result %0d (exp %0d)",
+                         i, seq, ts_first, tf[i], ts_result, tr[i]);
+                ok = 0;
+            end
+            do_pop();
+        end
+        check(ok, "seq / first-pixel / result timestamps paired in order");
+        check(empty, "drained by pops");
+
+        // 4-2. 시각 큐가 비어 있으면 결과 시각 - latency
+        reused = 1;
+        send_result(48'sd7, 2'd1, 32'd123, t);
+        reused = 0;
+        check(!empty && ts_first == t - 123 && ts_result == t && seq == 3, "fallback first-pixel time from latency");
+        check(o_reused, "reused flag stored with entry");
+        do_pop();
+
+        // 4-3. 가득 참: 새 결과 버림, 번호 공백 + overflow 플래그
+        for (int i = 0; i < DEPTH + 2; i++) send_result(48'sd1 * i, 2'd0, 32'd10, tr[i]);
+        check(level == DEPTH && drops == 2, "full FIFO drops newest results and counts them");
+        ok = 1;
+        for (int i = 0; i < DEPTH; i++) begin
+            if (seq != 4 + i || overflow) ok = 0;
+            do_pop();
+        end
+        check(ok, "stored entries keep consecutive sequence numbers");
+        send_result(48'sd99, 2'd2, 32'd10, t);
+        check(seq == 4 + DEPTH + 2 && overflow, "next entry flags overflow after sequence gap");
+        do_pop();
+        send_result(48'sd98, 2'd2, 32'd10, t);
+        check(!overflow, "overflow flag clears on following entry");
+        do_pop();
+
+        // 4-4. flush: 처리 중 프레임 시각 폐기 → 다음 결과는 latency 기준
+        first_pixel(tf[0]);
+        first_pixel(tf[1]);
+        @(negedge clk);
+        flush = 1;
+        @(negedge clk);
+        flush = 0;
+        send_result(48'sd5, 2'd0, 32'd40, t);
+        check(ts_first == t - 40, "flush drops in-flight first-pixel times");
+        do_pop();
+
+        // 4-5. 타임스탬프 카운터 진행
+        t = now;
+        repeat (10) @(posedge clk);
+        check(now - t == 10, "cycle counter free-runs");
+
+        if (error_count == 0) $display("✓ TEST PASSED");
+        else                  $display("✗ TEST FAILED: %0d errors", error_count);
+        $display("--- CNN Result FIFO Test FINISHED ---");
+        $finish;
+    end
+
+endmodule
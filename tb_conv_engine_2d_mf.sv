@@ -0,0 +1,192 @@
+`timescale 1ns/1ps
+module tb_conv_engine_2d_mf;
+
+    // 1. DUT 신호 선언 (필터 3개 x 입력 3채널, PPC = 1 / 2 두 인스턴스에 같은 이미지)
+    localparam W = 12, H = 8;
+    localparam F = 3, C = 3;
+    localparam KW = $clog2(9 * F * C);
+
+    logic clk;
+    logic rst;
+    logic start_signal;
+    logic [4:0] i_img_width = 5'(W);
+    logic [3:0] i_img_height = 4'(H);
+    logic [1:0] i_stride_log2;
+    logic i_pad_same;
+    logic kbank;
+    logic kwr_en;
+    logic [KW-1:0] kwr_idx;
+    logic signed [7:0] kwr_data;
+    logic signed [7:0] no_ovr [0:8] = '{default: 8'sd0};
+
+    logic pixel_valid1, pixel_valid2;
+    logic [8*C-1:0] pixel_in1;
+    logic [16*C-1:0] pixel_in2;
+    logic signed [22*F-1:0] result_out1;
+    logic signed [44*F-1:0] result_out2;
+    logic result_valid1;
+    logic [1:0] result_valid2;
+    logic done1, done2;
+
+    conv_engine_2d #(.IMG_WIDTH(W), .IMG_HEIGHT(H), .PPC(1), .NUM_FILTERS(F), .NUM_CHANNELS(C)) dut1 (
+        .clk, .rst, .start_signal,
+        .pixel_in(pixel_in1), .pixel_valid(pixel_valid1),
+        .result_out(result_out1), .result_valid(result_valid1), .done_signal(done1),
+        .i_img_width, .i_img_height, .i_stride_log2, .i_pad_same,
+        .i_kernel_bank(kbank), .i_kernel_wr_en(kwr_en), .i_kernel_wr_bank(1'b1),
+        .i_kernel_wr_idx(kwr_idx), .i_kernel_wr_data(kwr_data),
+        .i_kernel_ovr(1'b0), .i_kernel_ovr_data(no_ovr)
+    );
+
+    conv_engine_2d #(.IMG_WIDTH(W), .IMG_HEIGHT(H), .PPC(2), .NUM_FILTERS(F), .NUM_CHANNELS(C)) dut2 (
+        .clk, .rst, .start_signal,
+        .pixel_in(pixel_in2), .pixel_valid(pixel_valid2),
+        .result_out(result_out2), .result_valid(result_valid2), .done_signal(done2),
+        .i_img_width, .i_img_height, .i_stride_log2, .i_pad_same,
+        .i_kernel_bank(kbank), .i_kernel_wr_en(kwr_en), .i_kernel_wr_bank(1'b1),
+        .i_kernel_wr_idx(kwr_idx), .i_kernel_wr_data(kwr_data),
+        .i_kernel_ovr(1'b0), .i_kernel_ovr_data(no_ovr)
+    );
+
+    // 2. 클럭 생성
+    initial clk = 0;
+    always #5 clk = ~clk;
+
+    logic [7:0] img [0:C-1][0:H-1][0:W-1];
+    logic signed [7:0] kern [0:F-1][0:C-1][0:2][0:2];
+    logic signed [21:0] expected [$];
+    logic signed [21:0] got1 [$], got2 [$];
+    integer error_count = 0;
+
+    // 3. 출력 수집 (픽셀마다 필터 0..F-1 순서 = 채널 인터리브)
+    always @(posedge clk) begin
+        if (result_valid1)
+            for (int f = 0; f < F; f++) got1.push_back(result_out1[22*f +: 22]);
+        for (int l = 0; l < 2; l++)
+            if (result_valid2[l])
+                for (int f = 0; f < F; f++) got2.push_back(result_out2[22*(l*F + f) +: 22]);
+    end
+
+    // 기준 모델: 필터마다 Σ채널 Σ3x3, valid/same, stride
+    task automatic build_expected(input bit sobel);
+        int fw, fh, off, s;
+        fw = i_pad_same ? W : W - 2;
+        fh = i_pad_same ? H : H - 2;
+        off = i_pad_same ? -1 : 0;
+        s = 1 << i_stride_log2;
+        expected.delete();
+        for (int oy = 0; oy < fh; oy += s)
+            for (int ox = 0; ox < fw; ox += s)
+                for (int f = 0; f < F; f++) begin
+                    int sum = 0;
+                    for (int c = 0; c < C; c++)
+                        for (int i = 0; i < 3; i++)
+                            for (int j = 0; j < 3; j++) begin
+                                int y = oy + off + i, x = ox + off + j;
+                                int k = sobel ? ((j == 1) ? 0 : ((i == 1) ? 2 : 1) * ((j == 0) ? 1 : -1)) : int'(kern[f][c][i][j]);
+                                if (x >= 0 && x < W && y >= 0 && y < H) sum += int'(img[c][y][x]) * k;
+                            end
+                    expected.push_back(22'(sum));
+                end
+    endtask
+
+    // 섀도 뱅크 1에 필터 x 채널 커널 로드: idx = (f*C + c)*9 + row*3 + col
+    task automatic load_kernels();
+        for (int f = 0; f < F; f++)
+            for (int c = 0; c < C; c++)
+                for (int t = 0; t < 9; t++) begin
+                    kern[f][c][t / 3][t % 3] = 8'($urandom_range(0, 255));
+                    @(negedge clk);
+                    kwr_en = 1;
+                    kwr_idx = KW'((f*C + c)*9 + t);
+                    kwr_data = kern[f][c][t / 3][t % 3];
+                end
+        @(negedge clk);
+        kwr_en = 0;
+    endtask
+
+    task automatic run_case(input string name, input bit sobel, input logic same, input logic [1:0] stride_log2);
+        i_pad_same = same;
+        i_stride_log2 = stride_log2;
+        kbank = !sobel;
+        for (int c = 0; c < C; c++)
+            for (int y = 0; y < H; y++)
+                for (int x = 0; x < W; x++) img[c][y][x] = $urandom_range(0, 255);
+        build_expected(sobel);
+        got1.delete();
+        got2.delete();
+
+        @(posedge clk);
+        start_signal <= 1;
+        @(posedge clk);
+        start_signal <= 0;
+        // PPC = 2는 비트 사이에 빈 사이클을 넣어 스트림 공백도 확인
+        fork
+            begin
+                for (int y = 0; y < H; y++)
+                    for (int x = 0; x < W; x++) begin
+                        pixel_valid1 <= 1;
+                        for (int c = 0; c < C; c++) pixel_in1[8*c +: 8] <= img[c][y][x];
+                        @(posedge clk);
+                    end
+                pixel_valid1 <= 0;
+            end
+            begin
+                for (int y = 0; y < H; y++)
+                    for (int b = 0; b < W / 2; b++) begin
+                        pixel_valid2 <= 1;
+                        for (int l = 0; l < 2; l++)
+                            for (int c = 0; c < C; c++) pixel_in2[8*(l*C + c) +: 8] <= img[c][y][2*b + l];
+                        @(posedge clk);
+                        pixel_valid2 <= 0;
+                        @(posedge clk);
+                    end
+            end
+        join
+        repeat (2 * W + 20) @(posedge clk);
+
+        if (got1 != expected || got2 != expected) begin
+            $display("✗ %s: %0d outputs expected, PPC1 %0d, PPC2 %0d", name, expected.size(), got1.size(), got2.size());
+            for (int n = 0; n < expected.size() && n < got1.size(); n++)
+                if (got1[n] != expected[n]) begin
+                    $display("  first mismatch PPC1 #%0d: %0d (exp %0d)", n, got1[n], expected[n]);
+                    break;
+                end
+            error_count++;
+        end else begin
+            $display("✓ %s: %0d outputs match (PPC 1 / 2)", name, expected.size());
+        end
+    endtask
+
+    // 4. 테스트 시나리오
+    initial begin
+        $display("--- conv_engine_2d Multi-Filter Test START ---");
+        rst = 0;   // Active Low
+        start_signal = 0;
+        pixel_valid1 = 0; pixel_valid2 = 0;
+        pixel_in1 = 0; pixel_in2 = 0;
+        i_stride_log2 = 0; i_pad_same = 0;
+        kbank = 0; kwr_en = 0; kwr_idx = 0; kwr_data = 0;
+        #20;
+        rst = 1;
+
+        run_case("default Sobel on every filter / channel", 1'b1, 1'b0, 2'd0);
+        load_kernels();
+        run_case("loaded kernels, valid, stride 1", 1'b0, 1'b0, 2'd0);
+        run_case("loaded kernels, same, stride 1", 1'b0, 1'b1, 2'd0);
+        run_case("loaded kernels, same, stride 2", 1'b0, 1'b1, 2'd1);
+
+        if (error_count == 0) $display("✓ TEST PASSED");
+        else                  $display("✗ TEST FAILED: %0d errors", error_count);
+        $display("--- conv_engine_2d Multi-Filter Test FINISHED ---");
+        $finish;
+    end
+
+    // 타임아웃
+    initial begin
+        #1_000_000;
+        $display("✗ TIMEOUT");
+        $finish;
+    end
+
+endmodule
@@ -0,0 +1,220 @@
+`timescale 1ns/1ps
+module tb_frame_change_detector;
+
+    // 1. DUT 신호 선언
+    localparam MAX_PIXELS = 64;
+    localparam N = 64;   // 8x8 프레임
+
+    logic clk;
+    logic rst;
+    logic enable;
+    logic [31:0] threshold;
+    logic [7:0] max_skip;
+    logic in_start, in_valid, in_done;
+    logic [7:0] in_data;
+    logic in_ready;
+    logic cnn_ready, cnn_idle;
+    logic out_start, out_valid;
+    logic [7:0] out_data;
+    logic reuse;
+    logic [31:0] last_sad, skips;
+
+    frame_change_detector #(
+        .MAX_PIXELS(MAX_PIXELS)
+    ) dut (
+        .clk(clk), .rst(rst),
+        .i_enable(enable),
+        .i_threshold(threshold),
+        .i_max_skip(max_skip),
+        .i_frame_start(in_start),
+        .i_pixel_valid(in_valid),
+        .i_pixel_data(in_data),
+        .i_frame_done(in_done),
+        .o_in_ready(in_ready),
+        .i_cnn_ready(cnn_ready),
+        .i_cnn_idle(cnn_idle),
+        .o_frame_start(out_start),
+        .o_pixel_valid(out_valid),
+        .o_pixel_data(out_data),
+        .o_reuse(reuse),
+        .o_last_sad(last_sad),
+        .o_skip_count(skips)
+    );
+
+    // 2. 클럭 생성
+    initial clk = 0;
+    always #5 clk = ~clk;
+
+    // 3. CNN 모델: 시작 펄스 수, 받은 픽셀 기록, 재출력 펄스 수
+    integer cnn_frames = 0;
+    integer cnn_pix = 0;
+    integer reuse_n = 0;
+    integer reuse_busy = 0;   // CNN busy 중 재출력 (위반)
+    logic [7:0] cnn_buf [0:N-1];
+
+    always @(posedge clk) begin
+        if (out_start) begin
+            cnn_frames++;
+            cnn_pix = 0;
+        end
+        if (out_valid) begin
+            if (cnn_pix < N) cnn_buf[cnn_pix] = out_data;
+            cnn_pix++;
+        end
+        if (reuse) begin
+            reuse_n++;
+            if (!cnn_idle) reuse_busy++;
+        end
+    end
+
+    // 4. 테스트 유틸
+    integer error_count = 0;
+    logic [7:0] img [0:N-1];
+
+    task automatic check(bit ok, string name);
+        if (ok) $display("✓ %s", name);
+        else begin
+            $display("✗ %s", name);
+            error_count++;
+        end
+    endtask
+
+    // 한 프레임 전송 (gap: 픽셀 사이 빈 클럭), 시작 전 in_ready 대기
+    task automatic send_frame(integer n, integer gap);
+        while (!in_ready) @(negedge clk);
+        @(negedge clk);
+        in_start = 1;
+        @(negedge clk);
+        in_start = 0;
+        for (int i = 0; i < n; i++) begin
+            in_valid = 1;
+            in_data = img[i];
+            in_done = (i == n - 1);
+            @(negedge clk);
+            in_valid = 0;
+            in_done = 0;
+            repeat (gap) @(negedge clk);
+        end
+    endtask
+
+    function automatic bit cnn_got_img(integer n);
+        if (cnn_pix != n) return 0;
+        for (int i = 0; i < n; i++) if (cnn_buf[i] != img[i]) return 0;
+        return 1;
+    endfunction
+
+    function automatic integer sad_vs(logic [7:0] ref_img [0:N-1]);
+        integer s = 0;
+        for (int i = 0; i < N; i++) s += (img[i] > ref_img[i]) ? img[i] - ref_img[i] : ref_img[i] - img[i];
+        return s;
+    endfunction
+
+    // 5. 테스트 시나리오
+    initial begin
+        integer f0, r0, s0;
+        logic [7:0] ref_img [0:N-1];
+        $display("--- Frame Change Detector Test START ---");
+        rst = 0;   // Active Low
+        enable = 0; threshold = 100; max_skip = 0;
+        in_start = 0; in_valid = 0; in_done = 0; in_data = 0;
+        cnn_ready = 1; cnn_idle = 1;
+        for (int i = 0; i < N; i++) img[i] = 8'(i * 3 + 17);
+        #40;
+        rst = 1;
+        #20;
+
+        // 5-1. 비활성: 그대로 전달, 준비 신호는 CNN 준비 그대로
+        send_frame(N, 1);
+        repeat (5) @(posedge clk);
+        check(cnn_frames == 1 && cnn_got_img(N), "disabled: frame passes straight to CNN");
+        cnn_ready = 0;
+        #1;
+        check(!in_ready, "disabled: input ready follows CNN ready");
+        cnn_ready = 1;
+
+        // 5-2. 활성 첫 프레임: 기준 없음 → 반드시 추론 (버퍼 재생)
+        enable = 1;
+        for (int i = 0; i < N; i++) img[i] = $urandom_range(0, 255);
+        send_frame(N, 2);
+        repeat (N + 10) @(posedge clk);
+        check(cnn_frames == 2 && cnn_got_img(N), "first enabled frame replayed to CNN unchanged");
+        for (int i = 0; i < N; i++) ref_img[i] = img[i];
+
+        // 5-3. 같은 프레임: CNN 생략, 재출력 1회
+        f0 = cnn_frames; r0 = reuse_n;
+        send_frame(N, 0);
+        repeat (10) @(posedge clk);
+        check(cnn_frames == f0 && reuse_n == r0 + 1 && skips == 1 && last_sad == 0, "identical frame skipped and result reused");
+
+        // 5-4. 임계값 이하 잡음: 생략, SAD 일치
+        for (int i = 0; i < N; i += 4) img[i] = ref_img[i] ^ 8'h01;
+        send_frame(N, 0);
+        repeat (10) @(posedge clk);
+        check(cnn_frames == f0 && skips == 2 && last_sad == sad_vs(ref_img) && last_sad <= threshold,
+              "small noise below threshold skipped, SAD matches reference");
+
+        // 5-5. 천천히 변하는 장면: 기준은 마지막 추론 프레임 → 누적 변화로 추론
+        f0 = cnn_frames;
+        for (int step = 0; step < 4 && cnn_frames == f0; step++) begin
+            for (int i = 0; i < N; i += 2) img[i] = ref_img[i] + 8'(step + 1);
+            send_frame(N, 0);
+            repeat (N + 10) @(posedge clk);
+        end
+        check(cnn_frames == f0 + 1 && last_sad > threshold && cnn_got_img(N), "accumulated drift triggers inference");
+        for (int i = 0; i < N; i++) ref_img[i] = img[i];
+
+        // 5-6. 큰 변화: 추론
+        f0 = cnn_frames;
+        for (int i = 0; i < N; i++) img[i] = 255 - ref_img[i];
+        send_frame(N, 0);
+        repeat (N + 10) @(posedge clk);
+        check(cnn_frames == f0 + 1 && cnn_got_img(N), "changed frame inferred");
+        for (int i = 0; i < N; i++) ref_img[i] = img[i];
+
+        // 5-7. 재출력은 CNN idle까지 대기
+        cnn_idle = 0;
+        r0 = reuse_n;
+        send_frame(N, 0);
+        repeat (30) @(posedge clk);
+        check(reuse_n == r0 && !in_ready, "reuse held while CNN busy");
+        cnn_idle = 1;
+        repeat (5) @(posedge clk);
+        check(reuse_n == r0 + 1 && in_ready, "reuse released when CNN idle");
+
+        // 5-8. 연속 생략 한도: max_skip 프레임 생략 후 강제 추론
+        max_skip = 3;
+        f0 = cnn_frames; s0 = skips;
+        for (int k = 0; k < 4; k++) begin
+            send_frame(N, 0);
+            repeat (N + 10) @(posedge clk);
+        end
+        // 5-7에서 1회 생략 → 2회 더 생략 후 강제 추론, 다시 1회 생략
+        check(cnn_frames == f0 + 1 && skips == s0 + 3, "max skip forces periodic inference");
+        max_skip = 0;
+
+        // 5-9. 프레임 크기 변경: 추론
+        f0 = cnn_frames;
+        send_frame(N / 2, 0);
+        repeat (N + 10) @(posedge clk);
+        check(cnn_frames == f0 + 1 && cnn_got_img(N / 2), "frame size change forces inference");
+
+        // 5-10. CNN 준비 대기: 재생은 cnn_ready 후 시작
+        f0 = cnn_frames;
+        for (int i = 0; i < N; i++) img[i] = $urandom_range(0, 255);
+        cnn_ready = 0;
+        send_frame(N, 0);
+        repeat (20) @(posedge clk);
+        check(cnn_frames == f0, "replay waits for CNN frame ready");
+        cnn_ready = 1;
+        repeat (N + 10) @(posedge clk);
+        check(cnn_frames == f0 + 1 && cnn_got_img(N), "replay starts once CNN ready");
+
+        check(reuse_busy == 0, "no reuse pulse while CNN busy");
+
+        if (error_count == 0) $display("✓ TEST PASSED");
+        else                  $display("✗ TEST FAILED: %0d errors", error_count);
+        $display("--- Frame Change Detector Test FINISHED ---");
+        $finish;
+    end
+
+endmodule
@@ -0,0 +1,135 @@
+`timescale 1ns/1ps
+module tb_lane_peak_detector;
+
+    // 1. DUT 신호 선언
+    localparam ROWS = 12;
+
+    logic clk;
+    logic rst;
+    logic start;
+    logic [7:0] rx_data;
+    logic rx_valid;
+    logic [7:0] tx_data, confidence;
+    logic done_signal;
+
+    top_controller dut (.*);
+
+    // 2. 클럭 생성
+    initial clk = 0;
+    always #5 clk = ~clk;
+
+    logic [7:0] rows [0:ROWS-1][0:31];
+    logic [7:0] exp_center [0:ROWS-1];
+    logic [7:0] exp_conf [0:ROWS-1];
+    integer got_count = 0;
+    integer error_count = 0;
+    longint first_done_time, last_done_time;
+
+    // 3. 기준 모델: 기존 top_controller 배치 알고리즘 (FIND_LANES + 전체 쌍 탐색)
+    task automatic reference();
+        int last_center = 15;
+        for (int r = 0; r < ROWS; r++) begin
+            int peak_pos [4], peak_val [4];
+            int cnt = 0, best_diff = 256, b1 = -1, b2 = -1;
+            for (int j = 0; j < 30; j++) begin
+                int v = -(j >= 2 ? int'(rows[r][j-2]) : 0) + 2 * (j >= 1 ? int'(rows[r][j-1]) : 0) - int'(rows[r][j]);
+                if (v < 0) v = -v;
+                if (v > 100 && cnt < 4) begin
+                    peak_pos[cnt] = j;
+                    peak_val[cnt] = v;
+                    cnt++;
+                end
+            end
+            for (int a = 0; a < cnt; a++)
+                for (int b = a + 1; b < cnt; b++) begin
+                    int c = (peak_pos[a] + peak_pos[b]) >> 1;
+                    int d = (c > last_center) ? c - last_center : last_center - c;
+                    if (d < best_diff) begin
+                        best_diff = d; b1 = a; b2 = b;
+                    end
+                end
+            if (b1 >= 0) begin
+                exp_center[r] = (peak_pos[b1] + peak_pos[b2]) >> 1;
+                exp_conf[r] = ((peak_val[b1] > 255) ? 127 : (peak_val[b1] & 8'hFF) >> 1) +
+                              ((peak_val[b2] > 255) ? 127 : (peak_val[b2] & 8'hFF) >> 1);
+                last_center = exp_center[r];
+            end else begin
+                exp_center[r] = last_center;
+                exp_conf[r] = 0;
+            end
+        end
+    endtask
+
+    // 4. 결과 수집
+    always @(posedge clk) begin
+        if (done_signal) begin
+            if (got_count == 0) first_done_time = $time;
+            last_done_time = $time;
+            if (got_count < ROWS && tx_data == exp_center[got_count] && confidence == exp_conf[got_count])
+                $display("✓ row %0d: center %0d, confidence %0d", got_count, tx_data, confidence);
+            else begin
+                $display("✗ row %0d: center %0d, confidence %0d (exp %0d, %0d)", got_count, tx_data, confidence,
+                         exp_center[got_count], exp_conf[got_count]);
+                error_count++;
+            end
+            got_count++;
+        end
+    end
+
+    // 5. 테스트 시나리오
+    initial begin
+        $display("--- Lane Peak Detector Test START ---");
+        rst = 0;   // Active Low
+        start = 0; rx_valid = 0; rx_data = 0;
+
+        // 행 패턴: 두 차선 (중심 이동), 차선 하나, 잡음 (피크 > 4개), 빈 행, 임의 값
+        for (int r = 0; r < ROWS; r++) begin
+            for (int i = 0; i < 32; i++) rows[r][i] = 8'd20;
+            case (r % 6)
+                0, 1: begin
+                    rows[r][6 + r] = 8'd200;
+                    rows[r][20 + r] = 8'd220;
+                end
+                2: rows[r][12] = 8'd250;
+                3: for (int i = 2; i < 30; i += 5) rows[r][i] = 8'd180;
+                4: ;
+                5: for (int i = 0; i < 32; i++) rows[r][i] = $urandom_range(0, 255);
+            endcase
+        end
+        reference();
+
+        #40;
+        rst = 1;
+        #20;
+
+        // 행을 공백 없이 연속 전송 (클럭당 1픽셀)
+        @(negedge clk);
+        start = 1;
+        for (int r = 0; r < ROWS; r++) begin
+            for (int i = 0; i < 32; i++) begin
+                rx_valid = 1;
+                rx_data = rows[r][i];
+                @(negedge clk);
+                start = 0;
+            end
+        end
+        rx_valid = 0;
+
+        repeat (20) @(posedge clk);
+
+        if (got_count != ROWS) begin
+            $display("✗ %0d results (exp %0d)", got_count, ROWS);
+            error_count++;
+        end else if ((last_done_time - first_done_time) / 10 != 32 * (ROWS - 1)) begin
+            $display("✗ result spacing %0d cycles over %0d rows", (last_done_time - first_done_time) / 10, ROWS);
+            error_count++;
+        end else
+            $display("✓ line rate: one result every 32 cycles");
+
+        if (error_count == 0) $display("✓ TEST PASSED");
+        else                  $display("✗ TEST FAILED: %0d errors", error_count);
+        $display("--- Lane Peak Detector Test FINISHED ---");
+        $finish;
+    end
+
+endmodule
@@ -10,6 +10,11 @@ module tb_max_pooling;
     logic signed [21:0] result_out;
     logic result_valid;
     logic done_signal;
+    logic [2:0] i_img_width = 3'd4;
+    logic [2:0] i_img_height = 3'd4;
+    int result_count = 0;
+    int error_count = 0;
+    int expected [4] = '{6, 8, 14, 16};   // 1~16 순서 입력의 2x2 최댓값
 
     // --- Max_Pooling DUT 인스턴스 ---
     Max_Pooling #(
@@ -26,12 +31,12 @@ module tb_max_pooling;
         $display("--- Max_Pooling Unit Test START ---");
 
         // --- 초기화 ---
-        rst = 1;
+        rst = 0;   // Active Low
         start_signal = 0;
         pixel_valid = 0;
         pixel_in = 0;
         #20;
-        rst = 0;
+        rst = 1;
         #10;
 
         // --- 시작 신호 ---
@@ -58,6 +63,12 @@ module tb_max_pooling;
         wait(done_signal);
         #20;
 
+        if (result_count != 4) begin
+            $display("✗ %0d results (expected 4)", result_count);
+            error_count++;
+        end
+        if (error_count == 0) $display("✓ TEST PASSED");
+        else                  $display("✗ TEST FAILED: %0d errors", error_count);
         $display("--- Max_Pooling Unit Test FINISHED ---");
         $finish;
     end
@@ -68,12 +79,13 @@ module tb_max_pooling;
             // 결과가 유효할 때마다 입력 윈도우와 최종 결과를 출력
             $display("----------------------------------------------------");
             $display("Time=%0t, Result Valid!", $time);
-            $display("  >> Window Top Left  (line_buffer[cnt_x-1]) = %d", dut.win_top_left);
-            $display("  >> Window Top Right (line_buffer[cnt_x])   = %d", dut.win_top_right);
-            $display("  >> Window Bot Left  (pixel_d1)             = %d", dut.win_bot_left);
-            $display("  >> Window Bot Right (pixel_in)             = %d", dut.win_bot_right);
             $display("  >> MAX Result                               = %d", result_out);
             $display("----------------------------------------------------");
+            if (result_count < 4 && result_out !== 22'(expected[result_count])) begin
+                $display("✗ result %0d = %0d (expected %0d)", result_count, result_out, expected[result_count]);
+                error_count++;
+            end
+            result_count++;
         end
     end
 
@@ -0,0 +1,170 @@
+`timescale 1ns/1ps
+module tb_spi_frame_receiver;
+
+    // 1. DUT 신호 선언 (시스템 100 MHz, SCLK 62.5 MHz: 기존 오버샘플링 한계 25 MHz 이상)
+    localparam LEN = 16;
+    localparam real SCLK_HALF = 8.0;
+
+    logic clk;
+    logic rst;
+    logic i_sclk, i_ss_n;
+    logic [3:0] i_io;
+    logic o_miso, o_miso_oe;
+    logic [15:0] i_expected_len = LEN;
+    logic i_frame_ready;
+    logic o_frame_start, o_pixel_valid, o_frame_done, o_frame_ok;
+    logic [7:0] o_pixel_data;
+    logic [7:0] o_seq;
+    logic [15:0] o_frame_count, o_error_count;
+    logic o_busy;
+
+    spi_frame_receiver #(.FIFO_DEPTH(64)) dut (.*);
+
+    // 2. 클럭 생성 (SCLK는 트랜잭션 중에만)
+    initial clk = 0;
+    always #5 clk = ~clk;
+
+    logic [7:0] pixels [$], got [$];
+    logic [7:0] miso_byte;
+    integer start_count, done_count, ok_count;
+    integer error_count = 0;
+
+    // 3. CNN 쪽 출력 수집
+    always @(posedge clk) begin
+        if (o_frame_start) start_count++;
+        if (o_pixel_valid) got.push_back(o_pixel_data);
+        if (o_frame_done) begin
+            done_count++;
+            if (o_frame_ok) ok_count++;
+        end
+    end
+
+    function automatic logic [15:0] crc16(input logic [7:0] data [$]);
+        logic [15:0] c = 16'hFFFF;
+        foreach (data[k]) begin
+            c ^= {data[k], 8'h00};
+            for (int i = 0; i < 8; i++) c = c[15] ? ((c << 1) ^ 16'h1021) : (c << 1);
+        end
+        return c;
+    endfunction
+
+    // SPI 마스터 (모드 0): 명령은 1비트, 데이터는 1비트 또는 쿼드
+    task automatic spi_transfer(input logic [7:0] cmd, input logic [7:0] data [$], input logic quad_data);
+        i_ss_n = 0;
+        #30;   // SS → 첫 SCLK 리드 타임
+        for (int b = 7; b >= 0; b--) begin
+            i_io[0] = cmd[b];
+            #(SCLK_HALF) i_sclk = 1;
+            miso_byte[b] = o_miso;
+            #(SCLK_HALF) i_sclk = 0;
+        end
+        foreach (data[k]) begin
+            if (quad_data) begin
+                for (int n = 1; n >= 0; n--) begin
+                    i_io = data[k][4*n +: 4];
+                    #(SCLK_HALF) i_sclk = 1;
+                    #(SCLK_HALF) i_sclk = 0;
+                end
+            end else begin
+                for (int b = 7; b >= 0; b--) begin
+                    i_io[0] = data[k][b];
+                    #(SCLK_HALF) i_sclk = 1;
+                    #(SCLK_HALF) i_sclk = 0;
+                end
+            end
+        end
+        #20 i_ss_n = 1;
+        i_io = 4'h0;
+        #100;
+    endtask
+
+    // 프레임 패킷: 헤더 + 픽셀 + CRC (crc_xor로 오류 주입, keep으로 잘린 전송)
+    task automatic send_frame(input logic [7:0] seq, input logic quad, input logic [15:0] crc_xor,
+                              input int keep, input int garbage);
+        logic [7:0] pkt [$];
+        logic [7:0] body [$];
+        logic [15:0] crc;
+        pixels.delete();
+        for (int i = 0; i < LEN; i++) pixels.push_back($urandom_range(0, 255));
+        body = {seq, 8'(LEN), 8'(LEN >> 8)};
+        foreach (pixels[i]) body.push_back(pixels[i]);
+        crc = crc16(body) ^ crc_xor;
+        for (int i = 0; i < garbage; i++) pkt.push_back(8'h11 * i);
+        pkt.push_back(8'hA5);
+        pkt.push_back(8'h5A);
+        foreach (body[i]) pkt.push_back(body[i]);
+        pkt.push_back(crc[15:8]);
+        pkt.push_back(crc[7:0]);
+        while (pkt.size() > keep) void'(pkt.pop_back());
+        spi_transfer(quad ? 8'h32 : 8'h02, pkt, quad);
+    endtask
+
+    // n_real: 실제로 보낸 픽셀 수 (나머지는 0으로 채워져야 함)
+    task automatic check(input string name, input bit exp_ok, input int n_real);
+        logic [7:0] exp [$];
+        for (int i = 0; i < LEN; i++) exp.push_back((i < n_real) ? pixels[i] : 8'h00);
+        repeat (50) @(posedge clk);
+        if (start_count != 1 || done_count != 1 || ok_count != int'(exp_ok) || got != exp) begin
+            $display("✗ %s: start %0d, done %0d, ok %0d, pixels %0d", name, start_count, done_count, ok_count, got.size());
+            error_count++;
+        end else begin
+            $display("✓ %s: %0d pixels, ok %0d, frames %0d, errors %0d", name, got.size(), ok_count,
+                     o_frame_count, o_error_count);
+        end
+        start_count = 0; done_count = 0; ok_count = 0;
+        got.delete();
+    endtask
+
+    // 4. 테스트 시나리오
+    initial begin
+        $display("--- SPI Frame Receiver Test START ---");
+        rst = 0;   // Active Low
+        i_sclk = 0; i_ss_n = 1; i_io = 0;
+        i_frame_ready = 1;
+        start_count = 0; done_count = 0; ok_count = 0;
+        #40;
+        rst = 1;
+        #50;
+
+        // 상태만 읽기: ready = 1, busy = 0
+        spi_transfer(8'h05, {}, 1'b0);
+        if (miso_byte[7] && !miso_byte[6]) $display("✓ status byte 0x%02h (ready)", miso_byte);
+        else begin
+            $display("✗ status byte 0x%02h", miso_byte);
+            error_count++;
+        end
+
+        send_frame(8'h01, 1'b0, 16'h0000, 1000, 0);
+        check("single-bit frame", 1'b1, LEN);
+        send_frame(8'h02, 1'b1, 16'h0000, 1000, 3);
+        check("quad frame after garbage bytes", 1'b1, LEN);
+        send_frame(8'h03, 1'b0, 16'h0400, 1000, 0);
+        check("CRC error reported", 1'b0, LEN);
+        send_frame(8'h04, 1'b1, 16'h0000, 10, 0);
+        check("truncated frame padded", 1'b0, 5);
+        send_frame(8'h05, 1'b1, 16'h0000, 1000, 0);
+        check("resync on next frame", 1'b1, LEN);
+
+        // 상태 바이트: 마지막 seq 5, 불량 플래그 해제
+        spi_transfer(8'h05, {}, 1'b0);
+        if (miso_byte[3:0] == 4'd5 && !miso_byte[5] && o_seq == 8'h05 && o_frame_count == 3 && o_error_count == 2)
+            $display("✓ status seq %0d, frames %0d, errors %0d", miso_byte[3:0], o_frame_count, o_error_count);
+        else begin
+            $display("✗ status 0x%02h, frames %0d, errors %0d", miso_byte, o_frame_count, o_error_count);
+            error_count++;
+        end
+
+        if (error_count == 0) $display("✓ TEST PASSED");
+        else                  $display("✗ TEST FAILED: %0d errors", error_count);
+        $display("--- SPI Frame Receiver Test FINISHED ---");
+        $finish;
+    end
+
+    // 타임아웃
+    initial begin
+        #1_000_000;
+        $display("✗ TIMEOUT");
+        $finish;
+    end
+
+endmodule
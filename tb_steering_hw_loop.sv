@@ -0,0 +1,306 @@
+`timescale 1ns/1ps
+module tb_steering_hw_loop;
+
+    // 1. DUT 신호 선언 (myip_CNN_v1_0과 같은 연결: PID → steering_mixer → axil_pwm_writer)
+    localparam DEAD = 50;
+
+    logic clk;
+    logic rst;
+    logic enable, clear;
+    logic [4:0] err_shift;
+    logic signed [15:0] kp, ki, kd;
+    logic [23:0] int_limit;
+    logic [7:0] base, steer_max, rate;
+    logic cnn_valid;
+    logic signed [47:0] cnn_error;
+    logic [1:0] cnn_class;
+    logic [1:0] class_pipe [0:3];       // myip_CNN_v1_0과 같이 PID 지연만큼 클래스 지연
+
+    logic pid_valid;
+    logic signed [15:0] pid_out;
+    logic mix_valid;
+    logic signed [7:0] mix_steer;
+    logic [6:0] duty_l, duty_r;
+    logic pwm_busy, pwm_armed;
+    logic [7:0] pwm_errors;
+    logic [31:0] pwm_updates;
+
+    logic [31:0] awaddr, wdata;
+    logic [2:0] awprot;
+    logic [3:0] wstrb;
+    logic awvalid, awready, wvalid, wready, bvalid, bready;
+    logic [1:0] bresp;
+
+    PID_Controller u_pid (
+        .clk(clk), .rst(rst),
+        .i_clear(clear | ~enable),
+        .i_err_shift(err_shift),
+        .i_kp(kp), .i_ki(ki), .i_kd(kd),
+        .i_int_limit(int_limit),
+        .i_out_limit(steer_max),
+        .i_cnn_valid(cnn_valid),
+        .i_cnn_error(cnn_error),
+        .o_pid_valid(pid_valid),
+        .o_pid_output(pid_out)
+    );
+
+    steering_mixer u_mixer (
+        .clk(clk), .rst(rst),
+        .i_clear(clear | ~enable),
+        .i_base(base), .i_steer_max(steer_max), .i_rate(rate),
+        .i_valid(pid_valid), .i_steer(pid_out), .i_class(class_pipe[3]),
+        .o_valid(mix_valid), .o_steer(mix_steer),
+        .o_duty_l(duty_l), .o_duty_r(duty_r)
+    );
+
+    axil_pwm_writer #(
+        .C_PWM_BASEADDR(32'h44A1_0000),
+        .DEAD_CYCLES(DEAD)
+    ) u_writer (
+        .clk(clk), .rst(rst),
+        .i_enable(enable),
+        .i_valid(mix_valid), .i_duty_l(duty_l), .i_duty_r(duty_r),
+        .o_busy(pwm_busy), .o_armed(pwm_armed),
+        .o_err_count(pwm_errors), .o_update_count(pwm_updates),
+        .m_axi_awaddr(awaddr), .m_axi_awprot(awprot), .m_axi_awvalid(awvalid), .m_axi_awready(awready),
+        .m_axi_wdata(wdata), .m_axi_wstrb(wstrb), .m_axi_wvalid(wvalid), .m_axi_wready(wready),
+        .m_axi_bresp(bresp), .m_axi_bvalid(bvalid), .m_axi_bready(bready)
+    );
+
+    // 2. 클럭 생성
+    initial clk = 0;
+    always #5 clk = ~clk;
+
+    longint cycle = 0;
+    always @(posedge clk) cycle++;
+
+    always @(posedge clk) begin
+        class_pipe[0] <= cnn_class;
+        for (int k = 1; k < 4; k++) class_pipe[k] <= class_pipe[k-1];
+    end
+
+    // 3. PWM IP 모델 (AXI4-Lite 슬레이브, 무작위 ready, 쓰기 기록)
+    logic [31:0] pwm_en, pwm_dir, pwm_duty;
+    logic aw_got, w_got;
+    logic [31:0] aw_q, w_q;
+    logic inject_err;
+    longint log_cycle [0:1023];
+    logic [31:0] log_addr [0:1023];
+    logic [31:0] log_data [0:1023];
+    integer log_n = 0;
+
+    always @(posedge clk or negedge rst) begin
+        if (!rst) begin
+            awready <= 0; wready <= 0; bvalid <= 0; bresp <= 0;
+            aw_got <= 0; w_got <= 0;
+            pwm_en <= 0; pwm_dir <= 0; pwm_duty <= 0;
+        end else begin
+            awready <= !aw_got && $urandom_range(0, 2) != 0;
+            wready  <= !w_got && $urandom_range(0, 2) != 0;
+            if (awvalid && awready && !aw_got) begin aw_got <= 1; aw_q <= awaddr; awready <= 0; end
+            if (wvalid && wready && !w_got)    begin w_got <= 1;  w_q <= wdata;   wready <= 0;  end
+            if (aw_got && w_got && !bvalid) begin
+                case (aw_q - 32'h44A1_0000)
+                    32'h00: pwm_en <= w_q;
+                    32'h04: pwm_dir <= w_q;
+                    32'h08: pwm_duty <= w_q;
+                endcase
+                log_cycle[log_n] = cycle;
+                log_addr[log_n] = aw_q - 32'h44A1_0000;
+                log_data[log_n] = w_q;
+                log_n++;
+                bvalid <= 1;
+                bresp <= inject_err ? 2'b10 : 2'b00;
+                aw_got <= 0; w_got <= 0;
+            end
+            if (bvalid && bready) bvalid <= 0;
+        end
+    end
+
+    // 4. 기준 모델: PID (Q8.8, 조건부 적분) + 펌웨어 cnn_apply_steering_logic + compute_lr_duty
+    longint r_integ, r_eprev, r_stprev;
+    bit r_have, r_sathi, r_satlo;
+    integer exp_l, exp_r;
+
+    task automatic ref_clear();
+        r_integ = 0; r_eprev = 0; r_have = 0; r_sathi = 0; r_satlo = 0; r_stprev = 0;
+    endtask
+
+    function automatic longint clampl(longint v, longint lo, longint hi);
+        return (v < lo) ? lo : (v > hi) ? hi : v;
+    endfunction
+
+    task automatic ref_step(longint err, bit [1:0] cls);
+        longint e, d, sum, out, smax, st, s, l, r;
+        longint lim = steer_max, b = base, rt = rate, ilim = int_limit;
+        e = clampl(err >>> err_shift, -32768, 32767);
+        d = r_have ? e - r_eprev : 0;
+        r_eprev = e;
+        r_have = 1;
+        if (!((r_sathi && e > 0) || (r_satlo && e < 0)))
+            r_integ = clampl(r_integ + e, -ilim, ilim);
+        sum = (longint'(kp) * e + longint'(ki) * r_integ + longint'(kd) * d) >>> 8;
+        r_sathi = sum > lim;
+        r_satlo = sum < -lim;
+        out = clampl(sum, -lim, lim);
+
+        // 클래스 보정 (좌 +3, 우 -3, 시작/끝 /2는 0 방향 절삭)
+        case (cls)
+            2'd1: out = clampl(out + 3, -lim, lim);
+            2'd2: out = clampl(out - 3, -lim, lim);
+            2'd3: out = out / 2;
+            default: ;
+        endcase
+
+        smax = (lim > 100) ? 100 : lim;
+        st = clampl(out, -smax, smax);
+        if (rt != 0) st = clampl(st, r_stprev - rt, r_stprev + rt);
+        r_stprev = st;
+
+        s = -st;   // STEER_SIGN
+        if (b > 100) b = 100;
+        l = clampl(b * (100 + s) / 100, 0, 100);
+        r = clampl(b * (100 - s) / 100, 0, 100);
+        if (l >= r) begin
+            if (l > 0 && l < 30) l = 30;
+            if (r > 0 && r < 14) r = 14;
+        end else begin
+            if (r > 0 && r < 30) r = 30;
+            if (l > 0 && l < 14) l = 14;
+        end
+        exp_l = l;
+        exp_r = r;
+    endtask
+
+    function automatic [31:0] pack(integer l, integer r);
+        return {8'(r), 8'(l), 8'(l), 8'(r)};
+    endfunction
+
+    // 5. 테스트 유틸
+    integer error_count = 0;
+
+    task automatic check(bit ok, string name);
+        if (ok) $display("✓ %s", name);
+        else begin
+            $display("✗ %s", name);
+            error_count++;
+        end
+    endtask
+
+    task automatic send_result(longint err, bit [1:0] cls = 2'd0);
+        @(negedge clk);
+        cnn_valid = 1;
+        cnn_error = err;
+        cnn_class = cls;
+        @(negedge clk);
+        cnn_valid = 0;
+        if (enable && !clear) ref_step(err, cls);
+    endtask
+
+    function automatic longint rand_err(int steer_range);
+        return longint'($urandom_range(0, 2 * steer_range)) * 2048 - longint'(steer_range) * 2048 +
+               longint'($urandom_range(0, 2047));
+    endfunction
+
+    // 6. 테스트 시나리오
+    initial begin
+        longint t0;
+        integer n0, mism, max_lat, lat, writes;
+        $display("--- Steering HW Loop Test START ---");
+        rst = 0;   // Active Low
+        enable = 0; clear = 0; inject_err = 0;
+        err_shift = 11; kp = 16'sh0180; ki = 16'sh0040; kd = 16'sh0080;
+        int_limit = 300; base = 50; steer_max = 80; rate = 10;
+        cnn_valid = 0; cnn_error = 0; cnn_class = 0;
+        ref_clear();
+        #40;
+        rst = 1;
+        #20;
+
+        // 6-1. 비활성: 결과가 와도 PWM 쓰기 없음
+        for (int i = 0; i < 5; i++) begin
+            send_result(rand_err(100));
+            repeat (20) @(posedge clk);
+        end
+        check(log_n == 0, "disabled loop leaves PWM alone");
+
+        // 6-2. 활성화 후 첫 결과: EN=0 → 데드타임 → DIR → DUTY → EN=F
+        @(negedge clk);
+        enable = 1;
+        send_result(rand_err(40));
+        repeat (DEAD + 60) @(posedge clk);
+        check(log_n == 4 && log_addr[0] == 0 && log_data[0] == 0 && log_addr[1] == 4 && log_data[1] == 32'h5 &&
+              log_addr[2] == 8 && log_data[2] == pack(exp_l, exp_r) && log_addr[3] == 0 && log_data[3] == 32'hF,
+              "arming sequence EN=0, DIR=fwd, DUTY, EN=F");
+        check(log_n >= 2 && log_cycle[1] - log_cycle[0] >= DEAD, "dead time before direction write");
+        check(pwm_armed, "writer armed");
+
+        // 6-3. 결과마다 DUTY 갱신 (PID + 변화량 제한 + 듀티 규칙 일치)
+        mism = 0; max_lat = 0;
+        for (int i = 0; i < 60; i++) begin
+            n0 = log_n;
+            t0 = cycle;
+            send_result(rand_err(i < 30 ? 60 : 150), 2'($urandom_range(0, 3)));   // 후반은 포화 → anti-windup
+            repeat (40) @(posedge clk);
+            if (pwm_duty != pack(exp_l, exp_r)) begin
+                $display("  result %0d: duty %08h (exp L %0d R %0d)", i, pwm_duty, exp_l, exp_r);
+                mism++;
+            end
+            if (log_n > n0) begin
+                lat = log_cycle[n0] - t0;
+                if (lat > max_lat) max_lat = lat;
+            end
+        end
+        check(mism == 0, "duty matches PID + class adjust + compute_lr_duty reference for every result");
+        $display("  result -> PWM write latency <= %0d cycles", max_lat);
+        check(max_lat <= 30, "steering update latency below 30 cycles");
+        check(pwm_en == 32'hF && pwm_dir == 32'h5, "EN / DIR untouched in steady state");
+
+        // 6-4. 연속 결과: 쓰기 중 갱신은 최신 값으로 합침
+        n0 = log_n;
+        for (int i = 0; i < 8; i++) begin
+            send_result(rand_err(60), 2'(i));
+            repeat (4) @(negedge clk);
+        end
+        repeat (40) @(posedge clk);
+        writes = log_n - n0;
+        $display("  8 back-to-back results -> %0d DUTY writes", writes);
+        check(pwm_duty == pack(exp_l, exp_r), "coalesced burst ends on latest duty");
+
+        // 6-5. 적분 초기화 (clear 펄스)
+        @(negedge clk);
+        clear = 1;
+        @(negedge clk);
+        clear = 0;
+        ref_clear();
+        send_result(rand_err(60));
+        repeat (40) @(posedge clk);
+        check(pwm_duty == pack(exp_l, exp_r), "clear resets integrator and rate limiter");
+
+        // 6-6. 쓰기 오류 응답 계수
+        inject_err = 1;
+        n0 = log_n;
+        for (int i = 0; i < 4 && log_n == n0; i++) begin
+            send_result(longint'(i % 2 ? -70 : 70) * 2048);   // 부호 교대 → 듀티가 반드시 바뀜
+            repeat (40) @(posedge clk);
+        end
+        inject_err = 0;
+        check(pwm_errors == 1, "SLVERR counted");
+
+        // 6-7. 비활성화: EN=0, 이후 결과 무시
+        @(negedge clk);
+        enable = 0;
+        repeat (20) @(posedge clk);
+        check(pwm_en == 0 && !pwm_armed && !pwm_busy, "disable stops motors and releases PWM");
+        n0 = log_n;
+        send_result(rand_err(60));
+        repeat (40) @(posedge clk);
+        check(log_n == n0, "no writes after disable");
+
+        if (error_count == 0) $display("✓ TEST PASSED");
+        else                  $display("✗ TEST FAILED: %0d errors", error_count);
+        $display("--- Steering HW Loop Test FINISHED ---");
+        $finish;
+    end
+
+endmodule
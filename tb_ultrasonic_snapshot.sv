@@ -0,0 +1,172 @@
+`timescale 1ns/1ps
+module tb_ultrasonic_snapshot;
+
+    // 1. DUT 신호 선언 (CLK_HZ를 낮춰 1 "ms" = 100클럭)
+    localparam CLK_HZ = 100_000;
+
+    logic clk;
+    logic rst;
+    logic enable;
+    logic [1:0] filter;
+    logic [7:0] period_ms;
+    logic [9:0] max_cm;
+    logic [7:0] wall_cm, steer_k, near_cm;
+    logic [2:0][11:0] bcd;
+    logic [31:0] now;
+
+    logic [2:0][9:0] cm;
+    logic [2:0] valid;
+    logic signed [15:0] obstacle;
+    logic [31:0] ts;
+    logic [7:0] seq;
+    logic [15:0] rejects;
+
+    ultrasonic_snapshot #(.CLK_HZ(CLK_HZ)) dut (
+        .clk, .rst,
+        .i_enable(enable), .i_filter(filter), .i_period_ms(period_ms), .i_max_cm(max_cm),
+        .i_wall_cm(wall_cm), .i_steer_k(steer_k), .i_near_cm(near_cm),
+        .i_bcd(bcd), .i_now(now),
+        .o_cm(cm), .o_valid(valid), .o_obstacle(obstacle), .o_ts(ts), .o_seq(seq), .o_rejects(rejects)
+    );
+
+    // 2. 클럭 생성 + 타임스탬프 카운터
+    initial clk = 0;
+    always #5 clk = ~clk;
+
+    always_ff @(posedge clk or negedge rst) begin
+        if(!rst) now <= 0;
+        else     now <= now + 1;
+    end
+
+    // 3. 테스트 유틸
+    integer error_count = 0;
+
+    task automatic check(bit ok, string name);
+        if (ok) $display("✓ %s", name);
+        else begin
+            $display("✗ %s", name);
+            error_count++;
+        end
+    endtask
+
+    function automatic logic [11:0] to_bcd(int v);
+        return {4'(v / 100), 4'((v / 10) % 10), 4'(v % 10)};
+    endfunction
+
+    task automatic set_cm(int f, int r, int l);
+        @(negedge clk);
+        bcd[0] = to_bcd(f);
+        bcd[1] = to_bcd(r);
+        bcd[2] = to_bcd(l);
+    endtask
+
+    task automatic wait_snapshots(int n);
+        repeat (n) begin
+            logic [7:0] s0 = seq;
+            while (seq == s0) @(posedge clk);
+        end
+        @(negedge clk);
+    endtask
+
+    // 펌웨어 auto_step_with_cnn과 같은 장애물 조향 항
+    function automatic int ref_obstacle(int r, int l);
+        int s = 0, near;
+        if (r > 0 && r <= wall_cm) s += (wall_cm - r) * steer_k;
+        if (l > 0 && l <= wall_cm) s -= (wall_cm - l) * steer_k;
+        near = (r == 0) ? l : ((l == 0) ? r : ((r < l) ? r : l));
+        if (near > 0 && near <= near_cm) s *= 2;
+        return s;
+    endfunction
+
+    // 4. 테스트 시나리오
+    initial begin
+        int s0, t0;
+        $display("--- Ultrasonic Snapshot Test START ---");
+        rst = 0;   // Active Low
+        enable = 0; filter = 2'd1; period_ms = 8'd5; max_cm = 10'd400;
+        wall_cm = 8'd50; steer_k = 8'd22; near_cm = 8'd35;
+        bcd = '0;
+        #100;
+        rst = 1;
+
+        // 4-1. 샘플 주기: 5 "ms"마다 스냅샷 한 개
+        set_cm(90, 40, 30);
+        enable = 1;
+        wait_snapshots(1);
+        s0 = seq;
+        t0 = ts;
+        wait_snapshots(3);
+        check(8'(seq - s0) == 3 && ts - t0 == 3 * 5 * 100, $sformatf("snapshot every period (dt %0d cycles)", ts - t0));
+
+        // 4-2. 평균 필터 + 장애물 조향 항 (오른쪽 40, 왼쪽 30 → 가까운 쪽 35 이하 2배)
+        check(cm[0] == 90 && cm[1] == 40 && cm[2] == 30 && valid == 3'b111, "steady readings in cm");
+        check(obstacle == ref_obstacle(40, 30), $sformatf("obstacle term %0d (expect %0d)", obstacle, ref_obstacle(40, 30)));
+
+        // 4-3. 범위 밖 (450 cm) / BCD 오류는 버리고 계수, 남은 유효 샘플 평균
+        set_cm(450, 40, 30);
+        wait_snapshots(1);
+        check(cm[0] == 90 && rejects == 1, "out-of-range sample rejected and counted");
+        @(negedge clk);
+        bcd[0] = 12'h0A5;
+        wait_snapshots(1);
+        check(cm[0] == 90 && rejects == 2, "bad BCD digit rejected");
+        set_cm(0, 40, 30);
+        wait_snapshots(1);
+        check(cm[0] == 0 && !valid[0] && rejects == 2, "no echo: channel invalid, not counted as error");
+
+        // 4-4. 평균 vs 중앙값 (90, 10, 92 → 평균 64, 중앙값 90)
+        set_cm(90, 40, 30); wait_snapshots(1);
+        set_cm(10, 40, 30); wait_snapshots(1);
+        set_cm(92, 40, 30); wait_snapshots(1);
+        check(cm[0] == (90 + 10 + 92) / 3, $sformatf("moving average of 3 valid samples (%0d)", cm[0]));
+        filter = 2'd2;
+        set_cm(90, 40, 30); wait_snapshots(1);
+        set_cm(10, 40, 30); wait_snapshots(1);
+        set_cm(92, 40, 30); wait_snapshots(1);
+        check(cm[0] == 90, $sformatf("median rejects single outlier (%0d)", cm[0]));
+        filter = 2'd0;
+        wait_snapshots(1);
+        check(cm[0] == 92, "filter 0 publishes latest sample");
+
+        // 4-5. 양쪽 벽 / 한쪽 벽 / 먼 벽 조향 항
+        filter = 2'd1;
+        set_cm(90, 20, 0); wait_snapshots(3);
+        check(obstacle == ref_obstacle(20, 0) && obstacle > 0, $sformatf("right wall only: %0d", obstacle));
+        set_cm(90, 45, 48); wait_snapshots(3);
+        check(obstacle == ref_obstacle(45, 48), $sformatf("far walls, no boost: %0d", obstacle));
+
+        // 4-6. 자리가 바뀌는 중인 입력은 안정될 때까지 샘플하지 않음
+        s0 = seq;
+        fork
+            begin
+                repeat (2000) begin
+                    @(negedge clk);
+                    bcd[0] = bcd[0] ^ 12'h011;
+                end
+            end
+        join
+        check(seq == s0, "no snapshot while inputs toggle every cycle");
+        set_cm(90, 45, 48);
+        wait_snapshots(1);
+        check(seq == 8'(s0 + 1), "sampling resumes once inputs are stable");
+
+        // 4-7. 비활성: 스냅샷 유지, 번호 정지
+        enable = 0;
+        s0 = seq;
+        repeat (3000) @(negedge clk);
+        check(seq == s0 && cm[0] != 0, "disabled: last snapshot held");
+
+        if (error_count == 0) $display("✓ TEST PASSED");
+        else                  $display("✗ TEST FAILED: %0d errors", error_count);
+        $display("--- Ultrasonic Snapshot Test FINISHED ---");
+        $finish;
+    end
+
+    // 타임아웃
+    initial begin
+        #5_000_000;
+        $display("✗ TIMEOUT");
+        $finish;
+    end
+
+endmodule
@@ -0,0 +1,203 @@
+/* ===== 바이너리 텔레메트리 / 명령 프레임 (telem.h) ===== */
+#include "telem.h"
+
+/* ================= CRC / 프레임 ================= */
+
+u16 telem_crc16(u16 crc, const u8 *p, int n) {
+    for (int i = 0; i < n; i++) {
+        crc ^= (u16)p[i] << 8;
+        for (int b = 0; b < 8; b++) crc = (crc & 0x8000) ? (u16)((crc << 1) ^ 0x1021) : (u16)(crc << 1);
+    }
+    return crc;
+}
+
+int telem_frame_encode(u8 *out, u8 type, const u8 *payload, u8 len) {
+    out[0] = TELEM_SYNC0;
+    out[1] = TELEM_SYNC1;
+    out[2] = type;
+    out[3] = len;
+    for (int i = 0; i < len; i++) out[4 + i] = payload[i];
+    u16 crc = telem_crc16(0xFFFF, &out[2], 2 + len);
+    out[4 + len] = (u8)crc;
+    out[5 + len] = (u8)(crc >> 8);
+    return TELEM_OVERHEAD + len;
+}
+
+/* ================= 리틀 엔디언 필드 ================= */
+
+static u8 *put16(u8 *p, u16 v) { p[0] = (u8)v; p[1] = (u8)(v >> 8); return p + 2; }
+static u8 *put32(u8 *p, u32 v) { p = put16(p, (u16)v); return put16(p, (u16)(v >> 16)); }
+static u16 get16(const u8 **p) { u16 v = (u16)((*p)[0] | ((*p)[1] << 8)); *p += 2; return v; }
+static u32 get32(const u8 **p) { u32 lo = get16(p); return lo | ((u32)get16(p) << 16); }
+
+void telem_record_pack(u8 *out, const TelemRecord *r) {
+    u8 *p = out;
+    p = put32(p, r->t_us);
+    p = put16(p, r->seq);
+    for (int i = 0; i < 3; i++) p = put16(p, r->ultra_cm[i]);
+    p = put32(p, (u32)r->cnn_steer);
+    p = put32(p, r->cnn_seq);
+    p = put32(p, r->cnn_age_us);
+    *p++ = (u8)r->cnn_class;
+    *p++ = r->mode;
+    *p++ = r->flags;
+    *p++ = (u8)r->speed;
+    *p++ = (u8)r->steer;
+    *p++ = r->duty_l;
+    *p++ = r->duty_r;
+    *p++ = r->reserved;
+    p = put16(p, r->exec_us);
+    put16(p, r->drops);
+}
+
+void telem_record_unpack(TelemRecord *r, const u8 *in) {
+    const u8 *p = in;
+    r->t_us = get32(&p);
+    r->seq = get16(&p);
+    for (int i = 0; i < 3; i++) r->ultra_cm[i] = get16(&p);
+    r->cnn_steer = (s32)get32(&p);
+    r->cnn_seq = get32(&p);
+    r->cnn_age_us = get32(&p);
+    r->cnn_class = (s8)*p++;
+    r->mode = *p++;
+    r->flags = *p++;
+    r->speed = (s8)*p++;
+    r->steer = (s8)*p++;
+    r->duty_l = *p++;
+    r->duty_r = *p++;
+    r->reserved = *p++;
+    r->exec_us = get16(&p);
+    r->drops = get16(&p);
+}
+
+void telem_status_pack(u8 *out, const TelemStatus *s) {
+    u8 *p = out;
+    p = put32(p, s->cnn_status);
+    p = put32(p, s->cnn_frames);
+    p = put32(p, s->cnn_timeouts);
+    p = put32(p, s->cnn_seq_lost);
+    p = put32(p, s->cnn_lat_last_cyc);
+    p = put32(p, s->cnn_lat_max_cyc);
+    p = put32(p, s->cnn_stale);
+    p = put32(p, s->cnn_reused);
+    p = put32(p, s->telem_drops);
+    p = put16(p, s->telem_peak);
+    put16(p, s->cmd_errors);
+}
+
+void telem_status_unpack(TelemStatus *s, const u8 *in) {
+    const u8 *p = in;
+    s->cnn_status = get32(&p);
+    s->cnn_frames = get32(&p);
+    s->cnn_timeouts = get32(&p);
+    s->cnn_seq_lost = get32(&p);
+    s->cnn_lat_last_cyc = get32(&p);
+    s->cnn_lat_max_cyc = get32(&p);
+    s->cnn_stale = get32(&p);
+    s->cnn_reused = get32(&p);
+    s->telem_drops = get32(&p);
+    s->telem_peak = get16(&p);
+    s->cmd_errors = get16(&p);
+}
+
+/* ================= 수신 파서 ================= */
+
+enum { P_SYNC0, P_SYNC1, P_TYPE, P_LEN, P_PAYLOAD, P_CRC_LO, P_CRC_HI };
+
+void telem_parser_reset(TelemParser *p) {
+    p->state = P_SYNC0;
+    p->pos = 0;
+}
+
+/**
+ * 한 바이트 처리. 동기 바이트가 아닌 프레임 밖 바이트는 -1 (호출 측이 텍스트 키로 처리)
+ * 동기 0xA5 뒤에 0x5A가 아니면 그 바이트도 프레임 밖으로 돌려줌
+ */
+int telem_parser_feed(TelemParser *p, u8 byte) {
+    switch (p->state) {
+    case P_SYNC0:
+        if (byte != TELEM_SYNC0) return -1;
+        p->state = P_SYNC1;
+        return 0;
+    case P_SYNC1:
+        if (byte == TELEM_SYNC1) { p->state = P_TYPE; return 0; }
+        if (byte == TELEM_SYNC0) return 0;
+        p->state = P_SYNC0;
+        return -1;
+    case P_TYPE:
+        p->type = byte;
+        p->state = P_LEN;
+        return 0;
+    case P_LEN:
+        if (byte > TELEM_MAX_PAYLOAD) {
+            p->errors++;
+            p->state = P_SYNC0;
+            return 0;
+        }
+        p->len = byte;
+        p->pos = 0;
+        p->state = byte ? P_PAYLOAD : P_CRC_LO;
+        return 0;
+    case P_PAYLOAD:
+        p->payload[p->pos++] = byte;
+        if (p->pos == p->len) p->state = P_CRC_LO;
+        return 0;
+    case P_CRC_LO:
+        p->crc_rx = byte;
+        p->state = P_CRC_HI;
+        return 0;
+    case P_CRC_HI: {
+        u8 hdr[2] = { p->type, p->len };
+        u16 crc = telem_crc16(telem_crc16(0xFFFF, hdr, 2), p->payload, p->len);
+        p->crc_rx |= (u16)byte << 8;
+        p->state = P_SYNC0;
+        if (crc != p->crc_rx) {
+            p->errors++;
+            return 0;
+        }
+        p->frames++;
+        return 1;
+    }
+    default:
+        p->state = P_SYNC0;
+        return 0;
+    }
+}
+
+/* ================= 송신 링 ================= */
+
+#define RING_MASK (TELEM_RING_SIZE - 1)
+
+static u8 ring[TELEM_RING_SIZE];
+static volatile u32 ring_head = 0;      // 메인만 씀 (프레임 전체를 쓴 뒤 공개)
+static volatile u32 ring_tail = 0;      // TX ISR만 씀
+static u32 ring_drops = 0;
+static u32 ring_peak = 0;
+
+int telem_tx_send(u8 type, const u8 *payload, u8 len) {
+    u8 frame[TELEM_MAX_PAYLOAD + TELEM_OVERHEAD];
+    if (len > TELEM_MAX_PAYLOAD) return -1;
+    int n = telem_frame_encode(frame, type, payload, len);
+
+    u32 head = ring_head;
+    u32 used = head - ring_tail;
+    if (TELEM_RING_SIZE - used < (u32)n) {
+        ring_drops++;
+        return -1;
+    }
+    for (int i = 0; i < n; i++) ring[(head + i) & RING_MASK] = frame[i];
+    ring_head = head + n;
+    if (used + n > ring_peak) ring_peak = used + n;
+    return 0;
+}
+
+int telem_tx_pull(u8 *byte) {
+    u32 tail = ring_tail;
+    if (tail == ring_head) return 0;
+    *byte = ring[tail & RING_MASK];
+    ring_tail = tail + 1;
+    return 1;
+}
+
+u32 telem_tx_drops(void) { return ring_drops; }
+u32 telem_tx_peak(void)  { return ring_peak; }
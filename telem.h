@@ -0,0 +1,121 @@
+/* ===== 바이너리 텔레메트리 / 명령 프레임 =====
+ * 프레임: 0xA5 0x5A | type | len | payload[len] | CRC16 (하위, 상위)
+ *   CRC-16/CCITT-FALSE (다항식 0x1021, 초기값 0xFFFF), type + len + payload에 대해 계산
+ *   동기 바이트는 ASCII 밖 → 같은 UART에서 텍스트 키 입력 / 콘솔 출력과 구분 (프레임 밖 바이트는 텍스트)
+ * 다중 바이트 필드는 리틀 엔디언, 구조체를 그대로 보내지 않고 pack/unpack으로 고정 배치
+ * 펌웨어 (Microblaze.c)와 호스트 도구 (sim/telem_tool.c)가 같은 코드를 사용.
+ *
+ * 송신 링: 제어 루프는 프레임을 링에 넣기만 하고 (자리가 없으면 프레임 통째로 버리고 계수),
+ * UART TX 인터럽트가 telem_tx_pull로 한 바이트씩 꺼내 보냄 → 제어 루프는 UART를 기다리지 않음.
+ * 생산자는 메인 루프 하나, 소비자는 TX ISR 하나 (잠금 없음). */
+#ifndef TELEM_H
+#define TELEM_H
+
+#include "hal.h"
+
+#define TELEM_SYNC0          0xA5
+#define TELEM_SYNC1          0x5A
+#define TELEM_MAX_PAYLOAD    64
+#define TELEM_OVERHEAD       6        // 동기 2 + type + len + CRC 2
+#define TELEM_RING_SIZE      2048     // 송신 링 (2의 거듭제곱), 115200 bps에서 약 180 ms 분량
+
+/* ===== 프레임 종류 =====
+ * 대상 → 호스트: 0x01~ 기록, 0x80 응답 / 호스트 → 대상: 0x10~ 명령 */
+enum {
+    TELEM_T_RECORD = 0x01,    // 제어 주기 기록 (TelemRecord)
+    TELEM_T_STATUS = 0x02,    // CNN / 텔레메트리 상태 (TelemStatus)
+    TELEM_C_DRIVE  = 0x10,    // s8 속도 (-100..100), s8 조향 (-80..80): 텍스트 'C' 명령 대체
+    TELEM_C_KEY    = 0x11,    // u8 키: 한 글자 키 명령 실행
+    TELEM_C_STREAM = 0x12,    // u8 켜기, u8 간격 (제어 주기 N번에 한 번, 0 → 1)
+    TELEM_C_STATUS = 0x13,    // 페이로드 없음 → TELEM_T_STATUS 응답
+    TELEM_C_FC_WT  = 0x14,    // u8 뉴런, u16 시작 인덱스, s32 가중치 1~15개 → 섀도 뱅크 (교체는 키 'B')
+    TELEM_C_SEQ_NET = 0x15,   // u8 첫 레이어, 레이어 1~6개 x 10바이트 (op, relu, in_shift, out_shift,
+                              // in_w, in_h, in_c, out_c, u16 커널 베이스) → 레이어 수 = 첫 레이어 + 개수
+    TELEM_C_SEQ_WT = 0x16,    // u16 시작 워드, s32 conv 커널 값 1~15개 → 시퀀서 커널 메모리
+    TELEM_C_GEOMETRY = 0x17,  // u8 폭, u8 높이, u8 log2(stride), u8 same 패딩 → 다음 프레임부터 (FC 가중치는 'fcwt'로 맞춤)
+    TELEM_C_PREPROC = 0x18,   // u8 포맷, u16 원본 폭, u16 x0, u16 y0, u16 ROI 폭, u16 ROI 높이, u8 dx, u8 dy (dx = 0 → 끄기)
+    TELEM_T_ACK    = 0x80,    // u8 명령 종류, u8 결과 (TELEM_ACK_*)
+};
+
+enum {
+    TELEM_ACK_OK      = 0,
+    TELEM_ACK_BAD_LEN = 1,
+    TELEM_ACK_UNKNOWN = 2,
+    TELEM_ACK_REJECTED = 3,   // 값 범위 밖 / 하드웨어 대기 타임아웃 (실행 안 함)
+};
+
+/* ===== 제어 주기 기록 (제어 태스크마다 하나) ===== */
+#define TELEM_RECORD_LEN     36
+
+/* mode: [1:0] auto_mode, [2] CNN 사용, [3] 킥 중, [6:4] 회피 단계 */
+/* flags */
+#define TELEM_F_CNN_NEW      (1u << 0)    // 이번 주기에 새 CNN 결과 사용
+#define TELEM_F_CNN_STALE    (1u << 1)    // 오래된 결과라 버림
+#define TELEM_F_CNN_TIMEOUT  (1u << 2)    // 결과 없음 10주기 초과 → 초음파 조향
+#define TELEM_F_PANIC        (1u << 3)    // 이번 주기에 비상 후진 시작
+#define TELEM_F_HW_LOOP      (1u << 4)    // 하드웨어 조향 루프가 PWM 소유
+#define TELEM_F_US_HW        (1u << 5)    // 초음파 값이 하드웨어 스냅샷 (아니면 센서 IP 직접 읽기)
+
+typedef struct {
+    u32 t_us;                 // 제어 태스크 시작 시각
+    u16 seq;                  // 기록 번호 (링이 가득 차 버린 기록은 번호 공백으로 보임)
+    u16 ultra_cm[3];          // 전방 / 오른쪽 / 왼쪽 (이동 평균)
+    s32 cnn_steer;            // 가공된 CNN 조향 (마지막 유효 값)
+    u32 cnn_seq;              // 다음에 기대하는 결과 시퀀스 번호
+    u32 cnn_age_us;           // 사용한 결과의 생성 후 경과 시간 (새 결과 없으면 0)
+    s8  cnn_class;            // 패턴 클래스 (-1 = 없음)
+    u8  mode;
+    u8  flags;
+    s8  speed;                // 속도 % (후진은 음수)
+    s8  steer;                // 최종 조향
+    u8  duty_l, duty_r;       // 좌/우 듀티 %
+    u8  reserved;
+    u16 exec_us;              // 제어 태스크 실행 시간 (기록 작성 제외)
+    u16 drops;                // 링 부족으로 버린 프레임 수 (누적, 포화)
+} TelemRecord;
+
+/* ===== 상태 응답 ===== */
+#define TELEM_STATUS_LEN     40
+
+typedef struct {
+    u32 cnn_status;           // STATUS 레지스터
+    u32 cnn_frames;
+    u32 cnn_timeouts;
+    u32 cnn_seq_lost;
+    u32 cnn_lat_last_cyc;     // 첫 픽셀 → 결과 (버스 클럭 사이클)
+    u32 cnn_lat_max_cyc;
+    u32 cnn_stale;
+    u32 cnn_reused;
+    u32 telem_drops;
+    u16 telem_peak;           // 송신 링 최대 점유 (바이트)
+    u16 cmd_errors;           // CRC / 길이 오류로 버린 명령 프레임
+} TelemStatus;
+
+/* ===== 프레임 부호화 / 필드 배치 ===== */
+u16  telem_crc16(u16 crc, const u8 *p, int n);
+int  telem_frame_encode(u8 *out, u8 type, const u8 *payload, u8 len);   // 프레임 길이 반환
+void telem_record_pack(u8 *out, const TelemRecord *r);
+void telem_record_unpack(TelemRecord *r, const u8 *in);
+void telem_status_pack(u8 *out, const TelemStatus *s);
+void telem_status_unpack(TelemStatus *s, const u8 *in);
+
+/* ===== 수신 파서 (바이트 단위) ===== */
+typedef struct {
+    int state;
+    u8  type, len, pos;
+    u8  payload[TELEM_MAX_PAYLOAD];
+    u16 crc_rx;
+    u32 frames;
+    u32 errors;               // CRC 불일치 / 길이 초과
+} TelemParser;
+
+void telem_parser_reset(TelemParser *p);
+int  telem_parser_feed(TelemParser *p, u8 byte);   // 1: 프레임 완성 (type/len/payload), 0: 프레임 진행 중, -1: 프레임 밖 바이트
+
+/* ===== 송신 링 (메인 → UART TX ISR) ===== */
+int  telem_tx_send(u8 type, const u8 *payload, u8 len);   // 0, 자리가 없으면 -1 (버림)
+int  telem_tx_pull(u8 *byte);                              // ISR: 보낼 바이트가 있으면 1
+u32  telem_tx_drops(void);
+u32  telem_tx_peak(void);
+
+#endif /* TELEM_H */
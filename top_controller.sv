@@ -1,183 +1,97 @@
 `timescale 1ns/1ps
-module top_controller(
+// ===== 스트리밍 차선 검출 컨트롤러 =====
+// 기존: 32픽셀 수신 → conv_engine LOAD/PROCESSING → FIND_LANES 스캔 → SELECT_PAIR 루프 (행마다 배치 처리)
+// 현재: 픽셀이 들어오는 대로 1D conv [-1, 2, -1] → lane_peak_detector (임계값/피크 추적/쌍 선택)
+//   → 32클럭마다 행을 연속으로 받을 수 있고, 행당 결과 1개 (마지막 픽셀 후 3클럭)
+// conv 출력 정의는 conv_engine과 같음: result[j] = -d[j-2] + 2*d[j-1] - d[j] (범위 밖 0), j = 0~29
+module top_controller #(
+	parameter ROW_PIXELS = 32,
+	parameter signed [17:0] THRESHOLD = 100
+)(
 	input logic clk,
-	input logic rst,
-	input logic start,
+	input logic rst,   // Active Low
+	input logic start, // 행 동기: 1이면 열 카운터를 0으로 (생략 가능, 행 경계는 픽셀 수로 추적)
 	input logic [7:0] rx_data,
-	input logic  rx_valid,
-	output logic [7:0] tx_data, //  ߽ ġ (0~29)
-	output logic [7:0] confidence, //ŷڵ (   )
-	output logic done_signal
+	input logic rx_valid,
+	output logic [7:0] tx_data,     // 차선 중심 위치 (0~29)
+	output logic [7:0] confidence,  // 신뢰도 (두 피크 세기 합)
+	output logic done_signal        // 행 결과 펄스
 );
+	localparam CONV_OUTPUTS = ROW_PIXELS - 2;
 
-	logic start_signal;
-	logic conv_engine_done;
-	logic [5:0]  count;
-	logic [255:0] flattened_pixel_data;
-	logic [7:0] pixel_row_data [0:31];
-	logic signed [17:0] result_data [0:29];
-	
-	parameter signed [17:0] THRESHOLD = 100;//  ν ּ  ( ſ)
-	localparam MAX_PEAKS = 4;
-	
-	logic [7:0] peak_positions [0:MAX_PEAKS -1];
-	logic signed [17:0] peak_values [0 : MAX_PEAKS -1];
-	logic [$clog2(MAX_PEAKS+1) : 0] peak_count;
-	
-	logic [7:0] best_peak1_pos, best_peak2_pos;
-	logic signed [17:0] best_peak1_val, best_peak2_val;
-	
-	logic [7:0] last_center_pos;
-	
-	logic [7:0] min_diff_reg;
-	logic [2:0] p1_reg, p2_reg;  // 3Ʈ  (0~7)
-	
-	enum logic [3:0] {IDLE, RECEIVE_DATA, COMPUTE, FIND_LANES, SELECT_PAIR, CALC_CENTER, SEND_RESULT} state;
-	
-	always_comb begin
-		for( int i=0;i<32;i++) flattened_pixel_data[i*8 +: 8] = pixel_row_data[i];
+	logic [$clog2(ROW_PIXELS)-1:0] col;
+	logic [7:0] prev1, prev2;   // d[j-1], d[j-2] (행 시작에서 0)
+
+	// ===== 1D conv (kernel -1, 2, -1), 1클럭 =====
+	logic conv_valid, conv_last;
+	logic signed [17:0] conv_data;
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			col <= '0;
+			prev1 <= '0;
+			prev2 <= '0;
+			conv_valid <= 1'b0;
+			conv_last <= 1'b0;
+			conv_data <= '0;
+		end else begin
+			conv_valid <= 1'b0;
+			conv_last <= 1'b0;
+			if(start && !rx_valid) begin
+				col <= '0;
+				prev1 <= '0;
+				prev2 <= '0;
+			end else if(rx_valid) begin
+				logic [$clog2(ROW_PIXELS)-1:0] c;
+				logic [7:0] p1, p2;
+				c = start ? '0 : col;
+				p1 = (c == 0) ? 8'd0 : prev1;
+				p2 = (c < 2) ? 8'd0 : prev2;
+				if(c < CONV_OUTPUTS) begin
+					conv_valid <= 1'b1;
+					conv_last <= (c == CONV_OUTPUTS - 1);
+					conv_data <= 18'sd2 * signed'({10'd0, p1}) - signed'({10'd0, p2}) - signed'({10'd0, rx_data});
+				end
+				prev2 <= p1;
+				prev1 <= rx_data;
+				col <= (c == ROW_PIXELS - 1) ? '0 : c + 1'b1;
+			end
+		end
 	end
-	
-	conv_engine U0(
+
+	// ===== 피크 검출 + 쌍 선택 =====
+	logic det_valid;
+	logic [7:0] det_center, det_confidence;
+
+	lane_peak_detector #(
+		.DATA_WIDTH(18),
+		.MAX_PEAKS(4),
+		.THRESHOLD(THRESHOLD),
+		.CENTER_INIT(CONV_OUTPUTS / 2)
+	) u_peak (
 		.clk, .rst,
-		.start(start_signal),
-		.pixel_row_data(flattened_pixel_data),
-		.done_signal(conv_engine_done),
-		.result_data
+		.i_valid(conv_valid),
+		.i_data(conv_data),
+		.i_last(conv_last),
+		.o_valid(det_valid),
+		.o_center(det_center),
+		.o_confidence(det_confidence),
+		.o_peak_count(),
+		.o_pair_found()
 	);
 
-	always_ff@(posedge clk) begin
-		if(rst) begin
-			state <= IDLE;
-			count <= '0;
-			start_signal <= '0;
-			done_signal <= '0;
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
 			tx_data <= '0;
-			pixel_row_data <= '{default: '0};
 			confidence <= '0;
-			last_center_pos <= 8'd15;
-			peak_count <= '0;
-			peak_positions <= '{default : '0};
-			peak_values <= '{default : '0};
-	        best_peak1_pos <= '0; best_peak2_pos <= '0;
-	        best_peak1_val <= '0; best_peak2_val <= '0;			
-			min_diff_reg <= 8'd255;
-			p1_reg <= '0; p2_reg <= '0;
-		end
-		else begin
-			start_signal <= '0;
 			done_signal <= 1'b0;
-			case(state) 
-				IDLE : begin
-				    if(start) begin 
-				        state <= RECEIVE_DATA;
-				        count <= '0;
-				    end
-				end
-				RECEIVE_DATA : begin
-					if(rx_valid) begin
-						pixel_row_data[count[4:0]] <= rx_data;
-						if(count[4:0] == 5'd31) begin
-							state <= COMPUTE;
-							count <= '0;
-							start_signal <= 1'b1;
-						end
-						else count <= count + 6'd1;
-					end
-				end
-				COMPUTE : begin
-					if(conv_engine_done) begin
-						state <= FIND_LANES;
-						peak_count <= '0;
-						for(int k=0; k<MAX_PEAKS; k++) begin
-							peak_positions[k] <= '0;
-							peak_values[k] <= '0;						
-						end
-						count <= 6'd0; 
-					end
-				end
-				FIND_LANES : begin
-					if(count[4:0] < 30) begin
-						// THRESHOLD üũ  ũ 
-						if(((result_data[count[4:0]] < 0) ? -result_data[count[4:0]] : result_data[count[4:0]]) > THRESHOLD && peak_count < MAX_PEAKS) begin
-							peak_positions[peak_count] <= count[4:0];
-							peak_values[peak_count] <= (result_data[count[4:0]] < 0) ? -result_data[count[4:0]] : result_data[count[4:0]];
-							peak_count <= peak_count + 1'b1;
-						end
-						count <= count + 6'd1;
-					end else begin
-						// SELECT_PAIR ʱȭ
-						state <= SELECT_PAIR;
-						min_diff_reg <= 8'd255;
-						p1_reg <= 3'd0;
-						p2_reg <= 3'd1;  // p2 ׻ p1+1 
-						best_peak1_pos <= '0;
-						best_peak2_pos <= '0;
-						best_peak1_val <= '0;
-						best_peak2_val <= '0;
-					end	
-				end
-				SELECT_PAIR : begin
-					// ũ 2 ̻ ־   
-					if(peak_count >= 2) begin
-						// p1 ȿ   ִ Ȯ
-						if(p1_reg < peak_count - 1) begin
-							// p2 ȿ   ִ Ȯ
-							if(p2_reg < peak_count) begin
-								//   (p1_reg, p2_reg) ˻
-								// peak_positions 0 ƴ ̹ FIND_LANES 
-								
-								// ߽ ġ 
-								logic [7:0] current_center;
-								logic [7:0] diff;
-								current_center <= (peak_positions[p1_reg] + peak_positions[p2_reg]) >> 1;
-								diff <= (current_center > last_center_pos) ? 
-								       (current_center - last_center_pos) : 
-								       (last_center_pos - current_center);
-								
-								// ּ  Ʈ
-								if(diff < min_diff_reg) begin
-									min_diff_reg <= diff;
-									best_peak1_pos <= peak_positions[p1_reg];
-									best_peak2_pos <= peak_positions[p2_reg];
-									best_peak1_val <= peak_values[p1_reg];
-									best_peak2_val <= peak_values[p2_reg];
-								end
-								
-								// p2   ( !)
-								p2_reg <= p2_reg + 1;
-								
-							end else begin
-								// p2  Ϸ  p1 , p2 ʱȭ
-								p1_reg <= p1_reg + 1;
-								p2_reg <= p1_reg + 2;  // ο p1  p2 = (p1+1) + 1
-							end
-						end else begin
-							//   ˻ Ϸ
-							state <= CALC_CENTER;
-						end
-					end else begin
-						// ũ   ٷ CALC_CENTER
-						state <= CALC_CENTER;
-					end
-				end								
-				CALC_CENTER: begin
-					if(best_peak1_pos != '0 && best_peak2_pos != '0) begin
-						tx_data <= (best_peak1_pos + best_peak2_pos) >> 1;
-						confidence <= ((best_peak1_val > 255) ? 8'd127 : (best_peak1_val[7:0] >> 1)) + 
-						              ((best_peak2_val > 255) ? 8'd127 : (best_peak2_val[7:0] >> 1));
-					end else begin
-						tx_data <= last_center_pos;
-						confidence <= 8'd0;
-					end
-					state <= SEND_RESULT;		
-				end
-				SEND_RESULT: begin					
-					done_signal <= 1'b1;
-					state <= IDLE;
-					last_center_pos <= tx_data;
-				end
-			endcase
+		end else begin
+			done_signal <= det_valid;
+			if(det_valid) begin
+				tx_data <= det_center;
+				confidence <= det_confidence;
+			end
 		end
 	end
-endmodule
\ No newline at end of file
+
+endmodule
@@ -0,0 +1,220 @@
+`timescale 1ns/1ps
+// ===== 초음파 3채널 샘플링 / 필터 / 스냅샷 =====
+// 초음파 IP 3개 (전방 / 오른쪽 / 왼쪽)의 BCD 거리 출력을 주기마다 직접 샘플링 → cm 변환 → 범위 검사
+// → 채널별 최근 3샘플 필터 → F/R/L + 장애물 조향 항 + 타임스탬프 + 번호를 한 사이클에 함께 갱신
+// CPU는 센서 IP 레지스터 6번 읽기 + 소프트웨어 평균 대신 스냅샷 레지스터 몇 개만 읽음
+//
+// 필터 (i_filter): 0 = 최신 샘플 (무효면 0), 1 = 유효 샘플 평균 (펌웨어 ULTRA_TAPS 3 동작),
+//                  2 = 중앙값 (3개 모두 유효할 때, 아니면 유효 샘플 평균)
+// 유효 샘플: BCD 자리마다 0~9, 0 < cm <= i_max_cm (펌웨어 0 < v <= 400 규칙), 무효 샘플은 이력에 0으로
+// 장애물 조향: 펌웨어 auto_step_with_cnn과 같은 식 (벽 거리 i_wall_cm, 이득 i_steer_k,
+//   가까운 쪽이 i_near_cm 이하면 2배), 제한 전 값 (signed 16비트 포화)
+// BCD 입력은 센서 IP 클럭과 무관할 수 있으므로 2단 동기화 후 두 사이클 연속 같은 값만 샘플
+module ultrasonic_snapshot #(
+	parameter integer CLK_HZ = 100_000_000
+)(
+	input logic clk,
+	input logic rst,   // Active Low
+
+	// ===== 설정 =====
+	input logic i_enable,
+	input logic [1:0] i_filter,
+	input logic [7:0] i_period_ms,                // 샘플 주기 (0 → 1 ms)
+	input logic [9:0] i_max_cm,
+	input logic [7:0] i_wall_cm,
+	input logic [7:0] i_steer_k,
+	input logic [7:0] i_near_cm,
+
+	// ===== 센서 IP BCD 출력: [11:8] 백, [7:4] 십, [3:0] 일 (채널 0 전방, 1 오른쪽, 2 왼쪽) =====
+	input logic [2:0][11:0] i_bcd,
+	input logic [31:0] i_now,                     // 타임스탬프 카운터 (REG_CYCLE_NOW)
+
+	// ===== 스냅샷 (모두 같은 사이클에 갱신) =====
+	output logic [2:0][9:0] o_cm,                 // 필터 거리 (0 = 유효 샘플 없음)
+	output logic [2:0] o_valid,
+	output logic signed [15:0] o_obstacle,        // 장애물 조향 항 (+ 오른쪽 벽 → 왼쪽으로)
+	output logic [31:0] o_ts,                     // 샘플 시각
+	output logic [7:0] o_seq,                     // 스냅샷 번호 (갱신마다 +1)
+	output logic [15:0] o_rejects                 // 범위 밖 / BCD 오류 샘플 수 (포화)
+);
+	localparam integer MS_DIV = CLK_HZ / 1000;
+	localparam integer TAPS = 3;
+
+	// ===== 입력 동기화 + 안정 검사 =====
+	(* ASYNC_REG = "TRUE" *) logic [2:0][11:0] bcd_s1, bcd_s2;
+	logic [2:0][11:0] bcd_s3;
+	logic bcd_stable;
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			bcd_s1 <= '0;
+			bcd_s2 <= '0;
+			bcd_s3 <= '0;
+		end else begin
+			bcd_s1 <= i_bcd;
+			bcd_s2 <= bcd_s1;
+			bcd_s3 <= bcd_s2;
+		end
+	end
+
+	assign bcd_stable = (bcd_s2 == bcd_s3);
+
+	// ===== 샘플 주기 (1 ms 분주 → i_period_ms) =====
+	logic [$clog2(MS_DIV)-1:0] ms_cnt;
+	logic [7:0] period_cnt;
+	logic sample_due;
+	logic take;
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			ms_cnt <= '0;
+			period_cnt <= '0;
+			sample_due <= 1'b0;
+		end else if(!i_enable) begin
+			ms_cnt <= '0;
+			period_cnt <= '0;
+			sample_due <= 1'b0;
+		end else begin
+			if(take) sample_due <= 1'b0;
+			if(ms_cnt == MS_DIV - 1) begin
+				ms_cnt <= '0;
+				if(period_cnt + 8'd1 >= i_period_ms) begin
+					period_cnt <= '0;
+					sample_due <= 1'b1;
+				end else begin
+					period_cnt <= period_cnt + 8'd1;
+				end
+			end else begin
+				ms_cnt <= ms_cnt + 1'b1;
+			end
+		end
+	end
+
+	// 자리가 바뀌는 중이면 안정될 때까지 한두 사이클 미룸
+	assign take = sample_due && bcd_stable;
+
+	// ===== 1단: BCD → cm, 범위 검사, 이력 저장 =====
+	logic [9:0] hist [0:2][0:TAPS-1];            // 0 = 무효 샘플
+	logic [1:0] hist_pos;
+	logic [2:0] new_ok;
+	logic [2:0][9:0] new_cm;
+	logic [1:0] new_rejects;                     // 거리 0 (에코 없음)은 오류로 세지 않음
+	logic [31:0] sample_ts;
+	logic stage1_valid;
+
+	always_comb begin
+		new_rejects = '0;
+		for(int c = 0; c < 3; c++) begin
+			logic [3:0] h, t, o;
+			h = bcd_s2[c][11:8];
+			t = bcd_s2[c][7:4];
+			o = bcd_s2[c][3:0];
+			new_cm[c] = 10'(h * 7'd100) + 10'(t * 4'd10) + 10'(o);
+			new_ok[c] = (h <= 4'd9) && (t <= 4'd9) && (o <= 4'd9) && (new_cm[c] != 10'd0) && (new_cm[c] <= i_max_cm);
+			if(!new_ok[c] && bcd_s2[c] != 12'd0) new_rejects = new_rejects + 2'd1;
+		end
+	end
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			for(int c = 0; c < 3; c++)
+				for(int i = 0; i < TAPS; i++) hist[c][i] <= '0;
+			hist_pos <= '0;
+			sample_ts <= '0;
+			stage1_valid <= 1'b0;
+			o_rejects <= '0;
+		end else begin
+			stage1_valid <= take;
+			if(take) begin
+				for(int c = 0; c < 3; c++) hist[c][hist_pos] <= new_ok[c] ? new_cm[c] : 10'd0;
+				hist_pos <= (hist_pos == TAPS - 1) ? 2'd0 : hist_pos + 2'd1;
+				sample_ts <= i_now;
+				o_rejects <= (17'(o_rejects) + 17'(new_rejects) > 17'hFFFF) ? 16'hFFFF : o_rejects + 16'(new_rejects);
+			end
+		end
+	end
+
+	// ===== 2단: 채널별 필터 =====
+	logic [1:0] last_pos;
+	logic [2:0][9:0] filt_cm;
+	logic [31:0] filt_ts;
+	logic stage2_valid;
+
+	assign last_pos = (hist_pos == 2'd0) ? 2'(TAPS - 1) : hist_pos - 2'd1;
+
+	function automatic logic [9:0] med3(input logic [9:0] a, input logic [9:0] b, input logic [9:0] c);
+		logic [9:0] lo, hi;
+		lo = (a < b) ? a : b;
+		hi = (a < b) ? b : a;
+		return (c < lo) ? lo : ((c > hi) ? hi : c);
+	endfunction
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			filt_cm <= '0;
+			filt_ts <= '0;
+			stage2_valid <= 1'b0;
+		end else begin
+			stage2_valid <= stage1_valid;
+			if(stage1_valid) begin
+				filt_ts <= sample_ts;
+				for(int c = 0; c < 3; c++) begin
+					logic [11:0] sum;
+					logic [1:0] cnt;
+					logic [9:0] avg;
+					sum = '0;
+					cnt = '0;
+					for(int i = 0; i < TAPS; i++)
+						if(hist[c][i] != 10'd0) begin
+							sum = sum + 12'(hist[c][i]);
+							cnt = cnt + 2'd1;
+						end
+					// 나누기 3 = x 21846 >> 16 (합 <= 3069에서 정확)
+					case(cnt)
+						2'd1:    avg = sum[9:0];
+						2'd2:    avg = sum[10:1];
+						2'd3:    avg = 10'((28'(sum) * 28'd21846) >> 16);
+						default: avg = 10'd0;
+					endcase
+					case(i_filter)
+						2'd0:    filt_cm[c] <= hist[c][last_pos];
+						2'd2:    filt_cm[c] <= (cnt == 2'd3) ? med3(hist[c][0], hist[c][1], hist[c][2]) : avg;
+						default: filt_cm[c] <= avg;
+					endcase
+				end
+			end
+		end
+	end
+
+	// ===== 3단: 장애물 조향 항 + 스냅샷 공개 =====
+	logic signed [19:0] obst_r, obst_l, obst_sum, obst_boost;
+	logic [9:0] side_near;
+	logic [9:0] fr, fl;
+
+	assign fr = filt_cm[1];
+	assign fl = filt_cm[2];
+	assign obst_r = (fr != 10'd0 && fr <= i_wall_cm) ? 20'(signed'({1'b0, 10'(i_wall_cm) - fr}) * signed'({1'b0, i_steer_k})) : 20'sd0;
+	assign obst_l = (fl != 10'd0 && fl <= i_wall_cm) ? 20'(signed'({1'b0, 10'(i_wall_cm) - fl}) * signed'({1'b0, i_steer_k})) : 20'sd0;
+	assign obst_sum = obst_r - obst_l;
+	// min_nonzero(R, L)
+	assign side_near = (fr == 10'd0) ? fl : ((fl == 10'd0) ? fr : ((fr < fl) ? fr : fl));
+	assign obst_boost = (side_near != 10'd0 && side_near <= i_near_cm) ? (obst_sum <<< 1) : obst_sum;
+
+	always_ff @(posedge clk or negedge rst) begin
+		if(!rst) begin
+			o_cm <= '0;
+			o_valid <= '0;
+			o_obstacle <= '0;
+			o_ts <= '0;
+			o_seq <= '0;
+		end else if(stage2_valid) begin
+			o_cm <= filt_cm;
+			for(int c = 0; c < 3; c++) o_valid[c] <= (filt_cm[c] != 10'd0);
+			o_obstacle <= (obst_boost > 20'sd32767)  ? 16'sd32767 :
+			              (obst_boost < -20'sd32768) ? -16'sd32768 : 16'(obst_boost);
+			o_ts <= filt_ts;
+			o_seq <= o_seq + 8'd1;
+		end
+	end
+
+endmodule